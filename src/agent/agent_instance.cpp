@@ -45,7 +45,8 @@ namespace BorderRouter {
 AgentInstance::AgentInstance(const char *aIfName) :
     mNcp(Ncp::Controller::Create(aIfName)),
     mCoap(Coap::Agent::Create(SendCoap, this)),
-    mBorderAgent(mNcp, mCoap) {}
+    mBorderAgent(mNcp, mCoap),
+    mDiagnosticCollector(mCoap) {}
 
 otbrError AgentInstance::Init(void)
 {
@@ -73,12 +74,14 @@ void AgentInstance::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set
 {
     mNcp->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd);
     mBorderAgent.UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+    mDiagnosticCollector.UpdateFdSet(aReadFdSet, aWriteFdSet, aMaxFd, aTimeout);
 }
 
 void AgentInstance::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
     mNcp->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
     mBorderAgent.Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    mDiagnosticCollector.Process(aReadFdSet, aWriteFdSet);
 }
 
 void AgentInstance::FeedCoap(void *aContext, int aEvent, va_list aArguments)
@@ -41,6 +41,7 @@
 
 #include "coap.hpp"
 #include "border_agent.hpp"
+#include "diagnostic_collector.hpp"
 #include "ncp.hpp"
 
 namespace ot {
@@ -96,15 +97,32 @@ public:
      */
     void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
 
+    /**
+     * This method returns the border agent of this instance.
+     *
+     * @returns A reference to the border agent.
+     *
+     */
+    BorderAgent &GetBorderAgent(void) { return mBorderAgent; }
+
+    /**
+     * This method returns the diagnostic collector of this instance.
+     *
+     * @returns A reference to the diagnostic collector.
+     *
+     */
+    DiagnosticCollector &GetDiagnosticCollector(void) { return mDiagnosticCollector; }
+
 private:
     static ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
                             void *aContext);
     static void FeedCoap(void *aContext, int aEvent, va_list aArguments);
     ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort);
 
-    Ncp::Controller *mNcp;
-    Coap::Agent     *mCoap;
-    BorderAgent      mBorderAgent;
+    Ncp::Controller    *mNcp;
+    Coap::Agent        *mCoap;
+    BorderAgent         mBorderAgent;
+    DiagnosticCollector mDiagnosticCollector;
 };
 
 } // namespace BorderRouter
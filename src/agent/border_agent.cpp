@@ -34,6 +34,7 @@
 #include "border_agent.hpp"
 
 #include <assert.h>
+#include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -41,8 +42,9 @@
 #include "border_agent.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
 #include "common/types.hpp"
-#include "common/tlv.hpp"
+#include "common/tlv_view.hpp"
 #include "dtls.hpp"
 #include "ncp.hpp"
 #include "uris.hpp"
@@ -72,49 +74,268 @@ enum
 };
 
 /**
- * TLV types
+ * This function copies the Block options of a message, in the order they must be added.
  *
  */
-enum
+static void CopyBlocks(const Coap::Message &aFrom, Coap::Message &aTo)
 {
-    kJoinerRouterLocator = 20, ///< meshcop Joiner Router Locator TLV
-};
+    uint32_t number;
+    bool     more;
+    uint16_t size;
+
+    if (aFrom.GetBlock(Coap::kBlock2, number, more, size))
+    {
+        aTo.SetBlock(Coap::kBlock2, number, more, size);
+    }
+
+    if (aFrom.GetBlock(Coap::kBlock1, number, more, size))
+    {
+        aTo.SetBlock(Coap::kBlock1, number, more, size);
+    }
+}
+
+void BorderAgent::SendCommissionerResponse(Dtls::Session &aSession, const uint8_t *aToken, uint8_t aTokenLength,
+                                           Coap::Code aCode, const uint8_t *aPayload, uint16_t aLength,
+                                           const Coap::Message *aBlocks)
+{
+    Coap::Message *message = mCoaps->NewMessage(Coap::kTypeNonConfirmable, aCode, aToken, aTokenLength);
+    uint32_t       sequence;
+
+    // An error response ends the observation.
+    if ((aCode >> 5) != 2)
+    {
+        mObservers.Deregister(&aSession, aToken, aTokenLength);
+    }
+    else if (mObservers.Notify(&aSession, aToken, aTokenLength, sequence))
+    {
+        message->SetObserve(sequence);
+    }
+
+    if (aBlocks != NULL)
+    {
+        CopyBlocks(*aBlocks, *message);
+    }
+
+    message->SetPayload(aPayload, aLength);
+
+    SendCoapsMessage(aSession, *message);
+    mCoaps->FreeMessage(message);
+}
+
+void BorderAgent::SendCoapsMessage(Dtls::Session &aSession, Coap::Message &aMessage)
+{
+    const sockaddr_in6 &peer = aSession.GetPeerAddress();
+
+    mCoapsTransport = mStreamFramers.count(&aSession) ? Dtls::Server::kTransportStream :
+                      Dtls::Server::kTransportDatagram;
+    mCoaps->Send(aMessage, peer.sin6_addr.s6_addr, ntohs(peer.sin6_port), NULL, NULL);
+    mCoapsTransport = Dtls::Server::kTransportDatagram;
+}
 
 void BorderAgent::ForwardCommissionerResponse(const Coap::Message &aMessage)
 {
-    uint8_t        tokenLength = 0;
-    const uint8_t *token = aMessage.GetToken(tokenLength);
-    uint16_t       length = 0;
-    const uint8_t *payload = NULL;
+    uint8_t                tokenLength = 0;
+    const uint8_t         *token = aMessage.GetToken(tokenLength);
+    uint16_t               length = 0;
+    const uint8_t         *payload = aMessage.GetPayload(length);
+    Coap::Code             code = aMessage.GetCode();
+    ForwardTable::Entry    entry;
+    DatasetCache::Response response;
+    DatasetCache::Waiters  waiters;
+    uint32_t               number;
+    bool                   more;
+    uint16_t               size;
+
+    response.mCode = code;
+    response.mPartial = aMessage.GetBlock(Coap::kBlock2, number, more, size);
+    response.mPayload.assign(payload, payload + length);
+    mDatasetCache.Complete(token, tokenLength, response, waiters);
+
+    for (DatasetCache::Waiters::const_iterator it = waiters.begin(); it != waiters.end(); ++it)
+    {
+        SendCommissionerResponse(*it->mSession, it->mToken, it->mTokenLength, code, payload, length, &aMessage);
+    }
 
-    Coap::Code     code = aMessage.GetCode();
-    Coap::Message *message = mCoaps->NewMessage(Coap::kTypeNonConfirmable, code, token, tokenLength);
+    VerifyOrExit(mForwardTable.Remove(token, tokenLength, entry) == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_WARNING, "Response to unknown forwarded request!"));
 
     otbrLog(OTBR_LOG_INFO, "Forwarding CommissionerResponse ...");
 
-    payload = aMessage.GetPayload(length);
-    message->SetPayload(payload, length);
+    SendCommissionerResponse(*entry.mSession, entry.mToken, entry.mTokenLength, code, payload, length, &aMessage);
 
-    mCoaps->Send(*message, NULL, 0, NULL, NULL);
-    mCoaps->FreeMessage(message);
+    // Intermediate blocks of a change are acknowledged with Continue.
+    VerifyOrExit((code >> 5) == 2 && code != Coap::kCodeContinue);
+
+    // The leader accepted the change, observers of the changed state are notified.
+    if (!strcmp(OT_URI_PATH_ACTIVE_SET, entry.mPath))
+    {
+        mDatasetCache.Invalidate(OT_URI_PATH_ACTIVE_GET);
+        NotifyObservers(OT_URI_PATH_ACTIVE_GET);
+    }
+    else if (!strcmp(OT_URI_PATH_PENDING_SET, entry.mPath))
+    {
+        mDatasetCache.Invalidate(OT_URI_PATH_PENDING_GET);
+        NotifyObservers(OT_URI_PATH_PENDING_GET);
+    }
+    else if (!strcmp(OT_URI_PATH_COMMISSIONER_SET, entry.mPath))
+    {
+        NotifyObservers(OT_URI_PATH_COMMISSIONER_GET);
+    }
+    else if (!strcmp(OT_URI_PATH_COMMISSIONER_PETITION, entry.mPath) ||
+             !strcmp(OT_URI_PATH_COMMISSIONER_KEEP_ALIVE, entry.mPath))
+    {
+        UpdateActiveSession(*entry.mSession, payload, length);
+    }
+
+exit:
+    return;
+}
+
+void BorderAgent::UpdateActiveSession(Dtls::Session &aSession, const uint8_t *aPayload, uint16_t aLength)
+{
+    TlvView tlvs;
+    int8_t  state;
+
+    VerifyOrExit(tlvs.Init(aPayload, aLength) == OTBR_ERROR_NONE && tlvs.GetState(state));
+
+    if (state == kStateAccept)
+    {
+        if (mActiveSession != &aSession)
+        {
+            otbrLog(OTBR_LOG_INFO, "Commissioner petition accepted.");
+        }
+        mActiveSession = &aSession;
+    }
+    else if (state == kStateReject && mActiveSession == &aSession)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Commissioner rejected by leader.");
+        mActiveSession = NULL;
+    }
+
+exit:
+    return;
 }
 
 void BorderAgent::ForwardCommissionerRequest(const Coap::Resource &aResource, const Coap::Message &aMessage,
-                                             const uint8_t *aIp6, uint16_t aPort)
+                                             Coap::Message &aResponse, const uint8_t *aIp6, uint16_t aPort)
 {
     uint8_t        tokenLength = 0;
     const uint8_t *token = aMessage.GetToken(tokenLength);
     const char    *path = aResource.mPath;
+    Dtls::Session *session = FindDtlsSession(aIp6, aPort, mCoapsTransport);
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+    uint32_t       observe;
+    uint32_t       number;
+    bool           more;
+    uint16_t       size;
 
-    Coap::Message *message = mCoap->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
-                                               token, tokenLength);
-    Ip6Address     addr(kAloc16Leader);
+    VerifyOrExit(session != NULL, otbrLog(OTBR_LOG_ERR, "Request from unknown session!"));
+
+    if (aMessage.GetBlock(Coap::kBlock1, number, more, size) || aMessage.GetBlock(Coap::kBlock2, number, more, size))
+    {
+        ForwardCommissionerBlock(*session, path, aMessage, aResponse);
+        ExitNow();
+    }
+
+    // A request too large for the Thread network has to be sent block-wise.
+    if (length > kMaxBlockSize)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Request %s too large, asking for blocks of %u bytes.", path, kMaxBlockSize);
+        aResponse.SetCode(Coap::kCodeRequestTooLarge);
+        aResponse.SetBlock(Coap::kBlock1, 0, true, kMaxBlockSize);
+        ExitNow();
+    }
+
+    if (aMessage.GetObserve(observe) &&
+        (!strcmp(OT_URI_PATH_ACTIVE_GET, path) || !strcmp(OT_URI_PATH_PENDING_GET, path) ||
+         !strcmp(OT_URI_PATH_COMMISSIONER_GET, path)))
+    {
+        if (observe == 0)
+        {
+            if (mObservers.Register(session, path, token, tokenLength, payload, length) != OTBR_ERROR_NONE)
+            {
+                // The request is still served, without registration.
+                otbrLog(OTBR_LOG_WARNING, "Failed to observe %s: %s", path, strerror(errno));
+            }
+        }
+        else
+        {
+            mObservers.Deregister(session, token, tokenLength);
+        }
+    }
+
+    HandleCommissionerRequest(*session, path, token, tokenLength, payload, length, &aResponse);
+
+exit:
+    return;
+}
+
+void BorderAgent::ForwardCommissionerBlock(Dtls::Session &aSession, const char *aPath, const Coap::Message &aMessage,
+                                           Coap::Message &aResponse)
+{
+    uint8_t        tokenLength = 0;
+    const uint8_t *token = aMessage.GetToken(tokenLength);
     uint16_t       length = 0;
     const uint8_t *payload = aMessage.GetPayload(length);
+    uint8_t        forwardToken[ForwardTable::kSizeOfToken];
+    uint32_t       number;
+    bool           more;
+    uint16_t       size;
+
+    if (aMessage.GetBlock(Coap::kBlock1, number, more, size) && size > kMaxBlockSize)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Block of %u bytes too large, asking for %u bytes.", size, kMaxBlockSize);
+        aResponse.SetCode(Coap::kCodeRequestTooLarge);
+        aResponse.SetBlock(Coap::kBlock1, number, more, kMaxBlockSize);
+        ExitNow();
+    }
 
+    PrepareCommissionerRequest(aPath);
 
+    // Each block is relayed as it arrives, the leader reassembles the request and the commissioner the response.
+    if (mForwardTable.Add(&aSession, aPath, token, tokenLength, forwardToken) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to forward block of %s: %s", aPath, strerror(errno));
+        aResponse.SetCode(Coap::kCodeServiceUnavailable);
+        ExitNow();
+    }
 
-    otbrLog(OTBR_LOG_INFO, "Forwarding request %s...", path);
+    otbrLog(OTBR_LOG_INFO, "Forwarding block of request %s...", aPath);
+    ForwardToLeader(aPath, forwardToken, &aMessage, payload, length);
+
+exit:
+    return;
+}
+
+void BorderAgent::PrepareCommissionerRequest(const char *aPath)
+{
+    if (!strcmp(OT_URI_PATH_ACTIVE_SET, aPath))
+    {
+        mDatasetCache.Invalidate(OT_URI_PATH_ACTIVE_GET);
+    }
+    else if (!strcmp(OT_URI_PATH_ENERGY_SCAN, aPath))
+    {
+        mEnergySummary.Reset();
+        mEnergyReportTime = 0;
+    }
+    else if (!strcmp(OT_URI_PATH_PANID_QUERY, aPath))
+    {
+        mPanIdConflicts.clear();
+    }
+    else if (!strcmp(OT_URI_PATH_PENDING_SET, aPath))
+    {
+        mDatasetCache.Invalidate(OT_URI_PATH_PENDING_GET);
+    }
+}
+
+void BorderAgent::ForwardToLeader(const char *aPath, const uint8_t *aForwardToken, const Coap::Message *aBlocks,
+                                  const uint8_t *aPayload, uint16_t aLength)
+{
+    Ip6Address     addr(kAloc16Leader);
+    const char    *path = aPath;
+    Coap::Message *message = mCoap->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                               aForwardToken, ForwardTable::kSizeOfToken);
 
     if (!strcmp(OT_URI_PATH_COMMISSIONER_PETITION, path))
     {
@@ -127,15 +348,137 @@ void BorderAgent::ForwardCommissionerRequest(const Coap::Resource &aResource, co
 
     message->SetPath(path);
 
-    message->SetPayload(payload, length);
+    if (aBlocks != NULL)
+    {
+        CopyBlocks(*aBlocks, *message);
+    }
+
+    message->SetPayload(aPayload, aLength);
 
-    otbrDump(OTBR_LOG_DEBUG, "    Payload:", payload, length);
+    otbrDump(OTBR_LOG_DEBUG, "    Payload:", aPayload, aLength);
 
     mCoap->Send(*message, addr.m8, kCoapUdpPort, BorderAgent::ForwardCommissionerResponse, this);
     mCoap->FreeMessage(message);
+}
 
-    (void)aIp6;
-    (void)aPort;
+void BorderAgent::HandleCommissionerRequest(Dtls::Session &aSession, const char *aPath, const uint8_t *aToken,
+                                            uint8_t aTokenLength, const uint8_t *aPayload, uint16_t aLength,
+                                            Coap::Message *aResponse)
+{
+    const char *path = aPath;
+    uint8_t     forwardToken[ForwardTable::kSizeOfToken];
+    std::string key;
+    bool        cacheable = false;
+
+    PrepareCommissionerRequest(path);
+
+    cacheable = aTokenLength <= ForwardTable::kMaxTokenLength &&
+                DatasetCache::GetKey(path, aPayload, aLength, key);
+
+    if (cacheable)
+    {
+        DatasetCache::Waiter          waiter;
+        const DatasetCache::Response *response = NULL;
+
+        waiter.mSession = &aSession;
+        waiter.mTokenLength = aTokenLength;
+        memcpy(waiter.mToken, aToken, aTokenLength);
+
+        switch (mDatasetCache.Lookup(key, waiter, response))
+        {
+        case DatasetCache::kResultHit:
+            otbrLog(OTBR_LOG_INFO, "Responding request %s from cache.", path);
+
+            if (aResponse != NULL)
+            {
+                uint32_t sequence;
+
+                if (mObservers.Notify(&aSession, aToken, aTokenLength, sequence))
+                {
+                    aResponse->SetObserve(sequence);
+                }
+
+                aResponse->SetCode(static_cast<Coap::Code>(response->mCode));
+                aResponse->SetPayload(response->mPayload.empty() ? NULL : &response->mPayload[0],
+                                      static_cast<uint16_t>(response->mPayload.size()));
+            }
+            else
+            {
+                SendCommissionerResponse(aSession, aToken, aTokenLength, static_cast<Coap::Code>(response->mCode),
+                                         response->mPayload.empty() ? NULL : &response->mPayload[0],
+                                         static_cast<uint16_t>(response->mPayload.size()), NULL);
+            }
+
+            ExitNow();
+            break;
+
+        case DatasetCache::kResultJoined:
+            otbrLog(OTBR_LOG_INFO, "Request %s already forwarded, waiting for its response.", path);
+            ExitNow();
+            break;
+
+        case DatasetCache::kResultMiss:
+            break;
+        }
+    }
+
+    if (mForwardTable.Add(&aSession, aPath, aToken, aTokenLength, forwardToken) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to forward request %s: %s", path, strerror(errno));
+
+        if (aResponse != NULL)
+        {
+            aResponse->SetCode(Coap::kCodeServiceUnavailable);
+        }
+
+        ExitNow();
+    }
+
+    if (cacheable)
+    {
+        mDatasetCache.Begin(key, forwardToken);
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Forwarding request %s...", path);
+    ForwardToLeader(path, forwardToken, NULL, aPayload, aLength);
+
+exit:
+    return;
+}
+
+void BorderAgent::NotifyObservers(const char *aPath)
+{
+    ObserverRegistry::Observers observers;
+
+    mObservers.GetObservers(aPath, observers);
+
+    // Notifications of the same dataset are coalesced by the dataset cache into one request to the leader.
+    for (ObserverRegistry::Observers::const_iterator it = observers.begin(); it != observers.end(); ++it)
+    {
+        otbrLog(OTBR_LOG_INFO, "Notifying observer of %s ...", aPath);
+        HandleCommissionerRequest(*it->mSession, it->mPath, it->mToken, it->mTokenLength,
+                                  it->mPayload.empty() ? NULL : &it->mPayload[0],
+                                  static_cast<uint16_t>(it->mPayload.size()), NULL);
+    }
+}
+
+void BorderAgent::SendToCommissioner(const char *aPath, const uint8_t *aToken, uint8_t aTokenLength,
+                                     const uint8_t *aPayload, uint16_t aLength)
+{
+    VerifyOrExit(mActiveSession != NULL, otbrLog(OTBR_LOG_WARNING, "No active commissioner, %s dropped!", aPath));
+
+    {
+        Coap::Message *message = mCoaps->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost, aToken, aTokenLength);
+
+        message->SetPath(aPath);
+        message->SetPayload(aPayload, aLength);
+
+        SendCoapsMessage(*mActiveSession, *message);
+        mCoaps->FreeMessage(message);
+    }
+
+exit:
+    return;
 }
 
 void BorderAgent::HandleRelayReceive(const Coap::Message &aMessage, const uint8_t *aIp6, uint16_t aPort)
@@ -145,58 +488,110 @@ void BorderAgent::HandleRelayReceive(const Coap::Message &aMessage, const uint8_
     uint16_t       length = 0;
     const uint8_t *payload = aMessage.GetPayload(length);
 
-    Coap::Message *message = mCoaps->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost,
-                                                token, tokenLength);
     otbrLog(OTBR_LOG_INFO, "Handle Relay receive ...");
 
-    message->SetPath(OT_URI_PATH_RELAY_RX);
-    message->SetPayload(payload, length);
+    SendToCommissioner(OT_URI_PATH_RELAY_RX, token, tokenLength, payload, length);
 
-    mCoaps->Send(*message, NULL, 0, NULL, NULL);
-    mCoaps->FreeMessage(message);
+    (void)aIp6;
+    (void)aPort;
+}
+
+void BorderAgent::HandleDatasetChanged(const Coap::Message &aMessage, Coap::Message &aResponse, const uint8_t *aIp6,
+                                       uint16_t aPort)
+{
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+
+    otbrLog(OTBR_LOG_INFO, "Dataset changed.");
+
+    mDatasetCache.Invalidate(NULL);
+    aResponse.SetCode(Coap::kCodeChanged);
+
+    SendToCommissioner(OT_URI_PATH_DATASET_CHANGED, NULL, 0, payload, length);
+    NotifyObservers(OT_URI_PATH_ACTIVE_GET);
+    NotifyObservers(OT_URI_PATH_PENDING_GET);
 
     (void)aIp6;
     (void)aPort;
 }
 
+void BorderAgent::HandleEnergyReport(const Coap::Message &aMessage, Coap::Message &aResponse)
+{
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+
+    aResponse.SetCode(Coap::kCodeChanged);
+
+    VerifyOrExit(mEnergySummary.Merge(payload, length) == OTBR_ERROR_NONE,
+                 otbrLog(OTBR_LOG_WARNING, "Malformed energy report!"));
+
+    // Reports arriving within the delay are sent to the commissioner in one summary.
+    if (mEnergySummary.IsUpdated() && mEnergyReportTime == 0)
+    {
+        mEnergyReportTime = GetNow() + kEnergyReportDelay;
+    }
+
+exit:
+    return;
+}
+
+void BorderAgent::SendEnergyReport(void)
+{
+    std::vector<uint8_t> payload;
+
+    mEnergyReportTime = 0;
+    mEnergySummary.Flush(payload);
+    VerifyOrExit(!payload.empty());
+
+    otbrLog(OTBR_LOG_INFO, "Sending energy report summary ...");
+    SendToCommissioner(OT_URI_PATH_ENERGY_REPORT, NULL, 0, &payload[0], static_cast<uint16_t>(payload.size()));
+
+exit:
+    return;
+}
+
+void BorderAgent::HandlePanIdConflict(const Coap::Message &aMessage, Coap::Message &aResponse)
+{
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+
+    aResponse.SetCode(Coap::kCodeChanged);
+
+    // Many devices report the same conflict, only the first report of each is relayed.
+    if (mPanIdConflicts.insert(std::string(reinterpret_cast<const char *>(payload), length)).second)
+    {
+        SendToCommissioner(OT_URI_PATH_PANID_CONFLICT, NULL, 0, payload, length);
+    }
+}
+
 void BorderAgent::HandleRelayTransmit(const Coap::Message &aMessage, const uint8_t *aIp6, uint16_t aPort)
 {
     uint16_t       length = 0;
     const uint8_t *payload = aMessage.GetPayload(length);
     uint16_t       rloc = kInvalidLocator;
+    TlvView        tlvs;
 
     otbrDump(OTBR_LOG_DEBUG, "Relay transmit:", payload, length);
 
-    for (const Tlv *tlv = reinterpret_cast<const Tlv *>(payload); tlv < reinterpret_cast<const Tlv *>(payload + length);
-         tlv = tlv->GetNext())
-    {
-        if (tlv->GetType() == kJoinerRouterLocator)
-        {
-            rloc = tlv->GetValueUInt16();
-            break;
-        }
-    }
+    VerifyOrExit(tlvs.Init(payload, length) == OTBR_ERROR_NONE, otbrLog(OTBR_LOG_ERR, "Malformed relay transmit!"));
 
-    if (rloc == kInvalidLocator)
+    if (!tlvs.GetJoinerRouterLocator(rloc) || rloc == kInvalidLocator)
     {
         otbrLog(OTBR_LOG_ERR, "Joiner Router Locator not found!");
         ExitNow();
     }
 
     {
-        Ip6Address     addr(rloc);
         uint8_t        tokenLength = 0;
         const uint8_t *token = aMessage.GetToken(tokenLength);
-        Coap::Message *message = mCoap->NewMessage(Coap::kTypeNonConfirmable,
-                                                   Coap::kCodePost,
-                                                   token, tokenLength);
 
-        message->SetPath(OT_URI_PATH_RELAY_TX);
-        message->SetPayload(payload, length);
-        mCoap->Send(*message, addr.m8, kCoapUdpPort, NULL, NULL);
-        mCoap->FreeMessage(message);
+        // Messages are queued per joiner router and sent as fairness and rates allow.
+        VerifyOrExit(mRelayQueue.Push(rloc, token, tokenLength, payload, length) == OTBR_ERROR_NONE,
+                     otbrLog(OTBR_LOG_WARNING, "Relay to joiner router 0x%04x dropped: %s!", rloc, strerror(errno)));
     }
 
+    SendRelays();
+
 exit:
 
     (void)aIp6;
@@ -205,6 +600,25 @@ exit:
     return;
 }
 
+void BorderAgent::SendRelays(void)
+{
+    RelayQueue::Relay relay;
+
+    while (mRelayQueue.Pop(GetNow(), relay))
+    {
+        Ip6Address     addr(relay.mLocator);
+        Coap::Message *message = mCoap->NewMessage(Coap::kTypeNonConfirmable,
+                                                   Coap::kCodePost,
+                                                   relay.mToken, relay.mTokenLength);
+
+        message->SetPath(OT_URI_PATH_RELAY_TX);
+        message->SetPayload(relay.mPayload.empty() ? NULL : &relay.mPayload[0],
+                            static_cast<uint16_t>(relay.mPayload.size()));
+        mCoap->Send(*message, addr.m8, kCoapUdpPort, NULL, NULL);
+        mCoap->FreeMessage(message);
+    }
+}
+
 BorderAgent::BorderAgent(Ncp::Controller *aNcp, Coap::Agent *aCoap) :
     mActiveGet(OT_URI_PATH_ACTIVE_GET, ForwardCommissionerRequest, this),
     mActiveSet(OT_URI_PATH_ACTIVE_SET, ForwardCommissionerRequest, this),
@@ -212,11 +626,22 @@ BorderAgent::BorderAgent(Ncp::Controller *aNcp, Coap::Agent *aCoap) :
     mPendingSet(OT_URI_PATH_PENDING_SET, ForwardCommissionerRequest, this),
     mCommissionerPetitionHandler(OT_URI_PATH_COMMISSIONER_PETITION, ForwardCommissionerRequest, this),
     mCommissionerKeepAliveHandler(OT_URI_PATH_COMMISSIONER_KEEP_ALIVE, ForwardCommissionerRequest, this),
+    mCommissionerGetHandler(OT_URI_PATH_COMMISSIONER_GET, ForwardCommissionerRequest, this),
     mCommissionerSetHandler(OT_URI_PATH_COMMISSIONER_SET, ForwardCommissionerRequest, this),
     mCommissionerRelayTransmitHandler(OT_URI_PATH_RELAY_TX, HandleRelayTransmit, this),
+    mEnergyScanHandler(OT_URI_PATH_ENERGY_SCAN, ForwardCommissionerRequest, this),
+    mPanIdQueryHandler(OT_URI_PATH_PANID_QUERY, ForwardCommissionerRequest, this),
     mCommissionerRelayReceiveHandler(OT_URI_PATH_RELAY_RX, BorderAgent::HandleRelayReceive, this),
+    mDatasetChangedHandler(OT_URI_PATH_DATASET_CHANGED, BorderAgent::HandleDatasetChanged, this),
+    mEnergyReportHandler(OT_URI_PATH_ENERGY_REPORT, BorderAgent::HandleEnergyReport, this),
+    mPanIdConflictHandler(OT_URI_PATH_PANID_CONFLICT, BorderAgent::HandlePanIdConflict, this),
     mCoap(aCoap),
     mDtlsServer(Dtls::Server::Create(kBorderAgentUdpPort, HandleDtlsSessionState, this)),
+    mTlsServer(NULL),
+    mTlsPort(0),
+    mCoapsTransport(Dtls::Server::kTransportDatagram),
+    mActiveSession(NULL),
+    mEnergyReportTime(0),
     mCoaps(Coap::Agent::Create(SendCoaps, this)),
     mNcp(aNcp) {}
 
@@ -224,6 +649,11 @@ otbrError BorderAgent::Start(void)
 {
     otbrError error = OTBR_ERROR_NONE;
 
+    if (mTlsPort != 0)
+    {
+        mTlsServer = Dtls::Server::Create(mTlsPort, HandleTlsSessionState, this, Dtls::Server::kTransportStream);
+    }
+
     SuccessOrExit(error = mCoaps->AddResource(mActiveGet));
     SuccessOrExit(error = mCoaps->AddResource(mActiveSet));
     SuccessOrExit(error = mCoaps->AddResource(mPendingGet));
@@ -231,10 +661,16 @@ otbrError BorderAgent::Start(void)
 
     SuccessOrExit(error = mCoaps->AddResource(mCommissionerPetitionHandler));
     SuccessOrExit(error = mCoaps->AddResource(mCommissionerKeepAliveHandler));
+    SuccessOrExit(error = mCoaps->AddResource(mCommissionerGetHandler));
     SuccessOrExit(error = mCoaps->AddResource(mCommissionerSetHandler));
     SuccessOrExit(error = mCoaps->AddResource(mCommissionerRelayTransmitHandler));
+    SuccessOrExit(error = mCoaps->AddResource(mEnergyScanHandler));
+    SuccessOrExit(error = mCoaps->AddResource(mPanIdQueryHandler));
 
     SuccessOrExit(error = mCoap->AddResource(mCommissionerRelayReceiveHandler));
+    SuccessOrExit(error = mCoap->AddResource(mDatasetChangedHandler));
+    SuccessOrExit(error = mCoap->AddResource(mEnergyReportHandler));
+    SuccessOrExit(error = mCoap->AddResource(mPanIdConflictHandler));
 
     mNcp->On(Ncp::kEventPSKc, HandlePSKcChanged, this);
 
@@ -244,10 +680,20 @@ otbrError BorderAgent::Start(void)
         const uint8_t *eui64 = mNcp->GetEui64();
         VerifyOrExit(eui64 != NULL, error = OTBR_ERROR_ERRNO);
         mDtlsServer->SetSeed(eui64, kSizeEui64);
+
+        if (mTlsServer != NULL)
+        {
+            mTlsServer->SetSeed(eui64, kSizeEui64);
+        }
     }
 
     SuccessOrExit(error = mDtlsServer->Start());
 
+    if (mTlsServer != NULL)
+    {
+        SuccessOrExit(error = mTlsServer->Start());
+    }
+
 exit:
     if (error != OTBR_ERROR_NONE)
     {
@@ -260,6 +706,12 @@ exit:
 BorderAgent::~BorderAgent(void)
 {
     Dtls::Server::Destroy(mDtlsServer);
+
+    if (mTlsServer != NULL)
+    {
+        Dtls::Server::Destroy(mTlsServer);
+    }
+
     Coap::Agent::Destroy(mCoaps);
 }
 
@@ -269,13 +721,29 @@ void BorderAgent::HandleDtlsSessionState(Dtls::Session &aSession, Dtls::Session:
     {
     case Dtls::Session::kStateReady:
         aSession.SetDataHandler(FeedCoaps, this);
-        mDtlsSession = &aSession;
+        mDtlsSessions.push_back(&aSession);
         break;
 
     case Dtls::Session::kStateEnd:
     case Dtls::Session::kStateError:
     case Dtls::Session::kStateExpired:
-        mDtlsSession = NULL;
+        for (DtlsSessions::iterator it = mDtlsSessions.begin(); it != mDtlsSessions.end(); ++it)
+        {
+            if (*it == &aSession)
+            {
+                mDtlsSessions.erase(it);
+                break;
+            }
+        }
+
+        if (mActiveSession == &aSession)
+        {
+            mActiveSession = NULL;
+        }
+
+        mForwardTable.Remove(&aSession);
+        mDatasetCache.Remove(&aSession);
+        mObservers.Remove(&aSession);
         otbrLog(OTBR_LOG_WARNING, "DTLS session ended.");
         break;
 
@@ -284,39 +752,229 @@ void BorderAgent::HandleDtlsSessionState(Dtls::Session &aSession, Dtls::Session:
     }
 }
 
+void BorderAgent::HandleTlsSessionState(Dtls::Session &aSession, Dtls::Session::State aState)
+{
+    HandleDtlsSessionState(aSession, aState);
+
+    switch (aState)
+    {
+    case Dtls::Session::kStateReady:
+    {
+        uint8_t frame[2];
+
+        aSession.SetDataHandler(FeedCoapsStream, this);
+        mStreamFramers[&aSession] = Coap::StreamFramer();
+
+        // Each end starts with its capabilities, the border agent uses the defaults.
+        aSession.Write(frame, Coap::StreamFramer::Signal(Coap::StreamFramer::kCodeCsm, NULL, 0, frame));
+        break;
+    }
+
+    case Dtls::Session::kStateEnd:
+    case Dtls::Session::kStateError:
+    case Dtls::Session::kStateExpired:
+        mStreamFramers.erase(&aSession);
+        break;
+
+    default:
+        break;
+    }
+}
+
+Dtls::Session *BorderAgent::FindDtlsSession(const uint8_t *aIp6, uint16_t aPort, Dtls::Server::Transport aTransport)
+{
+    Dtls::Session *session = NULL;
+
+    // A TCP and a UDP commissioner may share an address and port.
+    for (DtlsSessions::const_iterator it = mDtlsSessions.begin(); it != mDtlsSessions.end(); ++it)
+    {
+        const sockaddr_in6     &peer = (*it)->GetPeerAddress();
+        Dtls::Server::Transport transport = mStreamFramers.count(*it) ? Dtls::Server::kTransportStream :
+                                            Dtls::Server::kTransportDatagram;
+
+        if (transport == aTransport && ntohs(peer.sin6_port) == aPort &&
+            !memcmp(peer.sin6_addr.s6_addr, aIp6, sizeof(peer.sin6_addr)))
+        {
+            session = *it;
+            break;
+        }
+    }
+
+    return session;
+}
+
 ssize_t BorderAgent::SendCoaps(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
                                void *aContext)
 {
-    // TODO verify the ip and port
-    (void)aIp6;
-    (void)aPort;
-    return static_cast<BorderAgent *>(aContext)->mDtlsSession->Write(aBuffer, aLength);
+    ssize_t        ret = -1;
+    BorderAgent   *borderAgent = static_cast<BorderAgent *>(aContext);
+    Dtls::Session *session = borderAgent->FindDtlsSession(aIp6, aPort, borderAgent->mCoapsTransport);
+
+    VerifyOrExit(session != NULL, errno = ENOTCONN);
+
+    if (borderAgent->mStreamFramers.count(session))
+    {
+        uint8_t frame[Coap::StreamFramer::kMaxSizeOfHeader + Coap::StreamFramer::kMaxUdpMessage];
+        int     length = Coap::StreamFramer::Frame(aBuffer, aLength, frame, sizeof(frame));
+
+        VerifyOrExit(length >= 0);
+        ret = aLength;
+
+        // Empty acknowledgments are not sent on reliable transports.
+        VerifyOrExit(length > 0);
+        VerifyOrExit(session->Write(frame, static_cast<uint16_t>(length)) == length, ret = -1);
+    }
+    else
+    {
+        ret = session->Write(aBuffer, aLength);
+    }
+
+exit:
+    return ret;
 }
 
-void BorderAgent::FeedCoaps(const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+void BorderAgent::FeedCoaps(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext)
 {
-    BorderAgent *borderAgent = static_cast<BorderAgent *>(aContext);
+    BorderAgent        *borderAgent = static_cast<BorderAgent *>(aContext);
+    const sockaddr_in6 &peer = aSession.GetPeerAddress();
+
+    // The peer address identifies the session for responses.
+    borderAgent->mCoapsTransport = Dtls::Server::kTransportDatagram;
+    borderAgent->mCoaps->Input(aBuffer, aLength, peer.sin6_addr.s6_addr, ntohs(peer.sin6_port));
+}
+
+void BorderAgent::FeedCoapsStream(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength,
+                                  void *aContext)
+{
+    BorderAgent                  *borderAgent = static_cast<BorderAgent *>(aContext);
+    const sockaddr_in6           &peer = aSession.GetPeerAddress();
+    StreamFramers::iterator       framer = borderAgent->mStreamFramers.find(&aSession);
+    uint8_t                       message[Coap::StreamFramer::kMaxUdpMessage];
+    int                           length;
+
+    VerifyOrExit(framer != borderAgent->mStreamFramers.end());
+
+    framer->second.Feed(aBuffer, aLength);
+
+    while ((length = framer->second.Next(message, sizeof(message))) > 0)
+    {
+        if ((message[1] >> 5) != 7)
+        {
+            borderAgent->mCoapsTransport = Dtls::Server::kTransportStream;
+            borderAgent->mCoaps->Input(message, static_cast<uint16_t>(length), peer.sin6_addr.s6_addr,
+                                       ntohs(peer.sin6_port));
+            borderAgent->mCoapsTransport = Dtls::Server::kTransportDatagram;
+            continue;
+        }
+
+        // Signaling messages are handled here, the Agent only handles CoAP over UDP.
+        switch (message[1])
+        {
+        case Coap::StreamFramer::kCodePing:
+        {
+            uint8_t frame[Coap::StreamFramer::kMaxSizeOfSignal];
+
+            aSession.Write(frame, Coap::StreamFramer::Signal(Coap::StreamFramer::kCodePong,
+                                                             message + Coap::StreamFramer::kSizeOfUdpHeader,
+                                                             message[0] & 0x0f, frame));
+            break;
+        }
+
+        case Coap::StreamFramer::kCodeRelease:
+        case Coap::StreamFramer::kCodeAbort:
+            otbrLog(OTBR_LOG_INFO, "Commissioner released the connection.");
+            aSession.Close();
+            ExitNow();
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (length < 0)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Malformed CoAP stream: %s!", strerror(errno));
+        aSession.Close();
+    }
 
-    borderAgent->mCoaps->Input(aBuffer, aLength, NULL, 0);
+exit:
+    return;
+}
+
+static void UpdateTimeout(timeval &aTimeout, unsigned long aDeadline)
+{
+    unsigned long now = GetNow();
+    unsigned long remaining = static_cast<long>(aDeadline - now) > 0 ? aDeadline - now : 0;
+
+    if (remaining < GetTimestamp(aTimeout))
+    {
+        aTimeout.tv_sec = static_cast<time_t>(remaining / 1000);
+        aTimeout.tv_usec = static_cast<suseconds_t>((remaining % 1000) * 1000);
+    }
 }
 
 void BorderAgent::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd,
                               timeval &aTimeout)
 {
+    if (mEnergyReportTime != 0)
+    {
+        UpdateTimeout(aTimeout, mEnergyReportTime);
+    }
+
+    if (!mRelayQueue.IsEmpty())
+    {
+        UpdateTimeout(aTimeout, mRelayQueue.GetNextTime(GetNow()));
+    }
+
+    mCoaps->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
     mDtlsServer->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+
+    if (mTlsServer != NULL)
+    {
+        mTlsServer->UpdateFdSet(aReadFdSet, aWriteFdSet, aErrorFdSet, aMaxFd, aTimeout);
+    }
 }
 
 void BorderAgent::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
     mDtlsServer->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+
+    if (mTlsServer != NULL)
+    {
+        mTlsServer->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    }
+
+    mCoaps->Process(aReadFdSet, aWriteFdSet, aErrorFdSet);
+
+    if (mEnergyReportTime != 0 && static_cast<long>(mEnergyReportTime - GetNow()) <= 0)
+    {
+        SendEnergyReport();
+    }
+
+    if (!mRelayQueue.IsEmpty())
+    {
+        SendRelays();
+    }
 }
 
 void BorderAgent::HandlePSKcChanged(void *aContext, int aEvent, va_list aArguments)
 {
     assert(aEvent == Ncp::kEventPSKc);
 
-    uint8_t *pskc = va_arg(aArguments, uint8_t *);
-    static_cast<BorderAgent *>(aContext)->mDtlsServer->SetPSK(pskc, kSizePSKc);
+    BorderAgent *borderAgent = static_cast<BorderAgent *>(aContext);
+    uint8_t     *pskc = va_arg(aArguments, uint8_t *);
+
+    borderAgent->mDtlsServer->SetPSK(pskc, kSizePSKc);
+
+    if (borderAgent->mTlsServer != NULL)
+    {
+        borderAgent->mTlsServer->SetPSK(pskc, kSizePSKc);
+    }
+
+    // The PSKc is part of the active dataset.
+    borderAgent->mDatasetCache.Invalidate(OT_URI_PATH_ACTIVE_GET);
+    borderAgent->NotifyObservers(OT_URI_PATH_ACTIVE_GET);
 }
 
 } // namespace BorderRouter
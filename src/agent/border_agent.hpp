@@ -36,9 +36,20 @@
 
 #include <stdint.h>
 
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "coap.hpp"
+#include "coap_stream.hpp"
+#include "dataset_cache.hpp"
 #include "dtls.hpp"
+#include "energy_summary.hpp"
+#include "forward_table.hpp"
 #include "ncp.hpp"
+#include "observer_registry.hpp"
+#include "relay_queue.hpp"
 
 namespace ot {
 
@@ -103,8 +114,85 @@ public:
      */
     void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
 
+    /**
+     * This method enables or disables coalescing of DTLS records sent to the commissioner.
+     *
+     * @param[in]   aEnabled     Whether to enable record coalescing.
+     *
+     */
+    void SetDtlsCoalescing(bool aEnabled) { mDtlsServer->SetCoalescing(aEnabled); }
+
+    /**
+     * This method sets the file to persist resumable DTLS sessions in.
+     *
+     * @param[in]   aPath        Path of the cache file, NULL to keep cached sessions in memory only.
+     *
+     */
+    void SetDtlsSessionCacheFile(const char *aPath) { mDtlsServer->SetSessionCacheFile(aPath); }
+
+    /**
+     * This method sets an already bound socket for the DTLS server, e.g. one handed over by a previous agent.
+     *
+     * @param[in]   aSocket      The bound UDP socket.
+     *
+     */
+    void SetDtlsSocket(int aSocket) { mDtlsServer->SetSocket(aSocket); }
+
+    /**
+     * This method returns the socket of the DTLS server.
+     *
+     * @returns The DTLS server socket, -1 if not started.
+     *
+     */
+    int GetDtlsSocket(void) const { return mDtlsServer->GetSocket(); }
+
+    /**
+     * This method sets the memory budget of DTLS sessions.
+     *
+     * @param[in]   aBudget      Memory budget in bytes, 0 for unlimited.
+     *
+     */
+    void SetDtlsMemoryBudget(size_t aBudget) { mDtlsServer->SetMemoryBudget(aBudget); }
+
+    /**
+     * This method sets how long the acknowledgment of a commissioner request is held for the leader's response
+     * to be piggybacked on it.
+     *
+     * @param[in]   aDelay       The delay in milliseconds, 0 to acknowledge immediately.
+     *
+     */
+    void SetCoapsAckDelay(uint32_t aDelay) { mCoaps->SetAckDelay(aDelay); }
+
+    /**
+     * This method enables the TLS over TCP listener for commissioners on reliable links. It takes effect when the
+     * border agent starts.
+     *
+     * @param[in]   aPort        The TCP port to listen on, 0 to disable the listener.
+     *
+     */
+    void SetCoapsTcpPort(uint16_t aPort) { mTlsPort = aPort; }
+
+    /**
+     * This method sets the rates of relayed joiner messages sent into the Thread network.
+     *
+     * @param[in]   aRouterRate  Bytes per second sent to one joiner router, 0 for unlimited.
+     * @param[in]   aTotalRate   Bytes per second sent to all joiner routers, 0 for unlimited.
+     *
+     */
+    void SetRelayRates(uint32_t aRouterRate, uint32_t aTotalRate) { mRelayQueue.SetRates(aRouterRate, aTotalRate); }
+
 private:
-    static void FeedCoaps(const uint8_t *aBuffer, uint16_t aLength, void *aContext);
+    enum
+    {
+        kEnergyReportDelay = 100, ///< Delay in milliseconds to gather energy reports into one summary.
+        kMaxBlockSize      = 512, ///< Max payload in bytes of a request forwarded into the Thread network.
+        kStateReject       = -1,  ///< State TLV value of a rejected petition or keep-alive.
+        kStateAccept       = 1,   ///< State TLV value of an accepted petition or keep-alive.
+    };
+
+    static void FeedCoaps(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext);
+    static void FeedCoapsStream(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength,
+                                void *aContext);
     static ssize_t SendCoaps(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
                              void *aContext);
 
@@ -114,6 +202,16 @@ private:
     }
     void HandleDtlsSessionState(Dtls::Session &aSession, Dtls::Session::State aState);
 
+    static void HandleTlsSessionState(Dtls::Session &aSession, Dtls::Session::State aState, void *aContext)
+    {
+        static_cast<BorderAgent *>(aContext)->HandleTlsSessionState(aSession, aState);
+    }
+    void HandleTlsSessionState(Dtls::Session &aSession, Dtls::Session::State aState);
+
+    Dtls::Session *FindDtlsSession(const uint8_t *aIp6, uint16_t aPort, Dtls::Server::Transport aTransport);
+    void           SendCoapsMessage(Dtls::Session &aSession, Coap::Message &aMessage);
+    void           UpdateActiveSession(Dtls::Session &aSession, const uint8_t *aPayload, uint16_t aLength);
+
     static void HandleRelayReceive(const Coap::Resource &aResource, const Coap::Message &aMessage,
                                    Coap::Message &aResponse,
                                    const uint8_t *aIp6, uint16_t aPort, void *aContext)
@@ -133,17 +231,25 @@ private:
         static_cast<BorderAgent *>(aContext)->HandleRelayTransmit(aMessage, aIp6, aPort);
     }
     void HandleRelayTransmit(const Coap::Message &aMessage, const uint8_t *aIp6, uint16_t aPort);
+    void SendRelays(void);
 
     static void ForwardCommissionerRequest(const Coap::Resource &aResource, const Coap::Message &aMessage,
                                            Coap::Message &aResponse,
                                            const uint8_t *aIp6, uint16_t aPort, void *aContext)
     {
-        (void)aIp6;
-        (void)aResponse;
-        static_cast<BorderAgent *>(aContext)->ForwardCommissionerRequest(aResource, aMessage, aIp6, aPort);
+        static_cast<BorderAgent *>(aContext)->ForwardCommissionerRequest(aResource, aMessage, aResponse, aIp6, aPort);
     }
     void ForwardCommissionerRequest(const Coap::Resource &aResource, const Coap::Message &aMessage,
-                                    const uint8_t *aIp6, uint16_t aPort);
+                                    Coap::Message &aResponse, const uint8_t *aIp6, uint16_t aPort);
+    void ForwardCommissionerBlock(Dtls::Session &aSession, const char *aPath, const Coap::Message &aMessage,
+                                  Coap::Message &aResponse);
+    void PrepareCommissionerRequest(const char *aPath);
+    void ForwardToLeader(const char *aPath, const uint8_t *aForwardToken, const Coap::Message *aBlocks,
+                         const uint8_t *aPayload, uint16_t aLength);
+    void HandleCommissionerRequest(Dtls::Session &aSession, const char *aPath, const uint8_t *aToken,
+                                   uint8_t aTokenLength, const uint8_t *aPayload, uint16_t aLength,
+                                   Coap::Message *aResponse);
+    void NotifyObservers(const char *aPath);
 
     static void ForwardCommissionerResponse(const Coap::Message &aMessage, void *aContext)
     {
@@ -151,6 +257,46 @@ private:
     }
     void ForwardCommissionerResponse(const Coap::Message &aMessage);
 
+    void SendCommissionerResponse(Dtls::Session &aSession, const uint8_t *aToken, uint8_t aTokenLength,
+                                  Coap::Code aCode, const uint8_t *aPayload, uint16_t aLength,
+                                  const Coap::Message *aBlocks);
+
+    static void HandleDatasetChanged(const Coap::Resource &aResource, const Coap::Message &aMessage,
+                                     Coap::Message &aResponse,
+                                     const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        (void)aResource;
+        static_cast<BorderAgent *>(aContext)->HandleDatasetChanged(aMessage, aResponse, aIp6, aPort);
+    }
+    void HandleDatasetChanged(const Coap::Message &aMessage, Coap::Message &aResponse, const uint8_t *aIp6,
+                              uint16_t aPort);
+
+    static void HandleEnergyReport(const Coap::Resource &aResource, const Coap::Message &aMessage,
+                                   Coap::Message &aResponse,
+                                   const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        (void)aResource;
+        (void)aIp6;
+        (void)aPort;
+        static_cast<BorderAgent *>(aContext)->HandleEnergyReport(aMessage, aResponse);
+    }
+    void HandleEnergyReport(const Coap::Message &aMessage, Coap::Message &aResponse);
+    void SendEnergyReport(void);
+
+    static void HandlePanIdConflict(const Coap::Resource &aResource, const Coap::Message &aMessage,
+                                    Coap::Message &aResponse,
+                                    const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        (void)aResource;
+        (void)aIp6;
+        (void)aPort;
+        static_cast<BorderAgent *>(aContext)->HandlePanIdConflict(aMessage, aResponse);
+    }
+    void HandlePanIdConflict(const Coap::Message &aMessage, Coap::Message &aResponse);
+
+    void SendToCommissioner(const char *aPath, const uint8_t *aToken, uint8_t aTokenLength,
+                            const uint8_t *aPayload, uint16_t aLength);
+
     static void HandlePSKcChanged(void *aContext, int aEvent, va_list aArguments);
 
     Coap::Resource mActiveGet;
@@ -161,15 +307,38 @@ private:
     // Border agent resources for external commissioner.
     Coap::Resource mCommissionerPetitionHandler;
     Coap::Resource mCommissionerKeepAliveHandler;
+    Coap::Resource mCommissionerGetHandler;
     Coap::Resource mCommissionerSetHandler;
     Coap::Resource mCommissionerRelayTransmitHandler;
+    Coap::Resource mEnergyScanHandler;
+    Coap::Resource mPanIdQueryHandler;
 
     // Border agent resources for Thread network.
     Coap::Resource   mCommissionerRelayReceiveHandler;
+    Coap::Resource   mDatasetChangedHandler;
+    Coap::Resource   mEnergyReportHandler;
+    Coap::Resource   mPanIdConflictHandler;
+
+    typedef std::vector<Dtls::Session *>                         DtlsSessions;
+    typedef std::set<std::string>                                PanIdConflicts;
+    typedef std::map<const Dtls::Session *, Coap::StreamFramer> StreamFramers;
 
     Coap::Agent     *mCoap;
     Dtls::Server    *mDtlsServer;
-    Dtls::Session   *mDtlsSession;
+    Dtls::Server    *mTlsServer;
+    uint16_t         mTlsPort;
+    StreamFramers    mStreamFramers;
+    // Transport of the CoAP message being received or sent, since commissioners are told apart by address.
+    Dtls::Server::Transport mCoapsTransport;
+    Dtls::Session   *mActiveSession; // The petitioned commissioner, receiving relayed joiner messages.
+    DtlsSessions     mDtlsSessions;
+    ForwardTable     mForwardTable;
+    DatasetCache     mDatasetCache;
+    ObserverRegistry mObservers;
+    EnergySummary    mEnergySummary;
+    unsigned long    mEnergyReportTime;
+    PanIdConflicts   mPanIdConflicts;
+    RelayQueue       mRelayQueue;
     Coap::Agent     *mCoaps;
     Ncp::Controller *mNcp;
 };
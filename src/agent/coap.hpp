@@ -36,6 +36,7 @@
 
 #include <stdint.h>
 #include <unistd.h>
+#include <sys/select.h>
 
 #include "common/types.hpp"
 
@@ -72,17 +73,41 @@ enum Type
  */
 enum Code
 {
-    kCodeEmpty   = 0x00, ///< Empty message code
-    kCodeGet     = 0x01, ///< Get
-    kCodePost    = 0x02, ///< Post
-    kCodePut     = 0x03, ///< Put
-    kCodeDelete  = 0x04, ///< Delete
-    kCodeCodeMin = 0x40, ///< 2.00
-    kCodeCreated = 0x41, ///< Created
-    kCodeDeleted = 0x42, ///< Deleted
-    kCodeValid   = 0x43, ///< Valid
-    kCodeChanged = 0x44, ///< Changed
-    kCodeContent = 0x45, ///< Content
+    kCodeEmpty              = 0x00, ///< Empty message code
+    kCodeGet                = 0x01, ///< Get
+    kCodePost               = 0x02, ///< Post
+    kCodePut                = 0x03, ///< Put
+    kCodeDelete             = 0x04, ///< Delete
+    kCodeCodeMin            = 0x40, ///< 2.00
+    kCodeCreated            = 0x41, ///< Created
+    kCodeDeleted            = 0x42, ///< Deleted
+    kCodeValid              = 0x43, ///< Valid
+    kCodeChanged            = 0x44, ///< Changed
+    kCodeContent            = 0x45, ///< Content
+    kCodeContinue           = 0x5f, ///< Continue
+    kCodeRequestIncomplete  = 0x88, ///< Request Entity Incomplete
+    kCodeRequestTooLarge    = 0x8d, ///< Request Entity Too Large
+    kCodeServiceUnavailable = 0xa3, ///< Service Unavailable
+};
+
+/**
+ * CoAP Block options (RFC 7959).
+ *
+ */
+enum BlockOption
+{
+    kBlock2 = 23, ///< Block2, for block-wise responses.
+    kBlock1 = 27, ///< Block1, for block-wise requests.
+};
+
+/**
+ * CoAP block sizes.
+ *
+ */
+enum
+{
+    kBlockSizeMin = 16,   ///< Minimum block size.
+    kBlockSizeMax = 1024, ///< Maximum block size.
 };
 
 /**
@@ -153,6 +178,52 @@ public:
      */
     virtual void SetPath(const char *aPath) = 0;
 
+    /**
+     * This method returns the CoAP Observe option of this message.
+     *
+     * @param[out]  aObserve    A reference to receive the value of the Observe option.
+     *
+     * @retval  true    The message has the Observe option.
+     * @retval  false   The message has no Observe option.
+     *
+     */
+    virtual bool GetObserve(uint32_t &aObserve) const = 0;
+
+    /**
+     * This method sets the CoAP Observe option of this message. It must be called before setting the Uri Path
+     * and the payload.
+     *
+     * @param[in]   aObserve    The value of the Observe option.
+     *
+     */
+    virtual void SetObserve(uint32_t aObserve) = 0;
+
+    /**
+     * This method returns a CoAP Block option of this message.
+     *
+     * @param[in]   aOption     The Block option.
+     * @param[out]  aNumber     A reference to receive the block number.
+     * @param[out]  aMore       A reference to receive whether more blocks follow.
+     * @param[out]  aSize       A reference to receive the block size.
+     *
+     * @retval  true    The message has the Block option.
+     * @retval  false   The message has no such Block option.
+     *
+     */
+    virtual bool GetBlock(BlockOption aOption, uint32_t &aNumber, bool &aMore, uint16_t &aSize) const = 0;
+
+    /**
+     * This method sets a CoAP Block option of this message. It must be called after setting the Uri Path and
+     * before setting the payload, and Block2 must be set before Block1.
+     *
+     * @param[in]   aOption     The Block option.
+     * @param[in]   aNumber     The block number.
+     * @param[in]   aMore       Whether more blocks follow.
+     * @param[in]   aSize       The block size, a power of two between kBlockSizeMin and kBlockSizeMax.
+     *
+     */
+    virtual void SetBlock(BlockOption aOption, uint32_t aNumber, bool aMore, uint16_t aSize) = 0;
+
     /**
      * This method returns the payload of this message.
      *
@@ -170,6 +241,29 @@ public:
      *
      */
     virtual void SetPayload(const uint8_t *aPayload, uint16_t aLength) = 0;
+
+    /**
+     * This method returns the space left for the payload, so that the payload is written in place.
+     *
+     * No option may be added afterwards, and SetPayloadLength() must be called with the length written.
+     *
+     * @param[out]  aSize       A reference to receive the size of the space.
+     *
+     * @returns A pointer to the space.
+     *
+     */
+    virtual uint8_t *GetPayloadBuffer(uint16_t &aSize) = 0;
+
+    /**
+     * This method sets the length of the payload written in place.
+     *
+     * @param[in]   aLength     Number of bytes written to the space returned by GetPayloadBuffer().
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the payload length.
+     * @retval  OTBR_ERROR_ERRNO    The payload was already set or @p aLength exceeds the space, errno is set.
+     *
+     */
+    virtual otbrError SetPayloadLength(uint16_t aLength) = 0;
 };
 
 /**
@@ -235,6 +329,11 @@ struct Resource
 class Agent
 {
 public:
+    enum
+    {
+        kMaxAckDelay = 1000, ///< Max delay of acknowledgments in milliseconds, well below the ACK_TIMEOUT of 2 s.
+    };
+
     /**
      * This function poiner is called when the agent needs to send data out.
      *
@@ -322,6 +421,42 @@ public:
     virtual otbrError Send(Message &aMessage, const uint8_t *aIp6, uint16_t aPort, ResponseHandler aHandler,
                            void *aContext) = 0;
 
+    /**
+     * This method sets how long the acknowledgment of a confirmable request is held when its handler does not
+     * respond immediately.
+     *
+     * A response to the request sent within this delay is piggybacked on the acknowledgment. Otherwise an empty
+     * acknowledgment is sent when the delay expires and the response is sent separately.
+     *
+     * @param[in]   aDelay      The delay in milliseconds, 0 to acknowledge immediately, at most kMaxAckDelay.
+     *
+     */
+    virtual void SetAckDelay(uint32_t aDelay) = 0;
+
+    /**
+     * This method updates the fd_set and timeout for mainloop. @p aTimeout should
+     * only be updated if the CoAP agent has pending process in less than its current value.
+     *
+     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
+     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
+     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
+     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
+     * @param[inout]    aTimeout        A reference to the timeout.
+     *
+     */
+    virtual void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd,
+                             timeval &aTimeout) = 0;
+
+    /**
+     * This method performs the CoAP processing, e.g. sending held acknowledgments.
+     *
+     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
+     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
+     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     *
+     */
+    virtual void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet) = 0;
+
     /**
      * This method creates a CoAP agent.
      *
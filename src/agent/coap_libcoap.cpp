@@ -38,6 +38,7 @@
 
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
+#include "common/time.hpp"
 #include "common/types.hpp"
 
 namespace ot {
@@ -132,11 +133,93 @@ void MessageLibcoap::SetPath(const char *aPath)
     }
 }
 
+bool MessageLibcoap::GetObserve(uint32_t &aObserve) const
+{
+    coap_opt_iterator_t iterator;
+    coap_opt_t         *option = coap_check_option(mPdu, COAP_OPTION_OBSERVE, &iterator);
+
+    if (option != NULL)
+    {
+        aObserve = coap_decode_var_bytes(COAP_OPT_VALUE(option), COAP_OPT_LENGTH(option));
+    }
+
+    return option != NULL;
+}
+
+void MessageLibcoap::SetObserve(uint32_t aObserve)
+{
+    uint8_t value[sizeof(aObserve)];
+
+    coap_add_option(mPdu, COAP_OPTION_OBSERVE, coap_encode_var_bytes(value, aObserve), value);
+}
+
+bool MessageLibcoap::GetBlock(BlockOption aOption, uint32_t &aNumber, bool &aMore, uint16_t &aSize) const
+{
+    coap_opt_iterator_t iterator;
+    coap_opt_t         *option = coap_check_option(mPdu, aOption, &iterator);
+
+    if (option != NULL)
+    {
+        unsigned int value = coap_decode_var_bytes(COAP_OPT_VALUE(option), COAP_OPT_LENGTH(option));
+
+        // NUM(4-20 bits) | M(1 bit) | SZX(3 bits), and the block size is 2^(SZX + 4).
+        aNumber = value >> 4;
+        aMore = (value & 0x08) != 0;
+        aSize = static_cast<uint16_t>(kBlockSizeMin << (value & 0x07));
+    }
+
+    return option != NULL;
+}
+
+void MessageLibcoap::SetBlock(BlockOption aOption, uint32_t aNumber, bool aMore, uint16_t aSize)
+{
+    uint8_t      value[sizeof(uint32_t)];
+    unsigned int szx = 0;
+
+    while ((kBlockSizeMin << szx) < aSize && (kBlockSizeMin << szx) < kBlockSizeMax)
+    {
+        ++szx;
+    }
+
+    coap_add_option(mPdu, aOption, coap_encode_var_bytes(value, (aNumber << 4) | (aMore ? 0x08 : 0) | szx), value);
+}
+
 void MessageLibcoap::SetPayload(const uint8_t *aPayload, uint16_t aLength)
 {
     coap_add_data(mPdu, aLength, aPayload);
 }
 
+uint8_t *MessageLibcoap::GetPayloadBuffer(uint16_t &aSize)
+{
+    // One byte is left for the payload marker.
+    size_t length = mPdu->length + 1u;
+
+    aSize = static_cast<uint16_t>(length < mPdu->max_size ? mPdu->max_size - length : 0);
+    return reinterpret_cast<uint8_t *>(mPdu->hdr) + length;
+}
+
+otbrError MessageLibcoap::SetPayloadLength(uint16_t aLength)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    uint16_t  size;
+
+    GetPayloadBuffer(size);
+    VerifyOrExit(mPdu->data == NULL, errno = EALREADY);
+    VerifyOrExit(aLength <= size, errno = EMSGSIZE);
+
+    if (aLength > 0)
+    {
+        mPdu->data = reinterpret_cast<uint8_t *>(mPdu->hdr) + mPdu->length;
+        *mPdu->data++ = COAP_PAYLOAD_START;
+        mPdu->length = static_cast<unsigned short>(mPdu->length + 1 + aLength);
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
 const uint8_t *MessageLibcoap::GetPayload(uint16_t &aLength) const
 {
     uint8_t *payload = NULL;
@@ -172,6 +255,23 @@ otbrError AgentLibcoap::Send(Message &aMessage, const uint8_t *aIp6, uint16_t aP
 
     CoapAddressInit(remote, aIp6, aPort);
 
+    // Piggyback the response on the held acknowledgment of its request.
+    if (pdu->hdr->code >= kCodeCodeMin)
+    {
+        for (PendingAcks::iterator it = mPendingAcks.begin(); it != mPendingAcks.end(); ++it)
+        {
+            if (it->mTokenLength == pdu->hdr->token_length &&
+                !memcmp(it->mToken, pdu->hdr->token, it->mTokenLength) &&
+                coap_address_equals(&it->mRemote, &remote))
+            {
+                pdu->hdr->type = COAP_MESSAGE_ACK;
+                pdu->hdr->id = it->mMessageId;
+                mPendingAcks.erase(it);
+                break;
+            }
+        }
+    }
+
     if (pdu->hdr->type == COAP_MESSAGE_CON)
     {
         MessageMeta meta = {
@@ -245,6 +345,22 @@ void AgentLibcoap::HandleRequest(struct coap_resource_t *aResource,
         // Handler should later respond an Non-ACK response.
         res.SetCode(kCodeEmpty);
         resource.mHandler(resource, req, res, aAddress, aPort, resource.mContext);
+
+        if (mAckDelay > 0 && res.GetCode() == kCodeEmpty && req.GetType() == kTypeConfirmable &&
+            aRequest->hdr->token_length <= kMaxTokenLength)
+        {
+            PendingAck pendingAck;
+
+            CoapAddressInit(pendingAck.mRemote, aAddress, aPort);
+            pendingAck.mExpiration = GetNow() + mAckDelay;
+            pendingAck.mMessageId = aRequest->hdr->id;
+            pendingAck.mTokenLength = aRequest->hdr->token_length;
+            memcpy(pendingAck.mToken, aRequest->hdr->token, pendingAck.mTokenLength);
+            mPendingAcks.push_back(pendingAck);
+
+            // libcoap drops an empty non-confirmable response, the acknowledgment is sent later.
+            res.SetType(kTypeNonConfirmable);
+        }
     }
 
 exit:
@@ -290,6 +406,67 @@ exit:
     return;
 }
 
+void AgentLibcoap::SendEmptyAck(const PendingAck &aPendingAck)
+{
+    coap_pdu_t *pdu = coap_pdu_init(COAP_MESSAGE_ACK, kCodeEmpty, aPendingAck.mMessageId, sizeof(coap_hdr_t));
+
+    VerifyOrExit(pdu != NULL, otbrLog(OTBR_LOG_ERR, "CoAP no memory for acknowledgment!"));
+
+    coap_send(&mCoap, mCoap.endpoint, &aPendingAck.mRemote, pdu);
+    coap_delete_pdu(pdu);
+
+exit:
+    return;
+}
+
+void AgentLibcoap::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd,
+                               timeval &aTimeout)
+{
+    unsigned long now = GetNow();
+    unsigned long timeout = GetTimestamp(aTimeout);
+
+    for (PendingAcks::const_iterator it = mPendingAcks.begin(); it != mPendingAcks.end(); ++it)
+    {
+        unsigned long remaining = static_cast<long>(it->mExpiration - now) > 0 ? it->mExpiration - now : 0;
+
+        if (remaining < timeout)
+        {
+            timeout = remaining;
+        }
+    }
+
+    aTimeout.tv_sec = static_cast<time_t>(timeout / 1000);
+    aTimeout.tv_usec = static_cast<suseconds_t>((timeout % 1000) * 1000);
+
+    (void)aReadFdSet;
+    (void)aWriteFdSet;
+    (void)aErrorFdSet;
+    (void)aMaxFd;
+}
+
+void AgentLibcoap::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
+{
+    unsigned long now = GetNow();
+
+    for (PendingAcks::iterator it = mPendingAcks.begin(); it != mPendingAcks.end();)
+    {
+        if (static_cast<long>(it->mExpiration - now) <= 0)
+        {
+            otbrLog(OTBR_LOG_INFO, "CoAP response not ready, acknowledging request %u.", it->mMessageId);
+            SendEmptyAck(*it);
+            it = mPendingAcks.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    (void)aReadFdSet;
+    (void)aWriteFdSet;
+    (void)aErrorFdSet;
+}
+
 otbrError AgentLibcoap::AddResource(const Resource &aResource)
 {
     otbrError        ret = OTBR_ERROR_ERRNO;
@@ -343,6 +520,7 @@ AgentLibcoap::AgentLibcoap(NetworkSender aNetworkSender, void *aContext)
 {
     mContext = aContext;
     mNetworkSender = aNetworkSender;
+    mAckDelay = 0;
     coap_clock_init();
 
     time_t clock_offset = time(NULL);
@@ -30,6 +30,7 @@
 #define COAP_LIBCOAP_HPP_
 
 #include <map>
+#include <vector>
 
 #include "libcoap.h"
 #include "coap.hpp"
@@ -138,6 +139,50 @@ public:
      */
     void SetPath(const char *aPath);
 
+    /**
+     * This method returns the CoAP Observe option of this message.
+     *
+     * @param[out]  aObserve        A reference to receive the value of the Observe option.
+     *
+     * @retval  true    The message has the Observe option.
+     * @retval  false   The message has no Observe option.
+     *
+     */
+    bool GetObserve(uint32_t &aObserve) const;
+
+    /**
+     * This method sets the CoAP Observe option of this message.
+     *
+     * @param[in]   aObserve        The value of the Observe option.
+     *
+     */
+    void SetObserve(uint32_t aObserve);
+
+    /**
+     * This method returns a CoAP Block option of this message.
+     *
+     * @param[in]   aOption         The Block option.
+     * @param[out]  aNumber         A reference to receive the block number.
+     * @param[out]  aMore           A reference to receive whether more blocks follow.
+     * @param[out]  aSize           A reference to receive the block size.
+     *
+     * @retval  true    The message has the Block option.
+     * @retval  false   The message has no such Block option.
+     *
+     */
+    bool GetBlock(BlockOption aOption, uint32_t &aNumber, bool &aMore, uint16_t &aSize) const;
+
+    /**
+     * This method sets a CoAP Block option of this message.
+     *
+     * @param[in]   aOption         The Block option.
+     * @param[in]   aNumber         The block number.
+     * @param[in]   aMore           Whether more blocks follow.
+     * @param[in]   aSize           The block size.
+     *
+     */
+    void SetBlock(BlockOption aOption, uint32_t aNumber, bool aMore, uint16_t aSize);
+
     /**
      * This method returns the payload of this message.
      *
@@ -157,6 +202,25 @@ public:
      */
     void SetPayload(const uint8_t *aPayload, uint16_t aLength);
 
+    /**
+     * This method returns the space left for the payload.
+     *
+     * @param[out]  aSize           A reference to receive the size of the space.
+     *
+     * @returns A pointer to the space.
+     */
+    uint8_t *GetPayloadBuffer(uint16_t &aSize);
+
+    /**
+     * This method sets the length of the payload written in place.
+     *
+     * @param[in]   aLength         Number of bytes written.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the payload length.
+     * @retval  OTBR_ERROR_ERRNO    The payload was already set or @p aLength exceeds the space.
+     */
+    otbrError SetPayloadLength(uint16_t aLength);
+
     /**
      * This method returns the underlying libcoap PDU.
      *
@@ -266,9 +330,60 @@ public:
      */
     otbrError RemoveResource(const Resource &aResource);
 
+    /**
+     * This method sets how long the acknowledgment of a confirmable request is held when its handler does not
+     * respond immediately.
+     *
+     * @param[in]   aDelay      The delay in milliseconds, 0 to acknowledge immediately.
+     *
+     */
+    void SetAckDelay(uint32_t aDelay) { mAckDelay = aDelay; }
+
+    /**
+     * This method updates the fd_set and timeout for mainloop.
+     *
+     * @param[inout]    aReadFdSet      A reference to fd_set for polling read.
+     * @param[inout]    aWriteFdSet     A reference to fd_set for polling write.
+     * @param[inout]    aErrorFdSet     A reference to fd_set for polling error.
+     * @param[inout]    aMaxFd          A reference to the current max fd in @p aReadFdSet and @p aWriteFdSet.
+     * @param[inout]    aTimeout        A reference to the timeout.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set &aErrorFdSet, int &aMaxFd, timeval &aTimeout);
+
+    /**
+     * This method sends held acknowledgments whose delay expired.
+     *
+     * @param[in]   aReadFdSet          A reference to fd_set ready for reading.
+     * @param[in]   aWriteFdSet         A reference to fd_set ready for writing.
+     * @param[in]   aErrorFdSet         A reference to fd_set with error occurred.
+     *
+     */
+    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+
 private:
     typedef std::map<struct coap_resource_t *, const Resource *> Resources;
 
+    enum
+    {
+        kMaxTokenLength = 8, ///< Maximum bytes of a CoAP token.
+    };
+
+    /**
+     * This structure records a confirmable request whose acknowledgment is held.
+     *
+     */
+    struct PendingAck
+    {
+        coap_address_t mRemote;                 ///< Source of the request.
+        unsigned long  mExpiration;             ///< When to send an empty acknowledgment.
+        uint16_t       mMessageId;              ///< Message ID of the request.
+        uint8_t        mTokenLength;            ///< Token length of the request.
+        uint8_t        mToken[kMaxTokenLength]; ///< Token of the request.
+    };
+
+    typedef std::vector<PendingAck> PendingAcks;
+
     struct MessageMeta
     {
         ResponseHandler mHandler;
@@ -301,11 +416,15 @@ private:
                                const coap_address_t *aDestination,
                                unsigned char *aBuffer, size_t aLength);
 
+    void SendEmptyAck(const PendingAck &aPendingAck);
+
     Resources      mResources;
     NetworkSender  mNetworkSender;
     void          *mContext;
     coap_context_t mCoap;
     coap_packet_t  mPacket;
+    uint32_t       mAckDelay;
+    PendingAcks    mPendingAcks;
 };
 
 /**
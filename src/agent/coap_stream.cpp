@@ -0,0 +1,196 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the framing of CoAP over reliable transports.
+ */
+
+#include "coap_stream.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "coap.hpp"
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+/**
+ * Values of the Len field of a frame, telling the size of the extended length.
+ *
+ */
+enum
+{
+    kLength8Bit  = 13, ///< The length minus 13 follows in 1 byte.
+    kLength16Bit = 14, ///< The length minus 269 follows in 2 bytes.
+    kLength32Bit = 15, ///< The length minus 65805 follows in 4 bytes.
+};
+
+/**
+ * Other constants
+ *
+ */
+enum
+{
+    kCoapVersion  = 1, ///< CoAP version of messages over UDP.
+    kMaxTokenSize = 8, ///< Max length of a token.
+};
+
+StreamFramer::StreamFramer(void) :
+    mMessageId(0) {}
+
+void StreamFramer::Feed(const uint8_t *aBuffer, uint16_t aLength)
+{
+    mBuffer.insert(mBuffer.end(), aBuffer, aBuffer + aLength);
+}
+
+int StreamFramer::Next(uint8_t *aMessage, uint16_t aSize)
+{
+    int      ret = 0;
+    size_t   size = mBuffer.size();
+    uint8_t  length;
+    uint8_t  tokenLength;
+    size_t   offset = 1;
+    uint32_t bodyLength = 0;
+    uint8_t  code;
+    uint8_t  type;
+
+    VerifyOrExit(size > 0);
+
+    length = mBuffer[0] >> 4;
+    tokenLength = mBuffer[0] & 0x0f;
+
+    VerifyOrExit(tokenLength <= kMaxTokenSize, ret = -1, errno = EBADMSG);
+
+    switch (length)
+    {
+    case kLength8Bit:
+        VerifyOrExit(size >= offset + 1);
+        bodyLength = 13 + mBuffer[offset];
+        offset += 1;
+        break;
+
+    case kLength16Bit:
+        VerifyOrExit(size >= offset + 2);
+        bodyLength = 269 + ((mBuffer[offset] << 8) | mBuffer[offset + 1]);
+        offset += 2;
+        break;
+
+    case kLength32Bit:
+        // Such a message is never accepted, no matter its exact length.
+        ExitNow(ret = -1, errno = EMSGSIZE);
+        break;
+
+    default:
+        bodyLength = length;
+        break;
+    }
+
+    VerifyOrExit(bodyLength <= kMaxMessageSize, ret = -1, errno = EMSGSIZE);
+    VerifyOrExit(size >= offset + 1 + tokenLength + bodyLength);
+    VerifyOrExit(kSizeOfUdpHeader + tokenLength + bodyLength <= aSize, ret = -1, errno = EMSGSIZE);
+
+    code = mBuffer[offset];
+    type = ((code >> 5) == 0 && code != kCodeEmpty) ? kTypeConfirmable : kTypeNonConfirmable;
+
+    aMessage[0] = static_cast<uint8_t>((kCoapVersion << 6) | (type << 4) | tokenLength);
+    aMessage[1] = code;
+    aMessage[2] = static_cast<uint8_t>(mMessageId >> 8);
+    aMessage[3] = static_cast<uint8_t>(mMessageId & 0xff);
+    ++mMessageId;
+    memcpy(aMessage + kSizeOfUdpHeader, &mBuffer[offset + 1], tokenLength + bodyLength);
+
+    ret = static_cast<int>(kSizeOfUdpHeader + tokenLength + bodyLength);
+    mBuffer.erase(mBuffer.begin(), mBuffer.begin() + static_cast<long>(offset + 1 + tokenLength + bodyLength));
+
+exit:
+    return ret;
+}
+
+int StreamFramer::Frame(const uint8_t *aMessage, uint16_t aLength, uint8_t *aFrame, uint16_t aSize)
+{
+    int      ret = -1;
+    uint8_t  tokenLength;
+    uint16_t bodyLength;
+    uint16_t offset = 1;
+
+    VerifyOrExit(aLength >= kSizeOfUdpHeader, errno = EBADMSG);
+
+    tokenLength = aMessage[0] & 0x0f;
+    VerifyOrExit(tokenLength <= kMaxTokenSize && kSizeOfUdpHeader + tokenLength <= aLength, errno = EBADMSG);
+
+    // Reliability is provided by the transport.
+    VerifyOrExit(aMessage[1] != kCodeEmpty, ret = 0);
+
+    bodyLength = static_cast<uint16_t>(aLength - kSizeOfUdpHeader - tokenLength);
+    VerifyOrExit(kMaxSizeOfHeader + tokenLength + bodyLength <= aSize, errno = EMSGSIZE);
+
+    if (bodyLength < 13)
+    {
+        aFrame[0] = static_cast<uint8_t>(bodyLength << 4);
+    }
+    else if (bodyLength < 269)
+    {
+        aFrame[0] = kLength8Bit << 4;
+        aFrame[offset++] = static_cast<uint8_t>(bodyLength - 13);
+    }
+    else
+    {
+        aFrame[0] = kLength16Bit << 4;
+        aFrame[offset++] = static_cast<uint8_t>((bodyLength - 269) >> 8);
+        aFrame[offset++] = static_cast<uint8_t>((bodyLength - 269) & 0xff);
+    }
+
+    aFrame[0] |= tokenLength;
+    aFrame[offset++] = aMessage[1];
+    memcpy(aFrame + offset, aMessage + kSizeOfUdpHeader, tokenLength + bodyLength);
+    ret = offset + tokenLength + bodyLength;
+
+exit:
+    return ret;
+}
+
+uint16_t StreamFramer::Signal(uint8_t aCode, const uint8_t *aToken, uint8_t aTokenLength, uint8_t *aFrame)
+{
+    aFrame[0] = aTokenLength;
+    aFrame[1] = aCode;
+    memcpy(aFrame + 2, aToken, aTokenLength);
+
+    return static_cast<uint16_t>(2 + aTokenLength);
+}
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
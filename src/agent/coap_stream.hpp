@@ -0,0 +1,141 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the framing of CoAP over reliable transports.
+ */
+
+#ifndef COAP_STREAM_HPP_
+#define COAP_STREAM_HPP_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Coap {
+
+/**
+ * This class implements the message framing of CoAP over TCP and TLS (RFC 8323).
+ *
+ * Messages received from a stream are converted to the CoAP over UDP format handled by Agent, and messages
+ * sent by Agent are converted back for the stream.
+ *
+ */
+class StreamFramer
+{
+public:
+    enum
+    {
+        kCodeCsm         = 0xe1, ///< 7.01 Capabilities and Settings Message.
+        kCodePing        = 0xe2, ///< 7.02 Ping.
+        kCodePong        = 0xe3, ///< 7.03 Pong.
+        kCodeRelease     = 0xe4, ///< 7.04 Release.
+        kCodeAbort       = 0xe5, ///< 7.05 Abort.
+        kMaxMessageSize  = 1152, ///< Max size of options and payload of a message, the default of RFC 8323.
+        kMaxSizeOfHeader = 4,    ///< Max size of the header of a frame without token, for messages below 64KB.
+        kSizeOfUdpHeader = 4,    ///< Size of the fixed header of a CoAP over UDP message.
+        kMaxUdpMessage   = 1164, ///< Max size of a received message in CoAP over UDP format.
+        kMaxSizeOfSignal = 10,   ///< Max size of a signaling frame built by Signal().
+    };
+
+    /**
+     * The constructor to initialize a stream framer.
+     *
+     */
+    StreamFramer(void);
+
+    /**
+     * This method appends data received from the stream.
+     *
+     * @param[in]   aBuffer     A pointer to the data.
+     * @param[in]   aLength     The length of the data.
+     *
+     */
+    void Feed(const uint8_t *aBuffer, uint16_t aLength);
+
+    /**
+     * This method takes the next complete message received, in CoAP over UDP format.
+     *
+     * Requests are converted to confirmable messages, so that responses are piggybacked, and other messages to
+     * non-confirmable ones. Each message is given a new message id.
+     *
+     * @param[out]  aMessage    A pointer to a buffer to receive the message.
+     * @param[in]   aSize       The size of @p aMessage.
+     *
+     * @returns The length of the message, 0 if no complete message is received yet, -1 if the stream is
+     *          malformed or the message is too large.
+     *
+     */
+    int Next(uint8_t *aMessage, uint16_t aSize);
+
+    /**
+     * This method converts a CoAP over UDP message to a frame of the stream.
+     *
+     * @param[in]   aMessage    A pointer to the message.
+     * @param[in]   aLength     The length of the message.
+     * @param[out]  aFrame      A pointer to a buffer to receive the frame.
+     * @param[in]   aSize       The size of @p aFrame.
+     *
+     * @returns The length of the frame, 0 if the message has no equivalent on a reliable transport, i.e. empty
+     *          acknowledgments and resets, -1 if the message is malformed or @p aFrame is too small.
+     *
+     */
+    static int Frame(const uint8_t *aMessage, uint16_t aLength, uint8_t *aFrame, uint16_t aSize);
+
+    /**
+     * This method creates a signaling message without options.
+     *
+     * @param[in]   aCode           The signaling code.
+     * @param[in]   aToken          A pointer to the token.
+     * @param[in]   aTokenLength    The length of the token.
+     * @param[out]  aFrame          A pointer to a buffer of at least 2 + @p aTokenLength bytes.
+     *
+     * @returns The length of the frame.
+     *
+     */
+    static uint16_t Signal(uint8_t aCode, const uint8_t *aToken, uint8_t aTokenLength, uint8_t *aFrame);
+
+private:
+    std::vector<uint8_t> mBuffer;
+    uint16_t             mMessageId;
+};
+
+} // namespace Coap
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // COAP_STREAM_HPP_
@@ -0,0 +1,293 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the cache of operational dataset responses.
+ */
+
+#include "dataset_cache.hpp"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+#include "common/tlv_view.hpp"
+#include "uris.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+DatasetCache::DatasetCache(uint16_t aCapacity, uint32_t aLifetime) :
+    mCapacity(aCapacity),
+    mLifetime(aLifetime)
+{
+}
+
+bool DatasetCache::GetKey(const char *aPath, const uint8_t *aPayload, uint16_t aLength, std::string &aKey)
+{
+    bool           cacheable = false;
+    const uint8_t *types = NULL;
+    uint16_t       length = 0;
+    TlvView        tlvs;
+
+    VerifyOrExit(!strcmp(aPath, OT_URI_PATH_ACTIVE_GET) || !strcmp(aPath, OT_URI_PATH_PENDING_GET));
+
+    if (aLength > 0)
+    {
+        // Only a request of nothing but a Get TLV is cacheable.
+        VerifyOrExit(tlvs.Init(aPayload, aLength) == OTBR_ERROR_NONE);
+        types = tlvs.GetValue(Meshcop::kGet, length);
+        VerifyOrExit(types != NULL && aPayload[0] == Meshcop::kGet && types + length == aPayload + aLength);
+    }
+
+    {
+        std::string requested;
+
+        if (types != NULL)
+        {
+            requested.assign(reinterpret_cast<const char *>(types), length);
+        }
+
+        std::sort(requested.begin(), requested.end());
+        requested.erase(std::unique(requested.begin(), requested.end()), requested.end());
+
+        aKey = aPath;
+        aKey += ':';
+        aKey += requested;
+    }
+
+    cacheable = true;
+
+exit:
+    return cacheable;
+}
+
+DatasetCache::Result DatasetCache::Lookup(const std::string &aKey, const Waiter &aWaiter, const Response *&aResponse)
+{
+    Result            result = kResultMiss;
+    Entries::iterator it = mEntries.find(aKey);
+
+    VerifyOrExit(it != mEntries.end());
+
+    if (static_cast<long>(it->second.mExpiration - GetNow()) <= 0)
+    {
+        mEntries.erase(it);
+        ExitNow();
+    }
+
+    if (it->second.mPending)
+    {
+        it->second.mWaiters.push_back(aWaiter);
+        result = kResultJoined;
+    }
+    else
+    {
+        aResponse = &it->second.mResponse;
+        result = kResultHit;
+    }
+
+exit:
+    return result;
+}
+
+void DatasetCache::Begin(const std::string &aKey, const uint8_t *aForwardToken)
+{
+    VerifyOrExit(MakeRoom());
+
+    {
+        Entry &entry = mEntries[aKey];
+
+        entry.mExpiration = GetNow() + ForwardTable::kDefaultTimeout;
+        entry.mPending = true;
+        entry.mStale = false;
+        memcpy(entry.mForwardToken, aForwardToken, sizeof(entry.mForwardToken));
+    }
+
+exit:
+    return;
+}
+
+void DatasetCache::Complete(const uint8_t *aForwardToken, uint8_t aTokenLength, const Response &aResponse,
+                            Waiters &aWaiters)
+{
+    Entries::iterator it;
+
+    VerifyOrExit(aTokenLength == ForwardTable::kSizeOfToken);
+
+    for (it = mEntries.begin(); it != mEntries.end(); ++it)
+    {
+        if (it->second.mPending && !memcmp(it->second.mForwardToken, aForwardToken, aTokenLength))
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(it != mEntries.end());
+
+    aWaiters.swap(it->second.mWaiters);
+
+    // Only cache whole successful responses to requests not preceded by a change of the dataset.
+    if (!it->second.mStale && !aResponse.mPartial && (aResponse.mCode >> 5) == 2)
+    {
+        UpdateTimestamp(it->first, aResponse);
+        it->second.mResponse = aResponse;
+        it->second.mPending = false;
+        it->second.mExpiration = GetNow() + mLifetime;
+    }
+    else
+    {
+        mEntries.erase(it);
+    }
+
+exit:
+    return;
+}
+
+void DatasetCache::Invalidate(const char *aPath)
+{
+    for (Entries::iterator it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (aPath != NULL && it->first.compare(0, strlen(aPath), aPath) != 0)
+        {
+            ++it;
+        }
+        else if (it->second.mPending)
+        {
+            it->second.mStale = true;
+            ++it;
+        }
+        else
+        {
+            mEntries.erase(it++);
+        }
+    }
+}
+
+void DatasetCache::Remove(const Dtls::Session *aSession)
+{
+    for (Entries::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+    {
+        Waiters &waiters = it->second.mWaiters;
+
+        for (Waiters::iterator waiter = waiters.begin(); waiter != waiters.end();)
+        {
+            if (waiter->mSession == aSession)
+            {
+                waiter = waiters.erase(waiter);
+            }
+            else
+            {
+                ++waiter;
+            }
+        }
+    }
+}
+
+bool DatasetCache::MakeRoom(void)
+{
+    unsigned long     now = GetNow();
+    Entries::iterator oldest = mEntries.end();
+
+    for (Entries::iterator it = mEntries.begin(); it != mEntries.end();)
+    {
+        if (static_cast<long>(it->second.mExpiration - now) <= 0)
+        {
+            mEntries.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    VerifyOrExit(mEntries.size() >= mCapacity);
+
+    for (Entries::iterator it = mEntries.begin(); it != mEntries.end(); ++it)
+    {
+        if (!it->second.mPending &&
+            (oldest == mEntries.end() || static_cast<long>(it->second.mExpiration - oldest->second.mExpiration) < 0))
+        {
+            oldest = it;
+        }
+    }
+
+    if (oldest != mEntries.end())
+    {
+        mEntries.erase(oldest);
+    }
+
+exit:
+    return mEntries.size() < mCapacity;
+}
+
+void DatasetCache::UpdateTimestamp(const std::string &aKey, const Response &aResponse)
+{
+    bool           active = !aKey.compare(0, strlen(OT_URI_PATH_ACTIVE_GET), OT_URI_PATH_ACTIVE_GET);
+    std::string   &timestamp = active ? mActiveTimestamp : mPendingTimestamp;
+    uint16_t       length = 0;
+    const uint8_t *value = NULL;
+    TlvView        tlvs;
+
+    VerifyOrExit(!aResponse.mPayload.empty() && aResponse.mPayload.size() <= TlvView::kMaxLength);
+    VerifyOrExit(tlvs.Init(&aResponse.mPayload[0], static_cast<uint16_t>(aResponse.mPayload.size())) ==
+                 OTBR_ERROR_NONE);
+
+    value = tlvs.GetValue(active ? Meshcop::kActiveTimestamp : Meshcop::kPendingTimestamp, length);
+    VerifyOrExit(value != NULL);
+
+    if (timestamp.compare(0, std::string::npos, reinterpret_cast<const char *>(value), length) != 0)
+    {
+        // A new timestamp means the dataset changed, responses cached before are outdated.
+        otbrLog(OTBR_LOG_INFO, "%s dataset changed.", active ? "Active" : "Pending");
+        timestamp.assign(reinterpret_cast<const char *>(value), length);
+
+        for (Entries::iterator it = mEntries.begin(); it != mEntries.end();)
+        {
+            if (!it->second.mPending && it->first.compare(0, aKey.find(':'), aKey, 0, aKey.find(':')) == 0)
+            {
+                mEntries.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+exit:
+    return;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,213 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the cache of operational dataset responses.
+ */
+
+#ifndef DATASET_CACHE_HPP_
+#define DATASET_CACHE_HPP_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "dtls.hpp"
+#include "forward_table.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a cache of MGMT_ACTIVE_GET and MGMT_PENDING_GET responses.
+ *
+ * Responses are keyed by the dataset and the set of requested TLVs. While a request is forwarded to the leader,
+ * identical requests wait for its response instead of being forwarded again.
+ *
+ */
+class DatasetCache
+{
+public:
+    enum
+    {
+        kDefaultCapacity = 16,    ///< Default number of cached responses.
+        kDefaultLifetime = 60000, ///< Default lifetime of a cached response in milliseconds.
+    };
+
+    /**
+     * Result of looking up a request.
+     *
+     */
+    enum Result
+    {
+        kResultHit    = 0, ///< A cached response is available.
+        kResultJoined = 1, ///< An identical request is in flight, the requester is added to its waiters.
+        kResultMiss   = 2, ///< The request should be forwarded.
+    };
+
+    /**
+     * This structure represents a requester waiting for a response.
+     *
+     */
+    struct Waiter
+    {
+        Dtls::Session *mSession;                               ///< The session of the requester.
+        uint8_t        mTokenLength;                           ///< Length of the token of the request.
+        uint8_t        mToken[ForwardTable::kMaxTokenLength];  ///< The token of the request.
+    };
+
+    typedef std::vector<Waiter> Waiters;
+
+    /**
+     * This structure represents a cached response.
+     *
+     */
+    struct Response
+    {
+        Response(void) :
+            mCode(0),
+            mPartial(false) {}
+
+        uint8_t              mCode;    ///< CoAP code of the response.
+        bool                 mPartial; ///< Whether the payload is only a block of the dataset.
+        std::vector<uint8_t> mPayload; ///< Payload of the response.
+    };
+
+    /**
+     * The constructor to initialize a dataset cache.
+     *
+     * @param[in]   aCapacity   Max number of cached and in flight requests.
+     * @param[in]   aLifetime   Lifetime of a cached response in milliseconds.
+     *
+     */
+    DatasetCache(uint16_t aCapacity = kDefaultCapacity, uint32_t aLifetime = kDefaultLifetime);
+
+    /**
+     * This method computes the cache key of a request.
+     *
+     * @param[in]   aPath       The URI path of the request.
+     * @param[in]   aPayload    A pointer to the payload of the request.
+     * @param[in]   aLength     The length of the payload.
+     * @param[out]  aKey        A reference to receive the key.
+     *
+     * @retval  true    The request is cacheable.
+     * @retval  false   The request is not cacheable.
+     *
+     */
+    static bool GetKey(const char *aPath, const uint8_t *aPayload, uint16_t aLength, std::string &aKey);
+
+    /**
+     * This method looks up a request.
+     *
+     * @param[in]   aKey            The key of the request.
+     * @param[in]   aWaiter         The requester, added to the waiters if an identical request is in flight.
+     * @param[out]  aResponse       A reference to receive the cached response on hit.
+     *
+     * @returns The result of the lookup.
+     *
+     */
+    Result Lookup(const std::string &aKey, const Waiter &aWaiter, const Response *&aResponse);
+
+    /**
+     * This method records a request forwarded after a miss.
+     *
+     * @param[in]   aKey            The key of the request.
+     * @param[in]   aForwardToken   A pointer to the token the request was forwarded with.
+     *
+     */
+    void Begin(const std::string &aKey, const uint8_t *aForwardToken);
+
+    /**
+     * This method completes a forwarded request with its response.
+     *
+     * @param[in]   aForwardToken   A pointer to the token of the response.
+     * @param[in]   aTokenLength    The length of the token of the response.
+     * @param[in]   aResponse       The response.
+     * @param[out]  aWaiters        A reference to receive the requesters waiting for this response.
+     *
+     */
+    void Complete(const uint8_t *aForwardToken, uint8_t aTokenLength, const Response &aResponse, Waiters &aWaiters);
+
+    /**
+     * This method drops cached responses of a dataset.
+     *
+     * @param[in]   aPath       The URI path of MGMT_GET of the dataset, NULL for all datasets.
+     *
+     */
+    void Invalidate(const char *aPath);
+
+    /**
+     * This method removes the waiters of a session.
+     *
+     * @param[in]   aSession    The session.
+     *
+     */
+    void Remove(const Dtls::Session *aSession);
+
+private:
+    struct Entry
+    {
+        unsigned long mExpiration;
+        bool          mPending;
+        bool          mStale;
+        uint8_t       mForwardToken[ForwardTable::kSizeOfToken];
+        Waiters       mWaiters;
+        Response      mResponse;
+    };
+
+    typedef std::map<std::string, Entry> Entries;
+
+    bool MakeRoom(void);
+    void UpdateTimestamp(const std::string &aKey, const Response &aResponse);
+
+    Entries     mEntries;
+    uint16_t    mCapacity;
+    uint32_t    mLifetime;
+    std::string mActiveTimestamp;
+    std::string mPendingTimestamp;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // DATASET_CACHE_HPP_
@@ -0,0 +1,552 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements collecting network diagnostics of the Thread network.
+ */
+
+#include "diagnostic_collector.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+#include "common/tlv_view.hpp"
+#include "local_socket.hpp"
+#include "uris.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+enum
+{
+    kAloc16Leader = 0xfc00, ///< leader anycast locator.
+    kCoapUdpPort  = 61631,  ///< Thread management UDP port.
+};
+
+DiagnosticCollector::DiagnosticCollector(Coap::Agent *aCoap, uint8_t aMaxInFlight, uint32_t aInterval) :
+    mCoap(aCoap),
+    mDiagnosticAnswer(OT_URI_PATH_DIAGNOSTIC_GET_ANSWER, HandleDiagnosticAnswer, this),
+    mMaxInFlight(aMaxInFlight),
+    mInterval(aInterval),
+    mSocket(-1),
+    mPath(NULL),
+    mNextRound(0) {}
+
+DiagnosticCollector::~DiagnosticCollector(void)
+{
+    for (Clients::const_iterator it = mClients.begin(); it != mClients.end(); ++it)
+    {
+        close(it->mFd);
+    }
+
+    if (mSocket != -1)
+    {
+        close(mSocket);
+        unlink(mPath);
+    }
+}
+
+otbrError DiagnosticCollector::Start(const char *aPath)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+
+    VerifyOrExit((mSocket = ListenLocal(aPath, kMaxClients)) != -1);
+    SuccessOrExit(fcntl(mSocket, F_SETFL, O_NONBLOCK));
+    SuccessOrExit(error = mCoap->AddResource(mDiagnosticAnswer));
+
+    mPath = aPath;
+    mNextRound = GetNow();
+    otbrLog(OTBR_LOG_INFO, "Serving network diagnostics on %s.", aPath);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error)
+    {
+        otbrLog(OTBR_LOG_ERR, "Failed to start diagnostic collector: %s!", strerror(errno));
+
+        if (mSocket != -1)
+        {
+            close(mSocket);
+            unlink(aPath);
+            mSocket = -1;
+        }
+    }
+
+    return error;
+}
+
+void DiagnosticCollector::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, int &aMaxFd, timeval &aTimeout)
+{
+    unsigned long now = GetNow();
+    unsigned long timeout = GetTimestamp(aTimeout);
+    unsigned long expiration = mNextRound;
+
+    VerifyOrExit(mSocket != -1);
+
+    // Leave further clients in the backlog until a slot is free.
+    if (mClients.size() < kMaxClients)
+    {
+        FD_SET(mSocket, &aReadFdSet);
+
+        if (aMaxFd < mSocket)
+        {
+            aMaxFd = mSocket;
+        }
+    }
+
+    for (Clients::const_iterator it = mClients.begin(); it != mClients.end(); ++it)
+    {
+        FD_SET(it->mFd, &aWriteFdSet);
+
+        if (aMaxFd < it->mFd)
+        {
+            aMaxFd = it->mFd;
+        }
+
+        if (static_cast<long>(it->mExpiration - expiration) < 0)
+        {
+            expiration = it->mExpiration;
+        }
+    }
+
+    if (!mPendingQueries.empty() && mQueries.size() < mMaxInFlight)
+    {
+        expiration = now;
+    }
+
+    for (Queries::const_iterator it = mQueries.begin(); it != mQueries.end(); ++it)
+    {
+        if (static_cast<long>(it->mExpiration - expiration) < 0)
+        {
+            expiration = it->mExpiration;
+        }
+    }
+
+    expiration = static_cast<long>(expiration - now) > 0 ? expiration - now : 0;
+
+    if (expiration < timeout)
+    {
+        aTimeout.tv_sec = static_cast<time_t>(expiration / 1000);
+        aTimeout.tv_usec = static_cast<suseconds_t>((expiration % 1000) * 1000);
+    }
+
+exit:
+    return;
+}
+
+void DiagnosticCollector::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet)
+{
+    unsigned long now = GetNow();
+
+    VerifyOrExit(mSocket != -1);
+
+    for (Queries::iterator it = mQueries.begin(); it != mQueries.end();)
+    {
+        if (static_cast<long>(it->mExpiration - now) <= 0)
+        {
+            otbrLog(OTBR_LOG_INFO, "Diagnostic query to 0x%04x timed out.", it->mRloc16);
+            it = mQueries.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if (static_cast<long>(mNextRound - now) <= 0)
+    {
+        StartRound();
+    }
+
+    while (mQueries.size() < mMaxInFlight && !mPendingQueries.empty())
+    {
+        SendQuery(mPendingQueries.front());
+        mPendingQueries.pop_front();
+    }
+
+    if (FD_ISSET(mSocket, &aReadFdSet))
+    {
+        Accept();
+    }
+
+    Serve(aWriteFdSet);
+
+exit:
+    return;
+}
+
+void DiagnosticCollector::StartRound(void)
+{
+    unsigned long now = GetNow();
+    unsigned long maxAge = static_cast<unsigned long>(mInterval) * kMaxAge;
+
+    mNextRound = now + mInterval;
+    mQueried.clear();
+
+    for (Nodes::iterator it = mNodes.begin(); it != mNodes.end();)
+    {
+        if (now - it->second.mUpdated > maxAge)
+        {
+            otbrLog(OTBR_LOG_INFO, "Node 0x%04x is gone.", it->first);
+            mNodes.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    // Start from the leader, and keep refreshing known routers even if it does not answer.
+    Enqueue(kAloc16Leader);
+
+    for (Nodes::const_iterator it = mNodes.begin(); it != mNodes.end(); ++it)
+    {
+        for (std::vector<uint8_t>::const_iterator id = it->second.mRouterIds.begin();
+             id != it->second.mRouterIds.end(); ++id)
+        {
+            Enqueue(static_cast<uint16_t>(*id << 10));
+        }
+    }
+}
+
+void DiagnosticCollector::Enqueue(uint16_t aRloc16)
+{
+    if (mQueried.insert(aRloc16).second)
+    {
+        mPendingQueries.push_back(aRloc16);
+    }
+}
+
+void DiagnosticCollector::SendQuery(uint16_t aRloc16)
+{
+    static const uint8_t kQuery[] = {
+        NetworkDiagnostic::kTypeList,
+        6,
+        NetworkDiagnostic::kExtMacAddress,
+        NetworkDiagnostic::kAddress16,
+        NetworkDiagnostic::kMode,
+        NetworkDiagnostic::kRoute64,
+        NetworkDiagnostic::kIp6AddressList,
+        NetworkDiagnostic::kChildTable,
+    };
+
+    uint8_t        token[] = {static_cast<uint8_t>(aRloc16 >> 8), static_cast<uint8_t>(aRloc16 & 0xff)};
+    Ip6Address     addr(aRloc16);
+    Query          query;
+    Coap::Message *message = mCoap->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, token, sizeof(token));
+
+    message->SetPath(OT_URI_PATH_DIAGNOSTIC_GET_REQUEST);
+    message->SetPayload(kQuery, sizeof(kQuery));
+
+    if (mCoap->Send(*message, addr.m8, kCoapUdpPort, HandleResponse, this) == OTBR_ERROR_NONE)
+    {
+        query.mRloc16 = aRloc16;
+        query.mExpiration = GetNow() + kRequestTimeout;
+        mQueries.push_back(query);
+    }
+
+    mCoap->FreeMessage(message);
+}
+
+void DiagnosticCollector::HandleResponse(const Coap::Message &aMessage)
+{
+    uint8_t        tokenLength = 0;
+    const uint8_t *token = aMessage.GetToken(tokenLength);
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+    uint16_t       rloc16;
+
+    VerifyOrExit(tokenLength == 2);
+    rloc16 = static_cast<uint16_t>(token[0] << 8 | token[1]);
+
+    for (Queries::iterator it = mQueries.begin(); it != mQueries.end(); ++it)
+    {
+        if (it->mRloc16 == rloc16)
+        {
+            mQueries.erase(it);
+            break;
+        }
+    }
+
+    VerifyOrExit(aMessage.GetCode() == Coap::kCodeChanged,
+                 otbrLog(OTBR_LOG_WARNING, "Diagnostic query to 0x%04x failed: %d.", rloc16, aMessage.GetCode()));
+
+    if (HandleAnswer(payload, length) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Malformed diagnostic answer from 0x%04x!", rloc16);
+    }
+
+exit:
+    return;
+}
+
+void DiagnosticCollector::HandleDiagnosticAnswer(const Coap::Message &aMessage, Coap::Message &aResponse)
+{
+    uint16_t       length = 0;
+    const uint8_t *payload = aMessage.GetPayload(length);
+
+    if (HandleAnswer(payload, length) != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Malformed diagnostic answer!");
+    }
+
+    aResponse.SetCode(Coap::kCodeChanged);
+}
+
+otbrError DiagnosticCollector::HandleAnswer(const uint8_t *aPayload, uint16_t aLength)
+{
+    otbrError      error = OTBR_ERROR_ERRNO;
+    const uint8_t *value = NULL;
+    uint16_t       length = 0;
+    uint16_t       rloc16 = 0;
+    uint8_t        mode = 0;
+    TlvView        tlvs;
+
+    // Validate the answer and find out the node it is from before updating anything.
+    SuccessOrExit(tlvs.Init(aPayload, aLength));
+    VerifyOrExit(tlvs.GetUInt16(NetworkDiagnostic::kAddress16, rloc16), errno = EBADMSG);
+
+    {
+        Node &node = mNodes[rloc16];
+
+        if (node.mUpdated == 0)
+        {
+            otbrLog(OTBR_LOG_INFO, "Found node 0x%04x.", rloc16);
+            node.mRloc16 = rloc16;
+            memset(node.mExtAddress, 0, sizeof(node.mExtAddress));
+            node.mMode = 0;
+        }
+
+        node.mUpdated = GetNow();
+        mQueried.insert(node.mRloc16);
+
+        if ((value = tlvs.GetFixed(NetworkDiagnostic::kExtMacAddress, sizeof(node.mExtAddress))) != NULL)
+        {
+            memcpy(node.mExtAddress, value, sizeof(node.mExtAddress));
+        }
+
+        if (tlvs.GetUInt8(NetworkDiagnostic::kMode, mode))
+        {
+            node.mMode = mode;
+        }
+
+        // ID sequence, router mask of 64 bits, route data of each router.
+        if ((value = tlvs.GetValue(NetworkDiagnostic::kRoute64, length)) != NULL && length >= 9)
+        {
+            node.mRouterIds.clear();
+
+            for (uint8_t id = 0; id < 64; ++id)
+            {
+                if (value[1 + id / 8] & (0x80 >> (id % 8)))
+                {
+                    node.mRouterIds.push_back(id);
+                    Enqueue(static_cast<uint16_t>(id << 10));
+                }
+            }
+        }
+
+        if ((value = tlvs.GetValue(NetworkDiagnostic::kIp6AddressList, length)) != NULL)
+        {
+            node.mAddresses.clear();
+
+            for (uint16_t i = 0; i + sizeof(Ip6Address) <= length; i += sizeof(Ip6Address))
+            {
+                Ip6Address address;
+
+                memcpy(address.m8, value + i, sizeof(address.m8));
+                node.mAddresses.push_back(address);
+            }
+        }
+
+        // Each entry is of timeout and child ID in 16 bits, followed by mode in 8 bits.
+        if ((value = tlvs.GetValue(NetworkDiagnostic::kChildTable, length)) != NULL)
+        {
+            node.mChildren.clear();
+
+            for (uint16_t i = 0; i + 3 <= length; i += 3)
+            {
+                uint16_t childId = static_cast<uint16_t>((value[i] << 8 | value[i + 1]) & 0x1ff);
+
+                node.mChildren.push_back(static_cast<uint16_t>(node.mRloc16 | childId));
+            }
+        }
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+std::string DiagnosticCollector::GetSnapshot(void) const
+{
+    unsigned long now = GetNow();
+    std::string   snapshot = "{\"nodes\":[";
+    char          buffer[INET6_ADDRSTRLEN + 8];
+
+    for (Nodes::const_iterator it = mNodes.begin(); it != mNodes.end(); ++it)
+    {
+        const Node &node = it->second;
+
+        if (it != mNodes.begin())
+        {
+            snapshot += ',';
+        }
+
+        snprintf(buffer, sizeof(buffer), "{\"rloc16\":%u", node.mRloc16);
+        snapshot += buffer;
+
+        snapshot += ",\"extAddress\":\"";
+
+        for (size_t i = 0; i < sizeof(node.mExtAddress); ++i)
+        {
+            snprintf(buffer, sizeof(buffer), "%02x", node.mExtAddress[i]);
+            snapshot += buffer;
+        }
+
+        snprintf(buffer, sizeof(buffer), "\",\"mode\":%u", node.mMode);
+        snapshot += buffer;
+        snprintf(buffer, sizeof(buffer), ",\"age\":%lu", now - node.mUpdated);
+        snapshot += buffer;
+
+        snapshot += ",\"routerIds\":[";
+
+        for (size_t i = 0; i < node.mRouterIds.size(); ++i)
+        {
+            snprintf(buffer, sizeof(buffer), i ? ",%u" : "%u", node.mRouterIds[i]);
+            snapshot += buffer;
+        }
+
+        snapshot += "],\"children\":[";
+
+        for (size_t i = 0; i < node.mChildren.size(); ++i)
+        {
+            snprintf(buffer, sizeof(buffer), i ? ",%u" : "%u", node.mChildren[i]);
+            snapshot += buffer;
+        }
+
+        snapshot += "],\"addresses\":[";
+
+        for (size_t i = 0; i < node.mAddresses.size(); ++i)
+        {
+            char address[INET6_ADDRSTRLEN];
+
+            inet_ntop(AF_INET6, node.mAddresses[i].m8, address, sizeof(address));
+            snprintf(buffer, sizeof(buffer), i ? ",\"%s\"" : "\"%s\"", address);
+            snapshot += buffer;
+        }
+
+        snapshot += "]}";
+    }
+
+    snapshot += "]}\n";
+
+    return snapshot;
+}
+
+void DiagnosticCollector::Accept(void)
+{
+    while (mClients.size() < kMaxClients)
+    {
+        Client client;
+
+        client.mFd = accept4(mSocket, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (client.mFd == -1)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Diagnostic collector failed to accept: %s!", strerror(errno));
+            }
+
+            break;
+        }
+
+        client.mSnapshot = GetSnapshot();
+        client.mSent = 0;
+        client.mExpiration = GetNow() + kClientTimeout;
+        mClients.push_back(client);
+    }
+}
+
+void DiagnosticCollector::Serve(const fd_set &aWriteFdSet)
+{
+    unsigned long now = GetNow();
+
+    for (Clients::iterator it = mClients.begin(); it != mClients.end();)
+    {
+        bool done = false;
+
+        if (FD_ISSET(it->mFd, &aWriteFdSet))
+        {
+            ssize_t ret = send(it->mFd, it->mSnapshot.data() + it->mSent, it->mSnapshot.size() - it->mSent,
+                               MSG_NOSIGNAL);
+
+            if (ret > 0)
+            {
+                it->mSent += static_cast<size_t>(ret);
+                done = (it->mSent == it->mSnapshot.size());
+            }
+            else if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                otbrLog(OTBR_LOG_WARNING, "Failed to send diagnostics: %s!", strerror(errno));
+                done = true;
+            }
+        }
+
+        if (!done && static_cast<long>(it->mExpiration - now) <= 0)
+        {
+            otbrLog(OTBR_LOG_WARNING, "Diagnostic client timed out.");
+            done = true;
+        }
+
+        if (done)
+        {
+            close(it->mFd);
+            it = mClients.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,245 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for collecting network diagnostics of the Thread network.
+ */
+
+#ifndef DIAGNOSTIC_COLLECTOR_HPP_
+#define DIAGNOSTIC_COLLECTOR_HPP_
+
+#include <stdint.h>
+#include <sys/select.h>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "coap.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-diagnostic
+ *
+ * @brief
+ *   This module includes definition for collecting network diagnostics.
+ *
+ * @{
+ */
+
+/**
+ * This class implements a collector of network diagnostics.
+ *
+ * The collector periodically queries the leader and then every router it learns of from the Route64 TLV,
+ * keeping a bounded number of queries in flight. Answers update a topology snapshot in place, and nodes not
+ * heard of for several rounds are dropped. The snapshot is served as JSON to each client connecting to a
+ * Unix socket. Clients are written to without blocking, and a client not reading its snapshot in time is
+ * dropped.
+ *
+ */
+class DiagnosticCollector
+{
+public:
+    enum
+    {
+        kDefaultMaxInFlight = 4,     ///< Default max number of queries in flight.
+        kDefaultInterval    = 60000, ///< Default interval between rounds in milliseconds.
+    };
+
+    /**
+     * This structure represents a node of the Thread network.
+     *
+     */
+    struct Node
+    {
+        uint16_t                mRloc16;        ///< RLOC16 of the node.
+        uint8_t                 mExtAddress[8]; ///< Extended MAC address of the node.
+        uint8_t                 mMode;          ///< MLE mode of the node.
+        std::vector<uint8_t>    mRouterIds;     ///< Router IDs allocated in the Route64 TLV.
+        std::vector<uint16_t>   mChildren;      ///< RLOC16s of children.
+        std::vector<Ip6Address> mAddresses;     ///< IPv6 addresses of the node.
+        unsigned long           mUpdated;       ///< Timestamp of the last answer in milliseconds.
+    };
+
+    typedef std::map<uint16_t, Node> Nodes;
+
+    /**
+     * The constructor to initialize a diagnostic collector.
+     *
+     * @param[in]   aCoap           A pointer to the TMF agent.
+     * @param[in]   aMaxInFlight    Max number of queries in flight.
+     * @param[in]   aInterval       Interval between rounds in milliseconds.
+     *
+     */
+    DiagnosticCollector(Coap::Agent *aCoap, uint8_t aMaxInFlight = kDefaultMaxInFlight,
+                        uint32_t aInterval = kDefaultInterval);
+
+    ~DiagnosticCollector(void);
+
+    /**
+     * This method starts collecting diagnostics and serving the snapshot.
+     *
+     * The directory containing @p aPath must be owned by root or the effective user and must not be writable
+     * by group or others. The socket is only accessible to its owner.
+     *
+     * @param[in]   aPath               Path of the Unix socket to serve the snapshot on.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully started.
+     * @retval      OTBR_ERROR_ERRNO    Failed to start for system error.
+     *
+     */
+    otbrError Start(const char *aPath);
+
+    /**
+     * This method updates the fd_set and timeout for mainloop.
+     *
+     * @param[inout]  aReadFdSet   A reference to read file descriptors.
+     * @param[inout]  aWriteFdSet  A reference to write file descriptors.
+     * @param[inout]  aMaxFd       A reference to the max file descriptor.
+     * @param[inout]  aTimeout     A reference to timeout.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, int &aMaxFd, timeval &aTimeout);
+
+    /**
+     * This method sends due queries, accepts connecting clients and sends them the snapshot.
+     *
+     * @param[in]   aReadFdSet   A reference to read file descriptors.
+     * @param[in]   aWriteFdSet  A reference to write file descriptors.
+     *
+     */
+    void Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet);
+
+    /**
+     * This method updates the snapshot with a diagnostic answer.
+     *
+     * @param[in]   aPayload            A pointer to the payload of the answer.
+     * @param[in]   aLength             The length of the payload.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully updated.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the answer is malformed or lacks the Address16 TLV.
+     *
+     */
+    otbrError HandleAnswer(const uint8_t *aPayload, uint16_t aLength);
+
+    /**
+     * This method returns the nodes in the snapshot.
+     *
+     * @returns A reference to the nodes.
+     *
+     */
+    const Nodes &GetNodes(void) const { return mNodes; }
+
+    /**
+     * This method formats the snapshot as JSON.
+     *
+     * @returns The snapshot in JSON.
+     *
+     */
+    std::string GetSnapshot(void) const;
+
+private:
+    enum
+    {
+        kRequestTimeout = 15000, ///< Timeout of a query in milliseconds.
+        kMaxAge         = 3,     ///< Number of rounds a node is kept without answering.
+        kMaxClients     = 4,     ///< Max number of clients being served at the same time.
+        kClientTimeout  = 5000,  ///< Time in milliseconds a client is given to read the snapshot.
+    };
+
+    struct Query
+    {
+        uint16_t      mRloc16;
+        unsigned long mExpiration;
+    };
+
+    typedef std::vector<Query> Queries;
+
+    struct Client
+    {
+        int           mFd;
+        std::string   mSnapshot;
+        size_t        mSent;
+        unsigned long mExpiration;
+    };
+
+    typedef std::vector<Client> Clients;
+
+    static void HandleResponse(const Coap::Message &aMessage, void *aContext)
+    {
+        static_cast<DiagnosticCollector *>(aContext)->HandleResponse(aMessage);
+    }
+    void HandleResponse(const Coap::Message &aMessage);
+
+    static void HandleDiagnosticAnswer(const Coap::Resource &aResource, const Coap::Message &aMessage,
+                                       Coap::Message &aResponse,
+                                       const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        (void)aResource;
+        (void)aIp6;
+        (void)aPort;
+        static_cast<DiagnosticCollector *>(aContext)->HandleDiagnosticAnswer(aMessage, aResponse);
+    }
+    void HandleDiagnosticAnswer(const Coap::Message &aMessage, Coap::Message &aResponse);
+
+    void StartRound(void);
+    void Enqueue(uint16_t aRloc16);
+    void SendQuery(uint16_t aRloc16);
+    void Accept(void);
+    void Serve(const fd_set &aWriteFdSet);
+
+    Coap::Agent          *mCoap;
+    Coap::Resource        mDiagnosticAnswer;
+    uint8_t               mMaxInFlight;
+    uint32_t              mInterval;
+    int                   mSocket;
+    const char           *mPath;
+    unsigned long         mNextRound;
+    std::deque<uint16_t>  mPendingQueries;
+    std::set<uint16_t>    mQueried;
+    Queries               mQueries;
+    Clients               mClients;
+    Nodes                 mNodes;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // DIAGNOSTIC_COLLECTOR_HPP_
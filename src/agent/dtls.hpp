@@ -34,7 +34,9 @@
 #ifndef DTLS_HPP_
 #define DTLS_HPP_
 
+#include <netinet/in.h>
 #include <sys/select.h>
+#include <sys/types.h>
 
 #include "common/types.hpp"
 
@@ -92,12 +94,13 @@ public:
     /**
      * This function pointer is called when decrypted data are ready for use.
      *
+     * @param[in]   aSession        The DTLS session the data were received on.
      * @param[in]   aBuffer         A pointer to decrypted data.
      * @param[in]   aLength         Number of bytes of @p aBuffer.
      * @param[in]   aContext        A pointer to application-specific context.
      *
      */
-    typedef void (*DataHandler)(const uint8_t *aBuffer, uint16_t aLength, void *aContext);
+    typedef void (*DataHandler)(Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext);
 
     /**
      * This method sets the data handler for this session.
@@ -127,6 +130,14 @@ public:
      */
     virtual const uint8_t *GetKek(void) = 0;
 
+    /**
+     * This method returns the address of the peer.
+     *
+     * @returns A reference to the socket address of the peer.
+     *
+     */
+    virtual const sockaddr_in6 &GetPeerAddress(void) const = 0;
+
     /**
      * This method closes the DTLS session.
      *
@@ -143,6 +154,16 @@ public:
 class Server
 {
 public:
+    /**
+     * Transport of a DTLS server.
+     *
+     */
+    enum Transport
+    {
+        kTransportDatagram = 0, ///< DTLS over UDP.
+        kTransportStream   = 1, ///< TLS over TCP.
+    };
+
     /**
      * This function pointer is called when the session state changed.
      *
@@ -153,16 +174,30 @@ public:
      */
     typedef void (*StateHandler)(Session &aSession, Session::State aState, void *aContext);
 
+    /**
+     * This function pointer is called when a session is created, to look up the PSK of its peer.
+     *
+     * @param[in]   aPeerAddress        The address of the peer.
+     * @param[out]  aLength             The length of the PSK returned.
+     * @param[in]   aContext            A pointer to application-specific context.
+     *
+     * @returns A pointer to the PSK of the peer, NULL to use the PSK of this server.
+     *
+     */
+    typedef const uint8_t *(*PSKHandler)(const sockaddr_in6 &aPeerAddress, uint8_t &aLength, void *aContext);
+
     /**
      * This method creates a DTLS server.
      *
      * @param[in]   aPort               The listening port of this DTLS server.
      * @param[in]   aStateHandler       A pointer to a function to be called when session state changed.
      * @param[in]   aContext            A pointer to application-specific context.
+     * @param[in]   aTransport          The transport of this server.
      *
      * @returns pointer to the created the DTLS server.
      */
-    static Server *Create(uint16_t aPort, StateHandler aStateHandler, void *aContext);
+    static Server *Create(uint16_t aPort, StateHandler aStateHandler, void *aContext,
+                          Transport aTransport = kTransportDatagram);
 
     /**
      * This method destroy a DTLS server.
@@ -172,6 +207,14 @@ public:
      */
     static void Destroy(Server *aServer);
 
+    /**
+     * This function returns the estimated memory usage of a single session.
+     *
+     * @returns The memory usage in bytes, the smallest useful memory budget.
+     *
+     */
+    static size_t GetSessionMemoryUsage(void);
+
     /**
      * This method updates the PSK of TLS_ECJPAKE_WITH_AES_128_CCM_8 used by this server.
      *
@@ -184,6 +227,16 @@ public:
      */
     virtual otbrError SetPSK(const uint8_t *aPSK, uint8_t aLength) = 0;
 
+    /**
+     * This method sets the handler to look up the PSK of each new session, so that peers may use different PSKs.
+     *
+     * @param[in]   aPSKHandler         A pointer to the function to look up the PSK, NULL to use the PSK of this
+     *                                  server for all sessions.
+     * @param[in]   aContext            A pointer to application-specific context.
+     *
+     */
+    virtual void SetPSKHandler(PSKHandler aPSKHandler, void *aContext) = 0;
+
     /**
      * This method updates the seed for random generator.
      *
@@ -196,6 +249,52 @@ public:
      */
     virtual otbrError SetSeed(const uint8_t *aSeed, uint16_t aLength) = 0;
 
+    /**
+     * This method enables or disables record coalescing of sessions created by this server.
+     *
+     * When enabled, DTLS records written by an established session in one mainloop iteration are
+     * gathered and sent in as few datagrams as the path MTU allows, instead of one datagram per record.
+     *
+     * @param[in]   aEnabled            Whether to enable record coalescing.
+     *
+     */
+    virtual void SetCoalescing(bool aEnabled) = 0;
+
+    /**
+     * This method sets the file to persist the session resumption cache in. It takes effect when the
+     * server starts.
+     *
+     * @param[in]   aPath               Path of the cache file, NULL to keep cached sessions in memory only.
+     *
+     */
+    virtual void SetSessionCacheFile(const char *aPath) = 0;
+
+    /**
+     * This method sets an already bound socket for the server to listen on, instead of binding a new one when
+     * the server starts.
+     *
+     * @param[in]   aSocket             The bound socket, a listening one for kTransportStream.
+     *
+     */
+    virtual void SetSocket(int aSocket) = 0;
+
+    /**
+     * This method returns the socket this server listens on.
+     *
+     * @returns The listening socket, -1 if not started.
+     *
+     */
+    virtual int GetSocket(void) const = 0;
+
+    /**
+     * This method sets the memory budget of all sessions. New sessions are refused while the estimated
+     * memory usage would exceed the budget.
+     *
+     * @param[in]   aBudget             Memory budget in bytes, 0 for unlimited.
+     *
+     */
+    virtual void SetMemoryBudget(size_t aBudget) = 0;
+
     /**
      * This method starts the DTLS service.
      *
@@ -36,6 +36,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <netinet/tcp.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -44,6 +45,12 @@
 #include "common/time.hpp"
 #include "common/types.hpp"
 
+extern "C" {
+
+#include <mbedtls/ssl_internal.h>
+
+} // extern "C"
+
 namespace ot {
 
 namespace BorderRouter {
@@ -105,9 +112,20 @@ static void MbedtlsDebug(void *aContext, int aLevel, const char *aFile, int aLin
     (void)aContext;
 }
 
-Server *Server::Create(uint16_t aPort, StateHandler aStateHandler, void *aContext)
+/**
+ * This function returns the memory a session holds right after it is created, i.e. the session itself, the
+ * I/O buffers of mbedTLS and the handshake context.
+ *
+ */
+static size_t GetNewSessionMemoryUsage(void)
 {
-    return new MbedtlsServer(aPort, aStateHandler, aContext);
+    return sizeof(MbedtlsSession) + 2 * MBEDTLS_SSL_BUFFER_LEN + sizeof(mbedtls_ssl_handshake_params) +
+           sizeof(mbedtls_ssl_transform) + sizeof(mbedtls_ssl_session);
+}
+
+Server *Server::Create(uint16_t aPort, StateHandler aStateHandler, void *aContext, Transport aTransport)
+{
+    return new MbedtlsServer(aPort, aStateHandler, aContext, aTransport);
 }
 
 void Server::Destroy(Server *aServer)
@@ -115,6 +133,11 @@ void Server::Destroy(Server *aServer)
     delete static_cast<MbedtlsServer *>(aServer);
 }
 
+size_t Server::GetSessionMemoryUsage(void)
+{
+    return GetNewSessionMemoryUsage();
+}
+
 otbrError MbedtlsServer::Start(void)
 {
     otbrError        ret = OTBR_ERROR_NONE;
@@ -127,9 +150,6 @@ otbrError MbedtlsServer::Start(void)
 
     mbedtls_ssl_config_init(&mConf);
     mbedtls_ssl_cookie_init(&mCookie);
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_init(&mCache);
-#endif
     mbedtls_entropy_init(&mEntropy);
     mbedtls_ctr_drbg_init(&mCtrDrbg);
 
@@ -141,7 +161,8 @@ otbrError MbedtlsServer::Start(void)
 
     SuccessOrExit(error = mbedtls_ssl_config_defaults(&mConf,
                                                       MBEDTLS_SSL_IS_SERVER,
-                                                      MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                                      mTransport == kTransportStream ?
+                                                      MBEDTLS_SSL_TRANSPORT_STREAM : MBEDTLS_SSL_TRANSPORT_DATAGRAM,
                                                       MBEDTLS_SSL_PRESET_DEFAULT));
 
     mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mCtrDrbg);
@@ -151,16 +172,26 @@ otbrError MbedtlsServer::Start(void)
     mbedtls_ssl_conf_ciphersuites(&mConf, ciphersuites);
     mbedtls_ssl_conf_read_timeout(&mConf, 0);
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_conf_session_cache(&mConf, &mCache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
-#endif
+    SuccessOrExit(ret = mSessionCache.Init(mSessionCacheFile));
+    mbedtls_ssl_conf_session_cache(&mConf, this, GetCachedSession, SetCachedSession);
 
-    SuccessOrExit(error = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, &mCtrDrbg));
+    // A TCP connection already proves the peer owns its address.
+    if (mTransport == kTransportDatagram)
+    {
+        SuccessOrExit(error = mbedtls_ssl_cookie_setup(&mCookie, mbedtls_ctr_drbg_random, &mCtrDrbg));
 
-    mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check,
-                                  &mCookie);
+        mbedtls_ssl_conf_dtls_cookies(&mConf, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check,
+                                      &mCookie);
+    }
 
-    SuccessOrExit(ret = Bind());
+    if (mSocket == -1)
+    {
+        SuccessOrExit(ret = Bind());
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_INFO, "DTLS inherited socket on port %u.", mPort);
+    }
 
 exit:
 
@@ -183,14 +214,27 @@ otbrError MbedtlsServer::Bind(void)
     sin6.sin6_family = AF_INET6;
     sin6.sin6_port = htons(mPort);
 
-    VerifyOrExit((mSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) != -1);
-    // This option enables retrieving the original destination IPv6 address.
-    SuccessOrExit(setsockopt(mSocket, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one)));
+    if (mTransport == kTransportStream)
+    {
+        VerifyOrExit((mSocket = socket(AF_INET6, SOCK_STREAM, IPPROTO_TCP)) != -1);
+    }
+    else
+    {
+        VerifyOrExit((mSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP)) != -1);
+        // This option enables retrieving the original destination IPv6 address.
+        SuccessOrExit(setsockopt(mSocket, IPPROTO_IPV6, IPV6_RECVPKTINFO, &one, sizeof(one)));
+    }
+
     // This option allows binding to the same address.
     SuccessOrExit(setsockopt(mSocket, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)));
     SuccessOrExit(bind(mSocket, reinterpret_cast<struct sockaddr *>(&sin6), sizeof(sin6)));
 
-    otbrLog(OTBR_LOG_INFO, "DTLS bound to port %u.", mPort);
+    if (mTransport == kTransportStream)
+    {
+        SuccessOrExit(listen(mSocket, kListenBacklog));
+    }
+
+    otbrLog(OTBR_LOG_INFO, "%s bound to port %u.", mTransport == kTransportStream ? "TLS" : "DTLS", mPort);
     ret = OTBR_ERROR_NONE;
 
 exit:
@@ -237,6 +281,7 @@ void MbedtlsSession::Close(void)
     VerifyOrExit(mState != kStateError && mState != kStateEnd);
 
     while (mbedtls_ssl_close_notify(&mSsl) == MBEDTLS_ERR_SSL_WANT_WRITE) ;
+    Flush();
     SetState(kStateEnd);
 
 exit:
@@ -251,6 +296,10 @@ MbedtlsSession::~MbedtlsSession(void)
     {
         mbedtls_net_free(&mNet);
     }
+    if (mWriteBuffer != NULL)
+    {
+        mServer.FreeBuffer(mWriteBuffer);
+    }
     mbedtls_ssl_free(&mSsl);
     otbrLog(OTBR_LOG_INFO, "DTLS session destroyed: %d.", mState);
 }
@@ -276,19 +325,23 @@ void MbedtlsSession::Process(void)
 
 int MbedtlsSession::Read(void)
 {
-    uint8_t buffer[kMaxSizeOfPacket];
-    int     ret = 0;
+    // Decrypted data are consumed by the data handler before returning, so sessions share one buffer.
+    uint8_t *buffer = mServer.mReadBuffer;
+    int      ret = 0;
 
     do
     {
-        ret = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer));
+        ret = mbedtls_ssl_read(&mSsl, buffer, sizeof(mServer.mReadBuffer));
 
         if (ret > 0)
         {
-            mDataHandler(buffer, (uint16_t)ret, mContext);
+            mDataHandler(*this, buffer, (uint16_t)ret, mContext);
         }
     }
-    while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+    // A record may arrive in several TCP segments, the rest is waited for in the mainloop.
+    while ((ret == MBEDTLS_ERR_SSL_WANT_READ && mServer.mTransport == Server::kTransportDatagram) ||
+           ret == MBEDTLS_ERR_SSL_WANT_WRITE ||
+           (ret > 0 && mState == kStateReady && mbedtls_ssl_get_bytes_avail(&mSsl) > 0));
 
     if (ret <= 0)
     {
@@ -313,6 +366,9 @@ int MbedtlsSession::Read(void)
             otbrLog(OTBR_LOG_WARNING, "DTLS read timeout!");
             break;
 
+        case MBEDTLS_ERR_SSL_WANT_READ:
+            break;
+
         default:
             otbrLog(OTBR_LOG_ERR, "DTLS read error: -0x%04x!", -ret);
             SetState(kStateError);
@@ -343,12 +399,28 @@ MbedtlsSession::MbedtlsSession(MbedtlsServer &aServer, const mbedtls_net_context
     mNet(aNet),
     mRemoteSock(aRemoteSock),
     mLocalSock(aLocalSock),
-    mServer(aServer) {}
+    mServer(aServer),
+    mWriteBuffer(NULL),
+    mWriteLength(0),
+    mWriteLimit(kMinIp6Mtu - kSizeOfUdp6Header) {}
 
 otbrError MbedtlsSession::Init(void)
 {
-    otbrError error = OTBR_ERROR_NONE;
-    int       rval = 0;
+    otbrError      error = OTBR_ERROR_NONE;
+    int            rval = 0;
+    const uint8_t *psk = NULL;
+    uint8_t        pskLength = 0;
+
+    if (mServer.mPSKHandler != NULL)
+    {
+        psk = mServer.mPSKHandler(mRemoteSock, pskLength, mServer.mPSKContext);
+    }
+
+    if (psk == NULL)
+    {
+        psk = mServer.mPSK;
+        pskLength = mServer.mPSKLength;
+    }
 
     mbedtls_ssl_init(&mSsl);
     SuccessOrExit(rval = mbedtls_ssl_setup(&mSsl, &mServer.mConf));
@@ -356,11 +428,30 @@ otbrError MbedtlsSession::Init(void)
     mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
 
     SuccessOrExit(rval = mbedtls_ssl_session_reset(&mSsl));
-    SuccessOrExit(rval = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mServer.mPSK, mServer.mPSKLength));
-    SuccessOrExit(rval = mbedtls_ssl_set_client_transport_id(&mSsl,
-                                                             reinterpret_cast<const unsigned char *>(&mRemoteSock),
-                                                             sizeof(mRemoteSock)));
-    mbedtls_ssl_set_bio(&mSsl, this, SendMbedtls, ReadMbedtls, NULL);
+    SuccessOrExit(rval = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, psk, pskLength));
+
+    if (mServer.mTransport == Server::kTransportStream)
+    {
+        // The accepted socket is already connected to the peer.
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+    }
+    else
+    {
+        SuccessOrExit(rval = mbedtls_ssl_set_client_transport_id(&mSsl,
+                                                                 reinterpret_cast<const unsigned char *>(&mRemoteSock),
+                                                                 sizeof(mRemoteSock)));
+
+        // A socket other than the listening one is already connected to the peer.
+        if (mNet.fd != mServer.mSocket)
+        {
+            SuccessOrExit(rval = mbedtls_net_set_nonblock(&mNet));
+            SetConnectedBio();
+        }
+        else
+        {
+            mbedtls_ssl_set_bio(&mSsl, this, SendMbedtls, ReadMbedtls, NULL);
+        }
+    }
 
     mState = kStateHandshaking;
 
@@ -390,13 +481,134 @@ int MbedtlsSession::SendMbedtls(const unsigned char *aBuffer, size_t aLength)
     SuccessOrExit(ret = bind(fd, reinterpret_cast<const struct sockaddr *>(&mLocalSock), sizeof(mLocalSock)));
     SuccessOrExit(ret = connect(fd, reinterpret_cast<const struct sockaddr *>(&mRemoteSock), sizeof(mRemoteSock)));
     SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
-    mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+    SetConnectedBio();
+
     VerifyOrExit((ret = mbedtls_net_send(&mNet, aBuffer, aLength)) != -1);
 
 exit:
     return ret;
 }
 
+void MbedtlsSession::SetConnectedBio(void)
+{
+    if (mServer.mCoalescing)
+    {
+        int       mtu = 0;
+        socklen_t length = sizeof(mtu);
+
+        // The path MTU is only known after connect(), fall back to the minimum IPv6 MTU.
+        if (getsockopt(mNet.fd, IPPROTO_IPV6, IPV6_MTU, &mtu, &length) == 0 && mtu > kSizeOfUdp6Header)
+        {
+            mWriteLimit = static_cast<uint16_t>(std::min(mtu - kSizeOfUdp6Header,
+                                                         static_cast<int>(kMaxSizeOfPacket)));
+        }
+
+        otbrLog(OTBR_LOG_INFO, "DTLS session[%d] coalescing records up to %u bytes.", mNet.fd, mWriteLimit);
+        mbedtls_ssl_set_bio(&mSsl, this, SendCoalesced, ReadMbedtls, NULL);
+    }
+    else
+    {
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+    }
+}
+
+int MbedtlsSession::SendCoalesced(const unsigned char *aBuffer, size_t aLength)
+{
+    int ret = static_cast<int>(aLength);
+
+    // Handshake flights are paced by mbedTLS retransmission timers, send them immediately.
+    if (mState != kStateReady || aLength > mWriteLimit)
+    {
+        Flush();
+        ExitNow(ret = mbedtls_net_send(&mNet, aBuffer, aLength));
+    }
+
+    if (mWriteLength + aLength > mWriteLimit)
+    {
+        Flush();
+    }
+
+    if (mWriteBuffer == NULL)
+    {
+        mWriteBuffer = mServer.AllocateBuffer();
+    }
+
+    memcpy(mWriteBuffer + mWriteLength, aBuffer, aLength);
+    mWriteLength += static_cast<uint16_t>(aLength);
+
+exit:
+    return ret;
+}
+
+void MbedtlsSession::Flush(void)
+{
+    int ret;
+
+    VerifyOrExit(mWriteLength > 0);
+
+    ret = mbedtls_net_send(&mNet, mWriteBuffer, mWriteLength);
+
+    if (ret != mWriteLength)
+    {
+        otbrLog(OTBR_LOG_WARNING, "DTLS session[%d] dropped %u coalesced bytes: -0x%04x!", mNet.fd, mWriteLength,
+                ret < 0 ? -ret : 0);
+    }
+
+    mWriteLength = 0;
+    mServer.FreeBuffer(mWriteBuffer);
+    mWriteBuffer = NULL;
+
+exit:
+    return;
+}
+
+size_t MbedtlsSession::GetMemoryUsage(void) const
+{
+    size_t usage = sizeof(*this);
+
+    if (mSsl.in_buf != NULL)
+    {
+        usage += MBEDTLS_SSL_BUFFER_LEN;
+    }
+
+    if (mSsl.out_buf != NULL)
+    {
+        usage += MBEDTLS_SSL_BUFFER_LEN;
+    }
+
+    if (mSsl.handshake != NULL)
+    {
+        usage += sizeof(mbedtls_ssl_handshake_params);
+    }
+
+    if (mSsl.transform != NULL)
+    {
+        usage += sizeof(mbedtls_ssl_transform);
+    }
+
+    if (mSsl.transform_negotiate != NULL && mSsl.transform_negotiate != mSsl.transform)
+    {
+        usage += sizeof(mbedtls_ssl_transform);
+    }
+
+    if (mSsl.session != NULL)
+    {
+        usage += sizeof(mbedtls_ssl_session);
+    }
+
+    if (mSsl.session_negotiate != NULL && mSsl.session_negotiate != mSsl.session)
+    {
+        usage += sizeof(mbedtls_ssl_session);
+    }
+
+    if (mWriteBuffer != NULL)
+    {
+        usage += kMaxSizeOfPacket;
+    }
+
+    return usage;
+}
+
 int MbedtlsSession::Handshake(void)
 {
     int ret = 0;
@@ -405,6 +617,8 @@ int MbedtlsSession::Handshake(void)
 
     otbrLog(OTBR_LOG_INFO, "DTLS handshaking...");
 
+    // The configuration is shared by all sessions, the keys are exported to the session handshaking.
+    mbedtls_ssl_conf_export_keys_cb(&mServer.mConf, MbedtlsSession::ExportKeys, this);
     SuccessOrExit(ret = mbedtls_ssl_handshake(&mSsl));
 
     otbrLog(OTBR_LOG_INFO, "DTLS session ready.");
@@ -458,7 +672,11 @@ void MbedtlsServer::UpdateFdSet(fd_set &aReadFdSet, fd_set &aWriteFdSet, fd_set
         {
             int fd = session->GetFd();
 
-            otbrLog(OTBR_LOG_INFO, "DTLS session[%d] alive.", fd);
+            // Records written since the last poll are complete once the mainloop is about to block.
+            session->Flush();
+
+            otbrLog(OTBR_LOG_INFO, "DTLS session[%d] alive, using %u bytes.", fd,
+                    static_cast<unsigned>(session->GetMemoryUsage()));
             FD_SET(fd, &aReadFdSet);
 
             if (aMaxFd < fd)
@@ -554,6 +772,15 @@ void MbedtlsServer::ProcessServer(const fd_set &aReadFdSet, const fd_set &aWrite
     VerifyOrExit(memcmp(dst.sin6_addr.s6_addr, in6addr_any.s6_addr, sizeof(dst.sin6_addr)) != 0,
                  errno = EDESTADDRREQ);
 
+    if (mMemoryBudget != 0 && GetMemoryUsage() + GetNewSessionMemoryUsage() > mMemoryBudget)
+    {
+        otbrLog(OTBR_LOG_WARNING, "DTLS memory budget of %u bytes exhausted, dropping new session!",
+                static_cast<unsigned>(mMemoryBudget));
+        // Consume the peeked datagram.
+        recv(mSocket, packet, sizeof(packet), 0);
+        ExitNow(error = OTBR_ERROR_NONE);
+    }
+
     // TODO Should check if this client has an existing session.
     {
         mbedtls_net_context net = {
@@ -565,8 +792,10 @@ void MbedtlsServer::ProcessServer(const fd_set &aReadFdSet, const fd_set &aWrite
         VerifyOrExit(session->Init() == OTBR_ERROR_NONE, delete session);
 
         mSessions.push_back(session);
-        mbedtls_ssl_conf_export_keys_cb(&mConf, MbedtlsSession::ExportKeys, session);
         session->Process();
+
+        otbrLog(OTBR_LOG_INFO, "DTLS sessions: %u, using %u bytes.", static_cast<unsigned>(mSessions.size()),
+                static_cast<unsigned>(GetMemoryUsage()));
     }
 
     error = OTBR_ERROR_NONE;
@@ -590,6 +819,68 @@ exit:
     (void)aErrorFdSet;
 }
 
+void MbedtlsServer::ProcessListener(const fd_set &aReadFdSet)
+{
+    otbrError           error = OTBR_ERROR_ERRNO;
+    int                 one = 1;
+    sockaddr_in6        src;
+    sockaddr_in6        dst;
+    socklen_t           length;
+    mbedtls_net_context net = {
+        -1
+    };
+
+    VerifyOrExit(mSocket >= 0 && FD_ISSET(mSocket, &aReadFdSet), error = OTBR_ERROR_NONE);
+
+    length = sizeof(src);
+    VerifyOrExit((net.fd = accept(mSocket, reinterpret_cast<struct sockaddr *>(&src), &length)) != -1);
+
+    if (mMemoryBudget != 0 && GetMemoryUsage() + GetNewSessionMemoryUsage() > mMemoryBudget)
+    {
+        otbrLog(OTBR_LOG_WARNING, "DTLS memory budget of %u bytes exhausted, dropping new connection!",
+                static_cast<unsigned>(mMemoryBudget));
+        ExitNow(error = OTBR_ERROR_NONE);
+    }
+
+    // Requests are small and latency bound, send each without waiting for more.
+    SuccessOrExit(setsockopt(net.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one)));
+    length = sizeof(dst);
+    SuccessOrExit(getsockname(net.fd, reinterpret_cast<struct sockaddr *>(&dst), &length));
+    SuccessOrExit(mbedtls_net_set_nonblock(&net));
+
+    {
+        MbedtlsSession *session = new MbedtlsSession(*this, net, src, dst);
+
+        // The session owns the connection from now on.
+        net.fd = -1;
+
+        if (session->Init() != OTBR_ERROR_NONE)
+        {
+            delete session;
+            ExitNow(error = OTBR_ERROR_DTLS);
+        }
+
+        mSessions.push_back(session);
+        session->Process();
+
+        otbrLog(OTBR_LOG_INFO, "TLS sessions: %u, using %u bytes.", static_cast<unsigned>(mSessions.size()),
+                static_cast<unsigned>(GetMemoryUsage()));
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "TLS failed to accept connection: %s.", otbrErrorString(error));
+    }
+
+    if (net.fd != -1)
+    {
+        mbedtls_net_free(&net);
+    }
+}
+
 void MbedtlsServer::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet)
 {
     for (SessionSet::iterator it = mSessions.begin();
@@ -606,7 +897,14 @@ void MbedtlsServer::Process(const fd_set &aReadFdSet, const fd_set &aWriteFdSet,
         }
     }
 
-    ProcessServer(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    if (mTransport == kTransportStream)
+    {
+        ProcessListener(aReadFdSet);
+    }
+    else
+    {
+        ProcessServer(aReadFdSet, aWriteFdSet, aErrorFdSet);
+    }
 
     (void)aErrorFdSet;
 }
@@ -623,6 +921,8 @@ otbrError MbedtlsServer::SetPSK(const uint8_t *aPSK, uint8_t aLength)
 
     memcpy(mPSK, aPSK, aLength);
     mPSKLength = aLength;
+    // Sessions established with a previous PSK must not be resumed.
+    mSessionCache.SetPSK(aPSK, aLength);
     ret = OTBR_ERROR_NONE;
 
 exit:
@@ -640,16 +940,99 @@ MbedtlsServer::~MbedtlsServer(void)
         it = mSessions.erase(it);
     }
 
+    for (BufferList::iterator buffer = mFreeBuffers.begin(); buffer != mFreeBuffers.end(); ++buffer)
+    {
+        delete[] *buffer;
+    }
+
     close(mSocket);
     mbedtls_ssl_config_free(&mConf);
     mbedtls_ssl_cookie_free(&mCookie);
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_free(&mCache);
-#endif
     mbedtls_ctr_drbg_free(&mCtrDrbg);
     mbedtls_entropy_free(&mEntropy);
 }
 
+size_t MbedtlsServer::GetMemoryUsage(void) const
+{
+    size_t usage = mFreeBuffers.size() * kMaxSizeOfPacket;
+
+    for (SessionSet::const_iterator it = mSessions.begin(); it != mSessions.end(); ++it)
+    {
+        usage += (*it)->GetMemoryUsage();
+    }
+
+    return usage;
+}
+
+uint8_t *MbedtlsServer::AllocateBuffer(void)
+{
+    uint8_t *buffer;
+
+    if (mFreeBuffers.empty())
+    {
+        buffer = new uint8_t[kMaxSizeOfPacket];
+    }
+    else
+    {
+        buffer = mFreeBuffers.back();
+        mFreeBuffers.pop_back();
+    }
+
+    return buffer;
+}
+
+void MbedtlsServer::FreeBuffer(uint8_t *aBuffer)
+{
+    if (mFreeBuffers.size() < kMaxFreeBuffers)
+    {
+        mFreeBuffers.push_back(aBuffer);
+    }
+    else
+    {
+        delete[] aBuffer;
+    }
+}
+
+int MbedtlsServer::GetCachedSession(void *aContext, mbedtls_ssl_session *aSession)
+{
+    MbedtlsServer             *server = static_cast<MbedtlsServer *>(aContext);
+    const SessionCache::Entry *entry = server->mSessionCache.Find(aSession->id,
+                                                                  static_cast<uint8_t>(aSession->id_len));
+    int                        ret = 1;
+
+    VerifyOrExit(entry != NULL);
+    VerifyOrExit(entry->mCiphersuite == aSession->ciphersuite && entry->mCompression == aSession->compression);
+
+    memcpy(aSession->master, entry->mMaster, sizeof(aSession->master));
+    otbrLog(OTBR_LOG_INFO, "DTLS session resumed from cache.");
+    ret = 0;
+
+exit:
+    return ret;
+}
+
+int MbedtlsServer::SetCachedSession(void *aContext, const mbedtls_ssl_session *aSession)
+{
+    MbedtlsServer      *server = static_cast<MbedtlsServer *>(aContext);
+    SessionCache::Entry entry;
+    int                 ret = 1;
+
+    VerifyOrExit(aSession->id_len <= sizeof(entry.mId));
+
+    memset(&entry, 0, sizeof(entry));
+    entry.mCiphersuite = aSession->ciphersuite;
+    entry.mCompression = aSession->compression;
+    entry.mIdLength = static_cast<uint8_t>(aSession->id_len);
+    memcpy(entry.mId, aSession->id, aSession->id_len);
+    memcpy(entry.mMaster, aSession->master, sizeof(entry.mMaster));
+
+    SuccessOrExit(server->mSessionCache.Store(entry));
+    ret = 0;
+
+exit:
+    return ret;
+}
+
 otbrError MbedtlsServer::SetSeed(const uint8_t *aSeed, uint16_t aLength)
 {
     assert(aSeed && aLength > 0);
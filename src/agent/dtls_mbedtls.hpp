@@ -63,14 +63,11 @@ extern "C" {
 #include <mbedtls/debug.h>
 #include <mbedtls/timing.h>
 
-#if defined(MBEDTLS_SSL_CACHE_C)
-#include <mbedtls/ssl_cache.h>
-#endif
-
 } // extern "C"
 
 #include "common/types.hpp"
 #include "dtls.hpp"
+#include "dtls_session_cache.hpp"
 
 namespace ot {
 
@@ -93,6 +90,8 @@ enum
 {
     kMaxSizeOfPacket  = 1500, ///< Max size of packet in bytes.
     kMaxSizeOfControl = 1500, ///< Max size of control message in bytes.
+    kMinIp6Mtu        = 1280, ///< Minimum IPv6 link MTU in bytes.
+    kSizeOfUdp6Header = 48,   ///< Size of IPv6 header and UDP header in bytes.
 };
 
 /**
@@ -108,7 +107,8 @@ public:
      * The constructor to initialize a DTLS session.
      *
      * @param[in]   aServer     A reference to the DTLS server.
-     * @param[in]   aNet        A reference to the mbedtls_net_context.
+     * @param[in]   aNet        A reference to the mbedtls_net_context, of the listening socket of the server or of
+     *                          a socket already connected to the peer.
      * @param[in]   aRemoteSock A reference to the remote sockaddr of this session.
      * @param[in]   aLocalSock  A reference to the local sockaddr of this session.
      *
@@ -162,6 +162,14 @@ public:
      */
     const uint8_t *GetKek(void) { return mKek; }
 
+    /**
+     * This method returns the address of the peer.
+     *
+     * @returns A reference to the socket address of the peer.
+     *
+     */
+    const sockaddr_in6 &GetPeerAddress(void) const { return mRemoteSock; }
+
     /**
      * This method performs the session processing.
      *
@@ -174,6 +182,20 @@ public:
      */
     void Close(void);
 
+    /**
+     * This method sends out all records gathered by record coalescing.
+     *
+     */
+    void Flush(void);
+
+    /**
+     * This method returns the memory held by this session, including mbedTLS buffers and contexts.
+     *
+     * @returns Memory usage in bytes.
+     *
+     */
+    size_t GetMemoryUsage(void) const;
+
 private:
     enum
     {
@@ -191,6 +213,13 @@ private:
         return static_cast<MbedtlsSession *>(aContext)->SendMbedtls(aBuffer, aLength);
     }
     int SendMbedtls(const unsigned char *aBuffer, size_t aLength);
+    void SetConnectedBio(void);
+
+    static int SendCoalesced(void *aContext, const unsigned char *aBuffer, size_t aLength)
+    {
+        return static_cast<MbedtlsSession *>(aContext)->SendCoalesced(aBuffer, aLength);
+    }
+    int SendCoalesced(const unsigned char *aBuffer, size_t aLength);
 
     static int ReadMbedtls(void *aContext, unsigned char *aBuffer, size_t aLength)
     {
@@ -210,6 +239,9 @@ private:
     MbedtlsServer               &mServer;
     unsigned long                mExpiration;
     uint8_t                      mKek[kKekSize];
+    uint8_t                     *mWriteBuffer;
+    uint16_t                     mWriteLength;
+    uint16_t                     mWriteLimit;
 };
 
 /**
@@ -227,13 +259,20 @@ public:
      * @param[in]   aPort               The listening port of this DTLS server.
      * @param[in]   aStateHandler       A pointer to the function to be called when an session's state changed.
      * @param[in]   aContext            A pointer to application-specific context.
+     * @param[in]   aTransport          The transport of this server.
      *
      */
-    MbedtlsServer(uint16_t aPort, StateHandler aStateHandler, void *aContext) :
+    MbedtlsServer(uint16_t aPort, StateHandler aStateHandler, void *aContext, Transport aTransport) :
         mSocket(-1),
         mPort(aPort),
+        mTransport(aTransport),
         mStateHandler(aStateHandler),
-        mContext(aContext) {}
+        mContext(aContext),
+        mPSKHandler(NULL),
+        mPSKContext(NULL),
+        mCoalescing(false),
+        mSessionCacheFile(NULL),
+        mMemoryBudget(0) {}
 
     ~MbedtlsServer(void);
 
@@ -283,6 +322,20 @@ public:
      */
     otbrError SetPSK(const uint8_t *aPSK, uint8_t aLength);
 
+    /**
+     * This method sets the handler to look up the PSK of each new session.
+     *
+     * @param[in]   aPSKHandler         A pointer to the function to look up the PSK, NULL to use the PSK of this
+     *                                  server for all sessions.
+     * @param[in]   aContext            A pointer to application-specific context.
+     *
+     */
+    void SetPSKHandler(PSKHandler aPSKHandler, void *aContext)
+    {
+        mPSKHandler = aPSKHandler;
+        mPSKContext = aContext;
+    }
+
     /**
      * This method updates the seed for random generator.
      *
@@ -295,34 +348,97 @@ public:
      */
     otbrError SetSeed(const uint8_t *aSeed, uint16_t aLength);
 
+    /**
+     * This method enables or disables record coalescing of sessions created by this server.
+     *
+     * @param[in]   aEnabled            Whether to enable record coalescing.
+     *
+     */
+    void SetCoalescing(bool aEnabled) { mCoalescing = aEnabled; }
+
+    /**
+     * This method sets the file to persist the session resumption cache in.
+     *
+     * @param[in]   aPath               Path of the cache file, NULL to keep cached sessions in memory only.
+     *
+     */
+    void SetSessionCacheFile(const char *aPath) { mSessionCacheFile = aPath; }
+
+    /**
+     * This method sets an already bound socket for the server to listen on.
+     *
+     * @param[in]   aSocket             The bound UDP socket.
+     *
+     */
+    void SetSocket(int aSocket) { mSocket = aSocket; }
+
+    /**
+     * This method returns the socket this server listens on.
+     *
+     * @returns The listening socket, -1 if not started.
+     *
+     */
+    int GetSocket(void) const { return mSocket; }
+
+    /**
+     * This method sets the memory budget of all sessions.
+     *
+     * @param[in]   aBudget             Memory budget in bytes, 0 for unlimited.
+     *
+     */
+    void SetMemoryBudget(size_t aBudget) { mMemoryBudget = aBudget; }
+
+    /**
+     * This method returns the memory held by all sessions and pooled buffers of this server.
+     *
+     * @returns Memory usage in bytes.
+     *
+     */
+    size_t GetMemoryUsage(void) const;
+
 private:
     typedef std::vector<MbedtlsSession *> SessionSet;
+    typedef std::vector<uint8_t *>        BufferList;
     enum
     {
-        kMaxSizeOfPSK = 32, ///< Max size of PSK in bytes.
+        kMaxSizeOfPSK   = 32, ///< Max size of PSK in bytes.
+        kMaxFreeBuffers = 8,  ///< Max number of idle buffers kept in pool.
+        kListenBacklog  = 4,  ///< Max number of pending TCP connections.
     };
 
     void HandleSessionState(Session &aSession, Session::State aState);
     void ProcessServer(const fd_set &aReadFdSet, const fd_set &aWriteFdSet, const fd_set &aErrorFdSet);
+    void ProcessListener(const fd_set &aReadFdSet);
     otbrError Bind(void);
+    uint8_t *AllocateBuffer(void);
+    void FreeBuffer(uint8_t *aBuffer);
+
+    static int GetCachedSession(void *aContext, mbedtls_ssl_session *aSession);
+    static int SetCachedSession(void *aContext, const mbedtls_ssl_session *aSession);
 
     SessionSet                mSessions;
     int                       mSocket;
     uint16_t                  mPort;
+    Transport                 mTransport;
     StateHandler              mStateHandler;
     void                     *mContext;
     uint8_t                   mSeed[MBEDTLS_CTR_DRBG_MAX_SEED_INPUT];
     uint16_t                  mSeedLength;
     uint8_t                   mPSK[kMaxSizeOfPSK];
     uint8_t                   mPSKLength;
+    PSKHandler                mPSKHandler;
+    void                     *mPSKContext;
+    bool                      mCoalescing;
+    const char               *mSessionCacheFile;
+    SessionCache              mSessionCache;
+    size_t                    mMemoryBudget;
+    BufferList                mFreeBuffers;
+    uint8_t                   mReadBuffer[kMaxSizeOfPacket];
 
     mbedtls_ssl_cookie_ctx    mCookie;
     mbedtls_entropy_context   mEntropy;
     mbedtls_ctr_drbg_context  mCtrDrbg;
     mbedtls_ssl_config        mConf;
-#if defined(MBEDTLS_SSL_CACHE_C)
-    mbedtls_ssl_cache_context mCache;
-#endif
 };
 
 /**
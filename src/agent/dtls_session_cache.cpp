@@ -0,0 +1,228 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the DTLS session resumption cache.
+ */
+
+#include "dtls_session_cache.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+extern "C" {
+
+#include <mbedtls/sha256.h>
+
+} // extern "C"
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Dtls {
+
+SessionCache::SessionCache(uint16_t aCapacity, uint32_t aTimeout) :
+    mHeader(NULL),
+    mEntries(NULL),
+    mCapacity(aCapacity),
+    mTimeout(aTimeout),
+    mHasFingerprint(false)
+{
+    memset(mFingerprint, 0, sizeof(mFingerprint));
+}
+
+SessionCache::~SessionCache(void)
+{
+    if (mHeader != NULL)
+    {
+        munmap(mHeader, GetSize());
+    }
+}
+
+otbrError SessionCache::Init(const char *aPath)
+{
+    otbrError   error = OTBR_ERROR_ERRNO;
+    int         fd = -1;
+    int         flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    struct stat st;
+    void       *memory;
+
+    VerifyOrExit(mHeader == NULL, errno = EALREADY);
+
+    if (aPath != NULL)
+    {
+        // Cached sessions carry master secrets, keep the file private, and never follow a link to another file.
+        VerifyOrExit((fd = open(aPath, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, S_IRUSR | S_IWUSR)) != -1);
+        SuccessOrExit(fstat(fd, &st));
+        VerifyOrExit(S_ISREG(st.st_mode) && st.st_uid == geteuid() && (st.st_mode & (S_IRWXG | S_IRWXO)) == 0,
+                     errno = EPERM);
+
+        if (static_cast<size_t>(st.st_size) != GetSize())
+        {
+            SuccessOrExit(ftruncate(fd, 0));
+            SuccessOrExit(ftruncate(fd, static_cast<off_t>(GetSize())));
+        }
+
+        flags = MAP_SHARED;
+    }
+
+    memory = mmap(NULL, GetSize(), PROT_READ | PROT_WRITE, flags, fd, 0);
+    VerifyOrExit(memory != MAP_FAILED);
+
+    mHeader = static_cast<Header *>(memory);
+    mEntries = reinterpret_cast<Entry *>(mHeader + 1);
+
+    if (mHeader->mMagic != kMagic || mHeader->mVersion != kVersion || mHeader->mSizeOfEntry != sizeof(Entry) ||
+        mHeader->mCapacity != mCapacity)
+    {
+        memset(mHeader, 0, GetSize());
+        mHeader->mMagic = kMagic;
+        mHeader->mVersion = kVersion;
+        mHeader->mSizeOfEntry = sizeof(Entry);
+        mHeader->mCapacity = mCapacity;
+    }
+
+    if (mHasFingerprint && memcmp(mHeader->mFingerprint, mFingerprint, sizeof(mFingerprint)))
+    {
+        Clear();
+        memcpy(mHeader->mFingerprint, mFingerprint, sizeof(mFingerprint));
+    }
+
+    otbrLog(OTBR_LOG_INFO, "DTLS session cache of %u sessions %s%s.", mCapacity,
+            aPath ? "persisted in " : "in memory", aPath ? aPath : "");
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    if (error)
+    {
+        otbrLog(OTBR_LOG_ERR, "DTLS session cache failed to initialize: %s!", strerror(errno));
+    }
+
+    return error;
+}
+
+void SessionCache::SetPSK(const uint8_t *aPSK, uint8_t aLength)
+{
+    uint8_t hash[32];
+
+    mbedtls_sha256(aPSK, aLength, hash, 0);
+    memcpy(mFingerprint, hash, sizeof(mFingerprint));
+    mHasFingerprint = true;
+
+    VerifyOrExit(mHeader != NULL);
+    VerifyOrExit(memcmp(mHeader->mFingerprint, mFingerprint, sizeof(mFingerprint)));
+
+    otbrLog(OTBR_LOG_INFO, "DTLS session cache dropped for PSK changed.");
+    Clear();
+    memcpy(mHeader->mFingerprint, mFingerprint, sizeof(mFingerprint));
+
+exit:
+    return;
+}
+
+const SessionCache::Entry *SessionCache::Find(const uint8_t *aId, uint8_t aIdLength) const
+{
+    const Entry *entry = NULL;
+    uint64_t     now = static_cast<uint64_t>(time(NULL));
+
+    VerifyOrExit(mEntries != NULL && aIdLength > 0 && aIdLength <= kMaxSizeOfId);
+
+    for (uint16_t i = 0; i < mCapacity; ++i)
+    {
+        if (mEntries[i].mExpiration > now && mEntries[i].mIdLength == aIdLength &&
+            !memcmp(mEntries[i].mId, aId, aIdLength))
+        {
+            ExitNow(entry = &mEntries[i]);
+        }
+    }
+
+exit:
+    return entry;
+}
+
+otbrError SessionCache::Store(const Entry &aEntry)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    Entry    *slot = NULL;
+
+    VerifyOrExit(mEntries != NULL && aEntry.mIdLength > 0 && aEntry.mIdLength <= kMaxSizeOfId, errno = EINVAL);
+
+    // Reuse the entry of the same session, otherwise evict the one expiring first. Empty entries never expire.
+    for (uint16_t i = 0; i < mCapacity; ++i)
+    {
+        Entry &entry = mEntries[i];
+
+        if (entry.mIdLength == aEntry.mIdLength && !memcmp(entry.mId, aEntry.mId, aEntry.mIdLength))
+        {
+            slot = &entry;
+            break;
+        }
+
+        if (slot == NULL || entry.mExpiration < slot->mExpiration)
+        {
+            slot = &entry;
+        }
+    }
+
+    *slot = aEntry;
+    slot->mExpiration = static_cast<uint64_t>(time(NULL)) + mTimeout;
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void SessionCache::Clear(void)
+{
+    VerifyOrExit(mEntries != NULL);
+    memset(mEntries, 0, mCapacity * sizeof(Entry));
+
+exit:
+    return;
+}
+
+} // namespace Dtls
+
+} // namespace BorderRouter
+
+} // namespace ot
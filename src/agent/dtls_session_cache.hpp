@@ -0,0 +1,189 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for DTLS session resumption cache.
+ */
+
+#ifndef DTLS_SESSION_CACHE_HPP_
+#define DTLS_SESSION_CACHE_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Dtls {
+
+/**
+ * @addtogroup border-router-dtls
+ *
+ * @{
+ */
+
+/**
+ * This class implements a bounded cache of DTLS sessions for abbreviated handshakes.
+ *
+ * Entries are keyed by session ID and expire after a fixed lifetime. The cache is kept in an anonymous
+ * mapping, or in a file mapping when a path is given so that sessions survive restarts of the agent.
+ *
+ */
+class SessionCache
+{
+public:
+    enum
+    {
+        kMaxSizeOfId        = 32,    ///< Max size of session ID in bytes.
+        kSizeOfMaster       = 48,    ///< Size of master secret in bytes.
+        kSizeOfFingerprint  = 16,    ///< Size of PSK fingerprint in bytes.
+        kDefaultCapacity    = 32,    ///< Default number of cached sessions.
+        kDefaultTimeout     = 86400, ///< Default session lifetime in seconds.
+    };
+
+    /**
+     * This structure represents a cached session.
+     *
+     */
+    struct Entry
+    {
+        uint64_t mExpiration;            ///< Expiration in seconds since epoch, zero for empty entry.
+        int32_t  mCiphersuite;           ///< Negotiated ciphersuite.
+        int32_t  mCompression;           ///< Negotiated compression.
+        uint8_t  mIdLength;              ///< Length of session ID.
+        uint8_t  mId[kMaxSizeOfId];      ///< Session ID.
+        uint8_t  mMaster[kSizeOfMaster]; ///< Master secret.
+    };
+
+    /**
+     * The constructor to initialize a session cache.
+     *
+     * @param[in]   aCapacity   Max number of cached sessions.
+     * @param[in]   aTimeout    Lifetime of a cached session in seconds.
+     *
+     */
+    SessionCache(uint16_t aCapacity = kDefaultCapacity, uint32_t aTimeout = kDefaultTimeout);
+
+    ~SessionCache(void);
+
+    /**
+     * This method initializes the storage of this cache.
+     *
+     * Sessions persisted in @p aPath are reused if the file was written with the same layout and capacity. The
+     * file must be a regular file, not a symbolic link, owned by the effective user and private to it.
+     *
+     * @param[in]   aPath               Path of the file to persist sessions, NULL to keep them in memory only.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully initialized.
+     * @retval      OTBR_ERROR_ERRNO    Failed to initialize for system error, errno is EPERM if the file is not
+     *                                  private to the effective user.
+     *
+     */
+    otbrError Init(const char *aPath);
+
+    /**
+     * This method updates the PSK that cached sessions were established with.
+     *
+     * All cached sessions are dropped if the PSK differs from the one of the cached sessions.
+     *
+     * @param[in]   aPSK                A pointer to the PSK buffer.
+     * @param[in]   aLength             The length of the PSK.
+     *
+     */
+    void SetPSK(const uint8_t *aPSK, uint8_t aLength);
+
+    /**
+     * This method looks up a session.
+     *
+     * @param[in]   aId         A pointer to the session ID.
+     * @param[in]   aIdLength   The length of the session ID.
+     *
+     * @returns A pointer to the cached session, NULL if not found or expired.
+     *
+     */
+    const Entry *Find(const uint8_t *aId, uint8_t aIdLength) const;
+
+    /**
+     * This method stores a session, replacing the one of the same ID or the one expiring first.
+     *
+     * @param[in]   aEntry              The session to store, its expiration is ignored.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully stored.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the cache is not initialized or the session ID is invalid.
+     *
+     */
+    otbrError Store(const Entry &aEntry);
+
+    /**
+     * This method drops all cached sessions.
+     *
+     */
+    void Clear(void);
+
+private:
+    struct Header
+    {
+        uint32_t mMagic;
+        uint16_t mVersion;
+        uint16_t mSizeOfEntry;
+        uint16_t mCapacity;
+        uint8_t  mFingerprint[kSizeOfFingerprint];
+        uint16_t mReserved[3]; ///< Keeps entries following the header 8-byte aligned.
+    };
+
+    enum
+    {
+        kMagic   = 0x6f746273, ///< "otbs"
+        kVersion = 1,
+    };
+
+    size_t GetSize(void) const { return sizeof(Header) + mCapacity * sizeof(Entry); }
+
+    Header        *mHeader;
+    Entry         *mEntries;
+    uint16_t       mCapacity;
+    uint32_t       mTimeout;
+    bool           mHasFingerprint;
+    uint8_t        mFingerprint[kSizeOfFingerprint];
+};
+
+/**
+ * @}
+ */
+
+} // namespace Dtls
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // DTLS_SESSION_CACHE_HPP_
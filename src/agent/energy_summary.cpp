@@ -0,0 +1,164 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements summarizing energy reports of an energy scan.
+ */
+
+#include "energy_summary.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/tlv_view.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+enum
+{
+    kChannelPage0 = 0,    ///< Channel page of 2.4 GHz O-QPSK.
+    kMinEnergy    = -128, ///< Energy of channels never measured.
+};
+
+EnergySummary::EnergySummary(void)
+{
+    Reset();
+}
+
+void EnergySummary::Reset(void)
+{
+    memset(mEnergy, kMinEnergy, sizeof(mEnergy));
+    mMeasuredMask = 0;
+    mUpdatedMask = 0;
+}
+
+otbrError EnergySummary::Merge(const uint8_t *aPayload, uint16_t aLength)
+{
+    otbrError      error = OTBR_ERROR_ERRNO;
+    const uint8_t *energies = NULL;
+    uint16_t       numEnergies = 0;
+    const uint8_t *entries = NULL;
+    uint16_t       entriesLength = 0;
+    uint32_t       mask = 0;
+    uint8_t        channels[kNumChannels];
+    uint8_t        numChannels = 0;
+    TlvView        tlvs;
+
+    SuccessOrExit(tlvs.Init(aPayload, aLength));
+
+    entries = tlvs.GetValue(Meshcop::kChannelMask, entriesLength);
+    energies = tlvs.GetValue(Meshcop::kEnergyList, numEnergies);
+    VerifyOrExit(entries != NULL && energies != NULL, errno = EBADMSG);
+
+    // Entries of channel page, mask length and mask, channels ordered from the most significant bit.
+    for (const uint8_t *entry = entries; entry < entries + entriesLength;)
+    {
+        VerifyOrExit(entries + entriesLength - entry >= 2 && entries + entriesLength - entry - 2 >= entry[1],
+                     errno = EBADMSG);
+
+        for (uint8_t channel = 0; entry[0] == kChannelPage0 && channel < entry[1] * 8 && channel < kNumChannels;
+             ++channel)
+        {
+            if (entry[2 + channel / 8] & (0x80 >> (channel % 8)))
+            {
+                mask |= (1UL << channel);
+            }
+        }
+
+        entry += 2 + entry[1];
+    }
+
+    // A channel listed in several entries is measured once.
+    for (uint8_t channel = 0; channel < kNumChannels; ++channel)
+    {
+        if (mask & (1UL << channel))
+        {
+            channels[numChannels++] = channel;
+        }
+    }
+
+    // Measurements of all channels are repeated for each scan of the report.
+    for (uint16_t i = 0; numChannels > 0 && i < numEnergies; ++i)
+    {
+        uint8_t channel = channels[i % numChannels];
+        int8_t  energy = static_cast<int8_t>(energies[i]);
+
+        if (!(mMeasuredMask & (1UL << channel)) || energy > mEnergy[channel])
+        {
+            mEnergy[channel] = energy;
+            mMeasuredMask |= (1UL << channel);
+            mUpdatedMask |= (1UL << channel);
+        }
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void EnergySummary::Flush(std::vector<uint8_t> &aPayload)
+{
+    uint8_t numChannels = 0;
+
+    aPayload.clear();
+    VerifyOrExit(mUpdatedMask != 0);
+
+    aPayload.push_back(Meshcop::kChannelMask);
+    aPayload.push_back(6);
+    aPayload.push_back(kChannelPage0);
+    aPayload.push_back(4);
+    aPayload.resize(aPayload.size() + kNumChannels / 8);
+
+    aPayload.push_back(Meshcop::kEnergyList);
+    aPayload.push_back(0);
+
+    for (uint8_t channel = 0; channel < kNumChannels; ++channel)
+    {
+        if (mUpdatedMask & (1UL << channel))
+        {
+            aPayload[4 + channel / 8] |= (0x80 >> (channel % 8));
+            aPayload.push_back(static_cast<uint8_t>(mEnergy[channel]));
+            ++numChannels;
+        }
+    }
+
+    aPayload[9] = numChannels;
+    mUpdatedMask = 0;
+
+exit:
+    return;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
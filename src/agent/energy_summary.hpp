@@ -0,0 +1,131 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for summarizing energy reports of an energy scan.
+ */
+
+#ifndef ENERGY_SUMMARY_HPP_
+#define ENERGY_SUMMARY_HPP_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a per-channel summary of MGMT_ED_REPORT answers.
+ *
+ * Reports of many devices are merged into the highest energy measured on each channel, and the channels
+ * updated since the last flush are encoded as a single report of one measurement per channel.
+ *
+ */
+class EnergySummary
+{
+public:
+    enum
+    {
+        kNumChannels = 32, ///< Number of channels of channel page 0.
+    };
+
+    EnergySummary(void);
+
+    /**
+     * This method drops the summary, e.g. for a new energy scan.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method merges an energy report.
+     *
+     * Only channels of channel page 0 are summarized.
+     *
+     * @param[in]   aPayload            A pointer to the payload of MGMT_ED_REPORT.ans.
+     * @param[in]   aLength             The length of the payload.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully merged.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the report is malformed.
+     *
+     */
+    otbrError Merge(const uint8_t *aPayload, uint16_t aLength);
+
+    /**
+     * This method indicates whether any channel was updated since the last flush.
+     *
+     * @retval  true    Some channel was updated.
+     * @retval  false   No channel was updated.
+     *
+     */
+    bool IsUpdated(void) const { return mUpdatedMask != 0; }
+
+    /**
+     * This method encodes the channels updated since the last flush as the payload of MGMT_ED_REPORT.ans.
+     *
+     * @param[out]  aPayload    A reference to receive the payload.
+     *
+     */
+    void Flush(std::vector<uint8_t> &aPayload);
+
+    /**
+     * This method returns the highest energy measured on a channel.
+     *
+     * @param[in]   aChannel    The channel.
+     *
+     * @returns The energy in dBm, or -128 if never measured.
+     *
+     */
+    int8_t GetEnergy(uint8_t aChannel) const { return mEnergy[aChannel]; }
+
+private:
+    int8_t   mEnergy[kNumChannels];
+    uint32_t mMeasuredMask;
+    uint32_t mUpdatedMask;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // ENERGY_SUMMARY_HPP_
@@ -0,0 +1,161 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the table of requests forwarded on behalf of commissioners.
+ */
+
+#include "forward_table.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/time.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+ForwardTable::ForwardTable(uint16_t aCapacity, uint32_t aTimeout) :
+    mEntries(aCapacity),
+    mTimeout(aTimeout)
+{
+    mFreeEntries.reserve(aCapacity);
+
+    for (uint16_t i = aCapacity; i > 0; --i)
+    {
+        Entry &entry = mEntries[i - 1];
+
+        memset(&entry, 0, sizeof(entry));
+        mFreeEntries.push_back(i - 1);
+    }
+}
+
+otbrError ForwardTable::Add(Dtls::Session *aSession, const char *aPath, const uint8_t *aToken,
+                            uint8_t aTokenLength, uint8_t *aForwardToken)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    uint16_t  index;
+
+    VerifyOrExit(aTokenLength <= kMaxTokenLength, errno = EINVAL);
+
+    if (mFreeEntries.empty())
+    {
+        Reclaim();
+    }
+
+    VerifyOrExit(!mFreeEntries.empty(), errno = ENOBUFS);
+
+    index = mFreeEntries.back();
+    mFreeEntries.pop_back();
+
+    {
+        Entry &entry = mEntries[index];
+
+        entry.mSession = aSession;
+        entry.mPath = aPath;
+        entry.mExpiration = GetNow() + mTimeout;
+        entry.mInUse = true;
+        entry.mTokenLength = aTokenLength;
+        memcpy(entry.mToken, aToken, aTokenLength);
+
+        aForwardToken[0] = static_cast<uint8_t>(index >> 8);
+        aForwardToken[1] = static_cast<uint8_t>(index & 0xff);
+        aForwardToken[2] = static_cast<uint8_t>(entry.mGeneration >> 8);
+        aForwardToken[3] = static_cast<uint8_t>(entry.mGeneration & 0xff);
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+otbrError ForwardTable::Remove(const uint8_t *aForwardToken, uint8_t aForwardTokenLength, Entry &aEntry)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+    uint16_t  index;
+    uint16_t  generation;
+
+    VerifyOrExit(aForwardTokenLength == kSizeOfToken, errno = ENOENT);
+
+    index = static_cast<uint16_t>((aForwardToken[0] << 8) | aForwardToken[1]);
+    generation = static_cast<uint16_t>((aForwardToken[2] << 8) | aForwardToken[3]);
+
+    VerifyOrExit(index < mEntries.size() && mEntries[index].mInUse && mEntries[index].mGeneration == generation,
+                 errno = ENOENT);
+
+    aEntry = mEntries[index];
+    Free(index);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void ForwardTable::Remove(const Dtls::Session *aSession)
+{
+    for (uint16_t i = 0; i < mEntries.size(); ++i)
+    {
+        if (mEntries[i].mInUse && mEntries[i].mSession == aSession)
+        {
+            Free(i);
+        }
+    }
+}
+
+void ForwardTable::Free(uint16_t aIndex)
+{
+    Entry &entry = mEntries[aIndex];
+
+    entry.mInUse = false;
+    entry.mSession = NULL;
+    ++entry.mGeneration;
+    mFreeEntries.push_back(aIndex);
+}
+
+void ForwardTable::Reclaim(void)
+{
+    unsigned long now = GetNow();
+
+    for (uint16_t i = 0; i < mEntries.size(); ++i)
+    {
+        if (mEntries[i].mInUse && static_cast<long>(mEntries[i].mExpiration - now) <= 0)
+        {
+            otbrLog(OTBR_LOG_INFO, "Forwarded request %u timed out.", i);
+            Free(i);
+        }
+    }
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,160 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the table of requests forwarded on behalf of commissioners.
+ */
+
+#ifndef FORWARD_TABLE_HPP_
+#define FORWARD_TABLE_HPP_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "dtls.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a bounded table translating tokens of forwarded requests back to their origin.
+ *
+ * Each forwarded request is given a token of its own, which encodes the index of its entry, so that a
+ * response is routed to the originating session and token in constant time.
+ *
+ */
+class ForwardTable
+{
+public:
+    enum
+    {
+        kMaxTokenLength    = 8,     ///< Max length of a CoAP token.
+        kSizeOfToken       = 4,     ///< Length of tokens of forwarded requests.
+        kDefaultCapacity   = 32,    ///< Default number of outstanding forwarded requests.
+        kDefaultTimeout    = 93000, ///< Default lifetime of an entry in milliseconds, i.e. MAX_TRANSMIT_WAIT.
+    };
+
+    /**
+     * This structure represents a forwarded request.
+     *
+     */
+    struct Entry
+    {
+        Dtls::Session *mSession;                 ///< The originating session.
+        const char    *mPath;                    ///< The URI path of the request.
+        unsigned long  mExpiration;              ///< Expiration timestamp in milliseconds.
+        uint16_t       mGeneration;              ///< Incremented each time the entry is reused.
+        bool           mInUse;                   ///< Whether this entry is in use.
+        uint8_t        mTokenLength;             ///< Length of the original token.
+        uint8_t        mToken[kMaxTokenLength];  ///< The original token.
+    };
+
+    /**
+     * The constructor to initialize a forward table.
+     *
+     * @param[in]   aCapacity   Max number of outstanding forwarded requests.
+     * @param[in]   aTimeout    Lifetime of an entry in milliseconds.
+     *
+     */
+    ForwardTable(uint16_t aCapacity = kDefaultCapacity, uint32_t aTimeout = kDefaultTimeout);
+
+    /**
+     * This method adds a forwarded request.
+     *
+     * Expired entries are reclaimed if the table is full.
+     *
+     * @param[in]   aSession            The originating session.
+     * @param[in]   aPath               The URI path of the request, which must outlive the entry.
+     * @param[in]   aToken              A pointer to the original token.
+     * @param[in]   aTokenLength        The length of the original token.
+     * @param[out]  aForwardToken       A pointer to a buffer of kSizeOfToken bytes to receive the token to forward with.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully added.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the table is full or the token is too long.
+     *
+     */
+    otbrError Add(Dtls::Session *aSession, const char *aPath, const uint8_t *aToken, uint8_t aTokenLength,
+                  uint8_t *aForwardToken);
+
+    /**
+     * This method removes the forwarded request of a token.
+     *
+     * @param[in]   aForwardToken       A pointer to the token of the forwarded request.
+     * @param[in]   aForwardTokenLength The length of the token of the forwarded request.
+     * @param[out]  aEntry              A reference to receive the removed entry.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully removed.
+     * @retval      OTBR_ERROR_ERRNO    Failed for no such request.
+     *
+     */
+    otbrError Remove(const uint8_t *aForwardToken, uint8_t aForwardTokenLength, Entry &aEntry);
+
+    /**
+     * This method removes all forwarded requests of a session.
+     *
+     * @param[in]   aSession            The session.
+     *
+     */
+    void Remove(const Dtls::Session *aSession);
+
+    /**
+     * This method returns the number of outstanding forwarded requests.
+     *
+     * @returns The number of outstanding forwarded requests.
+     *
+     */
+    uint16_t GetSize(void) const { return static_cast<uint16_t>(mEntries.size() - mFreeEntries.size()); }
+
+private:
+    void Free(uint16_t aIndex);
+    void Reclaim(void);
+
+    std::vector<Entry>    mEntries;
+    std::vector<uint16_t> mFreeEntries;
+    uint32_t              mTimeout;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // FORWARD_TABLE_HPP_
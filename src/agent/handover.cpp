@@ -0,0 +1,242 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements handing over the border agent to a restarted otbr-agent.
+ */
+
+#include "handover.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "local_socket.hpp"
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+Handover::Handover(const char *aPath) :
+    mPath(aPath),
+    mSocket(-1),
+    mPeer(-1) {}
+
+Handover::~Handover(void)
+{
+    if (mPeer != -1)
+    {
+        // Closing the connection tells the successor this agent has exited.
+        close(mPeer);
+    }
+    else if (mSocket != -1)
+    {
+        unlink(mPath);
+    }
+
+    if (mSocket != -1)
+    {
+        close(mSocket);
+    }
+}
+
+int Handover::Acquire(void)
+{
+    int                fd = -1;
+    int                ret = -1;
+    uint8_t            byte = 0;
+    char               control[CMSG_SPACE(sizeof(int))];
+    struct timeval     timeout = {kAcquireTimeout, 0};
+    struct sockaddr_un addr;
+    struct msghdr      msghdr;
+    struct iovec       iov;
+
+    VerifyOrExit(strlen(mPath) < sizeof(addr.sun_path), errno = ENAMETOOLONG);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, mPath);
+
+    VerifyOrExit((fd = socket(AF_UNIX, SOCK_STREAM, 0)) != -1);
+    SuccessOrExit(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)));
+
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+        otbrLog(OTBR_LOG_INFO, "No running agent to take over.");
+        ExitNow(errno = 0);
+    }
+
+    VerifyOrExit(IsTrustedPeer(fd));
+
+    memset(&msghdr, 0, sizeof(msghdr));
+    iov.iov_base = &byte;
+    iov.iov_len = sizeof(byte);
+    msghdr.msg_iov = &iov;
+    msghdr.msg_iovlen = 1;
+    msghdr.msg_control = control;
+    msghdr.msg_controllen = sizeof(control);
+
+    VerifyOrExit(recvmsg(fd, &msghdr, 0) > 0);
+
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msghdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msghdr, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+        {
+            memcpy(&ret, CMSG_DATA(cmsg), sizeof(ret));
+            break;
+        }
+    }
+
+    VerifyOrExit(ret != -1, errno = EBADMSG);
+
+    // The running agent closes the connection when it has exited.
+    while (read(fd, &byte, sizeof(byte)) > 0)
+    {
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Took over DTLS socket from running agent.");
+
+exit:
+    if (ret == -1 && errno != 0)
+    {
+        otbrLog(OTBR_LOG_WARNING, "Failed to take over running agent: %s!", strerror(errno));
+    }
+
+    if (fd != -1)
+    {
+        close(fd);
+    }
+
+    return ret;
+}
+
+otbrError Handover::Listen(void)
+{
+    otbrError error = OTBR_ERROR_ERRNO;
+
+    VerifyOrExit((mSocket = ListenLocal(mPath, 1)) != -1);
+
+    otbrLog(OTBR_LOG_INFO, "Handover listening on %s.", mPath);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error)
+    {
+        otbrLog(OTBR_LOG_ERR, "Handover failed to listen on %s: %s!", mPath, strerror(errno));
+    }
+
+    return error;
+}
+
+void Handover::UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd)
+{
+    VerifyOrExit(mSocket != -1 && mPeer == -1);
+
+    FD_SET(mSocket, &aReadFdSet);
+
+    if (aMaxFd < mSocket)
+    {
+        aMaxFd = mSocket;
+    }
+
+exit:
+    return;
+}
+
+void Handover::Process(const fd_set &aReadFdSet)
+{
+    VerifyOrExit(mSocket != -1 && mPeer == -1 && FD_ISSET(mSocket, &aReadFdSet));
+
+    mPeer = accept(mSocket, NULL, NULL);
+    VerifyOrExit(mPeer != -1, otbrLog(OTBR_LOG_WARNING, "Handover failed to accept: %s!", strerror(errno)));
+
+    if (!IsTrustedPeer(mPeer))
+    {
+        otbrLog(OTBR_LOG_WARNING, "Handover refused untrusted peer: %s!", strerror(errno));
+        close(mPeer);
+        ExitNow(mPeer = -1);
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Handing over to successor...");
+
+exit:
+    return;
+}
+
+otbrError Handover::Release(int aSocket)
+{
+    otbrError       error = OTBR_ERROR_ERRNO;
+    uint8_t         byte = 0;
+    char            control[CMSG_SPACE(sizeof(int))];
+    struct msghdr   msghdr;
+    struct iovec    iov;
+    struct cmsghdr *cmsg;
+
+    VerifyOrExit(mPeer != -1 && aSocket != -1, errno = EINVAL);
+
+    memset(&msghdr, 0, sizeof(msghdr));
+    memset(control, 0, sizeof(control));
+    iov.iov_base = &byte;
+    iov.iov_len = sizeof(byte);
+    msghdr.msg_iov = &iov;
+    msghdr.msg_iovlen = 1;
+    msghdr.msg_control = control;
+    msghdr.msg_controllen = sizeof(control);
+
+    cmsg = CMSG_FIRSTHDR(&msghdr);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(aSocket));
+    memcpy(CMSG_DATA(cmsg), &aSocket, sizeof(aSocket));
+
+    VerifyOrExit(sendmsg(mPeer, &msghdr, 0) > 0);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    if (error)
+    {
+        otbrLog(OTBR_LOG_ERR, "Handover failed to pass DTLS socket: %s!", strerror(errno));
+
+        if (mPeer != -1)
+        {
+            close(mPeer);
+            mPeer = -1;
+        }
+    }
+
+    return error;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
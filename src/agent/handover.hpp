@@ -0,0 +1,146 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for handing over the border agent to a restarted otbr-agent.
+ */
+
+#ifndef HANDOVER_HPP_
+#define HANDOVER_HPP_
+
+#include <sys/select.h>
+
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * This class implements hot handover between a running otbr-agent and its successor.
+ *
+ * The running agent listens on a Unix socket. A newly started agent connects to it and receives the bound
+ * DTLS server socket, so datagrams queued during the restart are not lost. The new agent waits until the
+ * previous one has exited before starting its own services. Both ends only talk to peers running as root or
+ * the same user, and the socket is only accessible to its owner.
+ *
+ */
+class Handover
+{
+public:
+    /**
+     * The constructor to initialize a handover.
+     *
+     * @param[in]   aPath       Path of the Unix socket for handover.
+     *
+     */
+    Handover(const char *aPath);
+
+    ~Handover(void);
+
+    /**
+     * This method takes over the DTLS server socket from a running agent, if any.
+     *
+     * This method blocks until the running agent has exited.
+     *
+     * @returns The received socket, -1 if there is no running agent or the handover failed.
+     *
+     */
+    int Acquire(void);
+
+    /**
+     * This method starts listening for a successor.
+     *
+     * The directory containing the socket must be owned by root or the effective user and must not be writable by
+     * group or others.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully started listening.
+     * @retval  OTBR_ERROR_ERRNO    Failed to listen for system error.
+     *
+     */
+    otbrError Listen(void);
+
+    /**
+     * This method updates the fd_set for mainloop.
+     *
+     * @param[inout]  aReadFdSet   A reference to read file descriptors.
+     * @param[inout]  aMaxFd       A reference to the max file descriptor.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd);
+
+    /**
+     * This method accepts a successor if it is connecting.
+     *
+     * A successor not running as root or the effective user is disconnected.
+     *
+     * @param[in]   aReadFdSet   A reference to read file descriptors.
+     *
+     */
+    void Process(const fd_set &aReadFdSet);
+
+    /**
+     * This method indicates whether a successor is waiting for handover.
+     *
+     * @retval  true    A successor is waiting, the mainloop should call Release() and exit.
+     * @retval  false   No successor is waiting.
+     *
+     */
+    bool IsRequested(void) const { return mPeer != -1; }
+
+    /**
+     * This method passes the DTLS server socket to the successor.
+     *
+     * The successor starts once this process closes the handover connection on exit. On failure the successor is
+     * disconnected and this process should keep serving.
+     *
+     * @param[in]   aSocket             The DTLS server socket.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully passed the socket.
+     * @retval  OTBR_ERROR_ERRNO    Failed to pass the socket for system error.
+     *
+     */
+    otbrError Release(int aSocket);
+
+private:
+    enum
+    {
+        kAcquireTimeout = 5, ///< Timeout in seconds to wait for the running agent.
+    };
+
+    const char *mPath;
+    int         mSocket;
+    int         mPeer;
+};
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // HANDOVER_HPP_
@@ -0,0 +1,244 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the registry of joiners allowed to join.
+ */
+
+#include "joiner_registry.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include <mbedtls/sha256.h>
+
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+JoinerRegistry::JoinerRegistry(uint8_t aSteeringLength) :
+    mSteeringDataChanged(false)
+{
+    memset(mCounters, 0, sizeof(mCounters));
+    mSteeringData.SetLength(aSteeringLength);
+    mSteeringData.Clear();
+}
+
+void JoinerRegistry::ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId)
+{
+    uint8_t hash[32];
+
+    mbedtls_sha256(aEui64, kSizeOfJoinerId, hash, 0);
+    memcpy(aJoinerId, hash, kSizeOfJoinerId);
+    // Sets the locally administered bit.
+    aJoinerId[0] |= 0x02;
+}
+
+void JoinerRegistry::ComputeJoinerId(uint64_t aDiscerner, uint8_t aLength, uint8_t *aJoinerId)
+{
+    uint8_t discerner[kSizeOfJoinerId];
+
+    if (aLength < kMaxDiscernerLength)
+    {
+        aDiscerner &= (static_cast<uint64_t>(1) << aLength) - 1;
+    }
+
+    for (int i = kSizeOfJoinerId - 1; i >= 0; i--)
+    {
+        discerner[i] = static_cast<uint8_t>(aDiscerner);
+        aDiscerner >>= 8;
+    }
+
+    ComputeJoinerId(discerner, aJoinerId);
+}
+
+uint64_t JoinerRegistry::ToKey(const uint8_t *aJoinerId)
+{
+    uint64_t key = 0;
+
+    for (int i = 0; i < kSizeOfJoinerId; i++)
+    {
+        key = (key << 8) | aJoinerId[i];
+    }
+
+    return key;
+}
+
+void JoinerRegistry::Increment(uint16_t aHash)
+{
+    uint8_t bit = static_cast<uint8_t>(aHash % mSteeringData.GetNumBits());
+
+    if (mCounters[bit]++ == 0)
+    {
+        mSteeringData.SetBit(bit);
+        mSteeringDataChanged = true;
+    }
+}
+
+void JoinerRegistry::Decrement(uint16_t aHash)
+{
+    uint8_t bit = static_cast<uint8_t>(aHash % mSteeringData.GetNumBits());
+
+    if (--mCounters[bit] == 0)
+    {
+        mSteeringData.ClearBit(bit);
+        mSteeringDataChanged = true;
+    }
+}
+
+otbrError JoinerRegistry::Add(const uint8_t *aJoinerId, const char *aPskd, unsigned long aExpiration)
+{
+    otbrError           error = OTBR_ERROR_ERRNO;
+    size_t              length = strlen(aPskd);
+    JoinerMap::iterator it;
+
+    VerifyOrExit(length >= kMinPskdLength && length <= kMaxPskdLength, errno = EINVAL);
+
+    it = mJoiners.find(ToKey(aJoinerId));
+
+    if (it == mJoiners.end())
+    {
+        Joiner joiner;
+
+        SteeringData::ComputeHashes(aJoinerId, joiner.mCcitt, joiner.mAnsi);
+        joiner.mExpiration = mExpirations.end();
+        it = mJoiners.insert(JoinerMap::value_type(ToKey(aJoinerId), joiner)).first;
+        Increment(joiner.mCcitt);
+        Increment(joiner.mAnsi);
+    }
+    else if (it->second.mExpiration != mExpirations.end())
+    {
+        mExpirations.erase(it->second.mExpiration);
+        it->second.mExpiration = mExpirations.end();
+    }
+
+    it->second.mPskd = aPskd;
+
+    if (aExpiration != 0)
+    {
+        it->second.mExpiration = mExpirations.insert(ExpirationMap::value_type(aExpiration, it->first));
+    }
+
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void JoinerRegistry::Erase(JoinerMap::iterator aJoiner)
+{
+    if (aJoiner->second.mExpiration != mExpirations.end())
+    {
+        mExpirations.erase(aJoiner->second.mExpiration);
+    }
+
+    Decrement(aJoiner->second.mCcitt);
+    Decrement(aJoiner->second.mAnsi);
+    mJoiners.erase(aJoiner);
+}
+
+otbrError JoinerRegistry::Remove(const uint8_t *aJoinerId)
+{
+    otbrError           error = OTBR_ERROR_ERRNO;
+    JoinerMap::iterator it = mJoiners.find(ToKey(aJoinerId));
+
+    VerifyOrExit(it != mJoiners.end(), errno = ENOENT);
+    Erase(it);
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void JoinerRegistry::Clear(void)
+{
+    mSteeringDataChanged = mSteeringDataChanged || !mSteeringData.IsCleared();
+    mJoiners.clear();
+    mExpirations.clear();
+    memset(mCounters, 0, sizeof(mCounters));
+    mSteeringData.Clear();
+}
+
+size_t JoinerRegistry::Expire(unsigned long aNow)
+{
+    size_t count = 0;
+
+    while (!mExpirations.empty() && static_cast<long>(mExpirations.begin()->first - aNow) <= 0)
+    {
+        Erase(mJoiners.find(mExpirations.begin()->second));
+        count++;
+    }
+
+    return count;
+}
+
+bool JoinerRegistry::GetNextExpiration(unsigned long &aExpiration) const
+{
+    bool found = !mExpirations.empty();
+
+    if (found)
+    {
+        aExpiration = mExpirations.begin()->first;
+    }
+
+    return found;
+}
+
+const char *JoinerRegistry::FindPskd(const uint8_t *aJoinerId) const
+{
+    JoinerMap::const_iterator it = mJoiners.find(ToKey(aJoinerId));
+
+    return it == mJoiners.end() ? NULL : it->second.mPskd.c_str();
+}
+
+void JoinerRegistry::SetSteeringLength(uint8_t aLength)
+{
+    uint8_t data[kMaxSteeringLength];
+    uint8_t length = static_cast<uint8_t>(mSteeringData.GetLength());
+    bool    changed = mSteeringDataChanged;
+
+    memcpy(data, mSteeringData.GetDataPointer(), length);
+    memset(mCounters, 0, sizeof(mCounters));
+    mSteeringData.SetLength(aLength);
+    mSteeringData.Clear();
+
+    for (JoinerMap::const_iterator it = mJoiners.begin(); it != mJoiners.end(); ++it)
+    {
+        Increment(it->second.mCcitt);
+        Increment(it->second.mAnsi);
+    }
+
+    mSteeringDataChanged = (changed || length != aLength || memcmp(data, mSteeringData.GetDataPointer(), length) != 0);
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
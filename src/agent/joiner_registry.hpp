@@ -0,0 +1,248 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the registry of joiners allowed to join.
+ */
+
+#ifndef JOINER_REGISTRY_HPP_
+#define JOINER_REGISTRY_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "common/types.hpp"
+#include "utils/steeringdata.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a registry of the joiners allowed to join, with their PSKd and expiration.
+ *
+ * The steering data is backed by a counting Bloom filter, a counter for each bit of the steering data, so that
+ * adding or removing a joiner updates it in constant time rather than rebuilding it from all joiners. The
+ * steering data is marked changed only when a bit flips, which is when it has to be sent again.
+ *
+ */
+class JoinerRegistry
+{
+public:
+    enum
+    {
+        kSizeOfJoinerId        = 8,  ///< Size of joiner ID in bytes.
+        kMinPskdLength         = 6,  ///< Min length of PSKd.
+        kMaxPskdLength         = 32, ///< Max length of PSKd.
+        kMaxSteeringLength     = 16, ///< Max length of steering data in bytes.
+        kDefaultSteeringLength = 15, ///< Default length of steering data in bytes.
+        kMaxDiscernerLength    = 64, ///< Max length of joiner discerner in bits.
+    };
+
+    /**
+     * The constructor to initialize an empty registry.
+     *
+     * @param[in]   aSteeringLength     Length of the steering data in bytes.
+     *
+     */
+    JoinerRegistry(uint8_t aSteeringLength = kDefaultSteeringLength);
+
+    /**
+     * This method computes the joiner ID of an EUI-64.
+     *
+     * @param[in]   aEui64      A pointer to the EUI-64.
+     * @param[out]  aJoinerId   A pointer to a buffer of kSizeOfJoinerId bytes to receive the joiner ID.
+     *
+     */
+    static void ComputeJoinerId(const uint8_t *aEui64, uint8_t *aJoinerId);
+
+    /**
+     * This method computes the joiner ID of a joiner discerner.
+     *
+     * @param[in]   aDiscerner  The value of the discerner, only its @p aLength least significant bits are used.
+     * @param[in]   aLength     The length of the discerner in bits, 1 to kMaxDiscernerLength.
+     * @param[out]  aJoinerId   A pointer to a buffer of kSizeOfJoinerId bytes to receive the joiner ID.
+     *
+     */
+    static void ComputeJoinerId(uint64_t aDiscerner, uint8_t aLength, uint8_t *aJoinerId);
+
+    /**
+     * This method adds a joiner, or updates the PSKd and expiration of a joiner already added.
+     *
+     * @param[in]   aJoinerId           A pointer to the joiner ID.
+     * @param[in]   aPskd               A pointer to the PSKd.
+     * @param[in]   aExpiration         Expiration timestamp in milliseconds, zero to never expire.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully added.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the PSKd is invalid.
+     *
+     */
+    otbrError Add(const uint8_t *aJoinerId, const char *aPskd, unsigned long aExpiration);
+
+    /**
+     * This method removes a joiner.
+     *
+     * @param[in]   aJoinerId           A pointer to the joiner ID.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully removed.
+     * @retval      OTBR_ERROR_ERRNO    Failed for no such joiner.
+     *
+     */
+    otbrError Remove(const uint8_t *aJoinerId);
+
+    /**
+     * This method removes all joiners.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method removes the joiners expired.
+     *
+     * @param[in]   aNow    Current timestamp in milliseconds.
+     *
+     * @returns The number of joiners removed.
+     *
+     */
+    size_t Expire(unsigned long aNow);
+
+    /**
+     * This method returns the earliest expiration of joiners.
+     *
+     * @param[out]  aExpiration     The earliest expiration timestamp in milliseconds.
+     *
+     * @returns Whether any joiner expires.
+     *
+     */
+    bool GetNextExpiration(unsigned long &aExpiration) const;
+
+    /**
+     * This method looks up the PSKd of a joiner.
+     *
+     * @param[in]   aJoinerId   A pointer to the joiner ID.
+     *
+     * @returns The pointer to the PSKd, NULL if not found.
+     *
+     */
+    const char *FindPskd(const uint8_t *aJoinerId) const;
+
+    /**
+     * This method returns the number of joiners.
+     *
+     * @returns The number of joiners.
+     *
+     */
+    size_t GetSize(void) const { return mJoiners.size(); }
+
+    /**
+     * This method changes the length of the steering data, the counters are rebuilt from all joiners.
+     *
+     * @param[in]   aLength     Length of the steering data in bytes, 1 to kMaxSteeringLength.
+     *
+     */
+    void SetSteeringLength(uint8_t aLength);
+
+    /**
+     * This method returns the steering data of all joiners.
+     *
+     * @returns The steering data.
+     *
+     */
+    const SteeringData &GetSteeringData(void) const { return mSteeringData; }
+
+    /**
+     * This method indicates whether the steering data changed since it was last sent.
+     *
+     * @returns Whether the steering data changed.
+     *
+     */
+    bool IsSteeringDataChanged(void) const { return mSteeringDataChanged; }
+
+    /**
+     * This method marks the steering data sent.
+     *
+     */
+    void HandleSteeringDataSent(void) { mSteeringDataChanged = false; }
+
+private:
+    /**
+     * This class orders expirations across the wrap of the millisecond timestamp, as long as all of them are
+     * within half of its range.
+     *
+     */
+    struct ExpirationLess
+    {
+        bool operator()(unsigned long aLeft, unsigned long aRight) const
+        {
+            return static_cast<long>(aLeft - aRight) < 0;
+        }
+    };
+
+    typedef std::multimap<unsigned long, uint64_t, ExpirationLess> ExpirationMap;
+
+    struct Joiner
+    {
+        std::string             mPskd;
+        uint16_t                mCcitt;
+        uint16_t                mAnsi;
+        ExpirationMap::iterator mExpiration; ///< End of mExpirations if never expires.
+    };
+
+    typedef std::map<uint64_t, Joiner> JoinerMap;
+
+    static uint64_t ToKey(const uint8_t *aJoinerId);
+    void            Increment(uint16_t aHash);
+    void            Decrement(uint16_t aHash);
+    void            Erase(JoinerMap::iterator aJoiner);
+
+    JoinerMap     mJoiners;
+    ExpirationMap mExpirations;
+    uint32_t      mCounters[kMaxSteeringLength * 8];
+    SteeringData  mSteeringData;
+    bool          mSteeringDataChanged;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // JOINER_REGISTRY_HPP_
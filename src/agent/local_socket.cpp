@@ -0,0 +1,140 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements Unix domain sockets restricted to local administrators.
+ */
+
+#include "local_socket.hpp"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+static bool IsTrustedUid(uid_t aUid)
+{
+    return aUid == 0 || aUid == geteuid();
+}
+
+static bool IsSafeDirectory(const char *aPath)
+{
+    struct sockaddr_un addr;
+    char               dir[sizeof(addr.sun_path)];
+    const char *       slash = strrchr(aPath, '/');
+    struct stat        st;
+    bool               safe = false;
+
+    if (slash == NULL)
+    {
+        strcpy(dir, ".");
+    }
+    else if (slash == aPath)
+    {
+        strcpy(dir, "/");
+    }
+    else
+    {
+        memcpy(dir, aPath, static_cast<size_t>(slash - aPath));
+        dir[slash - aPath] = '\0';
+    }
+
+    VerifyOrExit(lstat(dir, &st) == 0);
+    VerifyOrExit(S_ISDIR(st.st_mode) && IsTrustedUid(st.st_uid) && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0,
+                 errno = EPERM);
+    safe = true;
+
+exit:
+    return safe;
+}
+
+int ListenLocal(const char *aPath, int aBacklog)
+{
+    int                fd = -1;
+    int                ret = -1;
+    mode_t             mask;
+    struct sockaddr_un addr;
+
+    VerifyOrExit(strlen(aPath) < sizeof(addr.sun_path), errno = ENAMETOOLONG);
+    VerifyOrExit(IsSafeDirectory(aPath));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, aPath);
+
+    unlink(aPath);
+    VerifyOrExit((fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)) != -1);
+
+    // The socket file takes its mode from the umask at bind().
+    mask = umask(S_IXUSR | S_IRWXG | S_IRWXO);
+    ret = bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+    umask(mask);
+    SuccessOrExit(ret);
+
+    ret = -1;
+    SuccessOrExit(listen(fd, aBacklog));
+    ret = fd;
+
+exit:
+    if (ret == -1 && fd != -1)
+    {
+        int err = errno;
+
+        close(fd);
+        errno = err;
+    }
+
+    return ret;
+}
+
+bool IsTrustedPeer(int aSocket)
+{
+    struct ucred cred;
+    socklen_t    len = sizeof(cred);
+    bool         trusted = false;
+
+    VerifyOrExit(getsockopt(aSocket, SOL_SOCKET, SO_PEERCRED, &cred, &len) == 0);
+    VerifyOrExit(IsTrustedUid(cred.uid), errno = EACCES);
+    trusted = true;
+
+exit:
+    return trusted;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
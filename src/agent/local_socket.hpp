@@ -0,0 +1,70 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for Unix domain sockets restricted to local administrators.
+ */
+
+#ifndef LOCAL_SOCKET_HPP_
+#define LOCAL_SOCKET_HPP_
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * This function creates a Unix stream socket listening on @p aPath.
+ *
+ * The directory containing @p aPath must be owned by root or the effective user and must not be writable by
+ * group or others, so that no other user can replace the socket. The socket file is created with mode 0600.
+ *
+ * @param[in]   aPath       Path of the Unix socket.
+ * @param[in]   aBacklog    The backlog passed to listen().
+ *
+ * @returns The listening socket, -1 on failure with errno set. errno is EPERM if the directory is not safe.
+ *
+ */
+int ListenLocal(const char *aPath, int aBacklog);
+
+/**
+ * This function indicates whether the peer of a connected Unix socket runs as root or the effective user.
+ *
+ * @param[in]   aSocket     The connected Unix socket.
+ *
+ * @retval  true    The peer is trusted.
+ * @retval  false   The peer is not trusted or its credentials are not available, errno is set.
+ *
+ */
+bool IsTrustedPeer(int aSocket);
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // LOCAL_SOCKET_HPP_
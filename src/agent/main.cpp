@@ -28,6 +28,7 @@
 
 #include "otbr-config.h"
 
+#include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -35,6 +36,7 @@
 #include <unistd.h>
 
 #include "agent_instance.hpp"
+#include "handover.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
 #include "common/types.hpp"
@@ -45,13 +47,40 @@ static const char kDefaultInterfaceName[] = "wpan0";
 // Default poll timeout.
 static const struct timeval kPollTimeout = {10, 0};
 
-int Mainloop(const char *aInterfaceName)
+int Mainloop(const char *aInterfaceName, bool aCoalescing, const char *aSessionCacheFile, const char *aHandoverPath,
+             size_t aMemoryBudget, uint32_t aAckDelay, const char *aDiagnosticPath, uint16_t aTcpPort,
+             uint32_t aRouterRate, uint32_t aTotalRate)
 {
     int rval = EXIT_FAILURE;
 
+    // Declared first so that the handover connection is closed only after the instance is destroyed.
+    ot::BorderRouter::Handover      handover(aHandoverPath);
     ot::BorderRouter::AgentInstance instance(aInterfaceName);
+
+    instance.GetBorderAgent().SetDtlsCoalescing(aCoalescing);
+    instance.GetBorderAgent().SetDtlsSessionCacheFile(aSessionCacheFile);
+    instance.GetBorderAgent().SetDtlsMemoryBudget(aMemoryBudget);
+    instance.GetBorderAgent().SetCoapsAckDelay(aAckDelay);
+    instance.GetBorderAgent().SetCoapsTcpPort(aTcpPort);
+    instance.GetBorderAgent().SetRelayRates(aRouterRate, aTotalRate);
+
+    if (aHandoverPath != NULL)
+    {
+        instance.GetBorderAgent().SetDtlsSocket(handover.Acquire());
+    }
+
     SuccessOrExit(instance.Init());
 
+    if (aDiagnosticPath != NULL)
+    {
+        SuccessOrExit(instance.GetDiagnosticCollector().Start(aDiagnosticPath));
+    }
+
+    if (aHandoverPath != NULL)
+    {
+        SuccessOrExit(handover.Listen());
+    }
+
     otbrLog(OTBR_LOG_INFO, "Border router agent started.");
 
     while (true)
@@ -67,6 +96,7 @@ int Mainloop(const char *aInterfaceName)
         FD_ZERO(&errorFdSet);
 
         instance.UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+        handover.UpdateFdSet(readFdSet, maxFd);
         rval = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout);
 
         if ((rval < 0) && (errno != EINTR))
@@ -77,6 +107,14 @@ int Mainloop(const char *aInterfaceName)
         }
 
         instance.Process(readFdSet, writeFdSet, errorFdSet);
+        handover.Process(readFdSet);
+
+        // Exit only once the successor has the socket, otherwise keep serving.
+        if (handover.IsRequested() && handover.Release(instance.GetBorderAgent().GetDtlsSocket()) == OTBR_ERROR_NONE)
+        {
+            rval = EXIT_SUCCESS;
+            break;
+        }
     }
 
 exit:
@@ -88,32 +126,162 @@ void PrintVersion(void)
     printf("%s\n", PACKAGE_VERSION);
 }
 
+void PrintUsage(const char *aProgram)
+{
+    fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-c] [-s sessionCacheFile] "
+            "[-H handoverSocket] [-m memoryBudget] [-a ackDelay] [-D diagnosticSocket] [-T tcpPort] "
+            "[-R routerRate[:totalRate]] [-v]\n", aProgram);
+}
+
+// Parses an unsigned number of at most aMax at the start of a string.
+static bool ParseNumber(const char *aString, char **aEnd, unsigned long aMax, unsigned long &aValue)
+{
+    bool          ret = false;
+    unsigned long value;
+
+    VerifyOrExit(isdigit(static_cast<unsigned char>(aString[0])));
+
+    errno = 0;
+    value = strtoul(aString, aEnd, 0);
+    VerifyOrExit(errno == 0 && value <= aMax);
+
+    aValue = value;
+    ret = true;
+
+exit:
+    return ret;
+}
+
+// Parses a string that is an unsigned number of at most aMax.
+static bool ParseNumber(const char *aString, unsigned long aMax, unsigned long &aValue)
+{
+    char *end;
+
+    return ParseNumber(aString, &end, aMax, aValue) && *end == '\0';
+}
+
+// Parses a rate in bytes per second at the start of a string.
+static bool ParseRate(const char *aString, char **aEnd, uint32_t &aRate)
+{
+    unsigned long rate;
+    bool          ret = ParseNumber(aString, aEnd, 0xffffffffUL, rate);
+
+    if (ret)
+    {
+        aRate = static_cast<uint32_t>(rate);
+    }
+
+    return ret;
+}
+
+// Parses relay rates of the form routerRate[:totalRate], leaving the total rate unchanged if not given.
+static bool ParseRelayRates(const char *aRates, uint32_t &aRouterRate, uint32_t &aTotalRate)
+{
+    bool  ret = false;
+    char *end;
+
+    VerifyOrExit(ParseRate(aRates, &end, aRouterRate));
+
+    if (*end == ':')
+    {
+        VerifyOrExit(ParseRate(end + 1, &end, aTotalRate));
+    }
+
+    ret = (*end == '\0');
+
+exit:
+    return ret;
+}
+
 int main(int argc, char *argv[])
 {
-    const char *interfaceName = kDefaultInterfaceName;
-    int         logLevel = OTBR_LOG_INFO;
-    int         opt;
-    int         ret = 0;
+    const char   *interfaceName = kDefaultInterfaceName;
+    const char   *sessionCacheFile = NULL;
+    const char   *handoverPath = NULL;
+    const char   *diagnosticPath = NULL;
+    size_t        memoryBudget = 0;
+    uint32_t      ackDelay = 0;
+    uint16_t      tcpPort = 0;
+    uint32_t      routerRate = ot::BorderRouter::RelayQueue::kDefaultRouterRate;
+    uint32_t      totalRate = ot::BorderRouter::RelayQueue::kDefaultTotalRate;
+    int           logLevel = OTBR_LOG_INFO;
+    bool          coalescing = false;
+    unsigned long number;
+    int           opt;
+    int           ret = 0;
 
-    while ((opt = getopt(argc, argv, "d:I:v")) != -1)
+    while ((opt = getopt(argc, argv, "a:cd:D:H:I:m:R:s:T:v")) != -1)
     {
         switch (opt)
         {
+        case 'a':
+            if (!ParseNumber(optarg, ot::BorderRouter::Coap::Agent::kMaxAckDelay, number))
+            {
+                PrintUsage(argv[0]);
+                ExitNow(ret = -1);
+            }
+            ackDelay = static_cast<uint32_t>(number);
+            break;
+
+        case 'c':
+            coalescing = true;
+            break;
+
         case 'd':
             logLevel = atoi(optarg);
             break;
 
+        case 'D':
+            diagnosticPath = optarg;
+            break;
+
+        case 'H':
+            handoverPath = optarg;
+            break;
+
         case 'I':
             interfaceName = optarg;
             break;
 
+        case 'm':
+            // A budget too small for a single session would refuse every commissioner.
+            if (!ParseNumber(optarg, ~0UL, number) ||
+                (number != 0 && number < ot::BorderRouter::Dtls::Server::GetSessionMemoryUsage()))
+            {
+                PrintUsage(argv[0]);
+                ExitNow(ret = -1);
+            }
+            memoryBudget = static_cast<size_t>(number);
+            break;
+
+        case 'R':
+            if (!ParseRelayRates(optarg, routerRate, totalRate))
+            {
+                PrintUsage(argv[0]);
+                ExitNow(ret = -1);
+            }
+            break;
+
+        case 's':
+            sessionCacheFile = optarg;
+            break;
+
+        case 'T':
+            if (!ParseNumber(optarg, 0xffffUL, number) || number == 0)
+            {
+                PrintUsage(argv[0]);
+                ExitNow(ret = -1);
+            }
+            tcpPort = static_cast<uint16_t>(number);
+            break;
+
         case 'v':
             PrintVersion();
             ExitNow();
             break;
 
         default:
-            fprintf(stderr, "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-v]\n", argv[0]);
+            PrintUsage(argv[0]);
             ExitNow(ret = -1);
             break;
         }
@@ -122,7 +290,8 @@ int main(int argc, char *argv[])
     otbrLogInit(kSyslogIdent, logLevel);
     otbrLog(OTBR_LOG_INFO, "Starting border router agent on %s...", interfaceName);
 
-    ret = Mainloop(interfaceName);
+    ret = Mainloop(interfaceName, coalescing, sessionCacheFile, handoverPath, memoryBudget, ackDelay, diagnosticPath,
+                   tcpPort, routerRate, totalRate);
 
     otbrLogDeinit();
 
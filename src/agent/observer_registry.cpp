@@ -0,0 +1,157 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the registry of commissioners observing border agent resources.
+ */
+
+#include "observer_registry.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+ObserverRegistry::ObserverRegistry(uint16_t aCapacity) :
+    mCapacity(aCapacity) {}
+
+otbrError ObserverRegistry::Register(Dtls::Session *aSession, const char *aPath, const uint8_t *aToken,
+                                     uint8_t aTokenLength, const uint8_t *aPayload, uint16_t aLength)
+{
+    otbrError           error = OTBR_ERROR_ERRNO;
+    Observers::iterator it;
+
+    VerifyOrExit(aTokenLength <= ForwardTable::kMaxTokenLength, errno = EINVAL);
+
+    it = Find(aSession, aToken, aTokenLength);
+
+    if (it == mObservers.end())
+    {
+        Observer observer;
+
+        VerifyOrExit(mObservers.size() < mCapacity, errno = ENOBUFS);
+
+        observer.mSession = aSession;
+        observer.mPath = aPath;
+        observer.mSequence = 0;
+        observer.mTokenLength = aTokenLength;
+        memcpy(observer.mToken, aToken, aTokenLength);
+        observer.mPayload.assign(aPayload, aPayload + aLength);
+        mObservers.push_back(observer);
+    }
+    else
+    {
+        it->mPath = aPath;
+        it->mPayload.assign(aPayload, aPayload + aLength);
+    }
+
+    otbrLog(OTBR_LOG_INFO, "Observing %s, %u observers.", aPath, static_cast<unsigned>(mObservers.size()));
+    error = OTBR_ERROR_NONE;
+
+exit:
+    return error;
+}
+
+void ObserverRegistry::Deregister(const Dtls::Session *aSession, const uint8_t *aToken, uint8_t aTokenLength)
+{
+    Observers::iterator it = Find(aSession, aToken, aTokenLength);
+
+    if (it != mObservers.end())
+    {
+        mObservers.erase(it);
+    }
+}
+
+void ObserverRegistry::Remove(const Dtls::Session *aSession)
+{
+    for (Observers::iterator it = mObservers.begin(); it != mObservers.end();)
+    {
+        if (it->mSession == aSession)
+        {
+            it = mObservers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool ObserverRegistry::Notify(const Dtls::Session *aSession, const uint8_t *aToken, uint8_t aTokenLength,
+                              uint32_t &aSequence)
+{
+    Observers::iterator it = Find(aSession, aToken, aTokenLength);
+
+    if (it != mObservers.end())
+    {
+        it->mSequence = (it->mSequence + 1) & kMaxSequence;
+        aSequence = it->mSequence;
+    }
+
+    return it != mObservers.end();
+}
+
+void ObserverRegistry::GetObservers(const char *aPath, Observers &aObservers) const
+{
+    aObservers.clear();
+
+    for (Observers::const_iterator it = mObservers.begin(); it != mObservers.end(); ++it)
+    {
+        if (!strcmp(it->mPath, aPath))
+        {
+            aObservers.push_back(*it);
+        }
+    }
+}
+
+ObserverRegistry::Observers::iterator ObserverRegistry::Find(const Dtls::Session *aSession, const uint8_t *aToken,
+                                                             uint8_t aTokenLength)
+{
+    Observers::iterator it;
+
+    for (it = mObservers.begin(); it != mObservers.end(); ++it)
+    {
+        if (it->mSession == aSession && it->mTokenLength == aTokenLength &&
+            !memcmp(it->mToken, aToken, aTokenLength))
+        {
+            break;
+        }
+    }
+
+    return it;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
@@ -0,0 +1,176 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the registry of commissioners observing border agent resources.
+ */
+
+#ifndef OBSERVER_REGISTRY_HPP_
+#define OBSERVER_REGISTRY_HPP_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "dtls.hpp"
+#include "forward_table.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a bounded registry of CoAP observers (RFC 7641).
+ *
+ * An observer is identified by its session and the token of its registering request, whose payload is kept
+ * to fetch the resource again for each notification.
+ *
+ */
+class ObserverRegistry
+{
+public:
+    enum
+    {
+        kDefaultCapacity = 16,       ///< Default max number of observers.
+        kMaxSequence     = 0xffffff, ///< Max value of the Observe option in notifications.
+    };
+
+    /**
+     * This structure represents an observer.
+     *
+     */
+    struct Observer
+    {
+        Dtls::Session        *mSession;                              ///< The session of the observer.
+        const char           *mPath;                                 ///< The URI path observed.
+        uint32_t              mSequence;                             ///< Observe value of the last notification.
+        uint8_t               mTokenLength;                          ///< Length of the token.
+        uint8_t               mToken[ForwardTable::kMaxTokenLength]; ///< The token of the registration.
+        std::vector<uint8_t>  mPayload;                              ///< Payload of the registration.
+    };
+
+    typedef std::vector<Observer> Observers;
+
+    /**
+     * The constructor to initialize an observer registry.
+     *
+     * @param[in]   aCapacity   Max number of observers.
+     *
+     */
+    ObserverRegistry(uint16_t aCapacity = kDefaultCapacity);
+
+    /**
+     * This method registers an observer, or updates the one of the same session and token.
+     *
+     * @param[in]   aSession            The session of the observer.
+     * @param[in]   aPath               The URI path observed, which must outlive the registration.
+     * @param[in]   aToken              A pointer to the token.
+     * @param[in]   aTokenLength        The length of the token.
+     * @param[in]   aPayload            A pointer to the payload of the request.
+     * @param[in]   aLength             The length of the payload.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully registered.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the registry is full or the token is too long.
+     *
+     */
+    otbrError Register(Dtls::Session *aSession, const char *aPath, const uint8_t *aToken, uint8_t aTokenLength,
+                       const uint8_t *aPayload, uint16_t aLength);
+
+    /**
+     * This method deregisters an observer.
+     *
+     * @param[in]   aSession            The session of the observer.
+     * @param[in]   aToken              A pointer to the token.
+     * @param[in]   aTokenLength        The length of the token.
+     *
+     */
+    void Deregister(const Dtls::Session *aSession, const uint8_t *aToken, uint8_t aTokenLength);
+
+    /**
+     * This method deregisters all observers of a session.
+     *
+     * @param[in]   aSession            The session.
+     *
+     */
+    void Remove(const Dtls::Session *aSession);
+
+    /**
+     * This method returns the sequence number for the next notification of an observer.
+     *
+     * @param[in]   aSession            The session of the observer.
+     * @param[in]   aToken              A pointer to the token.
+     * @param[in]   aTokenLength        The length of the token.
+     * @param[out]  aSequence           A reference to receive the value of the Observe option.
+     *
+     * @retval  true    The token is of an observer.
+     * @retval  false   The token is not of an observer.
+     *
+     */
+    bool Notify(const Dtls::Session *aSession, const uint8_t *aToken, uint8_t aTokenLength, uint32_t &aSequence);
+
+    /**
+     * This method returns the observers of a resource.
+     *
+     * @param[in]   aPath               The URI path.
+     * @param[out]  aObservers          A reference to receive the observers.
+     *
+     */
+    void GetObservers(const char *aPath, Observers &aObservers) const;
+
+    /**
+     * This method returns the number of observers.
+     *
+     * @returns The number of observers.
+     *
+     */
+    uint16_t GetSize(void) const { return static_cast<uint16_t>(mObservers.size()); }
+
+private:
+    Observers::iterator Find(const Dtls::Session *aSession, const uint8_t *aToken, uint8_t aTokenLength);
+
+    Observers mObservers;
+    uint16_t  mCapacity;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // OBSERVER_REGISTRY_HPP_
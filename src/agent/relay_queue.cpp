@@ -0,0 +1,260 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements queueing relayed joiner messages into the Thread network.
+ */
+
+#include "relay_queue.hpp"
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+RelayQueue::RelayQueue(uint32_t aRouterRate, uint32_t aTotalRate, uint16_t aQuantum) :
+    mRouterRate(aRouterRate),
+    mTotalRate(aTotalRate),
+    mQuantum(aQuantum),
+    mSize(0)
+{
+    mBucket.mCredit = GetBurst(mTotalRate);
+    mBucket.mUpdated = 0;
+}
+
+void RelayQueue::SetRates(uint32_t aRouterRate, uint32_t aTotalRate)
+{
+    mRouterRate = aRouterRate;
+    mTotalRate = aTotalRate;
+}
+
+otbrError RelayQueue::Push(uint16_t aLocator, const uint8_t *aToken, uint8_t aTokenLength, const uint8_t *aPayload,
+                           uint16_t aLength)
+{
+    otbrError         error = OTBR_ERROR_NONE;
+    Routers::iterator it;
+
+    VerifyOrExit(aTokenLength <= ForwardTable::kMaxTokenLength && aLength <= kMaxRelaySize,
+                 error = OTBR_ERROR_ERRNO; errno = EMSGSIZE);
+
+    it = mRouters.find(aLocator);
+
+    if (it == mRouters.end())
+    {
+        Router router;
+
+        // A new joiner router starts with a full bucket.
+        router.mBucket.mCredit = GetBurst(mRouterRate);
+        router.mBucket.mUpdated = 0;
+        router.mDeficit = 0;
+        router.mGranted = false;
+        it = mRouters.insert(std::make_pair(aLocator, router)).first;
+    }
+
+    VerifyOrExit(it->second.mRelays.size() < kMaxQueueLength, error = OTBR_ERROR_ERRNO; errno = ENOBUFS);
+
+    if (it->second.mRelays.empty())
+    {
+        mActiveRouters.push_back(aLocator);
+    }
+
+    it->second.mRelays.push_back(Relay());
+
+    {
+        Relay &relay = it->second.mRelays.back();
+
+        relay.mLocator = aLocator;
+        relay.mTokenLength = aTokenLength;
+        memcpy(relay.mToken, aToken, aTokenLength);
+        relay.mPayload.assign(aPayload, aPayload + aLength);
+    }
+
+    ++mSize;
+
+exit:
+    return error;
+}
+
+bool RelayQueue::Pop(unsigned long aNow, Relay &aRelay)
+{
+    bool   popped = false;
+    size_t blocked = 0;
+
+    Refill(mBucket, mTotalRate, aNow);
+    Purge(aNow);
+
+    // Every turn either gives a quantum or counts a shaped joiner router, so the loop ends.
+    while (!popped && blocked < mActiveRouters.size())
+    {
+        Router  &router = mRouters[mActiveRouters.front()];
+        Relay   &relay = router.mRelays.front();
+        uint32_t size = static_cast<uint32_t>(relay.mPayload.size());
+        uint64_t cost = static_cast<uint64_t>(size) * 1000;
+
+        Refill(router.mBucket, mRouterRate, aNow);
+
+        if ((mRouterRate != 0 && router.mBucket.mCredit < cost) || (mTotalRate != 0 && mBucket.mCredit < cost))
+        {
+            // A shaped joiner router keeps its deficit but loses its turn.
+            Rotate(router);
+            ++blocked;
+            continue;
+        }
+
+        if (!router.mGranted)
+        {
+            router.mDeficit += mQuantum;
+            router.mGranted = true;
+        }
+
+        if (router.mDeficit < size)
+        {
+            Rotate(router);
+            blocked = 0;
+            continue;
+        }
+
+        aRelay.mLocator = relay.mLocator;
+        aRelay.mTokenLength = relay.mTokenLength;
+        memcpy(aRelay.mToken, relay.mToken, relay.mTokenLength);
+        aRelay.mPayload.swap(relay.mPayload);
+
+        router.mRelays.pop_front();
+        router.mDeficit -= size;
+        router.mBucket.mCredit -= (mRouterRate != 0 ? cost : 0);
+        mBucket.mCredit -= (mTotalRate != 0 ? cost : 0);
+        --mSize;
+
+        if (router.mRelays.empty())
+        {
+            router.mDeficit = 0;
+            router.mGranted = false;
+            mActiveRouters.pop_front();
+        }
+
+        popped = true;
+    }
+
+    return popped;
+}
+
+unsigned long RelayQueue::GetNextTime(unsigned long aNow) const
+{
+    unsigned long next = aNow;
+    bool          found = false;
+
+    for (std::deque<uint16_t>::const_iterator it = mActiveRouters.begin(); it != mActiveRouters.end(); ++it)
+    {
+        const Router &router = mRouters.find(*it)->second;
+        uint64_t      cost = static_cast<uint64_t>(router.mRelays.front().mPayload.size()) * 1000;
+        unsigned long routerTime = GetReadyTime(router.mBucket, mRouterRate, cost, aNow);
+        unsigned long totalTime = GetReadyTime(mBucket, mTotalRate, cost, aNow);
+        unsigned long time = static_cast<long>(routerTime - totalTime) > 0 ? routerTime : totalTime;
+
+        if (!found || static_cast<long>(time - next) < 0)
+        {
+            next = time;
+            found = true;
+        }
+    }
+
+    return next;
+}
+
+void RelayQueue::Rotate(Router &aRouter)
+{
+    aRouter.mGranted = false;
+    mActiveRouters.push_back(mActiveRouters.front());
+    mActiveRouters.pop_front();
+}
+
+void RelayQueue::Purge(unsigned long aNow)
+{
+    // An idle joiner router with a full bucket is the same as a new one.
+    for (Routers::iterator it = mRouters.begin(); it != mRouters.end();)
+    {
+        if (it->second.mRelays.empty() && GetCredit(it->second.mBucket, mRouterRate, aNow) >= GetBurst(mRouterRate))
+        {
+            mRouters.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+uint64_t RelayQueue::GetBurst(uint32_t aRate)
+{
+    uint64_t burst = static_cast<uint64_t>(aRate) * kBurstInterval;
+
+    // The largest message must always fit.
+    if (burst < static_cast<uint64_t>(kMaxRelaySize) * 1000)
+    {
+        burst = static_cast<uint64_t>(kMaxRelaySize) * 1000;
+    }
+
+    return burst;
+}
+
+uint64_t RelayQueue::GetCredit(const Bucket &aBucket, uint32_t aRate, unsigned long aNow)
+{
+    uint64_t burst = GetBurst(aRate);
+    uint64_t credit = aBucket.mCredit + static_cast<uint64_t>(aNow - aBucket.mUpdated) * aRate;
+
+    return credit > burst ? burst : credit;
+}
+
+void RelayQueue::Refill(Bucket &aBucket, uint32_t aRate, unsigned long aNow)
+{
+    aBucket.mCredit = GetCredit(aBucket, aRate, aNow);
+    aBucket.mUpdated = aNow;
+}
+
+unsigned long RelayQueue::GetReadyTime(const Bucket &aBucket, uint32_t aRate, uint64_t aCost, unsigned long aNow)
+{
+    unsigned long time = aNow;
+    uint64_t      credit;
+
+    VerifyOrExit(aRate != 0);
+    credit = GetCredit(aBucket, aRate, aNow);
+    VerifyOrExit(credit < aCost);
+    time += static_cast<unsigned long>((aCost - credit + aRate - 1) / aRate);
+
+exit:
+    return time;
+}
+
+} // namespace BorderRouter
+
+} // namespace ot
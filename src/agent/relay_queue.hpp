@@ -0,0 +1,213 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for queueing relayed joiner messages into the Thread network.
+ */
+
+#ifndef RELAY_QUEUE_HPP_
+#define RELAY_QUEUE_HPP_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "forward_table.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+/**
+ * @addtogroup border-router-border-agent
+ *
+ * @{
+ */
+
+/**
+ * This class implements a deficit round robin queue of Relay Transmit messages per joiner router.
+ *
+ * Each joiner router is given up to a quantum of bytes per round, so that a commissioner onboarding many
+ * joiners shares the airtime among their parents. Both the rate of each joiner router and the total rate
+ * are shaped by token buckets.
+ *
+ */
+class RelayQueue
+{
+public:
+    enum
+    {
+        kDefaultRouterRate = 0,    ///< Default bytes per second sent to one joiner router, unlimited.
+        kDefaultTotalRate  = 0,    ///< Default bytes per second sent to all joiner routers, unlimited.
+        kDefaultQuantum    = 256,  ///< Default bytes a joiner router is given per round.
+        kMaxQueueLength    = 64,   ///< Max number of messages queued for one joiner router.
+        kMaxRelaySize      = 1280, ///< Max size of the payload of a message.
+        kBurstInterval     = 500,  ///< Milliseconds of traffic a token bucket may accumulate.
+    };
+
+    /**
+     * This structure represents a queued Relay Transmit message.
+     *
+     */
+    struct Relay
+    {
+        uint16_t             mLocator;                               ///< The joiner router locator.
+        uint8_t              mTokenLength;                           ///< Length of the token.
+        uint8_t              mToken[ForwardTable::kMaxTokenLength];  ///< The token of the message.
+        std::vector<uint8_t> mPayload;                               ///< The payload of the message.
+    };
+
+    /**
+     * The constructor to initialize a relay queue.
+     *
+     * @param[in]   aRouterRate     Bytes per second sent to one joiner router, 0 for unlimited.
+     * @param[in]   aTotalRate      Bytes per second sent to all joiner routers, 0 for unlimited.
+     * @param[in]   aQuantum        Bytes a joiner router is given per round.
+     *
+     */
+    RelayQueue(uint32_t aRouterRate = kDefaultRouterRate, uint32_t aTotalRate = kDefaultTotalRate,
+               uint16_t aQuantum = kDefaultQuantum);
+
+    /**
+     * This method sets the rates.
+     *
+     * @param[in]   aRouterRate     Bytes per second sent to one joiner router, 0 for unlimited.
+     * @param[in]   aTotalRate      Bytes per second sent to all joiner routers, 0 for unlimited.
+     *
+     */
+    void SetRates(uint32_t aRouterRate, uint32_t aTotalRate);
+
+    /**
+     * This method queues a message.
+     *
+     * @param[in]   aLocator            The joiner router locator.
+     * @param[in]   aToken              A pointer to the token.
+     * @param[in]   aTokenLength        The length of the token.
+     * @param[in]   aPayload            A pointer to the payload.
+     * @param[in]   aLength             The length of the payload.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully queued.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the queue of the joiner router is full or the message is too long.
+     *
+     */
+    otbrError Push(uint16_t aLocator, const uint8_t *aToken, uint8_t aTokenLength, const uint8_t *aPayload,
+                   uint16_t aLength);
+
+    /**
+     * This method dequeues the next message allowed by the fairness and the rates.
+     *
+     * @param[in]   aNow        The current timestamp in milliseconds.
+     * @param[out]  aRelay      A reference to receive the message.
+     *
+     * @retval  true    A message is dequeued.
+     * @retval  false   No message may be sent now.
+     *
+     */
+    bool Pop(unsigned long aNow, Relay &aRelay);
+
+    /**
+     * This method returns the earliest time a message may be dequeued.
+     *
+     * @param[in]   aNow        The current timestamp in milliseconds.
+     *
+     * @returns The timestamp in milliseconds, only meaningful if the queue is not empty.
+     *
+     */
+    unsigned long GetNextTime(unsigned long aNow) const;
+
+    /**
+     * This method indicates whether no message is queued.
+     *
+     * @retval  true    No message is queued.
+     * @retval  false   Some message is queued.
+     *
+     */
+    bool IsEmpty(void) const { return mActiveRouters.empty(); }
+
+    /**
+     * This method returns the number of queued messages.
+     *
+     * @returns The number of queued messages.
+     *
+     */
+    size_t GetSize(void) const { return mSize; }
+
+    /**
+     * This method returns the number of joiner routers tracked, either queued or still shaped.
+     *
+     * @returns The number of joiner routers.
+     *
+     */
+    size_t GetNumRouters(void) const { return mRouters.size(); }
+
+private:
+    struct Bucket
+    {
+        uint64_t      mCredit; ///< Available credit in thousandths of bytes.
+        unsigned long mUpdated;
+    };
+
+    struct Router
+    {
+        std::deque<Relay> mRelays;
+        Bucket            mBucket;
+        uint32_t          mDeficit;
+        bool              mGranted; ///< Whether the quantum of the current round was given.
+    };
+
+    typedef std::map<uint16_t, Router> Routers;
+
+    void Rotate(Router &aRouter);
+    void Purge(unsigned long aNow);
+    static uint64_t GetBurst(uint32_t aRate);
+    static uint64_t GetCredit(const Bucket &aBucket, uint32_t aRate, unsigned long aNow);
+    static void Refill(Bucket &aBucket, uint32_t aRate, unsigned long aNow);
+    static unsigned long GetReadyTime(const Bucket &aBucket, uint32_t aRate, uint64_t aCost, unsigned long aNow);
+
+    Routers              mRouters;
+    std::deque<uint16_t> mActiveRouters;
+    Bucket               mBucket;
+    uint32_t             mRouterRate;
+    uint32_t             mTotalRate;
+    uint16_t             mQuantum;
+    size_t               mSize;
+};
+
+/**
+ * @}
+ */
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+#endif  // RELAY_QUEUE_HPP_
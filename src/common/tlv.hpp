@@ -186,19 +186,39 @@ namespace Meshcop {
 
 enum
 {
-    kState                   = 16,
+    kSteeringData            = 8,
     kCommissionerId          = 10,
     kCommissionerSessionId   = 11,
+    kGet                     = 13,
+    kActiveTimestamp         = 14,
+    kState                   = 16,
     kJoinerDtlsEncapsulation = 17,
-    kSteeringData            = 8,
     kJoinerUdpPort           = 18,
     kJoinerIid               = 19,
     kJoinerRouterLocator     = 20,
     kJoinerRouterKek         = 21,
+    kPendingTimestamp        = 51,
+    kChannelMask             = 53,
+    kEnergyList              = 57,
 };
 
 } // namespace Meshcop
 
+namespace NetworkDiagnostic {
+
+enum
+{
+    kExtMacAddress  = 0,
+    kAddress16      = 1,
+    kMode           = 2,
+    kRoute64        = 5,
+    kIp6AddressList = 8,
+    kChildTable     = 16,
+    kTypeList       = 18,
+};
+
+} // namespace NetworkDiagnostic
+
 } // namespace ot
 
 #endif  // TLV_HPP_
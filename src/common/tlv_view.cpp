@@ -0,0 +1,173 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a bounds-checked index of the TLVs of a buffer.
+ */
+
+#include "tlv_view.hpp"
+
+#include <errno.h>
+
+#include "code_utils.hpp"
+
+namespace ot {
+
+enum
+{
+    kSizeOfHeader         = 2, ///< Size of type and length.
+    kSizeOfExtendedHeader = 4, ///< Size of type, escape and extended length.
+    kLengthEscape         = 0xff,
+};
+
+TlvView::TlvView(void) :
+    mBuffer(NULL),
+    mNumTypes(0)
+{
+    memset(mOffsets, 0xff, sizeof(mOffsets));
+}
+
+otbrError TlvView::Init(const uint8_t *aBuffer, uint16_t aLength)
+{
+    otbrError error = OTBR_ERROR_NONE;
+    uint16_t  offset = 0;
+
+    Clear();
+    mBuffer = aBuffer;
+
+    VerifyOrExit(aLength <= kMaxLength, error = OTBR_ERROR_ERRNO; errno = EMSGSIZE);
+
+    while (offset < aLength)
+    {
+        uint16_t remaining = aLength - offset;
+        uint16_t header = kSizeOfHeader;
+        uint16_t length;
+
+        VerifyOrExit(remaining >= kSizeOfHeader, error = OTBR_ERROR_ERRNO; errno = EBADMSG);
+        length = aBuffer[offset + 1];
+
+        if (length == kLengthEscape)
+        {
+            VerifyOrExit(remaining >= kSizeOfExtendedHeader, error = OTBR_ERROR_ERRNO; errno = EBADMSG);
+            header = kSizeOfExtendedHeader;
+            length = static_cast<uint16_t>(aBuffer[offset + 2] << 8 | aBuffer[offset + 3]);
+        }
+
+        VerifyOrExit(length <= remaining - header, error = OTBR_ERROR_ERRNO; errno = EBADMSG);
+
+        if (mOffsets[aBuffer[offset]] == kNotFound)
+        {
+            mOffsets[aBuffer[offset]] = offset;
+            mTypes[mNumTypes++] = aBuffer[offset];
+        }
+
+        offset += header + length;
+    }
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        Clear();
+    }
+
+    return error;
+}
+
+void TlvView::Clear(void)
+{
+    for (uint16_t i = 0; i < mNumTypes; ++i)
+    {
+        mOffsets[mTypes[i]] = kNotFound;
+    }
+
+    mNumTypes = 0;
+}
+
+const uint8_t *TlvView::GetValue(uint8_t aType, uint16_t &aLength) const
+{
+    const uint8_t *value = NULL;
+    const Tlv     *tlv;
+
+    VerifyOrExit(mOffsets[aType] != kNotFound);
+
+    // The TLV was validated to fit in the buffer.
+    tlv = reinterpret_cast<const Tlv *>(mBuffer + mOffsets[aType]);
+    aLength = tlv->GetLength();
+    value = static_cast<const uint8_t *>(tlv->GetValue());
+
+exit:
+    return value;
+}
+
+const uint8_t *TlvView::GetFixed(uint8_t aType, uint16_t aLength) const
+{
+    uint16_t       length = 0;
+    const uint8_t *value = GetValue(aType, length);
+
+    return (value != NULL && length == aLength) ? value : NULL;
+}
+
+bool TlvView::GetUInt8(uint8_t aType, uint8_t &aValue) const
+{
+    const uint8_t *value = GetFixed(aType, sizeof(aValue));
+
+    if (value != NULL)
+    {
+        aValue = value[0];
+    }
+
+    return value != NULL;
+}
+
+bool TlvView::GetUInt16(uint8_t aType, uint16_t &aValue) const
+{
+    const uint8_t *value = GetFixed(aType, sizeof(aValue));
+
+    if (value != NULL)
+    {
+        aValue = static_cast<uint16_t>(value[0] << 8 | value[1]);
+    }
+
+    return value != NULL;
+}
+
+bool TlvView::GetState(int8_t &aState) const
+{
+    uint8_t state;
+    bool    found = GetUInt8(Meshcop::kState, state);
+
+    if (found)
+    {
+        aState = static_cast<int8_t>(state);
+    }
+
+    return found;
+}
+
+} // namespace ot
@@ -0,0 +1,253 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for a bounds-checked index of the TLVs of a buffer.
+ */
+
+#ifndef TLV_VIEW_HPP_
+#define TLV_VIEW_HPP_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tlv.hpp"
+#include "types.hpp"
+
+namespace ot {
+
+/**
+ * This class implements a read-only view of the TLVs of a buffer.
+ *
+ * The buffer is validated once, and the offset of the first TLV of each type is indexed, so that each
+ * lookup takes constant time and never reads past the buffer. The buffer is not copied and must outlive
+ * the view.
+ *
+ */
+class TlvView
+{
+public:
+    enum
+    {
+        kMaxLength = 0xfffe, ///< Max length of a buffer.
+    };
+
+    /**
+     * The constructor to initialize an empty view.
+     *
+     */
+    TlvView(void);
+
+    /**
+     * This method validates a buffer and indexes its TLVs.
+     *
+     * The view is empty if the buffer is malformed.
+     *
+     * @param[in]   aBuffer             A pointer to the TLVs.
+     * @param[in]   aLength             The length of @p aBuffer.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully indexed.
+     * @retval      OTBR_ERROR_ERRNO    Failed for some TLV does not fit in the buffer.
+     *
+     */
+    otbrError Init(const uint8_t *aBuffer, uint16_t aLength);
+
+    /**
+     * This method indicates whether a TLV of a type is present.
+     *
+     * @param[in]   aType   The TLV type.
+     *
+     * @retval  true    The TLV is present.
+     * @retval  false   The TLV is absent.
+     *
+     */
+    bool Contains(uint8_t aType) const { return mOffsets[aType] != kNotFound; }
+
+    /**
+     * This method returns the value of the first TLV of a type.
+     *
+     * @param[in]   aType       The TLV type.
+     * @param[out]  aLength     A reference to receive the length of the value.
+     *
+     * @returns A pointer to the value, or NULL if absent.
+     *
+     */
+    const uint8_t *GetValue(uint8_t aType, uint16_t &aLength) const;
+
+    /**
+     * This method returns the value of the first TLV of a type as a uint8_t.
+     *
+     * @param[in]   aType       The TLV type.
+     * @param[out]  aValue      A reference to receive the value.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or its length is not 1.
+     *
+     */
+    bool GetUInt8(uint8_t aType, uint8_t &aValue) const;
+
+    /**
+     * This method returns the value of the first TLV of a type as a uint16_t.
+     *
+     * @param[in]   aType       The TLV type.
+     * @param[out]  aValue      A reference to receive the value.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or its length is not 2.
+     *
+     */
+    bool GetUInt16(uint8_t aType, uint16_t &aValue) const;
+
+    /**
+     * This method returns the value of the first TLV of a type if it has an exact length.
+     *
+     * @param[in]   aType       The TLV type.
+     * @param[in]   aLength     The expected length of the value.
+     *
+     * @returns A pointer to the value, or NULL if absent or of another length.
+     *
+     */
+    const uint8_t *GetFixed(uint8_t aType, uint16_t aLength) const;
+
+    /**
+     * This method returns the State TLV.
+     *
+     * @param[out]  aState      A reference to receive the state.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or malformed.
+     *
+     */
+    bool GetState(int8_t &aState) const;
+
+    /**
+     * This method returns the Commissioner Session ID TLV.
+     *
+     * @param[out]  aSessionId  A reference to receive the value.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or malformed.
+     *
+     */
+    bool GetCommissionerSessionId(uint16_t &aSessionId) const
+    {
+        return GetUInt16(Meshcop::kCommissionerSessionId, aSessionId);
+    }
+
+    /**
+     * This method returns the Joiner UDP Port TLV.
+     *
+     * @param[out]  aPort       A reference to receive the value.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or malformed.
+     *
+     */
+    bool GetJoinerUdpPort(uint16_t &aPort) const { return GetUInt16(Meshcop::kJoinerUdpPort, aPort); }
+
+    /**
+     * This method returns the Joiner Router Locator TLV.
+     *
+     * @param[out]  aLocator    A reference to receive the value.
+     *
+     * @retval  true    Successfully read.
+     * @retval  false   The TLV is absent or malformed.
+     *
+     */
+    bool GetJoinerRouterLocator(uint16_t &aLocator) const { return GetUInt16(Meshcop::kJoinerRouterLocator, aLocator); }
+
+    /**
+     * This method returns the Joiner IID TLV.
+     *
+     * @returns A pointer to the value, or NULL if absent or malformed.
+     *
+     */
+    const uint8_t *GetJoinerIid(void) const { return GetFixed(Meshcop::kJoinerIid, kSizeOfJoinerIid); }
+
+    /**
+     * This method returns the Joiner Router KEK TLV.
+     *
+     * @returns A pointer to the value, or NULL if absent or malformed.
+     *
+     */
+    const uint8_t *GetJoinerRouterKek(void) const { return GetFixed(Meshcop::kJoinerRouterKek, kSizeOfKek); }
+
+    /**
+     * This method returns the Commissioner ID TLV.
+     *
+     * @param[out]  aLength     A reference to receive the length of the value.
+     *
+     * @returns A pointer to the value, or NULL if absent.
+     *
+     */
+    const uint8_t *GetCommissionerId(uint16_t &aLength) const { return GetValue(Meshcop::kCommissionerId, aLength); }
+
+    /**
+     * This method returns the Steering Data TLV.
+     *
+     * @param[out]  aLength     A reference to receive the length of the value.
+     *
+     * @returns A pointer to the value, or NULL if absent.
+     *
+     */
+    const uint8_t *GetSteeringData(uint16_t &aLength) const { return GetValue(Meshcop::kSteeringData, aLength); }
+
+    /**
+     * This method returns the Joiner DTLS Encapsulation TLV.
+     *
+     * @param[out]  aLength     A reference to receive the length of the value.
+     *
+     * @returns A pointer to the value, or NULL if absent.
+     *
+     */
+    const uint8_t *GetJoinerDtlsEncapsulation(uint16_t &aLength) const
+    {
+        return GetValue(Meshcop::kJoinerDtlsEncapsulation, aLength);
+    }
+
+private:
+    enum
+    {
+        kNotFound        = 0xffff,
+        kNumTypes        = 256,
+        kSizeOfJoinerIid = 8,
+        kSizeOfKek       = 16,
+    };
+
+    void Clear(void);
+
+    const uint8_t *mBuffer;
+    uint16_t       mNumTypes;
+    uint8_t        mTypes[kNumTypes];   ///< Types present, so that the index is cleared without a full pass.
+    uint16_t       mOffsets[kNumTypes]; ///< Offset of the first TLV of each type.
+};
+
+} // namespace ot
+
+#endif  // TLV_VIEW_HPP_
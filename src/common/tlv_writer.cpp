@@ -0,0 +1,112 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements composing TLVs in place.
+ */
+
+#include "tlv_writer.hpp"
+
+#include <errno.h>
+
+#include "code_utils.hpp"
+
+namespace ot {
+
+enum
+{
+    kSizeOfHeader         = 2, ///< Size of type and length.
+    kSizeOfExtendedHeader = 4, ///< Size of type, escape and extended length.
+    kLengthEscape         = 0xff,
+};
+
+TlvWriter::TlvWriter(uint8_t *aBuffer, uint16_t aSize) :
+    mBuffer(aBuffer),
+    mSize(aSize),
+    mLength(0),
+    mError(OTBR_ERROR_NONE)
+{
+}
+
+uint8_t *TlvWriter::Reserve(uint8_t aType, uint16_t aLength)
+{
+    uint8_t *value = NULL;
+    uint16_t header = (aLength < kLengthEscape) ? kSizeOfHeader : kSizeOfExtendedHeader;
+    uint8_t *cursor = mBuffer + mLength;
+
+    VerifyOrExit(mError == OTBR_ERROR_NONE);
+    VerifyOrExit(mSize - mLength >= header && mSize - mLength - header >= aLength,
+                 mError = OTBR_ERROR_ERRNO; errno = ENOBUFS);
+
+    cursor[0] = aType;
+
+    if (header == kSizeOfHeader)
+    {
+        cursor[1] = static_cast<uint8_t>(aLength);
+    }
+    else
+    {
+        cursor[1] = kLengthEscape;
+        cursor[2] = static_cast<uint8_t>(aLength >> 8);
+        cursor[3] = static_cast<uint8_t>(aLength & 0xff);
+    }
+
+    value = cursor + header;
+    mLength += header + aLength;
+
+exit:
+    return value;
+}
+
+otbrError TlvWriter::Append(uint8_t aType, const void *aValue, uint16_t aLength)
+{
+    uint8_t *value = Reserve(aType, aLength);
+
+    if (value != NULL && aLength > 0)
+    {
+        memcpy(value, aValue, aLength);
+    }
+
+    return mError;
+}
+
+otbrError TlvWriter::AppendUInt16(uint8_t aType, uint16_t aValue)
+{
+    uint8_t *value = Reserve(aType, sizeof(aValue));
+
+    if (value != NULL)
+    {
+        value[0] = static_cast<uint8_t>(aValue >> 8);
+        value[1] = static_cast<uint8_t>(aValue & 0xff);
+    }
+
+    return mError;
+}
+
+} // namespace ot
@@ -0,0 +1,256 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for composing TLVs in place.
+ */
+
+#ifndef TLV_WRITER_HPP_
+#define TLV_WRITER_HPP_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "tlv.hpp"
+#include "types.hpp"
+
+namespace ot {
+
+/**
+ * This class implements appending TLVs to a buffer, e.g. the payload buffer of a CoAP message.
+ *
+ * Extended lengths are used for values of 255 bytes or more. Failures are sticky, so that a payload may be
+ * composed by several appends and checked once. The typed MeshCoP appenders only accept values of their exact
+ * types, any other argument type fails to compile.
+ *
+ */
+class TlvWriter
+{
+public:
+    /**
+     * The constructor to initialize a TLV writer.
+     *
+     * @param[in]   aBuffer     A pointer to the buffer to write to.
+     * @param[in]   aSize       The size of @p aBuffer.
+     *
+     */
+    TlvWriter(uint8_t *aBuffer, uint16_t aSize);
+
+    /**
+     * This method appends a TLV.
+     *
+     * @param[in]   aType               The TLV type.
+     * @param[in]   aValue              A pointer to the value.
+     * @param[in]   aLength             The length of the value.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully appended.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the buffer is full, or a previous append failed.
+     *
+     */
+    otbrError Append(uint8_t aType, const void *aValue, uint16_t aLength);
+
+    /**
+     * This method appends a TLV of a uint8_t value.
+     *
+     * @param[in]   aType               The TLV type.
+     * @param[in]   aValue              The value.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully appended.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the buffer is full, or a previous append failed.
+     *
+     */
+    otbrError AppendUInt8(uint8_t aType, uint8_t aValue) { return Append(aType, &aValue, sizeof(aValue)); }
+
+    /**
+     * This method appends a TLV of a uint16_t value in network byte order.
+     *
+     * @param[in]   aType               The TLV type.
+     * @param[in]   aValue              The value.
+     *
+     * @retval      OTBR_ERROR_NONE     Successfully appended.
+     * @retval      OTBR_ERROR_ERRNO    Failed for the buffer is full, or a previous append failed.
+     *
+     */
+    otbrError AppendUInt16(uint8_t aType, uint16_t aValue);
+
+    /**
+     * This method appends the header of a TLV and reserves its value, to be written in place by the caller.
+     *
+     * @param[in]   aType       The TLV type.
+     * @param[in]   aLength     The length of the value.
+     *
+     * @returns A pointer to the value, or NULL if the buffer is full or a previous append failed.
+     *
+     */
+    uint8_t *Reserve(uint8_t aType, uint16_t aLength);
+
+    /**
+     * This method returns the length of the TLVs written.
+     *
+     * @returns The length of the TLVs written.
+     *
+     */
+    uint16_t GetLength(void) const { return mLength; }
+
+    /**
+     * This method returns the result of all appends.
+     *
+     * @retval      OTBR_ERROR_NONE     All appends succeeded.
+     * @retval      OTBR_ERROR_ERRNO    Some append failed.
+     *
+     */
+    otbrError GetError(void) const { return mError; }
+
+    /**
+     * This method appends a State TLV.
+     *
+     * @param[in]   aState      The state, 1 for accept, 0 for pending and -1 for reject.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendState(int8_t aState) { return AppendUInt8(Meshcop::kState, static_cast<uint8_t>(aState)); }
+
+    /**
+     * This method appends a Commissioner ID TLV.
+     *
+     * @param[in]   aId         A pointer to the commissioner ID, which is not NULL terminated in the TLV.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendCommissionerId(const char *aId)
+    {
+        return Append(Meshcop::kCommissionerId, aId, static_cast<uint16_t>(strlen(aId)));
+    }
+
+    /**
+     * This method appends a Commissioner Session ID TLV.
+     *
+     * @param[in]   aSessionId  The commissioner session ID.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendCommissionerSessionId(uint16_t aSessionId)
+    {
+        return AppendUInt16(Meshcop::kCommissionerSessionId, aSessionId);
+    }
+
+    /**
+     * This method appends a Steering Data TLV.
+     *
+     * @param[in]   aData       A pointer to the steering data.
+     * @param[in]   aLength     The length of the steering data.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendSteeringData(const uint8_t *aData, uint8_t aLength)
+    {
+        return Append(Meshcop::kSteeringData, aData, aLength);
+    }
+
+    /**
+     * This method appends a Joiner UDP Port TLV.
+     *
+     * @param[in]   aPort       The UDP port of the joiner.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendJoinerUdpPort(uint16_t aPort) { return AppendUInt16(Meshcop::kJoinerUdpPort, aPort); }
+
+    /**
+     * This method appends a Joiner IID TLV.
+     *
+     * @param[in]   aIid        The interface identifier of the joiner.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendJoinerIid(const uint8_t (&aIid)[8]) { return Append(Meshcop::kJoinerIid, aIid, sizeof(aIid)); }
+
+    /**
+     * This method appends a Joiner Router Locator TLV.
+     *
+     * @param[in]   aLocator    The RLOC16 of the joiner router.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendJoinerRouterLocator(uint16_t aLocator)
+    {
+        return AppendUInt16(Meshcop::kJoinerRouterLocator, aLocator);
+    }
+
+    /**
+     * This method appends a Joiner Router KEK TLV.
+     *
+     * @param[in]   aKek        The key encryption key.
+     *
+     * @returns The result as Append().
+     *
+     */
+    otbrError AppendJoinerRouterKek(const uint8_t (&aKek)[16])
+    {
+        return Append(Meshcop::kJoinerRouterKek, aKek, sizeof(aKek));
+    }
+
+    /**
+     * This method reserves a Joiner DTLS Encapsulation TLV, to receive a DTLS record in place.
+     *
+     * @param[in]   aLength     The length of the DTLS record.
+     *
+     * @returns The result as Reserve().
+     *
+     */
+    uint8_t *ReserveJoinerDtlsEncapsulation(uint16_t aLength)
+    {
+        return Reserve(Meshcop::kJoinerDtlsEncapsulation, aLength);
+    }
+
+private:
+    // Declared only, so that arguments of other types than the typed appenders take do not compile.
+    template <typename Type> otbrError AppendState(Type aState);
+    template <typename Type> otbrError AppendCommissionerSessionId(Type aSessionId);
+    template <typename Type> otbrError AppendJoinerUdpPort(Type aPort);
+    template <typename Type> otbrError AppendJoinerRouterLocator(Type aLocator);
+    template <typename Type> otbrError AppendJoinerIid(const Type &aIid);
+    template <typename Type> otbrError AppendJoinerRouterKek(const Type &aKek);
+
+    uint8_t  *mBuffer;
+    uint16_t  mSize;
+    uint16_t  mLength;
+    otbrError mError;
+};
+
+} // namespace ot
+
+#endif  // TLV_WRITER_HPP_
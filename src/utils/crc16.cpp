@@ -33,33 +33,255 @@
 
 #include "crc16.hpp"
 
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OTBR_CRC16_CLMUL 1
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#else
+#define OTBR_CRC16_CLMUL 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO) && defined(__linux__) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define OTBR_CRC16_PMULL 1
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#else
+#define OTBR_CRC16_PMULL 0
+#endif
+
 namespace ot {
 
+enum
+{
+    kNumSlices = 8,
+};
+
+// Table k holds the CRC of each byte followed by k zero bytes.
+static uint16_t sCcittTables[kNumSlices][256];
+static uint16_t sAnsiTables[kNumSlices][256];
+
+static void InitTables(uint16_t aPolynomial, uint16_t (*aTables)[256])
+{
+    for (unsigned byte = 0; byte < 256; byte++)
+    {
+        uint16_t crc = static_cast<uint16_t>(byte << 8);
+
+        for (int i = 0; i < 8; i++)
+        {
+            crc = static_cast<uint16_t>(crc << 1) ^ ((crc & 0x8000) ? aPolynomial : 0);
+        }
+
+        aTables[0][byte] = crc;
+    }
+
+    for (int k = 1; k < kNumSlices; k++)
+    {
+        for (unsigned byte = 0; byte < 256; byte++)
+        {
+            uint16_t crc = aTables[k - 1][byte];
+
+            aTables[k][byte] = static_cast<uint16_t>((crc << 8) ^ aTables[0][crc >> 8]);
+        }
+    }
+}
+
+static bool InitAllTables(void)
+{
+    InitTables(Crc16::kCcitt, sCcittTables);
+    InitTables(Crc16::kAnsi, sAnsiTables);
+
+    return true;
+}
+
+// The tables are filled once on first use, the function-local static making it safe across threads.
+static void EnsureTables(void)
+{
+    static const bool sInitialized = InitAllTables();
+
+    (void)sInitialized;
+}
+
+// The CRC of a block feeds no initial CRC, so it is the xor of each byte followed by the number of bytes after it.
+static inline uint16_t ComputeBlock(const uint16_t (*aTables)[256], const uint8_t *aBlock)
+{
+    return aTables[7][aBlock[0]] ^ aTables[6][aBlock[1]] ^ aTables[5][aBlock[2]] ^ aTables[4][aBlock[3]] ^
+           aTables[3][aBlock[4]] ^ aTables[2][aBlock[5]] ^ aTables[1][aBlock[6]] ^ aTables[0][aBlock[7]];
+}
+
+static void ComputeBlocksTable(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi)
+{
+    EnsureTables();
+
+    for (size_t i = 0; i < aCount; i++, aBlocks += Crc16::kSizeOfBlock)
+    {
+        aCcitt[i] = ComputeBlock(sCcittTables, aBlocks);
+        aAnsi[i] = ComputeBlock(sAnsiTables, aBlocks);
+    }
+}
+
+// With the block B as a polynomial of degree less than 64, the CRC is B * x^16 mod P, which is computed by Barrett
+// reduction with MU = floor(x^80 / P): the quotient is floor(B * MU / x^64), and the CRC the low 16 bits of the
+// quotient times P. Both MU and P have their leading terms implicit, the x^64 term of MU adds B to the quotient.
+static const uint64_t kCcittMu = 0x11303471a041b343ULL;
+static const uint64_t kAnsiMu = 0xfffbffe7ffaffe1fULL;
+
+#if OTBR_CRC16_CLMUL
+__attribute__((target("pclmul,sse2")))
+static void ComputeBlocksClmul(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi)
+{
+    const __m128i mu = _mm_set_epi64x(static_cast<long long>(kAnsiMu), static_cast<long long>(kCcittMu));
+    const __m128i polynomial = _mm_set_epi64x(Crc16::kAnsi, Crc16::kCcitt);
+
+    for (size_t i = 0; i < aCount; i++, aBlocks += Crc16::kSizeOfBlock)
+    {
+        uint64_t block;
+        __m128i  value;
+        __m128i  ccitt;
+        __m128i  ansi;
+
+        memcpy(&block, aBlocks, sizeof(block));
+        value = _mm_set_epi64x(0, static_cast<long long>(__builtin_bswap64(block)));
+
+        ccitt = _mm_xor_si128(_mm_srli_si128(_mm_clmulepi64_si128(value, mu, 0x00), 8), value);
+        ansi = _mm_xor_si128(_mm_srli_si128(_mm_clmulepi64_si128(value, mu, 0x10), 8), value);
+        aCcitt[i] = static_cast<uint16_t>(_mm_cvtsi128_si32(_mm_clmulepi64_si128(ccitt, polynomial, 0x00)));
+        aAnsi[i] = static_cast<uint16_t>(_mm_cvtsi128_si32(_mm_clmulepi64_si128(ansi, polynomial, 0x10)));
+    }
+}
+#endif // OTBR_CRC16_CLMUL
+
+#if OTBR_CRC16_PMULL
+static inline uint16_t ReducePmull(poly64_t aValue, poly64_t aMu, poly64_t aPolynomial)
+{
+    poly64_t quotient = vgetq_lane_p64(vreinterpretq_p64_p128(vmull_p64(aValue, aMu)), 1) ^ aValue;
+
+    return static_cast<uint16_t>(vgetq_lane_p64(vreinterpretq_p64_p128(vmull_p64(quotient, aPolynomial)), 0));
+}
+
+static void ComputeBlocksPmull(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi)
+{
+    for (size_t i = 0; i < aCount; i++, aBlocks += Crc16::kSizeOfBlock)
+    {
+        uint64_t block;
+
+        memcpy(&block, aBlocks, sizeof(block));
+        block = __builtin_bswap64(block);
+
+        aCcitt[i] = ReducePmull(block, kCcittMu, Crc16::kCcitt);
+        aAnsi[i] = ReducePmull(block, kAnsiMu, Crc16::kAnsi);
+    }
+}
+#endif // OTBR_CRC16_PMULL
+
 Crc16::Crc16(Polynomial aPolynomial)
 {
-    mPolynomial = static_cast<uint16_t>(aPolynomial);
+    EnsureTables();
+    mTables = (aPolynomial == kCcitt) ? sCcittTables : sAnsiTables;
     Init();
 }
 
-void Crc16::Update(uint8_t aByte)
+void Crc16::Update(const uint8_t *aBuffer, size_t aLength)
 {
-    uint8_t i;
+    for (; aLength >= kNumSlices; aLength -= kNumSlices, aBuffer += kNumSlices)
+    {
+        // The CRC so far only affects the first two bytes.
+        mCrc = mTables[7][aBuffer[0] ^ (mCrc >> 8)] ^ mTables[6][aBuffer[1] ^ (mCrc & 0xff)] ^
+               mTables[5][aBuffer[2]] ^ mTables[4][aBuffer[3]] ^ mTables[3][aBuffer[4]] ^ mTables[2][aBuffer[5]] ^
+               mTables[1][aBuffer[6]] ^ mTables[0][aBuffer[7]];
+    }
 
-    mCrc = mCrc ^ static_cast<uint16_t>(aByte << 8);
-    i = 8;
+    for (; aLength > 0; aLength--, aBuffer++)
+    {
+        Update(*aBuffer);
+    }
+}
 
-    do
+bool Crc16::IsSupported(Backend aBackend)
+{
+    bool ret = false;
+
+    switch (aBackend)
     {
-        if (mCrc & 0x8000)
-        {
-            mCrc = static_cast<uint16_t>(mCrc << 1) ^ mPolynomial;
-        }
-        else
+    case kBackendTable:
+        ret = true;
+        break;
+
+    case kBackendClmul:
+#if OTBR_CRC16_CLMUL
         {
-            mCrc = static_cast<uint16_t>(mCrc << 1);
+            unsigned int eax, ebx, ecx, edx;
+
+            ret = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL) != 0;
         }
+#endif
+        break;
+
+    case kBackendPmull:
+#if OTBR_CRC16_PMULL
+        ret = (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#endif
+        break;
+    }
+
+    return ret;
+}
+
+const char *Crc16::BackendToString(Backend aBackend)
+{
+    const char *name = "unknown";
+
+    switch (aBackend)
+    {
+    case kBackendTable:
+        name = "table";
+        break;
+
+    case kBackendClmul:
+        name = "clmul";
+        break;
+
+    case kBackendPmull:
+        name = "pmull";
+        break;
+    }
+
+    return name;
+}
+
+void Crc16::ComputeBlocks(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi,
+                          Backend aBackend)
+{
+    switch (aBackend)
+    {
+#if OTBR_CRC16_CLMUL
+    case kBackendClmul:
+        ComputeBlocksClmul(aBlocks, aCount, aCcitt, aAnsi);
+        break;
+#endif
+
+#if OTBR_CRC16_PMULL
+    case kBackendPmull:
+        ComputeBlocksPmull(aBlocks, aCount, aCcitt, aAnsi);
+        break;
+#endif
+
+    default:
+        ComputeBlocksTable(aBlocks, aCount, aCcitt, aAnsi);
+        break;
     }
-    while (--i);
+}
+
+void Crc16::ComputeBlocks(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi)
+{
+    static const Backend sBackend = IsSupported(kBackendClmul) ? kBackendClmul :
+                                    (IsSupported(kBackendPmull) ? kBackendPmull : kBackendTable);
+
+    ComputeBlocks(aBlocks, aCount, aCcitt, aAnsi, sBackend);
 }
 
 } // namespace ot
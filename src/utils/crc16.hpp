@@ -34,6 +34,7 @@
 #ifndef CRC16_HPP_
 #define CRC16_HPP_
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace ot {
@@ -41,6 +42,9 @@ namespace ot {
 /**
  * This class implements CRC16 computations.
  *
+ * Bytes are processed with a table, and buffers eight bytes at a time with eight tables (slice-by-8). Batches of
+ * 8-byte blocks such as joiner IDs may also be processed with carry-less multiplication where available.
+ *
  */
 class Crc16
 {
@@ -51,6 +55,22 @@ public:
         kAnsi  = 0x8005, ///< CRC16-ANSI
     };
 
+    /**
+     * This enumeration defines the implementations of ComputeBlocks().
+     *
+     */
+    enum Backend
+    {
+        kBackendTable = 0, ///< Slice-by-8 tables.
+        kBackendClmul = 1, ///< x86 PCLMULQDQ.
+        kBackendPmull = 2, ///< ARMv8 PMULL.
+    };
+
+    enum
+    {
+        kSizeOfBlock = 8, ///< Size of blocks of ComputeBlocks() in bytes.
+    };
+
     /**
      * This constructor initializes the object.
      *
@@ -65,13 +85,22 @@ public:
      */
     void Init(void) { mCrc = 0; }
 
-    /*c*
+    /**
      * This method feeds a byte value into the CRC16 computation.
      *
      * @param[in]  aByte  The byte value.
      *
      */
-    void Update(uint8_t aByte);
+    void Update(uint8_t aByte) { mCrc = static_cast<uint16_t>((mCrc << 8) ^ mTables[0][(mCrc >> 8) ^ aByte]); }
+
+    /**
+     * This method feeds bytes into the CRC16 computation.
+     *
+     * @param[in]  aBuffer  A pointer to the bytes.
+     * @param[in]  aLength  The number of bytes.
+     *
+     */
+    void Update(const uint8_t *aBuffer, size_t aLength);
 
     /**
      * This method gets the current CRC16 value.
@@ -81,8 +110,53 @@ public:
      */
     uint16_t Get(void) const { return mCrc; }
 
+    /**
+     * This method computes the CRC16-CCITT and CRC16-ANSI of each of consecutive 8-byte blocks, with the fastest
+     * backend supported.
+     *
+     * @param[in]   aBlocks     A pointer to the blocks.
+     * @param[in]   aCount      The number of blocks.
+     * @param[out]  aCcitt      A pointer to an array of @p aCount to receive the CRC16-CCITTs.
+     * @param[out]  aAnsi       A pointer to an array of @p aCount to receive the CRC16-ANSIs.
+     *
+     */
+    static void ComputeBlocks(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi);
+
+    /**
+     * This method computes the CRC16-CCITT and CRC16-ANSI of each of consecutive 8-byte blocks.
+     *
+     * @param[in]   aBlocks     A pointer to the blocks.
+     * @param[in]   aCount      The number of blocks.
+     * @param[out]  aCcitt      A pointer to an array of @p aCount to receive the CRC16-CCITTs.
+     * @param[out]  aAnsi       A pointer to an array of @p aCount to receive the CRC16-ANSIs.
+     * @param[in]   aBackend    The backend, which must be supported.
+     *
+     */
+    static void ComputeBlocks(const uint8_t *aBlocks, size_t aCount, uint16_t *aCcitt, uint16_t *aAnsi,
+                              Backend aBackend);
+
+    /**
+     * This method indicates whether a backend is supported by this build and processor.
+     *
+     * @param[in]   aBackend    The backend.
+     *
+     * @returns Whether the backend is supported.
+     *
+     */
+    static bool IsSupported(Backend aBackend);
+
+    /**
+     * This method returns the name of a backend.
+     *
+     * @param[in]   aBackend    The backend.
+     *
+     * @returns The name of the backend.
+     *
+     */
+    static const char *BackendToString(Backend aBackend);
+
 private:
-    uint16_t mPolynomial;
+    const uint16_t (*mTables)[256];
     uint16_t mCrc;
 };
 
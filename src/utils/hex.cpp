@@ -33,98 +33,284 @@
 
 #include "hex.hpp"
 
-#include <string>
-
-#include <stdio.h>
 #include <string.h>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OTBR_HEX_SSSE3 1
+#include <cpuid.h>
+#include <tmmintrin.h>
+#else
+#define OTBR_HEX_SSSE3 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define OTBR_HEX_NEON 1
+#include <arm_neon.h>
+#else
+#define OTBR_HEX_NEON 0
+#endif
+
 namespace ot {
 
 namespace Utils {
 
-int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength)
+enum
+{
+    kSizeOfVector = 16, ///< Number of bytes converted at a time by the vector kernels.
+};
+
+static const char kHexDigits[] = "0123456789ABCDEF";
+
+// The value of each hex digit, -1 for other chars.
+static const int8_t kNibbles[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+#if OTBR_HEX_SSSE3
+static bool HasSsse3(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSSE3) != 0;
+}
+
+// Conversions made by other static initializers before this one use the scalar code.
+static const bool sHasSsse3 = HasSsse3();
+
+__attribute__((target("ssse3")))
+static void EncodeSsse3(const uint8_t *aBytes, char *aHex)
+{
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(kHexDigits));
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i       bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBytes));
+    __m128i       high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), mask));
+    __m128i       low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, mask));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aHex), _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aHex + kSizeOfVector), _mm_unpackhi_epi8(high, low));
+}
+
+/**
+ * This function converts 16 hex chars to the nibbles of 8 bytes, the high nibbles in even lanes.
+ *
+ */
+__attribute__((target("ssse3")))
+static __m128i DecodeNibblesSsse3(__m128i aHex, __m128i &aValid)
+{
+    __m128i digit = _mm_sub_epi8(aHex, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(aHex, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    aValid = _mm_and_si128(aValid, _mm_or_si128(isDigit, isLetter));
+
+    return _mm_or_si128(_mm_and_si128(isDigit, digit),
+                        _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+static bool DecodeSsse3(const char *aHex, uint8_t *aBytes)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110); // 16 for the high nibble, 1 for the low one.
+    __m128i       valid = _mm_set1_epi8(-1);
+    __m128i       first = DecodeNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(aHex)), valid);
+    __m128i       second =
+        DecodeNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(aHex + kSizeOfVector)), valid);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aBytes),
+                     _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights)));
+
+    return _mm_movemask_epi8(valid) == 0xffff;
+}
+#endif // OTBR_HEX_SSSE3
+
+#if OTBR_HEX_NEON
+static void EncodeNeon(const uint8_t *aBytes, char *aHex)
+{
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t *>(kHexDigits));
+    uint8x16_t       bytes = vld1q_u8(aBytes);
+    uint8x16x2_t     hex;
+
+    hex.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+    hex.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0f)));
+    vst2q_u8(reinterpret_cast<uint8_t *>(aHex), hex);
+}
+
+static uint8x16_t DecodeNibblesNeon(uint8x16_t aHex, uint8x16_t &aValid)
+{
+    uint8x16_t digit = vsubq_u8(aHex, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(aHex, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+
+    aValid = vandq_u8(aValid, vorrq_u8(isDigit, isLetter));
+
+    return vorrq_u8(vandq_u8(isDigit, digit), vandq_u8(isLetter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+static bool DecodeNeon(const char *aHex, uint8_t *aBytes)
 {
-    size_t      hexLength = strlen(aHex);
-    const char *hexEnd = aHex + hexLength;
-    uint8_t    *cur = aBytes;
-    uint8_t     numChars = hexLength & 1;
-    uint8_t     byte = 0;
+    uint8x16x2_t hex = vld2q_u8(reinterpret_cast<const uint8_t *>(aHex));
+    uint8x16_t   valid = vdupq_n_u8(0xff);
+    uint8x16_t   high = DecodeNibblesNeon(hex.val[0], valid);
+    uint8x16_t   low = DecodeNibblesNeon(hex.val[1], valid);
+
+    vst1q_u8(aBytes, vorrq_u8(vshlq_n_u8(high, 4), low));
+
+    return vminvq_u8(valid) == 0xff;
+}
+#endif // OTBR_HEX_NEON
 
-    if ((hexLength + 1) / 2 > aBytesLength)
+static void Encode(const uint8_t *aBytes, uint16_t aBytesLength, char *aHex)
+{
+#if OTBR_HEX_SSSE3
+    if (sHasSsse3)
+    {
+        for (; aBytesLength >= kSizeOfVector; aBytesLength -= kSizeOfVector)
+        {
+            EncodeSsse3(aBytes, aHex);
+            aBytes += kSizeOfVector;
+            aHex += 2 * kSizeOfVector;
+        }
+    }
+#elif OTBR_HEX_NEON
+    for (; aBytesLength >= kSizeOfVector; aBytesLength -= kSizeOfVector)
+    {
+        EncodeNeon(aBytes, aHex);
+        aBytes += kSizeOfVector;
+        aHex += 2 * kSizeOfVector;
+    }
+#endif
+
+    for (; aBytesLength > 0; aBytesLength--)
+    {
+        *aHex++ = kHexDigits[*aBytes >> 4];
+        *aHex++ = kHexDigits[*aBytes++ & 0x0f];
+    }
+
+    *aHex = '\0';
+}
+
+int Hex2Bytes(const char *aHex, size_t aHexLength, uint8_t *aBytes, uint16_t aBytesLength)
+{
+    uint8_t *cur = aBytes;
+
+    if ((aHexLength + 1) / 2 > aBytesLength)
     {
         return -1;
     }
 
-    while (aHex < hexEnd)
+    if (aHexLength & 1)
     {
-        if ('A' <= *aHex && *aHex <= 'F')
-        {
-            byte |= 10 + (*aHex - 'A');
-        }
-        else if ('a' <= *aHex && *aHex <= 'f')
+        int8_t nibble = kNibbles[static_cast<uint8_t>(*aHex++)];
+
+        if (nibble < 0)
         {
-            byte |= 10 + (*aHex - 'a');
+            return -1;
         }
-        else if ('0' <= *aHex && *aHex <= '9')
+
+        *cur++ = static_cast<uint8_t>(nibble);
+        aHexLength--;
+    }
+
+#if OTBR_HEX_SSSE3
+    if (sHasSsse3)
+    {
+        for (; aHexLength >= 2 * kSizeOfVector; aHexLength -= 2 * kSizeOfVector)
         {
-            byte |= *aHex - '0';
+            if (!DecodeSsse3(aHex, cur))
+            {
+                return -1;
+            }
+
+            aHex += 2 * kSizeOfVector;
+            cur += kSizeOfVector;
         }
-        else
+    }
+#elif OTBR_HEX_NEON
+    for (; aHexLength >= 2 * kSizeOfVector; aHexLength -= 2 * kSizeOfVector)
+    {
+        if (!DecodeNeon(aHex, cur))
         {
             return -1;
         }
 
-        aHex++;
-        numChars++;
+        aHex += 2 * kSizeOfVector;
+        cur += kSizeOfVector;
+    }
+#endif
 
-        if (numChars >= 2)
-        {
-            numChars = 0;
-            *cur++ = byte;
-            byte = 0;
-        }
-        else
+    for (; aHexLength > 0; aHexLength -= 2)
+    {
+        int8_t high = kNibbles[static_cast<uint8_t>(*aHex++)];
+        int8_t low = kNibbles[static_cast<uint8_t>(*aHex++)];
+
+        if ((high | low) < 0)
         {
-            byte <<= 4;
+            return -1;
         }
+
+        *cur++ = static_cast<uint8_t>((high << 4) | low);
     }
 
     return static_cast<int>(cur - aBytes);
 }
 
-int Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex)
+int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength)
 {
-    char byteHex[3];
-
-    std::string hexString;
-    uint8_t     cur[aBytesLength];
-
-    memcpy(cur, aBytes, aBytesLength);
+    return Hex2Bytes(aHex, strlen(aHex), aBytes, aBytesLength);
+}
 
-    for (int i = 0; i < aBytesLength; i++)
+int Bytes2Hex(const uint8_t *aBytes, uint16_t aBytesLength, char *aHex, size_t aHexSize)
+{
+    if (aHexSize < 2 * static_cast<size_t>(aBytesLength) + 1)
     {
-        sprintf(byteHex, "%02X", cur[i]);
-        hexString += byteHex;
+        return -1;
     }
-    strcpy(aHex, hexString.c_str());
-    return strlen(aHex);
+
+    Encode(aBytes, aBytesLength, aHex);
+
+    return 2 * aBytesLength;
 }
 
-int Long2Hex(const uint64_t aLong, char *aHex)
+int Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex)
+{
+    Encode(aBytes, aBytesLength, aHex);
+
+    return 2 * aBytesLength;
+}
+
+int Long2Hex(uint64_t aLong, char *aHex, size_t aHexSize)
 {
-    std::string hexString;
-    char        byteHex[3];
-    uint64_t    longValue = aLong;
+    uint8_t bytes[sizeof(uint64_t)];
 
     for (uint8_t i = 0; i < sizeof(uint64_t); i++)
     {
-        uint8_t byte = longValue & 0xff;
-        sprintf(byteHex, "%02X", byte);
-        hexString += byteHex;
-        longValue = longValue >> 8;
+        bytes[i] = static_cast<uint8_t>(aLong);
+        aLong >>= 8;
     }
-    strcpy(aHex, hexString.c_str());
-    return strlen(aHex);
+
+    return Bytes2Hex(bytes, sizeof(bytes), aHex, aHexSize);
+}
+
+int Long2Hex(const uint64_t aLong, char *aHex)
+{
+    return Long2Hex(aLong, aHex, 2 * sizeof(uint64_t) + 1);
 }
 
 } // namespace Utils
@@ -34,18 +34,89 @@
 #ifndef HEX_HPP
 #define HEX_HPP
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace ot {
 
 namespace Utils {
 
+/**
+ * This function converts a hex string to bytes.
+ *
+ * A hex string of odd length is converted as if it had a leading zero.
+ *
+ * @param[in]   aHex            A pointer to the null-terminated hex string, in upper or lower case.
+ * @param[out]  aBytes          A pointer to the buffer to receive the bytes.
+ * @param[in]   aBytesLength    The size of @p aBytes.
+ *
+ * @returns The number of bytes converted, -1 if @p aHex is not hex or @p aBytes is too small.
+ *
+ */
 int Hex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength);
 
+/**
+ * This function converts a hex string of a given length to bytes.
+ *
+ * @param[in]   aHex            A pointer to the hex string, in upper or lower case.
+ * @param[in]   aHexLength      The length of @p aHex.
+ * @param[out]  aBytes          A pointer to the buffer to receive the bytes.
+ * @param[in]   aBytesLength    The size of @p aBytes.
+ *
+ * @returns The number of bytes converted, -1 if @p aHex is not hex or @p aBytes is too small.
+ *
+ */
+int Hex2Bytes(const char *aHex, size_t aHexLength, uint8_t *aBytes, uint16_t aBytesLength);
+
+/**
+ * This function converts bytes to a null-terminated upper case hex string.
+ *
+ * @param[in]   aBytes          A pointer to the bytes.
+ * @param[in]   aBytesLength    The number of bytes.
+ * @param[out]  aHex            A pointer to the buffer of at least 2 * @p aBytesLength + 1 chars.
+ *
+ * @returns The length of the hex string.
+ *
+ */
 int Bytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex);
 
+/**
+ * This function converts bytes to a null-terminated upper case hex string, checking the size of the buffer.
+ *
+ * @param[in]   aBytes          A pointer to the bytes.
+ * @param[in]   aBytesLength    The number of bytes.
+ * @param[out]  aHex            A pointer to the buffer to receive the hex string.
+ * @param[in]   aHexSize        The size of @p aHex.
+ *
+ * @returns The length of the hex string, -1 if @p aHex is too small.
+ *
+ */
+int Bytes2Hex(const uint8_t *aBytes, uint16_t aBytesLength, char *aHex, size_t aHexSize);
+
+/**
+ * This function converts a 64-bit integer to a null-terminated upper case hex string, least significant byte first.
+ *
+ * @param[in]   aLong           The integer.
+ * @param[out]  aHex            A pointer to the buffer of at least 17 chars.
+ *
+ * @returns The length of the hex string.
+ *
+ */
 int Long2Hex(const uint64_t aLong, char *aHex);
 
+/**
+ * This function converts a 64-bit integer to a null-terminated upper case hex string, least significant byte first,
+ * checking the size of the buffer.
+ *
+ * @param[in]   aLong           The integer.
+ * @param[out]  aHex            A pointer to the buffer to receive the hex string.
+ * @param[in]   aHexSize        The size of @p aHex.
+ *
+ * @returns The length of the hex string, -1 if @p aHex is too small.
+ *
+ */
+int Long2Hex(uint64_t aLong, char *aHex, size_t aHexSize);
+
 } //namespace Utils
 
 } //namespace ot
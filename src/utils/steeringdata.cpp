@@ -38,7 +38,7 @@
 
 namespace ot {
 
-bool SteeringData::IsCleared(void)
+bool SteeringData::IsCleared(void) const
 {
     bool rval = true;
 
@@ -54,20 +54,51 @@ bool SteeringData::IsCleared(void)
     return rval;
 }
 
+void SteeringData::ComputeHashes(const uint8_t *aJoinerId, uint16_t &aCcitt, uint16_t &aAnsi)
+{
+    Crc16::ComputeBlocks(aJoinerId, 1, &aCcitt, &aAnsi);
+}
+
 void SteeringData::ComputeBloomFilter(const uint8_t *aExtAddress)
 {
-    Crc16 ccitt(Crc16::kCcitt);
-    Crc16 ansi(Crc16::kAnsi);
+    uint16_t ccitt;
+    uint16_t ansi;
+
+    ComputeHashes(aExtAddress, ccitt, ansi);
+    SetBit(ccitt % GetNumBits());
+    SetBit(ansi % GetNumBits());
+}
 
-    for (size_t j = 0; j < (64 / 8); j++)
+void SteeringData::ComputeBloomFilter(const uint8_t *aJoinerIds, size_t aCount)
+{
+    enum
     {
-        uint8_t byte = aExtAddress[j];
-        ccitt.Update(byte);
-        ansi.Update(byte);
-    }
+        kBatchSize = 64,
+    };
+
+    uint16_t ccitt[kBatchSize];
+    uint16_t ansi[kBatchSize];
+
+    while (aCount > 0)
+    {
+        size_t count = aCount;
+
+        if (count > kBatchSize)
+        {
+            count = kBatchSize;
+        }
+
+        Crc16::ComputeBlocks(aJoinerIds, count, ccitt, ansi);
 
-    SetBit(ccitt.Get() % GetNumBits());
-    SetBit(ansi.Get() % GetNumBits());
+        for (size_t i = 0; i < count; i++)
+        {
+            SetBit(ccitt[i] % GetNumBits());
+            SetBit(ansi[i] % GetNumBits());
+        }
+
+        aJoinerIds += count * LEN_BIN_EUI64;
+        aCount -= count;
+    }
 }
 
 
@@ -57,7 +57,7 @@ public:
     /**
      * Returns the length of the steering data.
      */
-    int  GetLength(void) { return mLength; }
+    int  GetLength(void) const { return mLength; }
 
     /**
      * Init the steering data.
@@ -106,7 +106,7 @@ public:
      * @returns The number of bits in the Bloom Filter.
      *
      */
-    uint8_t GetNumBits(void) { return GetLength() * 8; }
+    uint8_t GetNumBits(void) const { return GetLength() * 8; }
 
     /**
      * This method indicates whether or not bit @p aBit is set.
@@ -117,7 +117,7 @@ public:
      * @retval FALSE  If bit @p aBit is not set.
      *
      */
-    bool GetBit(uint8_t aBit) {
+    bool GetBit(uint8_t aBit) const {
         int b;
         int m;
 
@@ -163,7 +163,7 @@ public:
      * @retval FALSE  If the SteeringData isn't all zeros.
      *
      */
-    bool IsCleared(void);
+    bool IsCleared(void) const;
 
     /**
      * This method computes the Bloom Filter.
@@ -173,6 +173,26 @@ public:
      */
     void ComputeBloomFilter(const uint8_t *pEui64);
 
+    /**
+     * This method computes the Bloom Filter of many joiners at once.
+     *
+     * @param[in]  aJoinerIds  A pointer to the joiner IDs, 8 bytes each.
+     * @param[in]  aCount      The number of joiner IDs.
+     *
+     */
+    void ComputeBloomFilter(const uint8_t *aJoinerIds, size_t aCount);
+
+    /**
+     * This method computes the hashes of a joiner, the bits set for it in the Bloom Filter are these hashes modulo
+     * the number of bits.
+     *
+     * @param[in]   aJoinerId   A pointer to the joiner ID.
+     * @param[out]  aCcitt      The CRC16-CCITT of the joiner ID.
+     * @param[out]  aAnsi       The CRC16-ANSI of the joiner ID.
+     *
+     */
+    static void ComputeHashes(const uint8_t *aJoinerId, uint16_t &aCcitt, uint16_t &aAnsi);
+
     /**
      * This method uses an ASCII representation of an EUI64
      * to compute the Bloom filter.
@@ -188,7 +208,7 @@ public:
      * This method returns a pointer to the steering data.
      * @sa GetByteCount() to determine the length
      */
-    const uint8_t *GetDataPointer(void) { return &mSteeringData[0]; }
+    const uint8_t *GetDataPointer(void) const { return &mSteeringData[0]; }
 
 private:
     /* SPEC states steering ata can be upto 16 bytes long */
@@ -60,6 +60,7 @@ int main(int argc, char **argv)
 {
     const char *interfaceName = NULL;
     const char *httpPort = NULL;
+    const char *pskcCacheFile = NULL;
     int         logLevel = OTBR_LOG_INFO;
     int         ret = 0;
     int         opt;
@@ -67,10 +68,14 @@ int main(int argc, char **argv)
 
     ot::Web::WebServer *server = NULL;
 
-    while ((opt = getopt(argc, argv, "d:I:p:v")) != -1)
+    while ((opt = getopt(argc, argv, "c:d:I:p:v")) != -1)
     {
         switch (opt)
         {
+        case 'c':
+            pskcCacheFile = optarg;
+            break;
+
         case 'd':
             logLevel = atoi(optarg);
             break;
@@ -91,7 +96,8 @@ int main(int argc, char **argv)
             break;
 
         default:
-            fprintf(stderr, "Usage: %s [-d DEBUG_LEVEL] [-I interfaceName] [-p port] [-v]\n", argv[0]);
+            fprintf(stderr, "Usage: %s [-c pskcCacheFile] [-d DEBUG_LEVEL] [-I interfaceName] [-p port] [-v]\n",
+                    argv[0]);
             ExitNow(ret = -1);
             break;
         }
@@ -112,6 +118,12 @@ int main(int argc, char **argv)
     otbrLog(OTBR_LOG_INFO, "border router web started on %s", interfaceName);
 
     server = new ot::Web::WebServer();
+
+    if (pskcCacheFile != NULL)
+    {
+        server->SetPskcCacheFile(pskcCacheFile);
+    }
+
     server->StartWebServer(interfaceName, port);
 
     otbrLogDeinit();
@@ -0,0 +1,553 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the AES-CMAC-PRF-128 used to derive the PSKc.
+ */
+
+#include "cmac_prf.hpp"
+
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define OTBR_PSKC_AESNI 1
+#include <cpuid.h>
+#include <wmmintrin.h>
+#else
+#define OTBR_PSKC_AESNI 0
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO) && defined(__linux__) && \
+    (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define OTBR_PSKC_ARMCE 1
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#else
+#define OTBR_PSKC_ARMCE 0
+#endif
+
+#include "common/code_utils.hpp"
+
+// The lanes stay in registers only if the loops over them are unrolled, which gcc does not do at -O2.
+#if defined(__GNUC__) && !defined(__clang__)
+#define OTBR_PSKC_UNROLL_LANES __attribute__((optimize("peel-loops")))
+#else
+#define OTBR_PSKC_UNROLL_LANES
+#endif
+
+namespace ot {
+namespace Psk {
+
+// The hardware backends take the round keys expanded by mbedtls, which are the AES round keys in byte order on
+// little endian hosts. When iterating, the xor of the first subkey is folded into the first round key.
+
+#if OTBR_PSKC_AESNI
+__attribute__((target("aes,sse2")))
+static void EncryptAesNi(const uint8_t *aRoundKeys, uint8_t *aBlock)
+{
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBlock));
+
+    block = _mm_xor_si128(block, _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys)));
+
+    for (int i = 1; i < 10; i++)
+    {
+        block = _mm_aesenc_si128(block, _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys + i * 16)));
+    }
+
+    block = _mm_aesenclast_si128(block, _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys + 160)));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aBlock), block);
+}
+
+__attribute__((target("aes,sse2")))
+static void IterateAesNi(const uint8_t *aRoundKeys, const uint8_t *aSubkey, uint8_t *aBlock, uint8_t *aSum,
+                         uint32_t aCount)
+{
+    __m128i key[11];
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBlock));
+    __m128i sum = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aSum));
+
+    for (int i = 0; i < 11; i++)
+    {
+        key[i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys + i * 16));
+    }
+
+    key[0] = _mm_xor_si128(key[0], _mm_loadu_si128(reinterpret_cast<const __m128i *>(aSubkey)));
+
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        block = _mm_xor_si128(block, key[0]);
+        block = _mm_aesenc_si128(block, key[1]);
+        block = _mm_aesenc_si128(block, key[2]);
+        block = _mm_aesenc_si128(block, key[3]);
+        block = _mm_aesenc_si128(block, key[4]);
+        block = _mm_aesenc_si128(block, key[5]);
+        block = _mm_aesenc_si128(block, key[6]);
+        block = _mm_aesenc_si128(block, key[7]);
+        block = _mm_aesenc_si128(block, key[8]);
+        block = _mm_aesenc_si128(block, key[9]);
+        block = _mm_aesenclast_si128(block, key[10]);
+        sum = _mm_xor_si128(sum, block);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aBlock), block);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(aSum), sum);
+}
+
+template <unsigned kLanes>
+__attribute__((target("aes,sse2"))) OTBR_PSKC_UNROLL_LANES
+static void IterateAesNi(const uint8_t *const *aRoundKeys, const uint8_t *const *aSubkeys, uint8_t *const *aBlocks,
+                         uint8_t *const *aSums, uint32_t aCount)
+{
+    __m128i key[kLanes][11];
+    __m128i block[kLanes];
+    __m128i sum[kLanes];
+
+    for (unsigned lane = 0; lane < kLanes; lane++)
+    {
+        for (int i = 0; i < 11; i++)
+        {
+            key[lane][i] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aRoundKeys[lane] + i * 16));
+        }
+
+        key[lane][0] = _mm_xor_si128(key[lane][0], _mm_loadu_si128(reinterpret_cast<const __m128i *>(aSubkeys[lane])));
+        block[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aBlocks[lane]));
+        sum[lane] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(aSums[lane]));
+    }
+
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        // Each round is issued for all lanes before the next one, so that the encryptions overlap.
+        for (unsigned lane = 0; lane < kLanes; lane++)
+        {
+            block[lane] = _mm_xor_si128(block[lane], key[lane][0]);
+        }
+
+        for (int round = 1; round < 10; round++)
+        {
+            for (unsigned lane = 0; lane < kLanes; lane++)
+            {
+                block[lane] = _mm_aesenc_si128(block[lane], key[lane][round]);
+            }
+        }
+
+        for (unsigned lane = 0; lane < kLanes; lane++)
+        {
+            block[lane] = _mm_aesenclast_si128(block[lane], key[lane][10]);
+            sum[lane] = _mm_xor_si128(sum[lane], block[lane]);
+        }
+    }
+
+    for (unsigned lane = 0; lane < kLanes; lane++)
+    {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(aBlocks[lane]), block[lane]);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(aSums[lane]), sum[lane]);
+    }
+}
+
+static void (*const sIterateAesNiLanes[])(const uint8_t *const *, const uint8_t *const *, uint8_t *const *,
+                                          uint8_t *const *, uint32_t) = {
+    IterateAesNi<1>, IterateAesNi<2>, IterateAesNi<3>, IterateAesNi<4>,
+    IterateAesNi<5>, IterateAesNi<6>, IterateAesNi<7>, IterateAesNi<8>,
+};
+#endif // OTBR_PSKC_AESNI
+
+#if OTBR_PSKC_ARMCE
+static void EncryptArmCe(const uint8_t *aRoundKeys, uint8_t *aBlock)
+{
+    uint8x16_t block = vld1q_u8(aBlock);
+
+    for (int i = 0; i < 9; i++)
+    {
+        block = vaesmcq_u8(vaeseq_u8(block, vld1q_u8(aRoundKeys + i * 16)));
+    }
+
+    block = veorq_u8(vaeseq_u8(block, vld1q_u8(aRoundKeys + 144)), vld1q_u8(aRoundKeys + 160));
+    vst1q_u8(aBlock, block);
+}
+
+static void IterateArmCe(const uint8_t *aRoundKeys, const uint8_t *aSubkey, uint8_t *aBlock, uint8_t *aSum,
+                         uint32_t aCount)
+{
+    uint8x16_t key[11];
+    uint8x16_t block = vld1q_u8(aBlock);
+    uint8x16_t sum = vld1q_u8(aSum);
+
+    for (int i = 0; i < 11; i++)
+    {
+        key[i] = vld1q_u8(aRoundKeys + i * 16);
+    }
+
+    key[0] = veorq_u8(key[0], vld1q_u8(aSubkey));
+
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        block = vaesmcq_u8(vaeseq_u8(block, key[0]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[1]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[2]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[3]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[4]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[5]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[6]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[7]));
+        block = vaesmcq_u8(vaeseq_u8(block, key[8]));
+        block = veorq_u8(vaeseq_u8(block, key[9]), key[10]);
+        sum = veorq_u8(sum, block);
+    }
+
+    vst1q_u8(aBlock, block);
+    vst1q_u8(aSum, sum);
+}
+
+template <unsigned kLanes>
+OTBR_PSKC_UNROLL_LANES
+static void IterateArmCe(const uint8_t *const *aRoundKeys, const uint8_t *const *aSubkeys, uint8_t *const *aBlocks,
+                         uint8_t *const *aSums, uint32_t aCount)
+{
+    uint8x16_t key[kLanes][11];
+    uint8x16_t block[kLanes];
+    uint8x16_t sum[kLanes];
+
+    for (unsigned lane = 0; lane < kLanes; lane++)
+    {
+        for (int i = 0; i < 11; i++)
+        {
+            key[lane][i] = vld1q_u8(aRoundKeys[lane] + i * 16);
+        }
+
+        key[lane][0] = veorq_u8(key[lane][0], vld1q_u8(aSubkeys[lane]));
+        block[lane] = vld1q_u8(aBlocks[lane]);
+        sum[lane] = vld1q_u8(aSums[lane]);
+    }
+
+    for (uint32_t i = 0; i < aCount; i++)
+    {
+        // Each round is issued for all lanes before the next one, so that the encryptions overlap.
+        for (int round = 0; round < 9; round++)
+        {
+            for (unsigned lane = 0; lane < kLanes; lane++)
+            {
+                block[lane] = vaesmcq_u8(vaeseq_u8(block[lane], key[lane][round]));
+            }
+        }
+
+        for (unsigned lane = 0; lane < kLanes; lane++)
+        {
+            block[lane] = veorq_u8(vaeseq_u8(block[lane], key[lane][9]), key[lane][10]);
+            sum[lane] = veorq_u8(sum[lane], block[lane]);
+        }
+    }
+
+    for (unsigned lane = 0; lane < kLanes; lane++)
+    {
+        vst1q_u8(aBlocks[lane], block[lane]);
+        vst1q_u8(aSums[lane], sum[lane]);
+    }
+}
+
+static void (*const sIterateArmCeLanes[])(const uint8_t *const *, const uint8_t *const *, uint8_t *const *,
+                                          uint8_t *const *, uint32_t) = {
+    IterateArmCe<1>, IterateArmCe<2>, IterateArmCe<3>, IterateArmCe<4>,
+    IterateArmCe<5>, IterateArmCe<6>, IterateArmCe<7>, IterateArmCe<8>,
+};
+#endif // OTBR_PSKC_ARMCE
+
+static void Double(const uint8_t *aInput, uint8_t *aOutput)
+{
+    uint8_t carry = aInput[0] >> 7;
+
+    for (int i = 0; i < 15; i++)
+    {
+        aOutput[i] = static_cast<uint8_t>((aInput[i] << 1) | (aInput[i + 1] >> 7));
+    }
+
+    // Constant time, the subkeys are secret.
+    aOutput[15] = static_cast<uint8_t>((aInput[15] << 1) ^ (0x87 & -carry));
+}
+
+CmacPrf::CmacPrf(void) :
+    mBackend(kBackendSoftware)
+{
+    mbedtls_aes_init(&mAes);
+    memset(mSubkey1, 0, sizeof(mSubkey1));
+    memset(mSubkey2, 0, sizeof(mSubkey2));
+
+    if (IsSupported(kBackendAesNi))
+    {
+        mBackend = kBackendAesNi;
+    }
+    else if (IsSupported(kBackendArmCe))
+    {
+        mBackend = kBackendArmCe;
+    }
+}
+
+CmacPrf::~CmacPrf(void)
+{
+    mbedtls_aes_free(&mAes);
+    memset(mSubkey1, 0, sizeof(mSubkey1));
+    memset(mSubkey2, 0, sizeof(mSubkey2));
+}
+
+bool CmacPrf::IsSupported(Backend aBackend)
+{
+    bool ret = false;
+
+    switch (aBackend)
+    {
+    case kBackendSoftware:
+        ret = true;
+        break;
+
+    case kBackendAesNi:
+#if OTBR_PSKC_AESNI
+        {
+            unsigned int eax, ebx, ecx, edx;
+
+            ret = __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES) != 0;
+        }
+#endif
+        break;
+
+    case kBackendArmCe:
+#if OTBR_PSKC_ARMCE
+        ret = (getauxval(AT_HWCAP) & HWCAP_AES) != 0;
+#endif
+        break;
+    }
+
+    return ret;
+}
+
+const char *CmacPrf::BackendToString(Backend aBackend)
+{
+    const char *name = "unknown";
+
+    switch (aBackend)
+    {
+    case kBackendSoftware:
+        name = "software";
+        break;
+
+    case kBackendAesNi:
+        name = "aesni";
+        break;
+
+    case kBackendArmCe:
+        name = "armce";
+        break;
+    }
+
+    return name;
+}
+
+bool CmacPrf::SetBackend(Backend aBackend)
+{
+    bool ret = IsSupported(aBackend);
+
+    if (ret)
+    {
+        mBackend = aBackend;
+    }
+
+    return ret;
+}
+
+void CmacPrf::SetCipherKey(const uint8_t *aKey)
+{
+    uint8_t block[kBlockSize];
+
+    mbedtls_aes_setkey_enc(&mAes, aKey, kBlockSize * 8);
+
+    memset(block, 0, sizeof(block));
+    Encrypt(block);
+    Double(block, mSubkey1);
+    Double(mSubkey1, mSubkey2);
+    memset(block, 0, sizeof(block));
+}
+
+void CmacPrf::SetKey(const uint8_t *aKey, uint16_t aLength)
+{
+    uint8_t key[kBlockSize];
+
+    if (aLength == kBlockSize)
+    {
+        SetCipherKey(aKey);
+        ExitNow();
+    }
+
+    memset(key, 0, sizeof(key));
+    SetCipherKey(key);
+    Compute(aKey, aLength, key);
+    SetCipherKey(key);
+    memset(key, 0, sizeof(key));
+
+exit:
+    return;
+}
+
+void CmacPrf::Encrypt(uint8_t *aBlock)
+{
+    switch (mBackend)
+    {
+#if OTBR_PSKC_AESNI
+    case kBackendAesNi:
+        EncryptAesNi(GetRoundKeys(), aBlock);
+        break;
+#endif
+
+#if OTBR_PSKC_ARMCE
+    case kBackendArmCe:
+        EncryptArmCe(GetRoundKeys(), aBlock);
+        break;
+#endif
+
+    default:
+        mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, aBlock, aBlock);
+        break;
+    }
+}
+
+void CmacPrf::Compute(const uint8_t *aMessage, uint16_t aLength, uint8_t *aOutput)
+{
+    uint8_t block[kBlockSize];
+
+    memset(block, 0, sizeof(block));
+
+    for (; aLength > kBlockSize; aMessage += kBlockSize, aLength -= kBlockSize)
+    {
+        for (int i = 0; i < kBlockSize; i++)
+        {
+            block[i] ^= aMessage[i];
+        }
+
+        Encrypt(block);
+    }
+
+    // The last block is xored with the first subkey if it is complete, or padded and xored with the second one.
+    for (int i = 0; i < kBlockSize; i++)
+    {
+        if (aLength == kBlockSize)
+        {
+            block[i] ^= aMessage[i] ^ mSubkey1[i];
+        }
+        else
+        {
+            block[i] ^= (i < aLength ? aMessage[i] : (i == aLength ? 0x80 : 0)) ^ mSubkey2[i];
+        }
+    }
+
+    Encrypt(block);
+    memcpy(aOutput, block, sizeof(block));
+}
+
+void CmacPrf::Iterate(uint8_t *aBlock, uint8_t *aSum, uint32_t aCount)
+{
+    switch (mBackend)
+    {
+#if OTBR_PSKC_AESNI
+    case kBackendAesNi:
+        IterateAesNi(GetRoundKeys(), mSubkey1, aBlock, aSum, aCount);
+        break;
+#endif
+
+#if OTBR_PSKC_ARMCE
+    case kBackendArmCe:
+        IterateArmCe(GetRoundKeys(), mSubkey1, aBlock, aSum, aCount);
+        break;
+#endif
+
+    default:
+        for (uint32_t i = 0; i < aCount; i++)
+        {
+            // A single complete block, so that CMAC is the encryption of the block xored with the first subkey.
+            for (int j = 0; j < kBlockSize; j++)
+            {
+                aBlock[j] ^= mSubkey1[j];
+            }
+
+            mbedtls_aes_crypt_ecb(&mAes, MBEDTLS_AES_ENCRYPT, aBlock, aBlock);
+
+            for (int j = 0; j < kBlockSize; j++)
+            {
+                aSum[j] ^= aBlock[j];
+            }
+        }
+        break;
+    }
+}
+
+void CmacPrf::Iterate(CmacPrf *const *aPrfs, uint8_t *const *aBlocks, uint8_t *const *aSums, uint8_t aNumLanes,
+                      uint32_t aCount)
+{
+    const uint8_t *roundKeys[kMaxLanes];
+    const uint8_t *subkeys[kMaxLanes];
+    Backend        backend = aNumLanes > 0 ? aPrfs[0]->mBackend : kBackendSoftware;
+
+    for (uint8_t lane = 0; lane < aNumLanes && lane < kMaxLanes; lane++)
+    {
+        roundKeys[lane] = aPrfs[lane]->GetRoundKeys();
+        subkeys[lane] = aPrfs[lane]->mSubkey1;
+
+        if (aPrfs[lane]->mBackend != backend)
+        {
+            backend = kBackendSoftware;
+        }
+    }
+
+    if (aNumLanes == 0 || aNumLanes > kMaxLanes)
+    {
+        backend = kBackendSoftware;
+    }
+
+    switch (backend)
+    {
+#if OTBR_PSKC_AESNI
+    case kBackendAesNi:
+        sIterateAesNiLanes[aNumLanes - 1](roundKeys, subkeys, aBlocks, aSums, aCount);
+        break;
+#endif
+
+#if OTBR_PSKC_ARMCE
+    case kBackendArmCe:
+        sIterateArmCeLanes[aNumLanes - 1](roundKeys, subkeys, aBlocks, aSums, aCount);
+        break;
+#endif
+
+    default:
+        for (uint8_t lane = 0; lane < aNumLanes; lane++)
+        {
+            aPrfs[lane]->Iterate(aBlocks[lane], aSums[lane], aCount);
+        }
+        break;
+    }
+}
+
+} // namespace Psk
+} // namespace ot
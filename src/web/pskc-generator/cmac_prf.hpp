@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the AES-CMAC-PRF-128 used to derive the PSKc.
+ */
+
+#ifndef CMAC_PRF_HPP
+#define CMAC_PRF_HPP
+
+#include <stdint.h>
+
+#include <mbedtls/aes.h>
+
+namespace ot {
+namespace Psk {
+
+/**
+ * This class implements AES-CMAC-PRF-128 (RFC 4615) with a key schedule derived once per key.
+ *
+ * The PRF key, the AES round keys and the CMAC subkeys are computed by SetKey(), so that each PBKDF2 iteration
+ * costs a single block encryption. Blocks are encrypted with AES-NI or the ARMv8 cryptography extension when
+ * the CPU supports it, and with mbedtls otherwise.
+ *
+ */
+class CmacPrf
+{
+public:
+    /**
+     * AES implementations.
+     *
+     */
+    enum Backend
+    {
+        kBackendSoftware = 0, ///< mbedtls.
+        kBackendAesNi    = 1, ///< x86 AES-NI.
+        kBackendArmCe    = 2, ///< ARMv8 cryptography extension.
+    };
+
+    enum
+    {
+        kMaxLanes = 8, ///< Maximum number of chains iterated at once.
+    };
+
+    /**
+     * The constructor to initialize the PRF with the fastest backend of this CPU.
+     *
+     */
+    CmacPrf(void);
+
+    /**
+     * The destructor to clear the key schedule.
+     *
+     */
+    ~CmacPrf(void);
+
+    /**
+     * This method sets the PRF key, keys of other lengths than 16 bytes are derived as of RFC 4615.
+     *
+     * @param[in]   aKey        A pointer to the key.
+     * @param[in]   aLength     The length of the key.
+     *
+     */
+    void SetKey(const uint8_t *aKey, uint16_t aLength);
+
+    /**
+     * This method computes the PRF of a message.
+     *
+     * @param[in]   aMessage    A pointer to the message.
+     * @param[in]   aLength     The length of the message.
+     * @param[out]  aOutput     A pointer to receive the 16 bytes output.
+     *
+     */
+    void Compute(const uint8_t *aMessage, uint16_t aLength, uint8_t *aOutput);
+
+    /**
+     * This method iterates the PRF as of PBKDF2, replacing the block by its PRF and xoring it into the sum.
+     *
+     * @param[inout]    aBlock      A pointer to the 16 bytes block, U_i on input, and U_(i+aCount) on output.
+     * @param[inout]    aSum        A pointer to the 16 bytes sum of the blocks.
+     * @param[in]       aCount      The number of iterations.
+     *
+     */
+    void Iterate(uint8_t *aBlock, uint8_t *aSum, uint32_t aCount);
+
+    /**
+     * This method iterates independent chains of PRFs at once, interleaving their block encryptions.
+     *
+     * The hardware backends pipeline the encryptions of the lanes, which a single chain cannot do because each
+     * block depends on the previous one. Lanes of different backends are iterated one by one.
+     *
+     * @param[in]       aPrfs       An array of pointers to the PRF of each lane.
+     * @param[inout]    aBlocks     An array of pointers to the block of each lane, as of Iterate().
+     * @param[inout]    aSums       An array of pointers to the sum of each lane, as of Iterate().
+     * @param[in]       aNumLanes   The number of lanes, no more than kMaxLanes.
+     * @param[in]       aCount      The number of iterations.
+     *
+     */
+    static void Iterate(CmacPrf *const *aPrfs, uint8_t *const *aBlocks, uint8_t *const *aSums, uint8_t aNumLanes,
+                        uint32_t aCount);
+
+    /**
+     * This method returns the backend in use.
+     *
+     * @returns The backend in use.
+     *
+     */
+    Backend GetBackend(void) const { return mBackend; }
+
+    /**
+     * This method selects the backend, e.g. to compare them.
+     *
+     * @param[in]   aBackend    The backend.
+     *
+     * @retval  true    Successfully selected.
+     * @retval  false   The backend is not supported by this build or this CPU.
+     *
+     */
+    bool SetBackend(Backend aBackend);
+
+    /**
+     * This method tells whether a backend is supported by this build and this CPU.
+     *
+     * @param[in]   aBackend    The backend.
+     *
+     * @returns Whether the backend is supported.
+     *
+     */
+    static bool IsSupported(Backend aBackend);
+
+    /**
+     * This method returns the name of a backend.
+     *
+     * @param[in]   aBackend    The backend.
+     *
+     * @returns The name of the backend.
+     *
+     */
+    static const char *BackendToString(Backend aBackend);
+
+private:
+    enum
+    {
+        kBlockSize = 16,
+        kNumRounds = 10,
+    };
+
+    void SetCipherKey(const uint8_t *aKey);
+    void Encrypt(uint8_t *aBlock);
+    const uint8_t *GetRoundKeys(void) const { return reinterpret_cast<const uint8_t *>(mAes.rk); }
+
+    mbedtls_aes_context mAes;
+    uint8_t             mSubkey1[kBlockSize];
+    uint8_t             mSubkey2[kBlockSize];
+    Backend             mBackend;
+};
+
+} // namespace Psk
+} // namespace ot
+
+#endif  // CMAC_PRF_HPP
@@ -66,56 +66,72 @@ exit:
     return;
 }
 
-const uint8_t *Pskc::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+void Pskc::Start(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, uint8_t *aBlock)
 {
-    uint32_t blockCounter = 0;
-    uint16_t useLen = 0;
-    uint16_t prfBlockLen = MBEDTLS_CIPHER_BLKSIZE_MAX;
-    uint8_t  prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
-    uint8_t  prfOutput[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint8_t  keyBlock[MBEDTLS_CIPHER_BLKSIZE_MAX];
-    uint16_t keyLen = OT_PSKC_LENGTH;
-    uint8_t *pskc = mPskc;
+    const uint32_t blockCounter = 1;
+    uint8_t        prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
 
     SetSalt(aExtPanId, aNetworkName);
 
-    while (keyLen)
+    // The PRF key and its AES key schedule are derived once for all iterations.
+    mPrf.SetKey(reinterpret_cast<const uint8_t *>(aPassphrase), static_cast<uint16_t>(strlen(aPassphrase)));
+
+    // The PSKc is a single PRF block, so only the first block of PBKDF2 is computed.
+    memcpy(prfInput, mSalt, mSaltLen);
+    prfInput[mSaltLen + 0] = (uint8_t) (blockCounter >> 24);
+    prfInput[mSaltLen + 1] = (uint8_t) (blockCounter >> 16);
+    prfInput[mSaltLen + 2] = (uint8_t) (blockCounter >> 8);
+    prfInput[mSaltLen + 3] = (uint8_t) (blockCounter);
+
+    // Calculate U_1
+    mPrf.Compute(prfInput, mSaltLen + 4, aBlock);
+    memcpy(mPskc, aBlock, OT_PSKC_LENGTH);
+}
+
+const uint8_t *Pskc::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+{
+    uint8_t prfOutput[OT_PSKC_LENGTH];
+
+    Start(aExtPanId, aNetworkName, aPassphrase, prfOutput);
+
+    // Calculate U_i and xor them
+    mPrf.Iterate(prfOutput, mPskc, OT_ITERATION_COUNTS - 1);
+    memset(prfOutput, 0, sizeof(prfOutput));
+
+    return mPskc;
+}
+
+void Pskc::ComputePskcs(Pskc *aPskcs, const uint8_t *const *aExtPanIds, const char *const *aNetworkNames,
+                        const char *const *aPassphrases, uint8_t aCount)
+{
+    uint8_t  prfOutputs[kMaxBatchSize][OT_PSKC_LENGTH];
+    CmacPrf *prfs[kMaxBatchSize];
+    uint8_t *blocks[kMaxBatchSize];
+    uint8_t *sums[kMaxBatchSize];
+
+    for (unsigned offset = 0; offset < aCount; offset += kMaxBatchSize)
     {
-        memcpy(prfInput, mSalt, mSaltLen);
-
-        blockCounter++;
-        prfInput[mSaltLen + 0] = (uint8_t) (blockCounter >> 24);
-        prfInput[mSaltLen + 1] = (uint8_t) (blockCounter >> 16);
-        prfInput[mSaltLen + 2] = (uint8_t) (blockCounter >> 8);
-        prfInput[mSaltLen + 3] = (uint8_t) (blockCounter);
-        // Calculate U_1
-        mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase),
-                                 strlen(aPassphrase), prfInput,
-                                 mSaltLen + 4, prfOutput);
-        memcpy(keyBlock, prfOutput, prfBlockLen);
-
-        for (uint32_t i = 1; i < OT_ITERATION_COUNTS; i++)
+        uint8_t count = kMaxBatchSize;
+
+        if (aCount - offset < count)
         {
-            memcpy(prfInput, prfOutput, prfBlockLen);
-
-            // Calculate U_i
-            mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(aPassphrase),
-                                     strlen(aPassphrase), prfInput,
-                                     prfBlockLen, prfOutput);
-
-            // xor
-            for (uint32_t j = 0; j < prfBlockLen; j++)
-            {
-                keyBlock[j] ^= prfOutput[j];
-            }
+            count = static_cast<uint8_t>(aCount - offset);
         }
 
-        useLen = (keyLen < prfBlockLen) ? keyLen : prfBlockLen;
-        memcpy(pskc, keyBlock, useLen);
-        pskc += useLen;
-        keyLen -= useLen;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            Pskc &pskc = aPskcs[offset + i];
+
+            pskc.Start(aExtPanIds[offset + i], aNetworkNames[offset + i], aPassphrases[offset + i], prfOutputs[i]);
+            prfs[i] = &pskc.mPrf;
+            blocks[i] = prfOutputs[i];
+            sums[i] = pskc.mPskc;
+        }
+
+        CmacPrf::Iterate(prfs, blocks, sums, count, OT_ITERATION_COUNTS - 1);
     }
-    return mPskc;
+
+    memset(prfOutputs, 0, sizeof(prfOutputs));
 }
 
 } //namespace Psk
@@ -45,6 +45,8 @@
 
 #include <mbedtls/cmac.h>
 
+#include "cmac_prf.hpp"
+
 namespace ot {
 namespace Psk {
 
@@ -57,6 +59,10 @@ enum
 class Pskc
 {
 public:
+    enum
+    {
+        kMaxBatchSize = CmacPrf::kMaxLanes, ///< Number of PSKcs computed at once by ComputePskcs().
+    };
 
     /**
      * This method computes the PSKc.
@@ -70,12 +76,44 @@ public:
      */
     const uint8_t *ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase);
 
+    /**
+     * This method computes the PSKcs of several networks, interleaving the PBKDF2 chains of up to kMaxBatchSize
+     * networks at once.
+     *
+     * @param[inout]    aPskcs          An array of @p aCount PSKc computers, whose GetPskc() returns the results.
+     * @param[in]       aExtPanIds      An array of pointers to the extended PAN ID of each network.
+     * @param[in]       aNetworkNames   An array of pointers to the network name of each network.
+     * @param[in]       aPassphrases    An array of pointers to the passphrase of each network.
+     * @param[in]       aCount          The number of networks.
+     *
+     */
+    static void ComputePskcs(Pskc *aPskcs, const uint8_t *const *aExtPanIds, const char *const *aNetworkNames,
+                             const char *const *aPassphrases, uint8_t aCount);
+
+    /**
+     * This method returns the PSKc last computed.
+     *
+     * @returns The pointer to PSKc value.
+     *
+     */
+    const uint8_t *GetPskc(void) const { return mPskc; }
+
+    /**
+     * This method returns the PRF, e.g. to select its backend.
+     *
+     * @returns A reference to the PRF.
+     *
+     */
+    CmacPrf &GetPrf(void) { return mPrf; }
+
 private:
     void SetSalt(const uint8_t *aExtPanId, const char *aNetworkName);
+    void Start(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, uint8_t *aBlock);
 
     char     mSalt[OT_PBKDF2_SALT_MAX_LENGTH];
     uint16_t mSaltLen;
     uint8_t  mPskc[OT_PSKC_LENGTH];
+    CmacPrf  mPrf;
 };
 
 } //namespace Psk
@@ -0,0 +1,340 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the PSKc cache.
+ */
+
+#include "pskc_cache.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <mbedtls/entropy.h>
+#include <mbedtls/md.h>
+
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+namespace Psk {
+
+enum
+{
+    kCacheMagic = 0x504b4302, ///< "PKC" and the version of the file layout.
+};
+
+PskcCache::PskcCache(void) :
+    mTable(&mMemory),
+    mFd(-1),
+    mNumHits(0),
+    mNumMisses(0)
+{
+    InitTable(mMemory);
+}
+
+PskcCache::~PskcCache(void)
+{
+    Close();
+    memset(&mMemory, 0, sizeof(mMemory));
+    memset(mResult, 0, sizeof(mResult));
+}
+
+otbrError PskcCache::Open(const char *aPath)
+{
+    otbrError   error = OTBR_ERROR_ERRNO;
+    struct stat st;
+    void       *table = MAP_FAILED;
+    int         fd;
+
+    Close();
+
+    fd = open(aPath, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    VerifyOrExit(fd >= 0);
+
+    // The file holds PSKcs, so it must be private to this user.
+    VerifyOrExit(fstat(fd, &st) == 0);
+    VerifyOrExit(S_ISREG(st.st_mode) && st.st_nlink == 1 && st.st_uid == geteuid() &&
+                 (st.st_mode & (S_IRWXG | S_IRWXO)) == 0,
+                 errno = EPERM);
+
+    // Only a new file is sized, a file of any other size is not a cache and is left alone.
+    if (st.st_size == 0)
+    {
+        VerifyOrExit(ftruncate(fd, sizeof(Table)) == 0);
+    }
+    else
+    {
+        VerifyOrExit(st.st_size == static_cast<off_t>(sizeof(Table)), errno = EINVAL);
+    }
+
+    table = mmap(NULL, sizeof(Table), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    VerifyOrExit(table != MAP_FAILED);
+
+    mFd = fd;
+    mTable = static_cast<Table *>(table);
+    fd = -1;
+
+    Lock();
+
+    if (mTable->mMagic != kCacheMagic)
+    {
+        error = InitTable(*mTable);
+    }
+    else
+    {
+        error = OTBR_ERROR_NONE;
+    }
+
+    Unlock();
+
+    if (error != OTBR_ERROR_NONE)
+    {
+        Close();
+        ExitNow();
+    }
+
+    memset(&mMemory, 0, sizeof(mMemory));
+
+exit:
+    if (error != OTBR_ERROR_NONE)
+    {
+        otbrLog(OTBR_LOG_ERR, "PSKc cache %s not opened: %s", aPath, strerror(errno));
+
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+
+    return error;
+}
+
+void PskcCache::Close(void)
+{
+    VerifyOrExit(mTable != &mMemory);
+
+    munmap(mTable, sizeof(Table));
+    close(mFd);
+    mFd = -1;
+    mTable = &mMemory;
+    InitTable(mMemory);
+
+exit:
+    return;
+}
+
+otbrError PskcCache::InitTable(Table &aTable)
+{
+    otbrError               error = OTBR_ERROR_NONE;
+    mbedtls_entropy_context entropy;
+
+    memset(&aTable, 0, sizeof(aTable));
+
+    mbedtls_entropy_init(&entropy);
+
+    if (mbedtls_entropy_func(&entropy, aTable.mSalt, sizeof(aTable.mSalt)) != 0)
+    {
+        otbrLog(OTBR_LOG_ERR, "PSKc cache salt not generated");
+        errno = EIO;
+        error = OTBR_ERROR_ERRNO;
+    }
+
+    mbedtls_entropy_free(&entropy);
+
+    // A table without a salt is never used.
+    if (error == OTBR_ERROR_NONE)
+    {
+        aTable.mMagic = kCacheMagic;
+    }
+
+    return error;
+}
+
+void PskcCache::Lock(void)
+{
+    // Other processes may share the file.
+    if (mFd >= 0)
+    {
+        while (flock(mFd, LOCK_EX) != 0 && errno == EINTR)
+        {
+        }
+    }
+}
+
+void PskcCache::Unlock(void)
+{
+    if (mFd >= 0)
+    {
+        flock(mFd, LOCK_UN);
+    }
+}
+
+bool PskcCache::Equals(const uint8_t *aFirst, const uint8_t *aSecond, size_t aLength)
+{
+    uint8_t diff = 0;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        diff |= aFirst[i] ^ aSecond[i];
+    }
+
+    return diff == 0;
+}
+
+void PskcCache::ComputeKey(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase,
+                           uint8_t *aKey)
+{
+    mbedtls_md_context_t hmac;
+    uint8_t              length;
+
+    mbedtls_md_init(&hmac);
+    mbedtls_md_setup(&hmac, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 1);
+    mbedtls_md_hmac_starts(&hmac, mTable->mSalt, sizeof(mTable->mSalt));
+
+    // Lengths are hashed too, so that the fields cannot be shifted into one another.
+    length = static_cast<uint8_t>(strlen(aPassphrase));
+    mbedtls_md_hmac_update(&hmac, &length, sizeof(length));
+    mbedtls_md_hmac_update(&hmac, reinterpret_cast<const uint8_t *>(aPassphrase), length);
+    mbedtls_md_hmac_update(&hmac, aExtPanId, OT_EXTENDED_PAN_ID_LENGTH);
+    length = static_cast<uint8_t>(strlen(aNetworkName));
+    mbedtls_md_hmac_update(&hmac, &length, sizeof(length));
+    mbedtls_md_hmac_update(&hmac, reinterpret_cast<const uint8_t *>(aNetworkName), length);
+
+    mbedtls_md_hmac_finish(&hmac, aKey);
+    mbedtls_md_free(&hmac);
+}
+
+int PskcCache::Find(const uint8_t *aKey, uint8_t *aPskc)
+{
+    int found = -1;
+
+    memset(aPskc, 0, OT_PSKC_LENGTH);
+
+    // Every entry is compared and masked in, so that the time does not tell whether or where the key is.
+    for (int i = 0; i < kNumEntries; i++)
+    {
+        const Entry &entry = mTable->mEntries[i];
+        int          match = Equals(aKey, entry.mKey, kSizeOfKey) & (entry.mLastUsed != 0);
+        uint8_t      mask = static_cast<uint8_t>(-match);
+
+        for (int j = 0; j < OT_PSKC_LENGTH; j++)
+        {
+            aPskc[j] |= entry.mPskc[j] & mask;
+        }
+
+        found ^= (found ^ i) & -match;
+    }
+
+    return found;
+}
+
+void PskcCache::Insert(const uint8_t *aKey, const uint8_t *aPskc)
+{
+    Entry *victim = &mTable->mEntries[0];
+
+    for (int i = 1; i < kNumEntries; i++)
+    {
+        if (mTable->mEntries[i].mLastUsed < victim->mLastUsed)
+        {
+            victim = &mTable->mEntries[i];
+        }
+    }
+
+    memcpy(victim->mKey, aKey, kSizeOfKey);
+    memcpy(victim->mPskc, aPskc, OT_PSKC_LENGTH);
+    victim->mLastUsed = ++mTable->mClock;
+}
+
+bool PskcCache::Lookup(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, uint8_t *aPskc)
+{
+    uint8_t key[kSizeOfKey];
+    int     found;
+
+    ComputeKey(aExtPanId, aNetworkName, aPassphrase, key);
+
+    Lock();
+    found = Find(key, aPskc);
+
+    if (found >= 0)
+    {
+        mTable->mEntries[found].mLastUsed = ++mTable->mClock;
+    }
+
+    Unlock();
+
+    memset(key, 0, sizeof(key));
+
+    return found >= 0;
+}
+
+const uint8_t *PskcCache::ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase)
+{
+    uint8_t key[kSizeOfKey];
+
+    if (Lookup(aExtPanId, aNetworkName, aPassphrase, mResult))
+    {
+        mNumHits++;
+        ExitNow();
+    }
+
+    mNumMisses++;
+    memcpy(mResult, mPskc.ComputePskc(aExtPanId, aNetworkName, aPassphrase), sizeof(mResult));
+
+    ComputeKey(aExtPanId, aNetworkName, aPassphrase, key);
+    Lock();
+    Insert(key, mResult);
+    Unlock();
+    memset(key, 0, sizeof(key));
+
+exit:
+    return mResult;
+}
+
+bool PskcCache::Verify(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase,
+                       const uint8_t *aPskc)
+{
+    return Equals(ComputePskc(aExtPanId, aNetworkName, aPassphrase), aPskc, OT_PSKC_LENGTH);
+}
+
+void PskcCache::Clear(void)
+{
+    Lock();
+    memset(mTable->mEntries, 0, sizeof(mTable->mEntries));
+    mTable->mClock = 0;
+    Unlock();
+}
+
+} // namespace Psk
+} // namespace ot
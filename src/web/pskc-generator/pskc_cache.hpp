@@ -0,0 +1,210 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definition for the PSKc cache.
+ */
+
+#ifndef PSKC_CACHE_HPP
+#define PSKC_CACHE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "pskc.hpp"
+#include "common/types.hpp"
+
+namespace ot {
+namespace Psk {
+
+/**
+ * This class implements a cache of PSKcs, keyed by an HMAC-SHA256 of the extended PAN ID, the network name and the
+ * passphrase, so that the passphrase itself is never stored. The HMAC key is a random salt of each cache, so that
+ * passphrases cannot be tested against the keys without it.
+ *
+ * The cache lives in memory, or in a file mapped by Open() to be kept across restarts and shared between
+ * processes. Since the file holds PSKcs, it must be owned by the user of the process and accessible to nobody
+ * else, which for the border router daemons means root only.
+ *
+ */
+class PskcCache
+{
+public:
+    enum
+    {
+        kNumEntries = 16, ///< Number of PSKcs cached, the least recently used one is replaced.
+    };
+
+    /**
+     * The constructor to initialize an empty cache in memory.
+     *
+     */
+    PskcCache(void);
+
+    /**
+     * The destructor to close the cache file.
+     *
+     */
+    ~PskcCache(void);
+
+    /**
+     * This method persists the cache in a file, creating it if needed.
+     *
+     * @param[in]   aPath       A pointer to the path of the file.
+     *
+     * A symbolic link is not followed, and an existing file is only used if it has the size of a cache, so that
+     * no other file is overwritten.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully opened the file, PSKcs cached in memory are dropped.
+     * @retval  OTBR_ERROR_ERRNO    Failed to open or map the file, it is not private to this user or has other links
+     *                              (EPERM), or it is not a cache (EINVAL), the cache stays in memory.
+     *
+     */
+    otbrError Open(const char *aPath);
+
+    /**
+     * This method closes the cache file, and continues with an empty cache in memory.
+     *
+     */
+    void Close(void);
+
+    /**
+     * This method returns the PSKc of a network, computing it only if it is not cached.
+     *
+     * @param[in]  aExtPanId      A pointer to extended PAN ID.
+     * @param[in]  aNetworkName   A pointer to network name.
+     * @param[in]  aPassphrase    A pointer to passphrase.
+     *
+     * @returns The pointer to PSKc value, valid until the next call.
+     *
+     */
+    const uint8_t *ComputePskc(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase);
+
+    /**
+     * This method looks up the PSKc of a network, all entries are compared in constant time.
+     *
+     * @param[in]   aExtPanId      A pointer to extended PAN ID.
+     * @param[in]   aNetworkName   A pointer to network name.
+     * @param[in]   aPassphrase    A pointer to passphrase.
+     * @param[out]  aPskc          A pointer to receive the PSKc.
+     *
+     * @returns Whether the PSKc is cached.
+     *
+     */
+    bool Lookup(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, uint8_t *aPskc);
+
+    /**
+     * This method verifies a PSKc against the one of a network, in constant time.
+     *
+     * @param[in]   aExtPanId      A pointer to extended PAN ID.
+     * @param[in]   aNetworkName   A pointer to network name.
+     * @param[in]   aPassphrase    A pointer to passphrase.
+     * @param[in]   aPskc          A pointer to the PSKc to verify.
+     *
+     * @returns Whether @p aPskc is the PSKc of the network.
+     *
+     */
+    bool Verify(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, const uint8_t *aPskc);
+
+    /**
+     * This method removes all PSKcs.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method returns the number of PSKcs found in the cache.
+     *
+     * @returns The number of PSKcs found in the cache.
+     *
+     */
+    uint32_t GetNumHits(void) const { return mNumHits; }
+
+    /**
+     * This method returns the number of PSKcs computed.
+     *
+     * @returns The number of PSKcs computed.
+     *
+     */
+    uint32_t GetNumMisses(void) const { return mNumMisses; }
+
+    /**
+     * This method compares two buffers in a time independent of their contents.
+     *
+     * @param[in]   aFirst      A pointer to the first buffer.
+     * @param[in]   aSecond     A pointer to the second buffer.
+     * @param[in]   aLength     The length of the buffers.
+     *
+     * @returns Whether the buffers are equal.
+     *
+     */
+    static bool Equals(const uint8_t *aFirst, const uint8_t *aSecond, size_t aLength);
+
+private:
+    enum
+    {
+        kSizeOfKey  = 32,
+        kSizeOfSalt = 32,
+    };
+
+    struct Entry
+    {
+        uint8_t  mKey[kSizeOfKey];
+        uint8_t  mPskc[OT_PSKC_LENGTH];
+        uint32_t mLastUsed; ///< Zero for free entries.
+    };
+
+    struct Table
+    {
+        uint32_t mMagic;
+        uint32_t mClock;
+        uint8_t  mSalt[kSizeOfSalt]; ///< Key of the HMAC of entry keys.
+        Entry    mEntries[kNumEntries];
+    };
+
+    static otbrError InitTable(Table &aTable);
+    void ComputeKey(const uint8_t *aExtPanId, const char *aNetworkName, const char *aPassphrase, uint8_t *aKey);
+    int  Find(const uint8_t *aKey, uint8_t *aPskc);
+    void Insert(const uint8_t *aKey, const uint8_t *aPskc);
+    void Lock(void);
+    void Unlock(void);
+
+    Table   *mTable;
+    Table    mMemory;
+    int      mFd;
+    uint32_t mNumHits;
+    uint32_t mNumMisses;
+    uint8_t  mResult[OT_PSKC_LENGTH];
+    Pskc     mPskc;
+};
+
+} // namespace Psk
+} // namespace ot
+
+#endif  // PSKC_CACHE_HPP
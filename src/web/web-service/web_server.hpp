@@ -87,6 +87,17 @@ public:
      */
     void StartWebServer(const char *aIfName, uint16_t aPort);
 
+    /**
+     * This method persists the PSKcs computed for forming networks in a file.
+     *
+     * @param[in]  aPath    The pointer to the path of the file.
+     *
+     * @retval OTBR_ERROR_NONE   Successfully opened the file.
+     * @retval OTBR_ERROR_ERRNO  Failed to open the file, PSKcs are cached in memory.
+     *
+     */
+    otbrError SetPskcCacheFile(const char *aPath) { return mWpanService.SetPskcCacheFile(aPath); }
+
 private:
     typedef std::string (*HttpRequestCallback)(const std::string &aRequest, void *aUserData);
     static std::string HandleJoinNetworkRequest(const std::string &aJoinRequest, void *aUserData);
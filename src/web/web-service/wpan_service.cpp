@@ -74,7 +74,7 @@ std::string WpanService::HandleJoinNetworkRequest(const std::string &aJoinReques
     VerifyOrExit(wpanController.AddGateway(prefix.c_str(), defaultRoute) == ot::Dbus::kWpantundStatus_Ok,
                  ret = ot::Dbus::kWpantundStatus_SetGatewayFailed);
 
-    ot::Utils::Long2Hex(mNetworks[index].mExtPanId, extPanId);
+    ot::Utils::Long2Hex(mNetworks[index].mExtPanId, extPanId, sizeof(extPanId));
 exit:
 
     root.clear();
@@ -97,8 +97,7 @@ std::string WpanService::HandleFormNetworkRequest(const std::string &aFormReques
     Json::FastWriter         jsonWriter;
     Json::Reader             reader;
     std::string              response;
-    ot::Psk::Pskc            psk;
-    char                     pskcStr[OT_PSKC_MAX_LENGTH * 2];
+    char                     pskcStr[OT_PSKC_MAX_LENGTH * 2 + 1];
     uint8_t                  extPanIdBytes[OT_EXTENDED_PANID_LENGTH];
     ot::Dbus::WPANController wpanController;
     std::string              networkKey;
@@ -139,8 +138,9 @@ std::string WpanService::HandleFormNetworkRequest(const std::string &aFormReques
                                     extPanId.c_str()) == ot::Dbus::kWpantundStatus_Ok,
                  ret = ot::Dbus::kWpantundStatus_SetFailed);
     ot::Utils::Hex2Bytes(extPanId.c_str(), extPanIdBytes, OT_EXTENDED_PANID_LENGTH);
-    ot::Utils::Bytes2Hex(psk.ComputePskc(extPanIdBytes, networkName.c_str(),
-                                         passphrase.c_str()), OT_PSKC_MAX_LENGTH, pskcStr);
+    // Forming the same network again does not recompute its PSKc.
+    ot::Utils::Bytes2Hex(mPskcCache.ComputePskc(extPanIdBytes, networkName.c_str(),
+                                                passphrase.c_str()), OT_PSKC_MAX_LENGTH, pskcStr, sizeof(pskcStr));
     VerifyOrExit(wpanController.Set(kPropertyType_Data,
                                     kWPANTUNDProperty_NetworkPSKc,
                                     pskcStr) == ot::Dbus::kWpantundStatus_Ok,
@@ -332,8 +332,10 @@ std::string WpanService::HandleAvailableNetworkRequest()
     {
         char extPanId[OT_EXTENDED_PANID_LENGTH * 2 + 1], panId[OT_PANID_LENGTH * 2 + 3],
              hardwareAddress[OT_HARDWARE_ADDRESS_LENGTH * 2 + 1];
-        ot::Utils::Long2Hex(Thread::Encoding::BigEndian::HostSwap64(mNetworks[i].mExtPanId), extPanId);
-        ot::Utils::Bytes2Hex(mNetworks[i].mHardwareAddress, OT_HARDWARE_ADDRESS_LENGTH, hardwareAddress);
+        ot::Utils::Long2Hex(Thread::Encoding::BigEndian::HostSwap64(mNetworks[i].mExtPanId), extPanId,
+                            sizeof(extPanId));
+        ot::Utils::Bytes2Hex(mNetworks[i].mHardwareAddress, OT_HARDWARE_ADDRESS_LENGTH, hardwareAddress,
+                             sizeof(hardwareAddress));
         sprintf(panId, "0x%X", mNetworks[i].mPanId);
         networkInfo[i]["nn"] = mNetworks[i].mNetworkName;
         networkInfo[i]["xp"] = extPanId;
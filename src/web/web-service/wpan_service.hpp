@@ -43,6 +43,7 @@
 
 #include "../mdns-publisher/mdns_publisher.hpp"
 #include "../pskc-generator/pskc.hpp"
+#include "../pskc-generator/pskc_cache.hpp"
 #include "../wpan-controller/wpan_controller.hpp"
 #include "../utils/encoding.hpp"
 #include "common/logging.hpp"
@@ -149,11 +150,23 @@ public:
      */
     int GetWpanServiceStatus(std::string &aNetworkName, std::string &aExtPanId) const;
 
+    /**
+     * This method persists the PSKcs computed for forming networks in a file.
+     *
+     * @param[in]  aPath  The pointer to the path of the file.
+     *
+     * @retval OTBR_ERROR_NONE   Successfully opened the file.
+     * @retval OTBR_ERROR_ERRNO  Failed to open the file, PSKcs are cached in memory.
+     *
+     */
+    otbrError SetPskcCacheFile(const char *aPath) { return mPskcCache.Open(aPath); }
+
 private:
 
     ot::Dbus::WpanNetworkInfo mNetworks[DBUS_MAXIMUM_NAME_LENGTH];
     int                       mNetworksCount;
     char                      mIfName[IFNAMSIZ];
+    ot::Psk::PskcCache        mPskcCache;
     std::string               mNetworkName;
     std::string               mExtPanId;
     const char               *mResponseSuccess = "successful";
@@ -0,0 +1,491 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark comparing commissioner requests over DTLS and over TLS/TCP.
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/timing.h>
+
+#include "agent/coap.hpp"
+#include "agent/coap_stream.hpp"
+#include "agent/dtls.hpp"
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+
+using namespace ot::BorderRouter;
+
+enum
+{
+    kDtlsPort        = 49191,
+    kTlsPort         = 49192,
+    kDefaultRequests = 1000,
+    kSizeOfPayload   = 64,
+    kReadTimeout     = 2000, ///< Milliseconds to wait for a response.
+};
+
+static const uint8_t kPSKc[] = {
+    0xc3, 0xf5, 0x93, 0x68, 0x44, 0x5a, 0x1b, 0x61, 0x06, 0xbe, 0x42, 0x0a, 0x70, 0x6d, 0x4c, 0xc9,
+};
+static const uint8_t kSeed[] = "Benchmark";
+static const int     kCipherSuites[] = {
+    MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8,
+    0
+};
+
+/**
+ * This class implements the border agent side, serving one commissioner session at a time.
+ *
+ */
+class BenchServer
+{
+public:
+    BenchServer(bool aStream) :
+        mStream(aStream),
+        mDone(false),
+        mSession(NULL),
+        mServer(Dtls::Server::Create(aStream ? kTlsPort : kDtlsPort, HandleSessionState, this,
+                                     aStream ? Dtls::Server::kTransportStream : Dtls::Server::kTransportDatagram)),
+        mCoap(Coap::Agent::Create(SendCoap, this)),
+        mResource("c/cs", HandleRequest, this),
+        mCpuStart(0)
+    {
+    }
+
+    ~BenchServer(void)
+    {
+        Coap::Agent::Destroy(mCoap);
+        Dtls::Server::Destroy(mServer);
+    }
+
+    /**
+     * This method runs the server until the commissioner session ends.
+     *
+     * @param[in]   aReadyFd    The file descriptor to notify when the server is listening.
+     * @param[in]   aResultFd   The file descriptor to receive the CPU time in microseconds spent while ready.
+     *
+     */
+    int Run(int aReadyFd, int aResultFd)
+    {
+        int  ret = -1;
+        long cpu = 0;
+
+        mServer->SetSeed(kSeed, sizeof(kSeed));
+        mServer->SetPSK(kPSKc, sizeof(kPSKc));
+        SuccessOrExit(mServer->Start());
+        SuccessOrExit(mCoap->AddResource(mResource));
+        VerifyOrExit(write(aReadyFd, "R", 1) == 1);
+
+        while (!mDone)
+        {
+            fd_set         readFdSet;
+            fd_set         writeFdSet;
+            fd_set         errorFdSet;
+            int            maxFd = -1;
+            struct timeval timeout = {1, 0};
+
+            FD_ZERO(&readFdSet);
+            FD_ZERO(&writeFdSet);
+            FD_ZERO(&errorFdSet);
+
+            mServer->UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+            mCoap->UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+            VerifyOrExit(select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout) >= 0 || errno == EINTR);
+            mServer->Process(readFdSet, writeFdSet, errorFdSet);
+            mCoap->Process(readFdSet, writeFdSet, errorFdSet);
+        }
+
+        cpu = GetCpuTime() - mCpuStart;
+        VerifyOrExit(write(aResultFd, &cpu, sizeof(cpu)) == sizeof(cpu));
+        ret = 0;
+
+exit:
+        return ret;
+    }
+
+    static long GetCpuTime(void)
+    {
+        struct rusage usage;
+
+        getrusage(RUSAGE_SELF, &usage);
+
+        return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000 + usage.ru_utime.tv_usec +
+               usage.ru_stime.tv_usec;
+    }
+
+private:
+    static void HandleSessionState(Dtls::Session &aSession, Dtls::Session::State aState, void *aContext)
+    {
+        BenchServer *server = static_cast<BenchServer *>(aContext);
+
+        switch (aState)
+        {
+        case Dtls::Session::kStateReady:
+            server->mCpuStart = GetCpuTime();
+            server->mSession = &aSession;
+            aSession.SetDataHandler(HandleData, server);
+            break;
+
+        case Dtls::Session::kStateHandshaking:
+            break;
+
+        default:
+            server->mSession = NULL;
+            server->mDone = true;
+            break;
+        }
+    }
+
+    static void HandleData(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+    {
+        BenchServer       *server = static_cast<BenchServer *>(aContext);
+        const sockaddr_in6 &peer = aSession.GetPeerAddress();
+        uint8_t            message[Coap::StreamFramer::kMaxUdpMessage];
+        int                length;
+
+        if (!server->mStream)
+        {
+            server->mCoap->Input(aBuffer, aLength, peer.sin6_addr.s6_addr, ntohs(peer.sin6_port));
+            ExitNow();
+        }
+
+        server->mFramer.Feed(aBuffer, aLength);
+
+        while ((length = server->mFramer.Next(message, sizeof(message))) > 0)
+        {
+            if ((message[1] >> 5) != 7)
+            {
+                server->mCoap->Input(message, static_cast<uint16_t>(length), peer.sin6_addr.s6_addr,
+                                     ntohs(peer.sin6_port));
+            }
+        }
+
+exit:
+        return;
+    }
+
+    static ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
+                            void *aContext)
+    {
+        BenchServer *server = static_cast<BenchServer *>(aContext);
+        uint8_t      frame[Coap::StreamFramer::kMaxSizeOfHeader + Coap::StreamFramer::kMaxUdpMessage];
+        int          length;
+        ssize_t      ret = -1;
+
+        (void)aIp6;
+        (void)aPort;
+
+        VerifyOrExit(server->mSession != NULL, errno = ENOTCONN);
+        VerifyOrExit(server->mStream, ret = server->mSession->Write(aBuffer, aLength));
+        VerifyOrExit((length = Coap::StreamFramer::Frame(aBuffer, aLength, frame, sizeof(frame))) >= 0);
+        ret = aLength;
+        VerifyOrExit(length > 0);
+        VerifyOrExit(server->mSession->Write(frame, static_cast<uint16_t>(length)) == length, ret = -1);
+
+exit:
+        return ret;
+    }
+
+    static void HandleRequest(const Coap::Resource &aResource, const Coap::Message &aRequest,
+                              Coap::Message &aResponse, const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        uint16_t       length;
+        const uint8_t *payload = aRequest.GetPayload(length);
+
+        (void)aResource;
+        (void)aIp6;
+        (void)aPort;
+        (void)aContext;
+
+        aResponse.SetCode(Coap::kCodeChanged);
+        aResponse.SetPayload(payload, length);
+    }
+
+    bool                mStream;
+    bool                mDone;
+    Dtls::Session      *mSession;
+    Dtls::Server       *mServer;
+    Coap::Agent        *mCoap;
+    Coap::Resource      mResource;
+    Coap::StreamFramer  mFramer;
+    long                mCpuStart;
+};
+
+/**
+ * This class implements the commissioner side, measuring round trips of requests.
+ *
+ */
+class BenchClient
+{
+public:
+    BenchClient(bool aStream) :
+        mStream(aStream)
+    {
+        mbedtls_net_init(&mNet);
+        mbedtls_ssl_init(&mSsl);
+        mbedtls_ssl_config_init(&mConf);
+        mbedtls_entropy_init(&mEntropy);
+        mbedtls_ctr_drbg_init(&mDrbg);
+    }
+
+    ~BenchClient(void)
+    {
+        mbedtls_ssl_close_notify(&mSsl);
+        mbedtls_net_free(&mNet);
+        mbedtls_ssl_free(&mSsl);
+        mbedtls_ssl_config_free(&mConf);
+        mbedtls_ctr_drbg_free(&mDrbg);
+        mbedtls_entropy_free(&mEntropy);
+    }
+
+    int Connect(void)
+    {
+        int ret;
+
+        SuccessOrExit(ret = mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, kSeed, sizeof(kSeed)));
+        SuccessOrExit(ret = mbedtls_net_connect(&mNet, "::1", mStream ? "49192" : "49191",
+                                                mStream ? MBEDTLS_NET_PROTO_TCP : MBEDTLS_NET_PROTO_UDP));
+        SuccessOrExit(ret = mbedtls_ssl_config_defaults(&mConf, MBEDTLS_SSL_IS_CLIENT,
+                                                        mStream ? MBEDTLS_SSL_TRANSPORT_STREAM :
+                                                        MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                                        MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mDrbg);
+        mbedtls_ssl_conf_min_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_ciphersuites(&mConf, kCipherSuites);
+        mbedtls_ssl_conf_read_timeout(&mConf, kReadTimeout);
+        SuccessOrExit(ret = mbedtls_ssl_setup(&mSsl, &mConf));
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, NULL, mbedtls_net_recv_timeout);
+        mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        SuccessOrExit(ret = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, kPSKc, sizeof(kPSKc)));
+
+        do
+        {
+            ret = mbedtls_ssl_handshake(&mSsl);
+        } while (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE);
+
+exit:
+        return ret;
+    }
+
+    /**
+     * This method sends one request and waits for its response.
+     *
+     * @param[in]   aMessageId  The message id and token of the request.
+     *
+     * @returns 0 on a 2.04 Changed response, otherwise -1.
+     *
+     */
+    int Request(uint16_t aMessageId)
+    {
+        uint8_t request[Coap::StreamFramer::kSizeOfUdpHeader + 2 + 5 + 1 + kSizeOfPayload];
+        uint8_t frame[sizeof(request)];
+        uint8_t buffer[Coap::StreamFramer::kMaxUdpMessage];
+        uint8_t response[Coap::StreamFramer::kMaxUdpMessage];
+        int     length = 0;
+        int     ret = -1;
+
+        request[0] = 0x42; // Version 1, confirmable, 2 bytes token.
+        request[1] = Coap::kCodePost;
+        request[2] = request[4] = static_cast<uint8_t>(aMessageId >> 8);
+        request[3] = request[5] = static_cast<uint8_t>(aMessageId & 0xff);
+        memcpy(request + 6, "\xb1" "c" "\x02" "cs", 5); // Uri-Path c/cs.
+        request[11] = 0xff;
+        memset(request + 12, 0x5a, kSizeOfPayload);
+
+        if (mStream)
+        {
+            VerifyOrExit((length = Coap::StreamFramer::Frame(request, sizeof(request), frame, sizeof(frame))) > 0);
+            VerifyOrExit(mbedtls_ssl_write(&mSsl, frame, static_cast<size_t>(length)) == length);
+
+            // Skip signaling messages like the CSM of the border agent.
+            do
+            {
+                while ((length = mFramer.Next(response, sizeof(response))) == 0)
+                {
+                    int count = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer));
+
+                    VerifyOrExit(count > 0);
+                    mFramer.Feed(buffer, static_cast<uint16_t>(count));
+                }
+
+                VerifyOrExit(length > 0);
+            } while ((response[1] >> 5) == 7);
+        }
+        else
+        {
+            VerifyOrExit(mbedtls_ssl_write(&mSsl, request, sizeof(request)) == static_cast<int>(sizeof(request)));
+            VerifyOrExit((length = mbedtls_ssl_read(&mSsl, response, sizeof(response))) > 0);
+        }
+
+        VerifyOrExit(length > Coap::StreamFramer::kSizeOfUdpHeader && response[1] == Coap::kCodeChanged);
+        ret = 0;
+
+exit:
+        return ret;
+    }
+
+private:
+    bool                         mStream;
+    mbedtls_net_context          mNet;
+    mbedtls_ssl_context          mSsl;
+    mbedtls_ssl_config           mConf;
+    mbedtls_entropy_context      mEntropy;
+    mbedtls_ctr_drbg_context     mDrbg;
+    mbedtls_timing_delay_context mTimer;
+    Coap::StreamFramer           mFramer;
+};
+
+static long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return now.tv_sec * 1000000 + now.tv_usec;
+}
+
+static int RunBenchmark(const char *aName, bool aStream, unsigned aRequests)
+{
+    int   ret = -1;
+    int   ready[2] = {-1, -1};
+    int   result[2] = {-1, -1};
+    pid_t pid = -1;
+    char  byte;
+    long  serverCpu = 0;
+    long  clientCpu;
+    long  elapsed;
+
+    VerifyOrExit(pipe(ready) == 0 && pipe(result) == 0);
+    VerifyOrExit((pid = fork()) >= 0);
+
+    if (pid == 0)
+    {
+        BenchServer server(aStream);
+
+        _exit(server.Run(ready[1], result[1]) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+
+    VerifyOrExit(read(ready[0], &byte, 1) == 1);
+
+    {
+        BenchClient client(aStream);
+
+        VerifyOrExit(client.Connect() == 0, fprintf(stderr, "%s: handshake failed!\n", aName));
+
+        clientCpu = BenchServer::GetCpuTime();
+        elapsed = GetMicroseconds();
+
+        for (unsigned i = 0; i < aRequests; ++i)
+        {
+            VerifyOrExit(client.Request(static_cast<uint16_t>(i)) == 0,
+                         fprintf(stderr, "%s: request %u failed!\n", aName, i));
+        }
+
+        elapsed = GetMicroseconds() - elapsed;
+        clientCpu = BenchServer::GetCpuTime() - clientCpu;
+    }
+
+    VerifyOrExit(read(result[0], &serverCpu, sizeof(serverCpu)) == sizeof(serverCpu));
+
+    printf("%-4s requests=%u latency=%.1fus client-cpu=%.1fus server-cpu=%.1fus\n", aName, aRequests,
+           static_cast<double>(elapsed) / aRequests, static_cast<double>(clientCpu) / aRequests,
+           static_cast<double>(serverCpu) / aRequests);
+    ret = 0;
+
+exit:
+    if (pid > 0)
+    {
+        if (ret != 0)
+        {
+            kill(pid, SIGKILL);
+        }
+
+        waitpid(pid, NULL, 0);
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (ready[i] >= 0)
+        {
+            close(ready[i]);
+        }
+
+        if (result[i] >= 0)
+        {
+            close(result[i]);
+        }
+    }
+
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned requests = kDefaultRequests;
+    int      ret = EXIT_FAILURE;
+
+    if (argc > 1)
+    {
+        requests = static_cast<unsigned>(strtoul(argv[1], NULL, 0));
+    }
+
+    VerifyOrExit(argc <= 2 && requests > 0, fprintf(stderr, "Usage: %s [requests]\n", argv[0]));
+
+    otbrLogInit("otbr-bench-coaps", OTBR_LOG_ERR);
+
+    SuccessOrExit(RunBenchmark("dtls", false, requests));
+    SuccessOrExit(RunBenchmark("tls", true, requests));
+    ret = EXIT_SUCCESS;
+
+exit:
+    return ret;
+}
@@ -0,0 +1,201 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark computing the steering data of a batch of joiners with the CRC16 kernels.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/time.h>
+
+#include <vector>
+
+#include "utils/crc16.hpp"
+#include "utils/steeringdata.hpp"
+
+using ot::Crc16;
+
+enum
+{
+    kDefaultIterations = 20,
+    kNumJoiners        = 50000, ///< Size of a manufacturing batch.
+    kSteeringLength    = 16,    ///< Length of steering data set by SteeringData::Init().
+};
+
+static volatile unsigned sSink;
+
+/**
+ * This function computes a CRC16 one bit at a time, the way Crc16 did before its tables.
+ *
+ */
+static uint16_t ComputeBitwise(uint16_t aPolynomial, const uint8_t *aBuffer, size_t aLength)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        crc = crc ^ static_cast<uint16_t>(aBuffer[i] << 8);
+
+        for (int j = 0; j < 8; j++)
+        {
+            if (crc & 0x8000)
+            {
+                crc = static_cast<uint16_t>(crc << 1) ^ aPolynomial;
+            }
+            else
+            {
+                crc = static_cast<uint16_t>(crc << 1);
+            }
+        }
+    }
+
+    return crc;
+}
+
+static unsigned long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<unsigned long>(now.tv_sec * 1000000 + now.tv_usec);
+}
+
+static void Report(const char *aMethod, unsigned long aElapsed, unsigned aIterations, const uint8_t *aSteeringData,
+                   const uint8_t *aExpected)
+{
+    printf("%-9s joiners=%u iterations=%u time=%.1fns/joiner %s\n", aMethod, kNumJoiners, aIterations,
+           aElapsed * 1000.0 / aIterations / kNumJoiners,
+           memcmp(aSteeringData, aExpected, kSteeringLength) == 0 ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned              iterations = kDefaultIterations;
+    std::vector<uint8_t>  joinerIds(kNumJoiners * Crc16::kSizeOfBlock);
+    std::vector<uint16_t> ccitt(kNumJoiners);
+    std::vector<uint16_t> ansi(kNumJoiners);
+    ot::SteeringData      expected;
+    ot::SteeringData      steeringData;
+    unsigned long         elapsed;
+
+    if (argc > 1)
+    {
+        iterations = static_cast<unsigned>(strtoul(argv[1], NULL, 0));
+    }
+
+    if (argc > 2 || iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < joinerIds.size(); i++)
+    {
+        joinerIds[i] = static_cast<uint8_t>(rand());
+    }
+
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        expected.Init();
+
+        for (size_t j = 0; j < kNumJoiners; j++)
+        {
+            const uint8_t *joinerId = &joinerIds[j * Crc16::kSizeOfBlock];
+
+            expected.SetBit(ComputeBitwise(Crc16::kCcitt, joinerId, Crc16::kSizeOfBlock) % expected.GetNumBits());
+            expected.SetBit(ComputeBitwise(Crc16::kAnsi, joinerId, Crc16::kSizeOfBlock) % expected.GetNumBits());
+        }
+    }
+
+    Report("bitwise", GetMicroseconds() - elapsed, iterations, expected.GetDataPointer(),
+           expected.GetDataPointer());
+    elapsed = GetMicroseconds();
+
+    // Each joiner on its own, through the byte table.
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        steeringData.Init();
+
+        for (size_t j = 0; j < kNumJoiners; j++)
+        {
+            const uint8_t *joinerId = &joinerIds[j * Crc16::kSizeOfBlock];
+            Crc16          ccittCrc(Crc16::kCcitt);
+            Crc16          ansiCrc(Crc16::kAnsi);
+
+            for (int k = 0; k < Crc16::kSizeOfBlock; k++)
+            {
+                ccittCrc.Update(joinerId[k]);
+                ansiCrc.Update(joinerId[k]);
+            }
+
+            steeringData.SetBit(ccittCrc.Get() % steeringData.GetNumBits());
+            steeringData.SetBit(ansiCrc.Get() % steeringData.GetNumBits());
+        }
+    }
+
+    Report("bytewise", GetMicroseconds() - elapsed, iterations, steeringData.GetDataPointer(),
+           expected.GetDataPointer());
+
+    for (int backend = Crc16::kBackendTable; backend <= Crc16::kBackendPmull; backend++)
+    {
+        if (!Crc16::IsSupported(static_cast<Crc16::Backend>(backend)))
+        {
+            printf("%-9s unsupported\n", Crc16::BackendToString(static_cast<Crc16::Backend>(backend)));
+            continue;
+        }
+
+        elapsed = GetMicroseconds();
+
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            steeringData.Init();
+            Crc16::ComputeBlocks(&joinerIds[0], kNumJoiners, &ccitt[0], &ansi[0],
+                                 static_cast<Crc16::Backend>(backend));
+
+            for (size_t j = 0; j < kNumJoiners; j++)
+            {
+                steeringData.SetBit(ccitt[j] % steeringData.GetNumBits());
+                steeringData.SetBit(ansi[j] % steeringData.GetNumBits());
+            }
+        }
+
+        Report(Crc16::BackendToString(static_cast<Crc16::Backend>(backend)), GetMicroseconds() - elapsed, iterations,
+               steeringData.GetDataPointer(), expected.GetDataPointer());
+    }
+
+    sSink += steeringData.GetDataPointer()[0];
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a microbenchmark comparing the hex conversions with the ones they replaced.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/time.h>
+
+#include <string>
+
+#include "utils/hex.hpp"
+
+enum
+{
+    kDefaultIterations = 1000000,
+    kMaxLength         = 64,
+};
+
+static volatile unsigned sSink;
+
+/**
+ * This function converts bytes to hex the way Bytes2Hex() did before.
+ *
+ */
+static int LegacyBytes2Hex(const uint8_t *aBytes, const uint16_t aBytesLength, char *aHex)
+{
+    char        byteHex[3];
+    std::string hexString;
+
+    for (int i = 0; i < aBytesLength; i++)
+    {
+        sprintf(byteHex, "%02X", aBytes[i]);
+        hexString += byteHex;
+    }
+    strcpy(aHex, hexString.c_str());
+    return static_cast<int>(strlen(aHex));
+}
+
+/**
+ * This function converts hex to bytes the way Hex2Bytes() did before.
+ *
+ */
+static int LegacyHex2Bytes(const char *aHex, uint8_t *aBytes, uint16_t aBytesLength)
+{
+    size_t      hexLength = strlen(aHex);
+    const char *hexEnd = aHex + hexLength;
+    uint8_t    *cur = aBytes;
+    uint8_t     numChars = hexLength & 1;
+    uint8_t     byte = 0;
+
+    if ((hexLength + 1) / 2 > aBytesLength)
+    {
+        return -1;
+    }
+
+    while (aHex < hexEnd)
+    {
+        if ('A' <= *aHex && *aHex <= 'F')
+        {
+            byte |= 10 + (*aHex - 'A');
+        }
+        else if ('a' <= *aHex && *aHex <= 'f')
+        {
+            byte |= 10 + (*aHex - 'a');
+        }
+        else if ('0' <= *aHex && *aHex <= '9')
+        {
+            byte |= *aHex - '0';
+        }
+        else
+        {
+            return -1;
+        }
+
+        aHex++;
+        numChars++;
+
+        if (numChars >= 2)
+        {
+            numChars = 0;
+            *cur++ = byte;
+            byte = 0;
+        }
+        else
+        {
+            byte <<= 4;
+        }
+    }
+
+    return static_cast<int>(cur - aBytes);
+}
+
+static unsigned long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<unsigned long>(now.tv_sec * 1000000 + now.tv_usec);
+}
+
+static void Report(const char *aName, const char *aMethod, unsigned long aElapsed, unsigned aIterations)
+{
+    printf("%-6s %-7s iterations=%u time=%.1fns/conversion\n", aName, aMethod, aIterations,
+           aElapsed * 1000.0 / aIterations);
+}
+
+/**
+ * This function measures converting bytes of a length to hex and back.
+ *
+ */
+static void Run(const char *aName, uint16_t aLength, unsigned aIterations)
+{
+    uint8_t       bytes[kMaxLength];
+    uint8_t       decoded[kMaxLength];
+    char          hex[2 * kMaxLength + 1];
+    char          legacyHex[2 * kMaxLength + 1];
+    unsigned long elapsed;
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        bytes[i] = static_cast<uint8_t>(rand());
+    }
+
+    legacyHex[0] = '\0';
+
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        bytes[0] = static_cast<uint8_t>(i);
+        sSink += LegacyBytes2Hex(bytes, aLength, legacyHex);
+    }
+
+    Report(aName, "sprintf", GetMicroseconds() - elapsed, aIterations);
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        bytes[0] = static_cast<uint8_t>(i);
+        sSink += ot::Utils::Bytes2Hex(bytes, aLength, hex, sizeof(hex));
+    }
+
+    Report(aName, "encode", GetMicroseconds() - elapsed, aIterations);
+
+    if (strcmp(hex, legacyHex) != 0)
+    {
+        printf("%-6s MISMATCH\n", aName);
+    }
+
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        sSink += LegacyHex2Bytes(hex, decoded, aLength);
+        sSink += decoded[0];
+    }
+
+    Report(aName, "branch", GetMicroseconds() - elapsed, aIterations);
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        sSink += ot::Utils::Hex2Bytes(hex, 2 * aLength, decoded, aLength);
+        sSink += decoded[0];
+    }
+
+    Report(aName, "decode", GetMicroseconds() - elapsed, aIterations);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned iterations = kDefaultIterations;
+
+    if (argc > 1)
+    {
+        iterations = static_cast<unsigned>(strtoul(argv[1], NULL, 0));
+    }
+
+    if (argc > 2 || iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Run("eui64", 8, iterations);
+    Run("pskc", 16, iterations);
+    Run("key", 32, iterations);
+    Run("tlvs", kMaxLength, iterations);
+
+    return EXIT_SUCCESS;
+}
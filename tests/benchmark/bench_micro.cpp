@@ -0,0 +1,373 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the driver of the microbenchmark suite, which calibrates and times each benchmark and
+ *   writes the results as JSON.
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <getopt.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <sys/utsname.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "bench_micro.hpp"
+
+using namespace ot::Bench;
+
+enum
+{
+    kDefaultMinTime     = 200, ///< Minimum time of each repetition in milliseconds.
+    kDefaultRepetitions = 5,
+    kCalibrationDivisor = 10,  ///< The calibration stops at this fraction of the minimum time.
+};
+
+/**
+ * This structure represents the result of a benchmark.
+ *
+ */
+struct Result
+{
+    const char   *mName;
+    unsigned long mIterations;
+    double        mNsPerOp;    ///< Median of the repetitions.
+    double        mNsPerOpMin; ///< Best of the repetitions.
+    size_t        mBytes;
+};
+
+volatile unsigned ot::Bench::gSink;
+
+static const Benchmark *const kSuites[] = {
+    kUtilsBenchmarks, kTlvBenchmarks, kCoapBenchmarks, kEventBenchmarks, kDtlsBenchmarks, kLogBenchmarks,
+};
+
+static unsigned long long GetNanoseconds(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<unsigned long long>(now.tv_sec) * 1000000000ULL + static_cast<unsigned long long>(now.tv_nsec);
+}
+
+static unsigned long long Time(const Benchmark &aBenchmark, unsigned long aIterations)
+{
+    unsigned long long start = GetNanoseconds();
+
+    aBenchmark.mRun(aIterations);
+
+    return GetNanoseconds() - start;
+}
+
+/**
+ * This function finds the number of iterations lasting about the minimum time.
+ *
+ */
+static unsigned long Calibrate(const Benchmark &aBenchmark, unsigned long long aMinTime)
+{
+    unsigned long      iterations = 1;
+    unsigned long long elapsed;
+
+    while ((elapsed = Time(aBenchmark, iterations)) < aMinTime / kCalibrationDivisor)
+    {
+        iterations *= (elapsed == 0 ? 100 : 10);
+    }
+
+    return static_cast<unsigned long>(iterations * (static_cast<double>(aMinTime) / elapsed)) + 1;
+}
+
+static bool Measure(const Benchmark &aBenchmark, unsigned long long aMinTime, unsigned aRepetitions, Result &aResult)
+{
+    std::vector<double> samples;
+
+    if (aBenchmark.mSetUp != NULL && !aBenchmark.mSetUp())
+    {
+        fprintf(stderr, "%s: set up failed\n", aBenchmark.mName);
+        return false;
+    }
+
+    aResult.mName       = aBenchmark.mName;
+    aResult.mBytes      = aBenchmark.mBytes;
+    aResult.mIterations = Calibrate(aBenchmark, aMinTime);
+
+    for (unsigned i = 0; i < aRepetitions; i++)
+    {
+        samples.push_back(static_cast<double>(Time(aBenchmark, aResult.mIterations)) / aResult.mIterations);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    aResult.mNsPerOp    = samples[samples.size() / 2];
+    aResult.mNsPerOpMin = samples.front();
+
+    if (aBenchmark.mTearDown != NULL)
+    {
+        aBenchmark.mTearDown();
+    }
+
+    fprintf(stderr, "%-24s %12lu iterations %12.1f ns/op %12.1f ns/op min", aResult.mName, aResult.mIterations,
+            aResult.mNsPerOp, aResult.mNsPerOpMin);
+
+    if (aResult.mBytes != 0)
+    {
+        fprintf(stderr, " %10.1f MB/s", aResult.mBytes * 1000.0 / aResult.mNsPerOp);
+    }
+
+    fprintf(stderr, "\n");
+
+    return true;
+}
+
+static void WriteString(FILE *aOutput, const char *aString)
+{
+    fputc('"', aOutput);
+
+    for (const char *p = aString; *p != '\0'; p++)
+    {
+        unsigned char c = static_cast<unsigned char>(*p);
+
+        if (c == '"' || c == '\\')
+        {
+            fprintf(aOutput, "\\%c", c);
+        }
+        else if (c < 0x20)
+        {
+            fprintf(aOutput, "\\u%04x", c);
+        }
+        else
+        {
+            fputc(c, aOutput);
+        }
+    }
+
+    fputc('"', aOutput);
+}
+
+static void WriteJson(FILE *aOutput, const std::vector<Result> &aResults, const char *aLabel, unsigned aMinTime,
+                      unsigned aRepetitions)
+{
+    struct utsname system;
+    char           date[32];
+    time_t         now = time(NULL);
+
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+    if (uname(&system) != 0)
+    {
+        strcpy(system.nodename, "unknown");
+        strcpy(system.machine, "unknown");
+    }
+
+    fprintf(aOutput, "{\n  \"context\": {\n    \"label\": ");
+    WriteString(aOutput, aLabel);
+    fprintf(aOutput, ",\n    \"date\": \"%s\",\n    \"host\": ", date);
+    WriteString(aOutput, system.nodename);
+    fprintf(aOutput, ",\n    \"machine\": ");
+    WriteString(aOutput, system.machine);
+    fprintf(aOutput, ",\n    \"compiler\": ");
+    WriteString(aOutput, __VERSION__);
+    fprintf(aOutput, ",\n    \"min_time_ms\": %u,\n    \"repetitions\": %u\n  },\n  \"benchmarks\": [", aMinTime,
+            aRepetitions);
+
+    for (std::vector<Result>::const_iterator it = aResults.begin(); it != aResults.end(); ++it)
+    {
+        fprintf(aOutput, "%s\n    {\"name\": ", it == aResults.begin() ? "" : ",");
+        WriteString(aOutput, it->mName);
+        fprintf(aOutput, ", \"iterations\": %lu, \"ns_per_op\": %.3f, \"ns_per_op_min\": %.3f", it->mIterations,
+                it->mNsPerOp, it->mNsPerOpMin);
+
+        // An operation below the clock resolution has no rate, and inf is not valid JSON.
+        if (it->mNsPerOp > 0)
+        {
+            fprintf(aOutput, ", \"ops_per_sec\": %.1f", 1e9 / it->mNsPerOp);
+
+            if (it->mBytes != 0)
+            {
+                fprintf(aOutput, ", \"bytes_per_sec\": %.1f", it->mBytes * 1e9 / it->mNsPerOp);
+            }
+        }
+
+        fprintf(aOutput, "}");
+    }
+
+    fprintf(aOutput, "\n  ]\n}\n");
+}
+
+static void PrintUsage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s [-l] [-f FILTER] [-o FILE] [-r REPETITIONS] [-t MIN_MS] [-L LABEL]\n"
+            "    -l              List the benchmarks and exit.\n"
+            "    -f FILTER       Run only the benchmarks whose name contains FILTER.\n"
+            "    -o FILE         Write the JSON results to FILE instead of the standard output.\n"
+            "    -r REPETITIONS  Number of timed repetitions, the median is reported, defaults to %d.\n"
+            "    -t MIN_MS       Minimum time of each repetition in milliseconds, defaults to %d.\n"
+            "    -L LABEL        Label of the results, such as the commit being measured.\n",
+            aProgram, kDefaultRepetitions, kDefaultMinTime);
+}
+
+// Parses a positive decimal or hexadecimal number that fits an unsigned.
+static bool ParseCount(const char *aString, unsigned &aValue)
+{
+    char         *end;
+    unsigned long value;
+
+    if (!isdigit(static_cast<unsigned char>(aString[0])))
+    {
+        return false;
+    }
+
+    errno = 0;
+    value = strtoul(aString, &end, 0);
+
+    if (errno != 0 || *end != '\0' || value == 0 || value > UINT_MAX)
+    {
+        return false;
+    }
+
+    aValue = static_cast<unsigned>(value);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    const char         *filter = NULL;
+    const char         *path = NULL;
+    const char         *label = "";
+    unsigned            minTime = kDefaultMinTime;
+    unsigned            repetitions = kDefaultRepetitions;
+    bool                list = false;
+    std::vector<Result> results;
+    FILE               *output = stdout;
+    int                 ret = EXIT_SUCCESS;
+    int                 opt;
+
+    while ((opt = getopt(argc, argv, "f:lL:o:r:t:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'f':
+            filter = optarg;
+            break;
+
+        case 'l':
+            list = true;
+            break;
+
+        case 'L':
+            label = optarg;
+            break;
+
+        case 'o':
+            path = optarg;
+            break;
+
+        case 'r':
+            if (!ParseCount(optarg, repetitions))
+            {
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 't':
+            if (!ParseCount(optarg, minTime))
+            {
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        default:
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optind != argc)
+    {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // The output is opened first so that a bad path fails before the measurements rather than after.
+    if (!list && path != NULL && (output = fopen(path, "w")) == NULL)
+    {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < sizeof(kSuites) / sizeof(kSuites[0]); i++)
+    {
+        for (const Benchmark *benchmark = kSuites[i]; benchmark->mName != NULL; benchmark++)
+        {
+            Result result;
+
+            if (filter != NULL && strstr(benchmark->mName, filter) == NULL)
+            {
+                continue;
+            }
+
+            if (list)
+            {
+                printf("%s\n", benchmark->mName);
+            }
+            else if (Measure(*benchmark, minTime * 1000000ULL, repetitions, result))
+            {
+                results.push_back(result);
+            }
+            else
+            {
+                ret = EXIT_FAILURE;
+            }
+        }
+    }
+
+    if (list)
+    {
+        return ret;
+    }
+
+    WriteJson(output, results, label, minTime, repetitions);
+
+    if (output != stdout)
+    {
+        fclose(output);
+    }
+
+    return ret;
+}
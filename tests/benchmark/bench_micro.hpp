@@ -0,0 +1,82 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for the microbenchmark suite of the border router hot primitives.
+ */
+
+#ifndef BENCH_MICRO_HPP_
+#define BENCH_MICRO_HPP_
+
+#include <stddef.h>
+
+namespace ot {
+
+namespace Bench {
+
+/**
+ * This structure represents a microbenchmark.
+ *
+ * A benchmark keeps its state in its translation unit. The state is prepared by @p mSetUp, which is not timed,
+ * and released by @p mTearDown. @p mRun may be called many times in between, as the iterations are calibrated.
+ *
+ */
+struct Benchmark
+{
+    const char *mName;                          ///< The name, as AREA/CASE.
+    bool (*mSetUp)(void);                       ///< Prepares the state, returns false on failure, may be NULL.
+    void (*mRun)(unsigned long aIterations);    ///< Runs the given number of iterations.
+    void (*mTearDown)(void);                    ///< Releases the state, may be NULL.
+    size_t mBytes;                              ///< Bytes processed per iteration, 0 if not meaningful.
+};
+
+/**
+ * Volatile sink for results that must not be optimized out.
+ *
+ */
+extern volatile unsigned gSink;
+
+/**
+ * The benchmarks of each area, each array is terminated by an entry without name.
+ *
+ * The logging benchmarks must run last, as the log file they enable cannot be closed.
+ *
+ */
+extern const Benchmark kUtilsBenchmarks[];
+extern const Benchmark kTlvBenchmarks[];
+extern const Benchmark kCoapBenchmarks[];
+extern const Benchmark kEventBenchmarks[];
+extern const Benchmark kDtlsBenchmarks[];
+extern const Benchmark kLogBenchmarks[];
+
+} // namespace Bench
+
+} // namespace ot
+
+#endif // BENCH_MICRO_HPP_
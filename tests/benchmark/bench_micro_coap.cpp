@@ -0,0 +1,252 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the microbenchmarks of the TLV traversal and of building and parsing CoAP messages with
+ *   the CoAP agent.
+ */
+
+#include <string.h>
+
+#include "bench_micro.hpp"
+#include "agent/coap.hpp"
+#include "common/code_utils.hpp"
+#include "common/tlv.hpp"
+#include "common/tlv_view.hpp"
+
+namespace ot {
+
+namespace Bench {
+
+namespace Coap = BorderRouter::Coap;
+
+enum
+{
+    kSizeOfRecord   = 200,  ///< Size of the DTLS record encapsulated in the relayed message.
+    kSizeOfPayload  = 64,   ///< Size of the payload of the CoAP messages.
+    kSizeOfMessage  = 1280, ///< Size of the buffer capturing the CoAP messages sent.
+    kPort           = 49191,
+};
+
+static const uint8_t kToken[] = {0x12, 0x34};
+static const uint8_t kIp6[16] = {0xfd, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+                                 0x00, 0x00, 0x00, 0xff, 0xfe, 0x00, 0xfc, 0x00};
+static const char    kPath[]  = "c/cs";
+
+static uint8_t          sRelay[kSizeOfRecord + 32];
+static uint16_t         sRelayLength;
+static Coap::Agent     *sAgent;
+static uint8_t          sPayload[kSizeOfPayload];
+static uint8_t          sMessage[kSizeOfMessage];
+static uint16_t         sMessageLength;
+
+/**
+ * This function builds a Relay Transmit message as sent by a commissioner.
+ *
+ */
+static bool SetUpRelay(void)
+{
+    uint8_t iid[8];
+    uint8_t record[kSizeOfRecord];
+    Tlv    *tlv = reinterpret_cast<Tlv *>(sRelay);
+
+    memset(iid, 0x11, sizeof(iid));
+    memset(record, 0x16, sizeof(record));
+
+    tlv->SetType(Meshcop::kJoinerUdpPort);
+    tlv->SetValue(static_cast<uint16_t>(1000));
+    tlv = tlv->GetNext();
+    tlv->SetType(Meshcop::kJoinerIid);
+    tlv->SetValue(iid, sizeof(iid));
+    tlv = tlv->GetNext();
+    tlv->SetType(Meshcop::kJoinerRouterLocator);
+    tlv->SetValue(static_cast<uint16_t>(0x0400));
+    tlv = tlv->GetNext();
+    tlv->SetType(Meshcop::kJoinerDtlsEncapsulation);
+    tlv->SetValue(record, sizeof(record));
+    tlv = tlv->GetNext();
+
+    sRelayLength = static_cast<uint16_t>(reinterpret_cast<uint8_t *>(tlv) - sRelay);
+
+    return true;
+}
+
+static void RunTlvWalk(unsigned long aIterations)
+{
+    const Tlv *end = reinterpret_cast<const Tlv *>(sRelay + sRelayLength);
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        for (const Tlv *tlv = reinterpret_cast<const Tlv *>(sRelay); tlv < end; tlv = tlv->GetNext())
+        {
+            gSink += tlv->GetType();
+        }
+    }
+}
+
+static void RunTlvView(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        TlvView  view;
+        uint16_t port = 0;
+        uint16_t locator = 0;
+        uint16_t length = 0;
+
+        view.Init(sRelay, sRelayLength);
+        view.GetJoinerUdpPort(port);
+        view.GetJoinerRouterLocator(locator);
+        gSink += port + locator + (view.GetJoinerIid() != NULL) + (view.GetJoinerDtlsEncapsulation(length) != NULL) +
+                 length;
+    }
+}
+
+/**
+ * This function captures the messages sent by the CoAP agent.
+ *
+ */
+static ssize_t CaptureMessage(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
+                              void *aContext)
+{
+    if (aLength <= sizeof(sMessage))
+    {
+        memcpy(sMessage, aBuffer, aLength);
+        sMessageLength = aLength;
+    }
+
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+
+    return aLength;
+}
+
+static void HandleRequest(const Coap::Resource &aResource, const Coap::Message &aRequest, Coap::Message &aResponse,
+                          const uint8_t *aIp6, uint16_t aPort, void *aContext)
+{
+    uint16_t length;
+
+    gSink += (aRequest.GetPayload(length) != NULL) + length;
+
+    (void)aResource;
+    (void)aResponse;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+}
+
+static const Coap::Resource kResource(kPath, HandleRequest, NULL);
+
+static Coap::Message *BuildMessage(void)
+{
+    Coap::Message *message = sAgent->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost, kToken, sizeof(kToken));
+
+    message->SetPath(kPath);
+    message->SetPayload(sPayload, sizeof(sPayload));
+
+    return message;
+}
+
+static bool SetUpAgent(void)
+{
+    sAgent = Coap::Agent::Create(CaptureMessage, NULL);
+    memset(sPayload, 0x5a, sizeof(sPayload));
+
+    return sAgent != NULL && sAgent->AddResource(kResource) == OTBR_ERROR_NONE;
+}
+
+/**
+ * This function captures a request to parse, which the CoAP agent routes to the resource.
+ *
+ */
+static bool SetUpRequest(void)
+{
+    Coap::Message *message;
+    bool           ret = false;
+
+    sMessageLength = 0;
+
+    VerifyOrExit(SetUpAgent());
+    message = BuildMessage();
+    ret = (sAgent->Send(*message, kIp6, kPort, NULL, NULL) == OTBR_ERROR_NONE && sMessageLength != 0);
+    sAgent->FreeMessage(message);
+
+exit:
+    return ret;
+}
+
+static void TearDownAgent(void)
+{
+    sAgent->RemoveResource(kResource);
+    Coap::Agent::Destroy(sAgent);
+    sAgent = NULL;
+}
+
+/**
+ * This function builds requests and sends them the way the border agent does, the agent frees the sent PDU.
+ *
+ */
+static void RunCoapBuild(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        Coap::Message *message = BuildMessage();
+
+        sAgent->Send(*message, kIp6, kPort, NULL, NULL);
+        sAgent->FreeMessage(message);
+        gSink += sMessageLength;
+    }
+}
+
+static void RunCoapParse(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        // A new message ID per request, so that none is taken for a duplicate.
+        sMessage[2] = static_cast<uint8_t>(i >> 8);
+        sMessage[3] = static_cast<uint8_t>(i);
+        sAgent->Input(sMessage, sMessageLength, kIp6, kPort);
+    }
+}
+
+const Benchmark kTlvBenchmarks[] = {
+    {"tlv/walk", SetUpRelay, RunTlvWalk, NULL, 0},
+    {"tlv/view", SetUpRelay, RunTlvView, NULL, 0},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+const Benchmark kCoapBenchmarks[] = {
+    {"coap/build", SetUpAgent, RunCoapBuild, TearDownAgent, 0},
+    {"coap/parse", SetUpRequest, RunCoapParse, TearDownAgent, 0},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+} // namespace Bench
+
+} // namespace ot
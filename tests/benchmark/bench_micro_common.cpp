@@ -0,0 +1,129 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the microbenchmarks of the event emitter and of logging.
+ */
+
+#include <stdarg.h>
+
+#include "bench_micro.hpp"
+#include "common/event_emitter.hpp"
+#include "common/logging.hpp"
+
+namespace ot {
+
+namespace Bench {
+
+enum
+{
+    kEventReady = 1,
+    kEventOther = 2, ///< An event with a handler, so that the emitter looks up among several events.
+};
+
+static BorderRouter::EventEmitter *sEmitter;
+
+static void HandleEvent(void *aContext, int aEvent, va_list aArguments)
+{
+    gSink += static_cast<unsigned>(aEvent + va_arg(aArguments, int));
+
+    (void)aContext;
+}
+
+static bool SetUpEmitter(void)
+{
+    sEmitter = new BorderRouter::EventEmitter();
+    sEmitter->On(kEventReady, HandleEvent, NULL);
+    sEmitter->On(kEventOther, HandleEvent, NULL);
+
+    return true;
+}
+
+static void TearDownEmitter(void)
+{
+    delete sEmitter;
+    sEmitter = NULL;
+}
+
+static void RunEmit(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        sEmitter->Emit(kEventReady, static_cast<int>(i));
+    }
+}
+
+/**
+ * This function opens the syslog with a level filtering out the debug messages.
+ *
+ */
+static bool SetUpLogFiltered(void)
+{
+    otbrLogInit("otbr-bench", OTBR_LOG_ERR);
+
+    return true;
+}
+
+/**
+ * This function enables logging to /dev/null, which formats every message regardless of the level.
+ *
+ * The syslog is disabled as it is opened with LOG_PERROR, and the log file cannot be closed afterwards.
+ *
+ */
+static bool SetUpLogEnabled(void)
+{
+    otbrLogEnableSyslog(false);
+    otbrLogSetFilename("/dev/null");
+
+    return true;
+}
+
+static void RunLog(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        otbrLog(OTBR_LOG_DEBUG, "Commissioner session %u relayed %d bytes to port %u", 0x1234u,
+                static_cast<int>(i & 0xff), 1000u);
+    }
+}
+
+const Benchmark kEventBenchmarks[] = {
+    {"event/emit", SetUpEmitter, RunEmit, TearDownEmitter, 0},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+const Benchmark kLogBenchmarks[] = {
+    {"log/filtered", SetUpLogFiltered, RunLog, NULL, 0},
+    {"log/enabled", SetUpLogEnabled, RunLog, NULL, 0},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+} // namespace Bench
+
+} // namespace ot
@@ -0,0 +1,227 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the microbenchmark of a DTLS record round trip between a client and a server connected by
+ *   a socket pair.
+ */
+
+#include <string.h>
+
+#include <sys/socket.h>
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/timing.h>
+
+#include "bench_micro.hpp"
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+namespace Bench {
+
+enum
+{
+    kSizeOfRecord     = 64,  ///< Size of the application data of each record.
+    kMaxHandshakeTurn = 100, ///< Maximum turns of the handshake, each peer proceeding as far as it can.
+};
+
+static const uint8_t kPSKc[] = {
+    0xc3, 0xf5, 0x93, 0x68, 0x44, 0x5a, 0x1b, 0x61, 0x06, 0xbe, 0x42, 0x0a, 0x70, 0x6d, 0x4c, 0xc9,
+};
+static const uint8_t kSeed[]         = "Benchmark";
+static const int     kCipherSuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+
+/**
+ * This class represents a DTLS peer over one end of the socket pair.
+ *
+ */
+class Peer
+{
+public:
+    Peer(void)
+    {
+        mbedtls_net_init(&mNet);
+        mbedtls_ssl_init(&mSsl);
+        mbedtls_ssl_config_init(&mConf);
+        mbedtls_entropy_init(&mEntropy);
+        mbedtls_ctr_drbg_init(&mDrbg);
+    }
+
+    ~Peer(void)
+    {
+        mbedtls_net_free(&mNet);
+        mbedtls_ssl_free(&mSsl);
+        mbedtls_ssl_config_free(&mConf);
+        mbedtls_ctr_drbg_free(&mDrbg);
+        mbedtls_entropy_free(&mEntropy);
+    }
+
+    int Init(int aEndpoint, int aFd)
+    {
+        int ret;
+
+        mNet.fd = aFd;
+        SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
+        SuccessOrExit(ret = mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, kSeed, sizeof(kSeed)));
+        SuccessOrExit(ret = mbedtls_ssl_config_defaults(&mConf, aEndpoint, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                                        MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mDrbg);
+        mbedtls_ssl_conf_min_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_ciphersuites(&mConf, kCipherSuites);
+#if defined(MBEDTLS_SSL_DTLS_HELLO_VERIFY)
+        // The socket pair has no address to verify.
+        mbedtls_ssl_conf_dtls_cookies(&mConf, NULL, NULL, NULL);
+#endif
+        SuccessOrExit(ret = mbedtls_ssl_setup(&mSsl, &mConf));
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+        mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        ret = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, kPSKc, sizeof(kPSKc));
+
+    exit:
+        return ret;
+    }
+
+    /**
+     * This method proceeds with the handshake as far as possible without the peer.
+     *
+     * @returns 0 if the handshake is over, MBEDTLS_ERR_SSL_WANT_READ if waiting for the peer, or an error.
+     *
+     */
+    int Handshake(void)
+    {
+        int ret = mbedtls_ssl_handshake(&mSsl);
+
+        return ret == MBEDTLS_ERR_SSL_WANT_WRITE ? MBEDTLS_ERR_SSL_WANT_READ : ret;
+    }
+
+    int Write(const uint8_t *aBuffer, size_t aLength) { return mbedtls_ssl_write(&mSsl, aBuffer, aLength); }
+
+    int Read(uint8_t *aBuffer, size_t aLength) { return mbedtls_ssl_read(&mSsl, aBuffer, aLength); }
+
+private:
+    mbedtls_net_context          mNet;
+    mbedtls_ssl_context          mSsl;
+    mbedtls_ssl_config           mConf;
+    mbedtls_entropy_context      mEntropy;
+    mbedtls_ctr_drbg_context     mDrbg;
+    mbedtls_timing_delay_context mTimer;
+};
+
+static Peer *sClient;
+static Peer *sServer;
+
+static void TearDownDtls(void)
+{
+    // The peers own the sockets.
+    delete sClient;
+    delete sServer;
+    sClient = NULL;
+    sServer = NULL;
+}
+
+static bool SetUpDtls(void)
+{
+    int  fds[2];
+    int  client = MBEDTLS_ERR_SSL_WANT_READ;
+    int  server = MBEDTLS_ERR_SSL_WANT_READ;
+    bool ret = false;
+
+    VerifyOrExit(socketpair(AF_UNIX, SOCK_DGRAM, 0, fds) == 0);
+
+    sClient = new Peer();
+    sServer = new Peer();
+    VerifyOrExit(sClient->Init(MBEDTLS_SSL_IS_CLIENT, fds[0]) == 0);
+    VerifyOrExit(sServer->Init(MBEDTLS_SSL_IS_SERVER, fds[1]) == 0);
+
+    for (int turn = 0; turn < kMaxHandshakeTurn && (client != 0 || server != 0); turn++)
+    {
+        if (client == MBEDTLS_ERR_SSL_WANT_READ)
+        {
+            client = sClient->Handshake();
+        }
+
+        if (server == MBEDTLS_ERR_SSL_WANT_READ)
+        {
+            server = sServer->Handshake();
+        }
+    }
+
+    ret = (client == 0 && server == 0);
+
+exit:
+    if (!ret)
+    {
+        TearDownDtls();
+    }
+
+    return ret;
+}
+
+/**
+ * This function sends a record from the client, which the server echoes back.
+ *
+ */
+static void RunDtlsRoundTrip(unsigned long aIterations)
+{
+    uint8_t request[kSizeOfRecord];
+    uint8_t response[kSizeOfRecord];
+
+    memset(request, 0x5a, sizeof(request));
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        int length;
+
+        request[0] = static_cast<uint8_t>(i);
+        sClient->Write(request, sizeof(request));
+        length = sServer->Read(response, sizeof(response));
+        sServer->Write(response, length > 0 ? static_cast<size_t>(length) : 0);
+        gSink += sClient->Read(response, sizeof(response));
+    }
+}
+
+const Benchmark kDtlsBenchmarks[] = {
+    {"dtls/round-trip", SetUpDtls, RunDtlsRoundTrip, TearDownDtls, 2 * kSizeOfRecord},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+} // namespace Bench
+
+} // namespace ot
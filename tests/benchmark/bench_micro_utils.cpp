@@ -0,0 +1,171 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the microbenchmarks of the CRC16, steering data, hex and PSKc utilities.
+ */
+
+#include <string.h>
+
+#include "bench_micro.hpp"
+#include "utils/crc16.hpp"
+#include "utils/hex.hpp"
+#include "utils/steeringdata.hpp"
+#include "web/pskc-generator/pskc.hpp"
+
+namespace ot {
+
+namespace Bench {
+
+enum
+{
+    kSizeOfJoinerId  = 8,
+    kNumJoiners      = 64,  ///< Joiners added to the steering data at once.
+    kSizeOfHexBuffer = 256, ///< Bytes converted by the hex benchmarks.
+};
+
+static const uint8_t kJoinerId[kSizeOfJoinerId] = {0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x01};
+static const uint8_t kExtPanId[]                 = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+
+static uint8_t sJoinerIds[kNumJoiners * kSizeOfJoinerId];
+static uint8_t sBytes[kSizeOfHexBuffer];
+static char    sHex[kSizeOfHexBuffer * 2 + 1];
+
+static void RunCrc16(unsigned long aIterations)
+{
+    Crc16 ccitt(Crc16::kCcitt);
+    Crc16 ansi(Crc16::kAnsi);
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        ccitt.Init();
+        ansi.Init();
+        ccitt.Update(kJoinerId, sizeof(kJoinerId));
+        ansi.Update(kJoinerId, sizeof(kJoinerId));
+        gSink += ccitt.Get() ^ ansi.Get();
+    }
+}
+
+static void RunCrc16Blocks(unsigned long aIterations)
+{
+    uint16_t ccitt[kNumJoiners];
+    uint16_t ansi[kNumJoiners];
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        Crc16::ComputeBlocks(sJoinerIds, kNumJoiners, ccitt, ansi);
+        gSink += ccitt[0] ^ ansi[kNumJoiners - 1];
+    }
+}
+
+static bool SetUpJoiners(void)
+{
+    for (unsigned i = 0; i < kNumJoiners; i++)
+    {
+        memcpy(&sJoinerIds[i * kSizeOfJoinerId], kJoinerId, kSizeOfJoinerId);
+        sJoinerIds[i * kSizeOfJoinerId + kSizeOfJoinerId - 1] = static_cast<uint8_t>(i);
+    }
+
+    return true;
+}
+
+static void RunSteeringDataOne(unsigned long aIterations)
+{
+    SteeringData steeringData;
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        steeringData.Init();
+        steeringData.ComputeBloomFilter(kJoinerId);
+        gSink += steeringData.GetDataPointer()[0];
+    }
+}
+
+static void RunSteeringDataBatch(unsigned long aIterations)
+{
+    SteeringData steeringData;
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        steeringData.Init();
+        steeringData.ComputeBloomFilter(sJoinerIds, kNumJoiners);
+        gSink += steeringData.GetDataPointer()[0];
+    }
+}
+
+static bool SetUpHex(void)
+{
+    for (unsigned i = 0; i < kSizeOfHexBuffer; i++)
+    {
+        sBytes[i] = static_cast<uint8_t>(i * 7);
+    }
+
+    return Utils::Bytes2Hex(sBytes, kSizeOfHexBuffer, sHex) > 0;
+}
+
+static void RunBytes2Hex(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        gSink += Utils::Bytes2Hex(sBytes, kSizeOfHexBuffer, sHex);
+    }
+}
+
+static void RunHex2Bytes(unsigned long aIterations)
+{
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        gSink += Utils::Hex2Bytes(sHex, sBytes, kSizeOfHexBuffer);
+    }
+}
+
+static void RunPskc(unsigned long aIterations)
+{
+    Psk::Pskc pskc;
+
+    for (unsigned long i = 0; i < aIterations; i++)
+    {
+        gSink += pskc.ComputePskc(kExtPanId, "OpenThread", "123456")[0];
+    }
+}
+
+const Benchmark kUtilsBenchmarks[] = {
+    {"crc16/joiner-id", NULL, RunCrc16, NULL, kSizeOfJoinerId},
+    {"crc16/blocks", SetUpJoiners, RunCrc16Blocks, NULL, sizeof(sJoinerIds)},
+    {"steering/add-joiner", NULL, RunSteeringDataOne, NULL, kSizeOfJoinerId},
+    {"steering/add-joiners", SetUpJoiners, RunSteeringDataBatch, NULL, sizeof(sJoinerIds)},
+    {"hex/encode", SetUpHex, RunBytes2Hex, NULL, kSizeOfHexBuffer},
+    {"hex/decode", SetUpHex, RunHex2Bytes, NULL, kSizeOfHexBuffer},
+    {"pskc/compute", NULL, RunPskc, NULL, 0},
+    {NULL, NULL, NULL, NULL, 0},
+};
+
+} // namespace Bench
+
+} // namespace ot
@@ -0,0 +1,189 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a benchmark comparing the PSKc derivation by mbedtls with the CMAC PRF backends.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/time.h>
+
+#include <mbedtls/cmac.h>
+
+#include "web/pskc-generator/pskc.hpp"
+
+using namespace ot::Psk;
+
+enum
+{
+    kDefaultIterations = 20,
+};
+
+static const uint8_t kExtPanId[OT_EXTENDED_PAN_ID_LENGTH] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+};
+static const char    kNetworkName[] = "Test Network";
+static const char    kPassphrase[] = "12SECRETPASSWORD34";
+
+static volatile unsigned sSink;
+
+/**
+ * This function derives the PSKc the way the PSKc generator did before the CMAC PRF, with a full
+ * mbedtls_aes_cmac_prf_128() per iteration.
+ *
+ */
+static void ComputeReference(uint8_t *aPskc)
+{
+    uint8_t prfInput[OT_PBKDF2_SALT_MAX_LENGTH + 4];
+    uint8_t prfOutput[OT_PSKC_LENGTH];
+    size_t  saltLength = 0;
+
+    memcpy(prfInput, "Thread", 6);
+    saltLength += 6;
+    memcpy(prfInput + saltLength, kExtPanId, sizeof(kExtPanId));
+    saltLength += sizeof(kExtPanId);
+    memcpy(prfInput + saltLength, kNetworkName, strlen(kNetworkName));
+    saltLength += strlen(kNetworkName);
+    memcpy(prfInput + saltLength, "\x00\x00\x00\x01", 4);
+
+    mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(kPassphrase), strlen(kPassphrase), prfInput,
+                             saltLength + 4, prfOutput);
+    memcpy(aPskc, prfOutput, OT_PSKC_LENGTH);
+
+    for (int i = 1; i < OT_ITERATION_COUNTS; i++)
+    {
+        memcpy(prfInput, prfOutput, sizeof(prfOutput));
+        mbedtls_aes_cmac_prf_128(reinterpret_cast<const uint8_t *>(kPassphrase), strlen(kPassphrase), prfInput,
+                                 sizeof(prfOutput), prfOutput);
+
+        for (int j = 0; j < OT_PSKC_LENGTH; j++)
+        {
+            aPskc[j] ^= prfOutput[j];
+        }
+    }
+}
+
+static unsigned long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<unsigned long>(now.tv_sec * 1000000 + now.tv_usec);
+}
+
+static void Report(const char *aMethod, unsigned long aElapsed, unsigned aIterations, const uint8_t *aPskc,
+                   const uint8_t *aExpected)
+{
+    printf("%-9s iterations=%u time=%.3fms/pskc %s\n", aMethod, aIterations, aElapsed / 1000.0 / aIterations,
+           memcmp(aPskc, aExpected, OT_PSKC_LENGTH) == 0 ? "ok" : "MISMATCH");
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned      iterations = kDefaultIterations;
+    uint8_t       expected[OT_PSKC_LENGTH];
+    unsigned long elapsed;
+    Pskc          pskc;
+
+    if (argc > 1)
+    {
+        iterations = static_cast<unsigned>(strtoul(argv[1], NULL, 0));
+    }
+
+    if (argc > 2 || iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        ComputeReference(expected);
+        sSink += expected[0];
+    }
+
+    Report("mbedtls", GetMicroseconds() - elapsed, iterations, expected, expected);
+
+    for (int backend = CmacPrf::kBackendSoftware; backend <= CmacPrf::kBackendArmCe; backend++)
+    {
+        const uint8_t *result = NULL;
+
+        if (!pskc.GetPrf().SetBackend(static_cast<CmacPrf::Backend>(backend)))
+        {
+            printf("%-9s unsupported\n", CmacPrf::BackendToString(static_cast<CmacPrf::Backend>(backend)));
+            continue;
+        }
+
+        elapsed = GetMicroseconds();
+
+        for (unsigned i = 0; i < iterations; ++i)
+        {
+            result = pskc.ComputePskc(kExtPanId, kNetworkName, kPassphrase);
+            sSink += result[0];
+        }
+
+        Report(CmacPrf::BackendToString(pskc.GetPrf().GetBackend()), GetMicroseconds() - elapsed, iterations, result,
+               expected);
+    }
+
+    // Interleaved chains of a batch, on the fastest backend.
+    {
+        Pskc           batch[Pskc::kMaxBatchSize];
+        const uint8_t *extPanIds[Pskc::kMaxBatchSize];
+        const char    *networkNames[Pskc::kMaxBatchSize];
+        const char    *passphrases[Pskc::kMaxBatchSize];
+
+        for (int i = 0; i < Pskc::kMaxBatchSize; i++)
+        {
+            extPanIds[i] = kExtPanId;
+            networkNames[i] = kNetworkName;
+            passphrases[i] = kPassphrase;
+        }
+
+        elapsed = GetMicroseconds();
+
+        for (unsigned i = 0; i < iterations; i += Pskc::kMaxBatchSize)
+        {
+            Pskc::ComputePskcs(batch, extPanIds, networkNames, passphrases, Pskc::kMaxBatchSize);
+            sSink += batch[0].GetPskc()[0];
+        }
+
+        Report("batch", GetMicroseconds() - elapsed,
+               (iterations + Pskc::kMaxBatchSize - 1) / Pskc::kMaxBatchSize * Pskc::kMaxBatchSize,
+               batch[Pskc::kMaxBatchSize - 1].GetPskc(), expected);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a microbenchmark comparing TLV lookups by walking a buffer and by the TLV view.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <sys/time.h>
+
+#include <vector>
+
+#include "common/tlv_view.hpp"
+
+using namespace ot;
+
+enum
+{
+    kDefaultIterations = 1000000,
+    kSizeOfRecord      = 200, ///< Size of the DTLS record encapsulated in the relayed message.
+};
+
+// The types looked up when relaying a message, the last one is absent.
+static const uint8_t kRelayTypes[] = {
+    Meshcop::kJoinerRouterLocator,
+    Meshcop::kJoinerUdpPort,
+    Meshcop::kJoinerIid,
+    Meshcop::kJoinerDtlsEncapsulation,
+    Meshcop::kJoinerRouterKek,
+};
+
+// The types of an Active Operational Dataset, all looked up.
+static const uint8_t kDatasetTypes[] = {
+    14, 0, 53, 7, 2, 5, 3, 1, 4, 12, 8, 15,
+};
+
+static volatile unsigned sSink;
+
+/**
+ * This function finds a TLV the way the border agent did before the TLV view.
+ *
+ */
+static const Tlv *FindTlv(const uint8_t *aBuffer, uint16_t aLength, uint8_t aType)
+{
+    const Tlv *end = reinterpret_cast<const Tlv *>(aBuffer + aLength);
+
+    for (const Tlv *tlv = reinterpret_cast<const Tlv *>(aBuffer); tlv < end; tlv = tlv->GetNext())
+    {
+        if (tlv->GetType() == aType)
+        {
+            return tlv;
+        }
+    }
+
+    return NULL;
+}
+
+static unsigned long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<unsigned long>(now.tv_sec * 1000000 + now.tv_usec);
+}
+
+static void Report(const char *aName, const char *aMethod, size_t aLookups, unsigned long aElapsed,
+                   unsigned aIterations)
+{
+    printf("%-7s %-4s iterations=%u lookups=%u time=%.1fns/message\n", aName, aMethod, aIterations,
+           static_cast<unsigned>(aLookups), aElapsed * 1000.0 / aIterations);
+}
+
+/**
+ * This function measures looking up TLVs of a message, with a new view per message like the border agent.
+ *
+ */
+static void Run(const char *aName, const uint8_t *aMessage, uint16_t aLength, const uint8_t *aTypes,
+                size_t aNumTypes, unsigned aIterations)
+{
+    unsigned long elapsed = GetMicroseconds();
+    uint16_t      length;
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        for (size_t j = 0; j < aNumTypes; ++j)
+        {
+            sSink += (FindTlv(aMessage, aLength, aTypes[j]) != NULL);
+        }
+    }
+
+    Report(aName, "walk", aNumTypes, GetMicroseconds() - elapsed, aIterations);
+    elapsed = GetMicroseconds();
+
+    for (unsigned i = 0; i < aIterations; ++i)
+    {
+        TlvView view;
+
+        view.Init(aMessage, aLength);
+
+        for (size_t j = 0; j < aNumTypes; ++j)
+        {
+            sSink += (view.GetValue(aTypes[j], length) != NULL);
+        }
+    }
+
+    Report(aName, "view", aNumTypes, GetMicroseconds() - elapsed, aIterations);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned             iterations = kDefaultIterations;
+    std::vector<uint8_t> relay;
+    std::vector<uint8_t> dataset;
+
+    if (argc > 1)
+    {
+        iterations = static_cast<unsigned>(strtoul(argv[1], NULL, 0));
+    }
+
+    if (argc > 2 || iterations == 0)
+    {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // A Relay Transmit message as sent by a commissioner.
+    relay.push_back(Meshcop::kJoinerUdpPort);
+    relay.push_back(2);
+    relay.push_back(0x03);
+    relay.push_back(0xe8);
+    relay.push_back(Meshcop::kJoinerIid);
+    relay.push_back(8);
+    relay.insert(relay.end(), 8, 0x11);
+    relay.push_back(Meshcop::kJoinerRouterLocator);
+    relay.push_back(2);
+    relay.push_back(0x04);
+    relay.push_back(0x00);
+    relay.push_back(Meshcop::kJoinerDtlsEncapsulation);
+    relay.push_back(kSizeOfRecord);
+    relay.insert(relay.end(), kSizeOfRecord, 0x16);
+
+    // An Active Operational Dataset of 8 bytes values.
+    for (size_t i = 0; i < sizeof(kDatasetTypes); ++i)
+    {
+        dataset.push_back(kDatasetTypes[i]);
+        dataset.push_back(8);
+        dataset.insert(dataset.end(), 8, static_cast<uint8_t>(i));
+    }
+
+    Run("relay", &relay[0], static_cast<uint16_t>(relay.size()), kRelayTypes, sizeof(kRelayTypes), iterations);
+    Run("dataset", &dataset[0], static_cast<uint16_t>(dataset.size()), kDatasetTypes, sizeof(kDatasetTypes),
+        iterations);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,171 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a fuzz target of the TLV view.
+ *
+ *   Built with a fuzzing engine, e.g. -fsanitize=fuzzer, it is a libFuzzer target. Otherwise it replays a
+ *   corpus together with truncated and mutated copies of each input, for `make check`.
+ */
+
+#include <assert.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "common/tlv_view.hpp"
+
+using namespace ot;
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *aData, size_t aSize)
+{
+    TlvView        view;
+    uint16_t       length;
+    const uint8_t *value;
+    uint16_t       number;
+    int8_t         state;
+
+    if (aSize <= TlvView::kMaxLength && view.Init(aData, static_cast<uint16_t>(aSize)) == OTBR_ERROR_NONE)
+    {
+        // Every value must lie within the input.
+        for (unsigned type = 0; type <= 0xff; ++type)
+        {
+            value = view.GetValue(static_cast<uint8_t>(type), length);
+            assert(value == NULL || (value >= aData && value + length <= aData + aSize));
+            assert((value != NULL) == view.Contains(static_cast<uint8_t>(type)));
+        }
+
+        view.GetState(state);
+        view.GetCommissionerSessionId(number);
+        view.GetJoinerUdpPort(number);
+        view.GetJoinerRouterLocator(number);
+        view.GetJoinerIid();
+        view.GetJoinerRouterKek();
+        view.GetSteeringData(length);
+    }
+
+    return 0;
+}
+
+#if !defined(FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION)
+
+enum
+{
+    kNumMutations = 256,
+};
+
+/**
+ * This function runs the target on an exactly sized copy, so that memory checkers catch overreads.
+ *
+ */
+static void RunOne(const std::vector<uint8_t> &aInput, size_t aSize)
+{
+    uint8_t *copy = static_cast<uint8_t *>(malloc(aSize == 0 ? 1 : aSize));
+
+    assert(copy != NULL);
+
+    if (aSize > 0)
+    {
+        memcpy(copy, &aInput[0], aSize);
+    }
+
+    LLVMFuzzerTestOneInput(copy, aSize);
+    free(copy);
+}
+
+static bool ReadFile(const char *aPath, std::vector<uint8_t> &aInput)
+{
+    FILE *file = fopen(aPath, "rb");
+    int   byte;
+
+    if (file != NULL)
+    {
+        aInput.clear();
+
+        while ((byte = fgetc(file)) != EOF)
+        {
+            aInput.push_back(static_cast<uint8_t>(byte));
+        }
+
+        fclose(file);
+    }
+
+    return file != NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    const char          *srcdir = getenv("srcdir");
+    std::string          corpus = (argc > 1) ? argv[1] : std::string(srcdir ? srcdir : ".") + "/corpus/tlv_view";
+    DIR                 *dir = opendir(corpus.c_str());
+    struct dirent       *entry;
+    std::vector<uint8_t> input;
+    unsigned             seed = 1;
+    unsigned             count = 0;
+
+    if (dir == NULL)
+    {
+        fprintf(stderr, "Failed to open corpus %s!\n", corpus.c_str());
+        return EXIT_FAILURE;
+    }
+
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (entry->d_name[0] == '.' || !ReadFile((corpus + "/" + entry->d_name).c_str(), input))
+        {
+            continue;
+        }
+
+        for (size_t size = 0; size <= input.size(); ++size)
+        {
+            RunOne(input, size);
+        }
+
+        for (int i = 0; i < kNumMutations && !input.empty(); ++i)
+        {
+            std::vector<uint8_t> mutation(input);
+
+            mutation[rand_r(&seed) % mutation.size()] = static_cast<uint8_t>(rand_r(&seed));
+            RunOne(mutation, mutation.size());
+        }
+
+        ++count;
+    }
+
+    closedir(dir);
+    printf("Replayed %u inputs.\n", count);
+
+    return count > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // FUZZING_BUILD_MODE_UNSAFE_FOR_PRODUCTION
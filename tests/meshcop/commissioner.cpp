@@ -86,29 +86,118 @@ inline uint16_t LengthOf(const void *aStart, const void *aEnd)
     return static_cast<const uint8_t *>(aEnd) - static_cast<const uint8_t *>(aStart);
 }
 
+/** Find the joiner whose relay socket has this port */
+static JoinerSession *FindJoinerSession(Context &aContext, uint16_t aPort)
+{
+    JoinerSessionsByPort::iterator it = aContext.mJoinerSessionsByPort.find(aPort);
+
+    return it == aContext.mJoinerSessionsByPort.end() ? NULL : it->second;
+}
+
+/** Find the joiner of a dtls session, the peer of the session is the relay socket of the joiner */
+static JoinerSession *FindJoinerSession(Context &aContext, Dtls::Session &aSession)
+{
+    return FindJoinerSession(aContext, ntohs(aSession.GetPeerAddress().sin6_port));
+}
+
+/** Create the session of a joiner seen in relay-rx for the first time */
+static JoinerSession *CreateJoinerSession(Context &aContext, uint64_t aIid)
+{
+    JoinerSession     *joiner = NULL;
+    const char        *pskd;
+    size_t             pskdLength;
+    struct sockaddr_in addr;
+    socklen_t          addrlen = sizeof(addr);
+    uint8_t            joinerId[JoinerRegistry::kSizeOfJoinerId];
+    int                fd = -1;
+
+    /* The joiner id is the IID with the universal/local bit toggled */
+    for (size_t i = 0; i < sizeof(joinerId); i++)
+    {
+        joinerId[i] = static_cast<uint8_t>(aIid >> (8 * (sizeof(joinerId) - 1 - i)));
+    }
+    joinerId[0] ^= 0x02;
+
+    pskd = aContext.mJoiners.FindPskd(joinerId);
+    if (pskd == NULL && aContext.mJoiner.mAllowAny && aContext.mJoiner.mPSKd_ascii[0])
+    {
+        pskd = aContext.mJoiner.mPSKd_ascii;
+    }
+    VerifyOrExit(pskd != NULL, otbrLog(OTBR_LOG_INFO, "relay: ignore unknown joiner %s",
+                                       CommissionerUtilsHexString(joinerId, sizeof(joinerId))));
+    pskdLength = strlen(pskd);
+    VerifyOrExit(pskdLength <= kPSKdLength, otbrLog(OTBR_LOG_ERR, "relay: pskd too long for joiner %s",
+                                                    CommissionerUtilsHexString(joinerId, sizeof(joinerId))));
+
+    /* Bind now, the port must be known before the first record reaches the DTLS server */
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    VerifyOrExit((fd = socket(AF_INET, SOCK_DGRAM, 0)) != -1);
+    VerifyOrExit(bind(fd, reinterpret_cast<const struct sockaddr *>(&addr), sizeof(addr)) == 0);
+    VerifyOrExit(getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen) == 0);
+
+    joiner = new JoinerSession();
+    for (size_t i = 0; i < sizeof(joiner->mIid); i++)
+    {
+        joiner->mIid[i] = static_cast<uint8_t>(aIid >> (8 * (sizeof(joiner->mIid) - 1 - i)));
+    }
+    joiner->mSocket = fd;
+    joiner->mPort = ntohs(addr.sin_port);
+    memcpy(joiner->mPSKd_ascii, pskd, pskdLength);
+    joiner->mPSKd_ascii[pskdLength] = '\0';
+    joiner->mState = kStateConnected;
+    gettimeofday(&joiner->mStartTv, NULL);
+    fd = -1;
+
+    aContext.mJoinerSessionsByIid[aIid] = joiner;
+    aContext.mJoinerSessionsByPort[joiner->mPort] = joiner;
+    otbrLog(OTBR_LOG_INFO, "relay: new joiner %s on port %d, %u joiners",
+            CommissionerUtilsHexString(joinerId, sizeof(joinerId)), joiner->mPort,
+            static_cast<unsigned>(aContext.mJoinerSessionsByIid.size()));
+
+exit:
+    if (fd != -1)
+    {
+        otbrLog(OTBR_LOG_ERR, "relay: cannot create joiner socket, errno=%d", errno);
+        close(fd);
+    }
+
+    return joiner;
+}
+
 void HandleJoinerFinalize(const Coap::Resource &aResource, const Coap::Message &aRequest,
                           Coap::Message &aResponse,
                           const uint8_t *aIp6, uint16_t aPort, void *aContext)
 {
-    Context &context = *static_cast<Context *>(aContext);
-    uint8_t  payload[10];
-    Tlv     *responseTlv = reinterpret_cast<Tlv *>(payload);
+    Context       &context = *static_cast<Context *>(aContext);
+    JoinerSession *joiner = FindJoinerSession(context, aPort);
+    uint16_t       size = 0;
+    uint8_t       *payload = aResponse.GetPayloadBuffer(size);
+    TlvWriter      writer(payload, size);
 
-    otbrLog(OTBR_LOG_INFO, "HandleJoinerFinalize, STATE = 1\n");
+    otbrLog(OTBR_LOG_INFO, "HandleJoinerFinalize, port=%d, STATE = 1\n", aPort);
 
-    context.mState = kStateFinalized;
-    responseTlv->SetType(Meshcop::kState);
-    responseTlv->SetValue(static_cast<uint8_t>(1));
-    responseTlv = responseTlv->GetNext();
+    if (joiner != NULL && joiner->mState == kStateAuthenticated)
+    {
+        joiner->mState = kStateFinalized;
+        gettimeofday(&joiner->mFinalizedTv, NULL);
+    }
+    writer.AppendState(static_cast<int8_t>(1));
 
     // Piggyback response
-    aResponse.SetCode(Coap::kCodeChanged);
-    aResponse.SetPayload(payload, LengthOf(payload, responseTlv));
+    if (writer.GetError() == OTBR_ERROR_NONE && aResponse.SetPayloadLength(writer.GetLength()) == OTBR_ERROR_NONE)
+    {
+        aResponse.SetCode(Coap::kCodeChanged);
+    }
+    else
+    {
+        otbrLog(OTBR_LOG_ERR, "JOIN_FIN.rsp: payload does not fit");
+        aResponse.SetCode(Coap::kCodeServiceUnavailable);
+    }
 
     (void)aResource;
     (void)aRequest;
     (void)aIp6;
-    (void)aPort;
 }
 
 void HandleRelayReceive(const Coap::Resource &aResource,
@@ -118,12 +207,19 @@ void HandleRelayReceive(const Coap::Resource &aResource,
                         uint16_t aPort,
                         void *aContext)
 {
-    int            ret = 0;
-    int            tlvType;
-    uint16_t       length;
-    Context       &context = *static_cast<Context *>(aContext);
-    const uint8_t *payload = aMessage.GetPayload(length);
-
+    int                           ret = 0;
+    int                           tlvType;
+    uint16_t                      length;
+    Context                      &context = *static_cast<Context *>(aContext);
+    const uint8_t                *payload = aMessage.GetPayload(length);
+    const Tlv                    *encapsulation = NULL;
+    const Tlv                    *iid = NULL;
+    JoinerSession                *joiner;
+    JoinerSessionsByIid::iterator it;
+    uint64_t                      key = 0;
+    struct sockaddr_in            addr;
+
+    /* The IID may follow the encapsulation, so gather the TLVs first */
     for (const Tlv *requestTlv = reinterpret_cast<const Tlv *>(payload);
          LengthOf(payload, requestTlv) < length;
          requestTlv = requestTlv->GetNext())
@@ -133,53 +229,87 @@ void HandleRelayReceive(const Coap::Resource &aResource,
         switch (tlvType)
         {
         case Meshcop::kJoinerDtlsEncapsulation:
-            struct sockaddr_in addr;
-            memset(&addr, 0, sizeof(addr));
-            addr.sin_family = AF_INET;
-            addr.sin_port = htons(kPortJoinerSession);
+            encapsulation = requestTlv;
+            break;
 
-            otbrLog(OTBR_LOG_INFO, "Encapsulation: %d bytes for port: %d",
-                    requestTlv->GetLength(), kPortJoinerSession);
-            {
-                char buf[IPSTR_BUFSIZE];
-                get_ip_str((struct sockaddr *)&addr, buf, sizeof(buf));
-                otbrLog(OTBR_LOG_INFO, "DEST: %s", buf);
-            }
-            ret = sendto(context.mSocket,
-                         requestTlv->GetValue(),
-                         requestTlv->GetLength(),
-                         0,
-                         reinterpret_cast<const struct sockaddr *>(&addr),
-                         sizeof(addr));
-            if (ret < 0)
-            {
-                otbrLog(OTBR_LOG_ERR, "relay receive, sendto() fails with %d", errno);
-            }
-            VerifyOrExit(ret != -1, ret = errno);
+        case Meshcop::kJoinerIid:
+            VerifyOrExit(requestTlv->GetLength() == sizeof(joiner->mIid),
+                         otbrLog(OTBR_LOG_ERR, "relay receive, bad IID length %d", requestTlv->GetLength()));
+            iid = requestTlv;
             break;
 
         case Meshcop::kJoinerUdpPort:
-            context.mJoiner.mUdpPort = requestTlv->GetValueUInt16();
-            otbrLog(OTBR_LOG_INFO, "JoinerPort: %d", context.mJoiner.mUdpPort);
+        case Meshcop::kJoinerRouterLocator:
             break;
 
-        case Meshcop::kJoinerIid:
-            memcpy(context.mJoiner.mIid,
-                   requestTlv->GetValue(),
-                   sizeof(context.mJoiner.mIid));
+        default:
+            otbrLog(OTBR_LOG_INFO, "skip tlv type: %d", tlvType);
+            break;
+        }
+    }
+
+    VerifyOrExit(encapsulation != NULL && iid != NULL, otbrLog(OTBR_LOG_ERR, "relay receive, missing tlv"));
+
+    /* Demultiplex by the IID of the joiner */
+    for (size_t i = 0; i < sizeof(joiner->mIid); i++)
+    {
+        key = (key << 8) | static_cast<const uint8_t *>(iid->GetValue())[i];
+    }
+
+    it = context.mJoinerSessionsByIid.find(key);
+    if (it != context.mJoinerSessionsByIid.end())
+    {
+        joiner = it->second;
+    }
+    else
+    {
+        VerifyOrExit((joiner = CreateJoinerSession(context, key)) != NULL);
+    }
+
+    for (const Tlv *requestTlv = reinterpret_cast<const Tlv *>(payload);
+         LengthOf(payload, requestTlv) < length;
+         requestTlv = requestTlv->GetNext())
+    {
+        switch (requestTlv->GetType())
+        {
+        case Meshcop::kJoinerUdpPort:
+            joiner->mUdpPort = requestTlv->GetValueUInt16();
+            otbrLog(OTBR_LOG_INFO, "JoinerPort: %d", joiner->mUdpPort);
             break;
 
         case Meshcop::kJoinerRouterLocator:
-            context.mJoiner.mRouterLocator = requestTlv->GetValueUInt16();
-            otbrLog(OTBR_LOG_INFO, "Router locator: %d", context.mJoiner.mRouterLocator);
+            joiner->mRouterLocator = requestTlv->GetValueUInt16();
+            otbrLog(OTBR_LOG_INFO, "Router locator: %d", joiner->mRouterLocator);
             break;
 
         default:
-            otbrLog(OTBR_LOG_INFO, "skip tlv type: %d", tlvType);
             break;
         }
     }
 
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(kPortJoinerSession);
+
+    otbrLog(OTBR_LOG_INFO, "Encapsulation: %d bytes for port: %d from joiner port: %d",
+            encapsulation->GetLength(), kPortJoinerSession, joiner->mPort);
+    {
+        char buf[IPSTR_BUFSIZE];
+        get_ip_str((struct sockaddr *)&addr, buf, sizeof(buf));
+        otbrLog(OTBR_LOG_INFO, "DEST: %s", buf);
+    }
+    ret = sendto(joiner->mSocket,
+                 encapsulation->GetValue(),
+                 encapsulation->GetLength(),
+                 0,
+                 reinterpret_cast<const struct sockaddr *>(&addr),
+                 sizeof(addr));
+    if (ret < 0)
+    {
+        otbrLog(OTBR_LOG_ERR, "relay receive, sendto() fails with %d", errno);
+    }
+    VerifyOrExit(ret != -1, ret = errno);
+
 exit:
 
     (void)aResource;
@@ -191,69 +321,63 @@ exit:
 }
 
 
-int SendRelayTransmit(Context &aContext)
+int SendRelayTransmit(Context &aContext, JoinerSession &aJoiner)
 {
-    uint8_t            payload[kSizeMaxPacket];
-    uint8_t            dtlsEncapsulation[kSizeMaxPacket];
-    Tlv               *responseTlv = reinterpret_cast<Tlv *>(payload);
     struct sockaddr_in from_addr;
     socklen_t          addrlen;
+    Coap::Message     *message;
+    uint16_t           token = ++aContext.mCoapToken;
+    uint16_t           size = 0;
+    uint8_t           *dtlsEncapsulation;
+    int                available = 0;
+    ssize_t            ret = -1;
 
     addrlen = sizeof(from_addr);
 
+    message = aContext.mCoap->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost,
+                                         reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+    message->SetPath("c/tx");
 
-    ssize_t ret =
-        recvfrom(aContext.mSocket, dtlsEncapsulation, sizeof(dtlsEncapsulation), 0, (struct sockaddr *)(&from_addr),
-                 &addrlen);
-
-    VerifyOrExit(ret > 0);
     {
-        // Print this, because in some environments...
-        // other things on the network use the same port
-        // as open thread is using here :-(
-        char buf[IPSTR_BUFSIZE];
-        get_ip_str((struct sockaddr *)(&from_addr), buf, sizeof(buf));
-        otbrLog(OTBR_LOG_INFO, "relay from: %s\n", buf);
-    }
+        // The DTLS record is received straight into the value of its TLV in the message payload.
+        TlvWriter writer(message->GetPayloadBuffer(size), size);
 
-    responseTlv->SetType(Meshcop::kJoinerDtlsEncapsulation);
-    responseTlv->SetValue(dtlsEncapsulation, static_cast<uint16_t>(ret));
-    responseTlv = responseTlv->GetNext();
+        VerifyOrExit(ioctl(aJoiner.mSocket, FIONREAD, &available) == 0 && available > 0);
+        dtlsEncapsulation = writer.ReserveJoinerDtlsEncapsulation(static_cast<uint16_t>(available));
+        VerifyOrExit(dtlsEncapsulation != NULL, otbrLog(OTBR_LOG_ERR, "relay: record too large %d", available));
 
-    responseTlv->SetType(Meshcop::kJoinerUdpPort);
-    responseTlv->SetValue(aContext.mJoiner.mUdpPort);
-    responseTlv = responseTlv->GetNext();
+        ret = recvfrom(aJoiner.mSocket, dtlsEncapsulation, static_cast<size_t>(available), 0,
+                       (struct sockaddr *)(&from_addr), &addrlen);
+        VerifyOrExit(ret == available);
+        {
+            // Print this, because in some environments...
+            // other things on the network use the same port
+            // as open thread is using here :-(
+            char buf[IPSTR_BUFSIZE];
+            get_ip_str((struct sockaddr *)(&from_addr), buf, sizeof(buf));
+            otbrLog(OTBR_LOG_INFO, "relay from: %s to joiner port: %d\n", buf, aJoiner.mPort);
+        }
 
-    responseTlv->SetType(Meshcop::kJoinerIid);
-    responseTlv->SetValue(aContext.mJoiner.mIid, sizeof(aContext.mJoiner.mIid));
-    responseTlv = responseTlv->GetNext();
+        writer.AppendJoinerUdpPort(aJoiner.mUdpPort);
+        writer.AppendJoinerIid(aJoiner.mIid);
+        writer.AppendJoinerRouterLocator(aJoiner.mRouterLocator);
 
-    responseTlv->SetType(Meshcop::kJoinerRouterLocator);
-    responseTlv->SetValue(aContext.mJoiner.mRouterLocator);
-    responseTlv = responseTlv->GetNext();
+        if (aJoiner.mState == kStateFinalized)
+        {
+            otbrLog(OTBR_LOG_INFO, "realy: KEK state");
+            writer.AppendJoinerRouterKek(aJoiner.mKek);
+        }
 
-    if (aContext.mState == kStateFinalized)
-    {
-        otbrLog(OTBR_LOG_INFO, "realy: KEK state");
-        responseTlv->SetType(Meshcop::kJoinerRouterKek);
-        responseTlv->SetValue(aContext.mKek, sizeof(aContext.mKek));
-        responseTlv = responseTlv->GetNext();
+        VerifyOrExit(writer.GetError() == OTBR_ERROR_NONE &&
+                         message->SetPayloadLength(writer.GetLength()) == OTBR_ERROR_NONE,
+                     ret = -1);
     }
 
-    {
-        Coap::Message *message;
-        uint16_t       token = ++aContext.mCoapToken;
-
-        message = aContext.mCoap->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodePost,
-                                             reinterpret_cast<const uint8_t *>(&token), sizeof(token));
-        message->SetPath("c/tx");
-        message->SetPayload(payload, LengthOf(payload, responseTlv));
-        otbrLog(OTBR_LOG_INFO, "RELAY_tx.req: send");
-        aContext.mCoap->Send(*message, NULL, 0, NULL, &aContext);
-        aContext.mCoap->FreeMessage(message);
-    }
+    otbrLog(OTBR_LOG_INFO, "RELAY_tx.req: send");
+    aContext.mCoap->Send(*message, NULL, 0, NULL, &aContext);
 
 exit:
+    aContext.mCoap->FreeMessage(message);
     return ret;
 }
 
@@ -271,10 +395,12 @@ static ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t
     }
     else
     {
-        otbrLog(OTBR_LOG_INFO, "SendCoap: session-write-len: %d", aLength);
-        if (context.mSession)
+        JoinerSession *joiner = FindJoinerSession(context, aPort);
+
+        otbrLog(OTBR_LOG_INFO, "SendCoap: session-write-len: %d port: %d", aLength, aPort);
+        if (joiner != NULL && joiner->mSession)
         {
-            ret = context.mSession->Write(aBuffer, aLength);
+            ret = joiner->mSession->Write(aBuffer, aLength);
         }
         else
         {
@@ -284,7 +410,6 @@ static ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t
     }
 
     (void)aIp6;
-    (void)aPort;
 
     return ret;
 }
@@ -382,21 +507,28 @@ static int CommissionerPetition(Context &aContext)
 {
     int     ret;
     uint8_t buffer[kSizeMaxPacket];
-    Tlv    *tlv = reinterpret_cast<Tlv *>(buffer);
 
     Coap::Message *message;
     uint16_t       token = ++aContext.mCoapToken;
+    uint16_t       size = 0;
 
     otbrLog(OTBR_LOG_INFO, "COMM_PET.req: start");
     token = htons(token);
     message = aContext.mCoap->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
                                          reinterpret_cast<const uint8_t *>(&token), sizeof(token));
-    tlv->SetType(Meshcop::kCommissionerId);
-    tlv->SetValue(kCommissionerId, sizeof(kCommissionerId) - 1);
-    tlv = tlv->GetNext();
-
     message->SetPath("c/cp");
-    message->SetPayload(buffer, LengthOf(buffer, tlv));
+    {
+        TlvWriter writer(message->GetPayloadBuffer(size), size);
+
+        writer.AppendCommissionerId(kCommissionerId);
+
+        if (writer.GetError() != OTBR_ERROR_NONE || message->SetPayloadLength(writer.GetLength()) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_ERR, "COMM_PET.req: payload does not fit");
+            aContext.mCoap->FreeMessage(message);
+            return -1;
+        }
+    }
     otbrLog(OTBR_LOG_INFO, "COMM_PET.req: send");
     aContext.mCoap->Send(*message, NULL, 0, HandleCommissionerPetition, &aContext);
     aContext.mCoap->FreeMessage(message);
@@ -478,8 +610,8 @@ static int CommissionerSet(Context &aContext)
     bool     ok;
     int      ret = 0;
     uint16_t token = ++aContext.mCoapToken;
+    uint16_t size = 0;
     uint8_t  buffer[kSizeMaxPacket];
-    Tlv     *tlv = reinterpret_cast<Tlv *>(buffer);
 
     Coap::Message *message;
 
@@ -490,27 +622,33 @@ static int CommissionerSet(Context &aContext)
                                          reinterpret_cast<const uint8_t *>(&token),
                                          sizeof(token));
 
-    tlv->SetType(Meshcop::kCommissionerSessionId);
-    tlv->SetValue(aContext.mCommissionerSessionId);
-    otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.req: session-id=%d", aContext.mCommissionerSessionId);
-    tlv = tlv->GetNext();
-
+    message->SetPath("c/cs");
+    otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.req: coap-uri: %s", "c/cs");
 
-    ok = CommissionerComputeSteering();
-    /* Note: Steering computation will have logged the steering data */
-    if (!ok)
     {
-        CommissionerUtilsFail("Cannot compute steering data\n");
-    }
+        TlvWriter writer(message->GetPayloadBuffer(size), size);
 
-    tlv->SetType(Meshcop::kSteeringData);
-    tlv->SetValue(aContext.mJoiner.mSteeringData.GetDataPointer(),
-                  aContext.mJoiner.mSteeringData.GetLength());
-    tlv = tlv->GetNext();
+        writer.AppendCommissionerSessionId(aContext.mCommissionerSessionId);
+        otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.req: session-id=%d", aContext.mCommissionerSessionId);
+
+        ok = CommissionerComputeSteering();
+        /* Note: Steering computation will have logged the steering data */
+        if (!ok)
+        {
+            CommissionerUtilsFail("Cannot compute steering data\n");
+        }
+
+        writer.AppendSteeringData(aContext.mJoiner.mSteeringData.GetDataPointer(),
+                                  static_cast<uint8_t>(aContext.mJoiner.mSteeringData.GetLength()));
+
+        if (writer.GetError() != OTBR_ERROR_NONE || message->SetPayloadLength(writer.GetLength()) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_ERR, "COMMISSIONER_SET.req: payload does not fit");
+            aContext.mCoap->FreeMessage(message);
+            return -1;
+        }
+    }
 
-    message->SetPath("c/cs");
-    otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.req: coap-uri: %s", "c/cs");
-    message->SetPayload(buffer, LengthOf(buffer, tlv));
     otbrLog(OTBR_LOG_INFO, "COMMISSIONER_SET.req: sent");
     aContext.mCoap->Send(*message, NULL, 0, HandleCommissionerSetResponse, &aContext);
     aContext.mCoap->FreeMessage(message);
@@ -590,9 +728,9 @@ static void HandleCommissionerKeepAlive(const Coap::Message &aMessage, void *aCo
 /** Send a COMM_KA to keep the session alive */
 static int CommissionerKeepAlive(Context &aContext)
 {
-    int     ret = 0;
-    uint8_t buffer[kSizeMaxPacket];
-    Tlv    *tlv = reinterpret_cast<Tlv *>(buffer);
+    int      ret = 0;
+    uint16_t size = 0;
+    uint8_t  buffer[kSizeMaxPacket];
 
     Coap::Message *message;
 
@@ -601,16 +739,20 @@ static int CommissionerKeepAlive(Context &aContext)
                                          reinterpret_cast<const uint8_t *>(&aContext.mCoapToken),
                                          sizeof(aContext.mCoapToken));
 
-    tlv->SetType(Meshcop::kState);
-    tlv->SetValue(static_cast<uint8_t>(1));
-    tlv = tlv->GetNext();
+    message->SetPath("c/ca");
+    {
+        TlvWriter writer(message->GetPayloadBuffer(size), size);
 
-    tlv->SetType(Meshcop::kCommissionerSessionId);
-    tlv->SetValue(aContext.mCommissionerSessionId);
-    tlv = tlv->GetNext();
+        writer.AppendState(static_cast<int8_t>(1));
+        writer.AppendCommissionerSessionId(aContext.mCommissionerSessionId);
 
-    message->SetPath("c/ca");
-    message->SetPayload(buffer, LengthOf(buffer, tlv));
+        if (writer.GetError() != OTBR_ERROR_NONE || message->SetPayloadLength(writer.GetLength()) != OTBR_ERROR_NONE)
+        {
+            otbrLog(OTBR_LOG_ERR, "COMM_KA.req: payload does not fit");
+            aContext.mCoap->FreeMessage(message);
+            return -1;
+        }
+    }
 
     otbrLog(OTBR_LOG_INFO, "COMM_KA.req: send");
     gettimeofday(&(aContext.mCOMM_KA.mLastTxTv), NULL);
@@ -661,39 +803,73 @@ static int CommissionerSessionProcess(Context &context)
     return ret;
 }
 
-/** send data into the coap session */
-static void FeedCoaps(const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+/** send data into the coap session, the port of the joiner tells the joiners apart */
+static void FeedCoaps(Dtls::Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext)
 {
-    Context &context = *static_cast<Context *>(aContext);
+    Context       &context = *static_cast<Context *>(aContext);
+    JoinerSession *joiner = FindJoinerSession(context, aSession);
+
+    if (joiner != NULL)
+    {
+        context.mCoap->Input(aBuffer, aLength, NULL, joiner->mPort);
+    }
+}
+
+/** look up the PSKd of a new dtls session, by the joiner relaying it */
+static const uint8_t *HandleJoinerPSK(const sockaddr_in6 &aPeerAddress, uint8_t &aLength, void *aContext)
+{
+    Context       &context = *static_cast<Context *>(aContext);
+    JoinerSession *joiner = FindJoinerSession(context, ntohs(aPeerAddress.sin6_port));
+    const uint8_t *psk = NULL;
+
+    VerifyOrExit(joiner != NULL);
 
-    context.mCoap->Input(aBuffer, aLength, NULL, 1);
+    otbrLog(OTBR_LOG_INFO, "commissioner-serve: port=%d device-pskd=%s", joiner->mPort, joiner->mPSKd_ascii);
+    psk = reinterpret_cast<const uint8_t *>(joiner->mPSKd_ascii);
+    aLength = static_cast<uint8_t>(strlen(joiner->mPSKd_ascii));
+
+exit:
+    return psk;
 }
 
 /** DTLS session has changed */
 static void HandleSessionChange(Dtls::Session &aSession, Dtls::Session::State aState, void *aContext)
 {
-    Context &context = *static_cast<Context *>(aContext);
+    Context       &context = *static_cast<Context *>(aContext);
+    JoinerSession *joiner = FindJoinerSession(context, aSession);
+
+    VerifyOrExit(joiner != NULL, otbrLog(OTBR_LOG_ERR, "DTLS session of unknown joiner"));
 
     switch (aState)
     {
     case Dtls::Session::kStateReady:
-        context.mState = kStateAuthenticated;
-        memcpy(context.mKek, aSession.GetKek(), sizeof(context.mKek));
+        joiner->mState = kStateAuthenticated;
+        gettimeofday(&joiner->mAuthenticatedTv, NULL);
+        memcpy(joiner->mKek, aSession.GetKek(), sizeof(joiner->mKek));
         aSession.SetDataHandler(FeedCoaps, aContext);
-        context.mSession = &aSession;
+        joiner->mSession = &aSession;
         break;
 
     case Dtls::Session::kStateClose:
-        context.mState = kStateDone;
+        if (joiner->mState != kStateDone)
+        {
+            joiner->mState = kStateDone;
+            gettimeofday(&joiner->mDoneTv, NULL);
+            context.mNumJoinersDone++;
+        }
         break;
 
     case Dtls::Session::kStateError:
     case Dtls::Session::kStateEnd:
-        context.mSession = NULL;
+    case Dtls::Session::kStateExpired:
+        joiner->mSession = NULL;
         break;
     default:
         break;
     }
+
+exit:
+    return;
 }
 
 /** Determine if it is time to send a COMM_KA or not */
@@ -745,21 +921,69 @@ static bool IsEnvelopeTimeout(Context &aContext)
 }
 
 
-/** Once connected, we await here till a joiner appears... and handle requests */
+/** milliseconds from the joiner was first seen, or -1 if not there yet */
+static long JoinerElapsedMs(const JoinerSession &aJoiner, const struct timeval &aTv)
+{
+    if (aTv.tv_sec == 0)
+    {
+        return -1;
+    }
+
+    return (aTv.tv_sec - aJoiner.mStartTv.tv_sec) * 1000 + (aTv.tv_usec - aJoiner.mStartTv.tv_usec) / 1000;
+}
+
+/** print the timing of each joiner, so scripts can easily parse */
+static void CommissionerReportJoiners(Context &aContext)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+
+    for (JoinerSessionsByIid::const_iterator it = aContext.mJoinerSessionsByIid.begin();
+         it != aContext.mJoinerSessionsByIid.end(); ++it)
+    {
+        const JoinerSession &joiner = *it->second;
+
+        fprintf(stdout, "joiner: iid=%s authenticated-ms=%ld finalized-ms=%ld done-ms=%ld\n",
+                CommissionerUtilsHexString(joiner.mIid, sizeof(joiner.mIid)),
+                JoinerElapsedMs(joiner, joiner.mAuthenticatedTv),
+                JoinerElapsedMs(joiner, joiner.mFinalizedTv),
+                JoinerElapsedMs(joiner, joiner.mDoneTv));
+    }
+
+    fprintf(stdout, "joiners: seen=%u done=%u seconds=%ld\n",
+            static_cast<unsigned>(aContext.mJoinerSessionsByIid.size()),
+            static_cast<unsigned>(aContext.mNumJoinersDone),
+            static_cast<long>(tv.tv_sec - aContext.mEnvelopeStartTv.tv_sec));
+    fflush(stdout);
+}
+
+/** Once connected, we await here till the joiners appear... and handle requests */
 int CommissionerServe(Context &aContext)
 {
     fd_set readFdSet;
     fd_set writeFdSet;
     fd_set errorFdSet;
     int    ret = 0;
+    size_t numJoiners = aContext.mJoiners.GetSize();
 
-    otbrLog(OTBR_LOG_INFO, "CommissionerServe: start");
-    aContext.mSocket = socket(AF_INET, SOCK_DGRAM, 0);
-    VerifyOrExit(aContext.mSocket != -1, ret = errno);
+    /* with allow any and no joiner list, one joiner is commissioned */
+    if (numJoiners == 0)
+    {
+        numJoiners = 1;
+    }
+
+    otbrLog(OTBR_LOG_INFO, "CommissionerServe: start, %u joiners", static_cast<unsigned>(numJoiners));
     aContext.mDtlsServer = Dtls::Server::Create(kPortJoinerSession, HandleSessionChange, &aContext);
+    VerifyOrExit(aContext.mDtlsServer != NULL, ret = -1);
 
-    otbrLog(OTBR_LOG_INFO, "commissioner-serve: device-pskd=%s", aContext.mJoiner.mPSKd_ascii);
-    aContext.mDtlsServer->SetPSK((const uint8_t *)aContext.mJoiner.mPSKd_ascii, strlen(aContext.mJoiner.mPSKd_ascii));
+    /* each joiner has its own PSKd, looked up when its session is created */
+    aContext.mDtlsServer->SetPSKHandler(HandleJoinerPSK, &aContext);
+    if (aContext.mJoiner.mPSKd_ascii[0])
+    {
+        aContext.mDtlsServer->SetPSK((const uint8_t *)aContext.mJoiner.mPSKd_ascii,
+                                     strlen(aContext.mJoiner.mPSKd_ascii));
+    }
     aContext.mDtlsServer->Start();
 
     if (aContext.mCOMM_KA.mDisabled)
@@ -769,7 +993,7 @@ int CommissionerServe(Context &aContext)
         otbrLog(OTBR_LOG_INFO, "COMM_KA: disabled");
     }
 
-    while (aContext.mState != kStateDone && aContext.mState != kStateError)
+    while (aContext.mNumJoinersDone < numJoiners && aContext.mState != kStateError)
     {
         struct timeval timeout = kPollTimeout;
         int            maxFd = -1;
@@ -798,10 +1022,14 @@ int CommissionerServe(Context &aContext)
         {
             maxFd = aContext.mNet->fd;
         }
-        FD_SET(aContext.mSocket, &readFdSet);
-        if (maxFd < aContext.mSocket)
+        for (JoinerSessionsByIid::iterator it = aContext.mJoinerSessionsByIid.begin();
+             it != aContext.mJoinerSessionsByIid.end(); ++it)
         {
-            maxFd = aContext.mSocket;
+            FD_SET(it->second->mSocket, &readFdSet);
+            if (maxFd < it->second->mSocket)
+            {
+                maxFd = it->second->mSocket;
+            }
         }
         aContext.mDtlsServer->UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
         ret = select(maxFd + 1, &readFdSet, &writeFdSet, &errorFdSet, &timeout);
@@ -811,30 +1039,26 @@ int CommissionerServe(Context &aContext)
             break;
         }
 
-        if (FD_ISSET(aContext.mSocket, &readFdSet))
-        {
-            SendRelayTransmit(aContext);
-        }
-
+        /* joiners seen in here are only relayed on the next tick, their sockets are not in the fd set */
         if (FD_ISSET(aContext.mNet->fd, &readFdSet))
         {
             ret = CommissionerSessionProcess(aContext);
             VerifyOrExit(ret > 0 || ret == MBEDTLS_ERR_SSL_TIMEOUT);
         }
 
+        for (JoinerSessionsByIid::iterator it = aContext.mJoinerSessionsByIid.begin();
+             it != aContext.mJoinerSessionsByIid.end(); ++it)
+        {
+            if (FD_ISSET(it->second->mSocket, &readFdSet))
+            {
+                SendRelayTransmit(aContext, *it->second);
+            }
+        }
+
         aContext.mDtlsServer->Process(readFdSet, writeFdSet, errorFdSet);
     }
 
-    /* the session with the joiner might not exist.
-     * Example: If we never found the joiner..
-     */
-    if (aContext.mSession)
-    {
-        aContext.mSession->Close();
-    }
-    Dtls::Server::Destroy(aContext.mDtlsServer);
-    close(aContext.mSocket);
-    if (aContext.mState == kStateDone)
+    if (aContext.mNumJoinersDone >= numJoiners)
     {
         ret = 0;
     }
@@ -844,6 +1068,35 @@ int CommissionerServe(Context &aContext)
     }
 
 exit:
+    CommissionerReportJoiners(aContext);
+
+    /* the session with a joiner might not exist.
+     * Example: If we never found the joiner..
+     */
+    for (JoinerSessionsByIid::iterator it = aContext.mJoinerSessionsByIid.begin();
+         it != aContext.mJoinerSessionsByIid.end(); ++it)
+    {
+        if (it->second->mSession)
+        {
+            it->second->mSession->Close();
+        }
+    }
+
+    if (aContext.mDtlsServer != NULL)
+    {
+        Dtls::Server::Destroy(aContext.mDtlsServer);
+        aContext.mDtlsServer = NULL;
+    }
+
+    for (JoinerSessionsByIid::iterator it = aContext.mJoinerSessionsByIid.begin();
+         it != aContext.mJoinerSessionsByIid.end(); ++it)
+    {
+        close(it->second->mSocket);
+        delete it->second;
+    }
+    aContext.mJoinerSessionsByIid.clear();
+    aContext.mJoinerSessionsByPort.clear();
+
     otbrLog(OTBR_LOG_INFO, "CommissionerServe: result=%d", ret);
 
     return ret;
@@ -876,9 +1129,15 @@ static int commissioning_session(Context &context)
         CommissionerUtilsFail("Missing AGENT ip port\n");
     }
 
-    if (context.mJoiner.mPSKd_ascii[0] == 0)
+    /* the joiner on the command line is commissioned along with the joiner list */
+    if (context.mJoiner.mPSKd_ascii[0] != 0 && context.mJoiner.mHashMac.ascii[0] != 0)
+    {
+        context.mJoiners.Add(context.mJoiner.mHashMac.bin, context.mJoiner.mPSKd_ascii, 0);
+    }
+
+    if (context.mJoiner.mPSKd_ascii[0] == 0 && context.mJoiners.GetSize() == 0)
     {
-        CommissionerUtilsFail("Missing PSKd (joiner passphrase/password)\n");
+        CommissionerUtilsFail("Missing PSKd (joiner passphrase/password) or joiner list\n");
     }
 
     context.mSsl = &ssl;
@@ -987,7 +1246,7 @@ static int commissioning_session(Context &context)
     /** Tell network who we want to commission */
     SuccessOrExit(ret = CommissionerSet(context));
 
-    /* and wait for that joiner to appear */
+    /* and wait for those joiners to appear */
     SuccessOrExit(ret = CommissionerServe(context));
 
     /* YEA! Success!!!! */
@@ -42,8 +42,11 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <syslog.h>
+#include <sys/ioctl.h>
 #include <sys/time.h>
 
+#include <map>
+
 #if !defined(MBEDTLS_CONFIG_FILE)
 #include "mbedtls/config.h"
 #else
@@ -61,13 +64,16 @@
 
 #include "agent/coap.hpp"
 #include "agent/dtls.hpp"
+#include "agent/joiner_registry.hpp"
 #include "agent/uris.hpp"
 #include "common/tlv.hpp"
+#include "common/tlv_writer.hpp"
 #include "common/code_utils.hpp"
 #include "common/logging.hpp"
 #include "utils/hex.hpp"
 #include "utils/steeringdata.hpp"
 #include "web/pskc-generator/pskc.hpp"
+#include "web/pskc-generator/pskc_cache.hpp"
 
 
 using namespace ot;
@@ -140,6 +146,48 @@ enum
 };
 
 
+/**
+ * Joiner session, one for each joiner seen in relay-rx.
+ */
+struct JoinerSession
+{
+    /** Interface id of the joiner device, relay-rx is demultiplexed by it */
+    uint8_t mIid[8];
+
+    /** UDP port of the joiner */
+    uint16_t mUdpPort;
+
+    /** the router we are using to talk to the joiner */
+    uint16_t mRouterLocator;
+
+    /** Socket relaying the DTLS records of the joiner, and its port
+     * The port tells the joiner apart in the DTLS server and in coap.
+     */
+    int      mSocket;
+    uint16_t mPort;
+
+    /** This is the PSKd of the joiner, from the joiner list or the command line */
+    char mPSKd_ascii[ kPSKdLength + 1 ];
+
+    /* the dtls session with the joiner */
+    Dtls::Session *mSession;
+
+    /** Kek with the joiner operation */
+    uint8_t mKek[16];
+
+    /** Joiner state */
+    int mState;
+
+    /** when the joiner was first seen, authenticated, finalized and done */
+    struct timeval mStartTv;
+    struct timeval mAuthenticatedTv;
+    struct timeval mFinalizedTv;
+    struct timeval mDoneTv;
+};
+
+typedef std::map<uint64_t, JoinerSession *> JoinerSessionsByIid;
+typedef std::map<uint16_t, JoinerSession *> JoinerSessionsByPort;
+
 /**
  * Commissioner Context.
  */
@@ -151,19 +199,13 @@ struct Context
     /** coap instance to talk to agent & device */
     Coap::Agent *mCoap;
 
-    /** dtls info for talking to agent & joiner */
+    /** dtls info for talking to joiners */
     Dtls::Server *mDtlsServer;
 
-    /* the session info for agent & joiner */
-    Dtls::Session *mSession;
-
     /* dtls context information */
     mbedtls_ssl_context *mSsl;
     mbedtls_net_context *mNet;
 
-    /* Socket we are using with the agent */
-    int mSocket;
-
     /* this generates our coap tokens */
     uint16_t mCoapToken;
 
@@ -201,8 +243,8 @@ struct Context
         struct
         {
 
-            /* this class does the calculation */
-            Psk::Pskc mTool;
+            /* this class does the calculation, or finds it in the cache */
+            Psk::PskcCache mTool;
 
             /** ascii & binary of PSKc, either from calculation or cmdline */
             char    ascii[ (OT_PSKC_LENGTH * 2) + 1 ];
@@ -211,9 +253,6 @@ struct Context
 
     } mAgent;
 
-    /** Kek with the joiner operation */
-    uint8_t mKek[32];
-
     struct comm_ka
     {
         /** last time a COMM_KA message was sent */
@@ -240,6 +279,16 @@ struct Context
     /** Commissioner state */
     int mState;
 
+    /** Joiners allowed to join with their PSKd, from the joiner list or the command line */
+    JoinerRegistry mJoiners;
+
+    /** Sessions of the joiners being commissioned, by IID and by the port of their relay socket */
+    JoinerSessionsByIid  mJoinerSessionsByIid;
+    JoinerSessionsByPort mJoinerSessionsByPort;
+
+    /** How many joiners are done */
+    size_t mNumJoinersDone;
+
 
     /** All things about the joiner */
     struct joiner
@@ -255,21 +304,9 @@ struct Context
         /** Set to true/false via cmdline param for test purposes. */
         bool mAllowAny;
 
-        /** Computed steering data based on hashmac */
+        /** Computed steering data based on hashmac, or on the joiner list */
         SteeringData mSteeringData;
 
-        /** UDP port of the joiner */
-        uint16_t mUdpPort;
-
-        /** Interface id of the joiner device */
-        uint8_t mIid[8];
-
-        /** the router we are using to talk to the joiner */
-        uint16_t mRouterLocator;
-
-        /** the port we are using */
-        uint16_t mPortSession;
-
         /** This is the PSKd from the command line */
         /* this is the shared string used by the device */
         char mPSKd_ascii[ kPSKdLength + 1 ];
@@ -297,8 +297,8 @@ static void handle_eui64(argcargv *pThis)
     }
 }
 
-/** Handle the preshared joining credential for the joining device on the command line */
-static void handle_pskd(argcargv *pThis)
+/** Check a preshared joining credential, returns why it is bad or NULL if it is good */
+static const char *check_pskd(const char *pskd)
 {
     const char *whybad;
     int         ch;
@@ -307,9 +307,6 @@ static void handle_pskd(argcargv *pThis)
     /* assume not bad */
     whybad = NULL;
 
-    /* get the parameter */
-    pThis->str_param(gContext.mJoiner.mPSKd_ascii, sizeof(gContext.mJoiner.mPSKd_ascii));
-
     /*
      * Problem: Should we "base32" decode this per the specification?
      * Answer: No - because this needs to be identical to the CLI application
@@ -330,7 +327,7 @@ static void handle_pskd(argcargv *pThis)
      * Thus 10 digits + 22 letters = 32 symbols.
      * Thus, "base32" encoding using the above.
      */
-    len = strlen(gContext.mJoiner.mPSKd_ascii);
+    len = strlen(pskd);
     if ((len < 6) || (len > 32))
     {
         whybad = "invalid length (range: 6..32)";
@@ -340,7 +337,7 @@ static void handle_pskd(argcargv *pThis)
 
         for (x = 0; x < len; x++)
         {
-            ch = gContext.mJoiner.mPSKd_ascii[x];
+            ch = pskd[x];
 
             switch (ch)
             {
@@ -368,6 +365,18 @@ static void handle_pskd(argcargv *pThis)
         }
     }
 
+    return whybad;
+}
+
+/** Handle the preshared joining credential for the joining device on the command line */
+static void handle_pskd(argcargv *pThis)
+{
+    const char *whybad;
+
+    /* get the parameter */
+    pThis->str_param(gContext.mJoiner.mPSKd_ascii, sizeof(gContext.mJoiner.mPSKd_ascii));
+
+    whybad = check_pskd(gContext.mJoiner.mPSKd_ascii);
     if (whybad)
     {
         pThis->usage("Illegal PSKd: \"%s\", %s\n",
@@ -375,6 +384,67 @@ static void handle_pskd(argcargv *pThis)
     }
 }
 
+/** Handle a file of joiners to commission on the command line
+ *
+ * Each line is: EUI64,PSKd
+ * Empty lines and lines starting with # are skipped.
+ */
+static void handle_joiner_list(argcargv *pThis)
+{
+    char        filename[ PATH_MAX ];
+    char        line[ 128 ];
+    FILE       *fp;
+    int         lineno = 0;
+    char       *pskd;
+    const char *whybad;
+    uint8_t     eui64[ kEui64Len ];
+    uint8_t     joinerId[ JoinerRegistry::kSizeOfJoinerId ];
+
+    pThis->str_param(filename, sizeof(filename));
+
+    fp = fopen(filename, "r");
+    if (fp == NULL)
+    {
+        pThis->usage("Cannot open joiner list: %s\n", filename);
+    }
+
+    while (fgets(line, sizeof(line), fp) != NULL)
+    {
+        lineno++;
+
+        /* strip the end of line */
+        line[strcspn(line, "\r\n")] = 0;
+        if ((line[0] == 0) || (line[0] == '#'))
+        {
+            continue;
+        }
+
+        pskd = strchr(line, ',');
+        if (pskd == NULL)
+        {
+            pThis->usage("%s:%d: expecting EUI64,PSKd\n", filename, lineno);
+        }
+        *pskd++ = 0;
+
+        if ((strlen(line) != (kEui64Len * 2)) || (Hex2Bytes(line, eui64, sizeof(eui64)) != kEui64Len))
+        {
+            pThis->usage("%s:%d: Invalid EUI64: %s\n", filename, lineno, line);
+        }
+
+        whybad = check_pskd(pskd);
+        if (whybad)
+        {
+            pThis->usage("%s:%d: Illegal PSKd: \"%s\", %s\n", filename, lineno, pskd, whybad);
+        }
+
+        JoinerRegistry::ComputeJoinerId(eui64, joinerId);
+        gContext.mJoiners.Add(joinerId, pskd, 0);
+    }
+
+    fclose(fp);
+    otbrLog(OTBR_LOG_INFO, "joiner-list: %u joiners", static_cast<unsigned>(gContext.mJoiners.GetSize()));
+}
+
 
 /** Handle a pre-computed border agent preshared key, the PSKc
  * This is derived from the Networkname, Xpanid & passphrase
@@ -420,6 +490,19 @@ static void handle_log_filename(argcargv *pThis)
     otbrLogSetFilename(filename);
 }
 
+/** Handle the PSKc cache filename on the command line */
+static void handle_pskc_cache(argcargv *pThis)
+{
+    char filename[ PATH_MAX ];
+
+    pThis->str_param(filename, sizeof(filename));
+
+    if (gContext.mAgent.mPSKc.mTool.Open(filename) != OTBR_ERROR_NONE)
+    {
+        pThis->usage("Cannot open PSKc cache: %s\n", filename);
+    }
+}
+
 /** compute the pskc from command line params */
 static void handle_compute_pskc(argcargv *pThis)
 {
@@ -572,6 +655,8 @@ void commissioner_argcargv(int argc, char **argv)
     args.add_option("--pskc-bin",                handle_pskc_bin,                "VALUE",
                     "Precomputed PSKc in hex notation");
     args.add_option("--joiner-passphrase",       handle_pskd,                    "VALUE",       "PSKd for joiner");
+    args.add_option("--joiner-list",             handle_joiner_list,             "FILENAME",
+                    "Commission the joiners of a file of EUI64,PSKd lines concurrently");
     args.add_option("--steering-length",         handle_steering_length,         "NUMBER",
                     "Length of steering data 1..15");
     args.add_option("--allow-all-joiners",       handle_allow_all_joiners,       "",
@@ -581,6 +666,8 @@ void commissioner_argcargv(int argc, char **argv)
     args.add_option("--agent-port",              handle_ip_port,                 "VALUE",
                     "ip port used by border router agent");
     args.add_option("--log-filename",            handle_log_filename,            "FILENAME",    "set logfilename");
+    args.add_option("--pskc-cache",              handle_pskc_cache,              "FILENAME",
+                    "Cache computed PSKcs in a file private to this user, before --compute-pskc");
     args.add_option("--compute-pskc",            handle_compute_pskc,            "",
                     "compute and print the pskc from parameters");
     args.add_option("--compute-hashmac",         handle_compute_hashmac,         "",
@@ -82,7 +82,8 @@ bool CommissionerComputeHashMac(void)
         /* convert to ascii */
         Bytes2Hex(gContext.mJoiner.mHashMac.bin,
                   8,
-                  gContext.mJoiner.mHashMac.ascii);
+                  gContext.mJoiner.mHashMac.ascii,
+                  sizeof(gContext.mJoiner.mHashMac.ascii));
     }
     otbrLog(OTBR_LOG_INFO, "hash-mac: %s", gContext.mJoiner.mHashMac.ascii);
 
@@ -133,7 +134,8 @@ bool CommissionerComputePskc(void)
 
         memcpy(gContext.mAgent.mPSKc.bin, pKey, OT_PSKC_LENGTH);
         /* convert to ascii for log purposes */
-        Bytes2Hex(gContext.mAgent.mPSKc.bin, OT_PSKC_LENGTH, gContext.mAgent.mPSKc.ascii);
+        Bytes2Hex(gContext.mAgent.mPSKc.bin, OT_PSKC_LENGTH, gContext.mAgent.mPSKc.ascii,
+                  sizeof(gContext.mAgent.mPSKc.ascii));
     }
     otbrLog(OTBR_LOG_INFO, "pskc: %s", gContext.mAgent.mPSKc.ascii);
     /* have a return here so this function matchs other "compute" functions */
@@ -155,6 +157,15 @@ bool CommissionerComputeSteering(void)
             break;
         }
 
+        /* The joiner list, and the joiner on the command line once added, are in the registry */
+        if (gContext.mJoiners.GetSize() > 0)
+        {
+            gContext.mJoiners.SetSteeringLength(static_cast<uint8_t>(gContext.mJoiner.mSteeringData.GetLength()));
+            gContext.mJoiner.mSteeringData = gContext.mJoiners.GetSteeringData();
+            ok = true;
+            break;
+        }
+
         /* We require a hashmac */
         ok = CommissionerComputeHashMac();
         if (!ok)
@@ -0,0 +1,961 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   The file implements a load generator, a swarm of commissioners against a border agent.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <sys/select.h>
+#include <sys/time.h>
+
+#include <map>
+#include <vector>
+
+#if !defined(MBEDTLS_CONFIG_FILE)
+#include "mbedtls/config.h"
+#else
+#include MBEDTLS_CONFIG_FILE
+#endif
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/net_sockets.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/timing.h>
+
+#include "agent/coap.hpp"
+#include "agent/uris.hpp"
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/tlv_view.hpp"
+#include "common/tlv_writer.hpp"
+#include "utils/hex.hpp"
+
+using namespace ot;
+using namespace ot::BorderRouter;
+
+enum
+{
+    kSizeOfPSKc        = 16,
+    kSizeOfRelayRecord = 64,      ///< Size of the fake DTLS record relayed for a joiner.
+    kSizeMaxPacket     = 1500,
+    kMaxClients        = 1000,    ///< All sockets must fit in an fd_set.
+    kNumBuckets        = 24,      ///< The i-th latency bucket counts latencies in [2^i, 2^(i+1)) microseconds.
+    kHistogramWidth    = 40,      ///< Width of the longest histogram bar.
+    kMaxPollInterval   = 10000,   ///< Microseconds, how late a request may be sent.
+    kDefaultClients    = 10,
+    kDefaultDuration   = 10,      ///< Seconds.
+    kDefaultTimeout    = 5000,    ///< Milliseconds to wait for a response.
+};
+
+static const char    kDefaultAddress[] = "::1";
+static const char    kDefaultPort[] = "49191";
+static const char    kCommissionerId[] = "OpenThread";
+static const uint8_t kSeed[] = "CommissionerLoad";
+static const int     kCipherSuites[] = {
+    MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8,
+    0
+};
+
+/**
+ * Operations of the commissioners.
+ *
+ */
+enum Operation
+{
+    kOperationHandshake,
+    kOperationPetition,
+    kOperationKeepAlive,
+    kOperationDatasetGet,
+    kOperationRelay,
+    kNumOperations,
+};
+
+static const char *const kOperationNames[kNumOperations] = {
+    "handshake", "petition", "keep-alive", "dataset-get", "relay-tx",
+};
+
+static unsigned long GetMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<unsigned long>(now.tv_sec) * 1000000 + static_cast<unsigned long>(now.tv_usec);
+}
+
+/**
+ * This class implements a latency histogram with buckets of powers of two microseconds.
+ *
+ */
+class Histogram
+{
+public:
+    Histogram(void) :
+        mCount(0),
+        mSum(0),
+        mMin(0),
+        mMax(0)
+    {
+        memset(mBuckets, 0, sizeof(mBuckets));
+    }
+
+    void Add(unsigned long aLatency)
+    {
+        unsigned bucket = 0;
+
+        while (bucket + 1 < kNumBuckets && (aLatency >> (bucket + 1)) != 0)
+        {
+            bucket++;
+        }
+
+        mBuckets[bucket]++;
+        mMin = (mCount == 0 || aLatency < mMin) ? aLatency : mMin;
+        mMax = aLatency > mMax ? aLatency : mMax;
+        mSum += aLatency;
+        mCount++;
+    }
+
+    unsigned long GetCount(void) const { return mCount; }
+    unsigned long GetMin(void) const { return mMin; }
+    unsigned long GetMax(void) const { return mMax; }
+    unsigned long GetMean(void) const { return mCount ? mSum / mCount : 0; }
+
+    /**
+     * This method returns the upper bound of the bucket holding a percentile, capped by the max latency.
+     *
+     */
+    unsigned long GetPercentile(unsigned aPercent) const
+    {
+        unsigned long rank = (mCount * aPercent + 99) / 100;
+        unsigned long count = 0;
+        unsigned long bound = 0;
+
+        for (unsigned i = 0; i < kNumBuckets && count < rank; i++)
+        {
+            count += mBuckets[i];
+            bound = (2UL << i) - 1;
+        }
+
+        return bound < mMax ? bound : mMax;
+    }
+
+    void Print(FILE *aFile, const char *aName) const
+    {
+        unsigned long peak = 0;
+
+        VerifyOrExit(mCount > 0);
+
+        for (unsigned i = 0; i < kNumBuckets; i++)
+        {
+            peak = mBuckets[i] > peak ? mBuckets[i] : peak;
+        }
+
+        fprintf(aFile, "%s latency histogram (us):\n", aName);
+
+        for (unsigned i = 0; i < kNumBuckets; i++)
+        {
+            char bar[kHistogramWidth + 1];
+            int  width = static_cast<int>((mBuckets[i] * kHistogramWidth + peak - 1) / peak);
+
+            if (mBuckets[i] == 0)
+            {
+                continue;
+            }
+
+            memset(bar, '#', static_cast<size_t>(width));
+            bar[width] = '\0';
+            fprintf(aFile, "  %8lu..%-8lu %8lu %s\n", i ? 1UL << i : 0UL, (2UL << i) - 1, mBuckets[i], bar);
+        }
+
+exit:
+        return;
+    }
+
+private:
+    unsigned long mBuckets[kNumBuckets];
+    unsigned long mCount;
+    unsigned long mSum;
+    unsigned long mMin;
+    unsigned long mMax;
+};
+
+/**
+ * This structure represents the statistics of an operation.
+ *
+ */
+struct Statistics
+{
+    Statistics(void) :
+        mSent(0),
+        mSucceeded(0),
+        mRejected(0),
+        mTimedOut(0),
+        mFailed(0)
+    {
+    }
+
+    unsigned long mSent;
+    unsigned long mSucceeded;
+    unsigned long mRejected; ///< Responded with an error code or a reject state.
+    unsigned long mTimedOut;
+    unsigned long mFailed;   ///< Failed to send, or the session failed.
+    Histogram     mLatency;
+};
+
+/**
+ * This structure represents the configuration of the load.
+ *
+ */
+struct Config
+{
+    const char   *mAddress;
+    const char   *mPort;
+    uint8_t       mPSKc[kSizeOfPSKc];
+    unsigned      mClients;
+    double        mConnectRate;           ///< Clients started per second, 0 to start all at once.
+    unsigned long mDuration;              ///< Microseconds.
+    unsigned long mTimeout;               ///< Microseconds.
+    double        mRates[kNumOperations]; ///< Requests per second of each client.
+};
+
+/**
+ * This class implements a commissioner of the swarm.
+ *
+ * It handshakes with the border agent, petitions, and then sends keep-alive, dataset get and relay requests at
+ * the configured rates without waiting for responses, timing each request until its response arrives.
+ *
+ */
+class LoadClient
+{
+public:
+    LoadClient(const Config &aConfig, mbedtls_ssl_config &aSslConfig, Statistics *aStatistics, unsigned aId) :
+        mConfig(aConfig),
+        mSslConfig(aSslConfig),
+        mStatistics(aStatistics),
+        mId(aId),
+        mState(kStateIdle),
+        mCoap(Coap::Agent::Create(SendCoap, this)),
+        mToken(0),
+        mSessionId(0),
+        mHandshakeStart(0),
+        mNow(0),
+        mWriteFailed(false)
+    {
+        mbedtls_net_init(&mNet);
+        mbedtls_ssl_init(&mSsl);
+        memset(mNext, 0, sizeof(mNext));
+    }
+
+    ~LoadClient(void)
+    {
+        if (mState == kStateReady)
+        {
+            mbedtls_ssl_close_notify(&mSsl);
+        }
+
+        Coap::Agent::Destroy(mCoap);
+        mbedtls_ssl_free(&mSsl);
+        mbedtls_net_free(&mNet);
+    }
+
+    /**
+     * This method connects to the border agent and starts the handshake.
+     *
+     * @param[in]   aNow    Current time in microseconds.
+     *
+     */
+    void Start(unsigned long aNow)
+    {
+        int ret;
+
+        mHandshakeStart = aNow;
+        mState = kStateHandshaking;
+        mStatistics[kOperationHandshake].mSent++;
+
+        SuccessOrExit(ret = mbedtls_net_connect(&mNet, mConfig.mAddress, mConfig.mPort, MBEDTLS_NET_PROTO_UDP));
+        SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
+        SuccessOrExit(ret = mbedtls_ssl_setup(&mSsl, &mSslConfig));
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+        mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        SuccessOrExit(ret = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, mConfig.mPSKc, sizeof(mConfig.mPSKc)));
+        Handshake(aNow);
+
+exit:
+        if (ret != 0)
+        {
+            otbrLog(OTBR_LOG_ERR, "client %u: failed to start: -0x%04x", mId, -ret);
+            Fail(kOperationHandshake);
+        }
+    }
+
+    /**
+     * This method updates the fd_set and timeout for the mainloop.
+     *
+     */
+    void UpdateFdSet(fd_set &aReadFdSet, int &aMaxFd, unsigned long &aTimeout, unsigned long aNow) const
+    {
+        VerifyOrExit(mState == kStateHandshaking || mState == kStateReady);
+
+        FD_SET(mNet.fd, &aReadFdSet);
+
+        if (aMaxFd < mNet.fd)
+        {
+            aMaxFd = mNet.fd;
+        }
+
+        for (int i = kOperationKeepAlive; i < kNumOperations && mState == kStateReady; i++)
+        {
+            if (mConfig.mRates[i] > 0 && mNext[i] < aNow + aTimeout)
+            {
+                aTimeout = mNext[i] > aNow ? mNext[i] - aNow : 0;
+            }
+        }
+
+exit:
+        return;
+    }
+
+    /**
+     * This method processes the responses, and sends the requests due.
+     *
+     * @param[in]   aReadFdSet  A reference to fd_set ready for reading.
+     * @param[in]   aNow        Current time in microseconds.
+     * @param[in]   aSending    Whether to send new requests.
+     *
+     */
+    void Process(const fd_set &aReadFdSet, unsigned long aNow, bool aSending)
+    {
+        switch (mState)
+        {
+        case kStateHandshaking:
+            if (FD_ISSET(mNet.fd, &aReadFdSet) || mbedtls_timing_get_delay(&mTimer) == 2)
+            {
+                Handshake(aNow);
+            }
+
+            break;
+
+        case kStateReady:
+            if (FD_ISSET(mNet.fd, &aReadFdSet))
+            {
+                Receive(aNow);
+            }
+
+            for (int i = kOperationKeepAlive; i < kNumOperations && aSending && mState == kStateReady; i++)
+            {
+                if (mConfig.mRates[i] > 0 && mNext[i] <= aNow)
+                {
+                    unsigned long interval = static_cast<unsigned long>(1000000 / mConfig.mRates[i]);
+
+                    // Missed slots are skipped rather than sent in a burst.
+                    mNext[i] += interval;
+                    if (mNext[i] <= aNow)
+                    {
+                        mNext[i] = aNow + interval;
+                    }
+
+                    Send(static_cast<Operation>(i), aNow);
+                }
+            }
+
+            Expire(aNow);
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    /**
+     * This method returns the number of requests waiting for responses.
+     *
+     */
+    size_t GetNumPending(void) const { return mState == kStateHandshaking ? 1 : mPending.size(); }
+
+private:
+    enum State
+    {
+        kStateIdle,
+        kStateHandshaking,
+        kStateReady,
+        kStateFailed,
+    };
+
+    struct Request
+    {
+        Operation     mOperation;
+        unsigned long mSentTime;
+    };
+
+    typedef std::map<uint16_t, Request> RequestMap;
+
+    void Handshake(unsigned long aNow)
+    {
+        int ret = mbedtls_ssl_handshake(&mSsl);
+
+        if (ret == 0)
+        {
+            mState = kStateReady;
+            mStatistics[kOperationHandshake].mSucceeded++;
+            mStatistics[kOperationHandshake].mLatency.Add(aNow - mHandshakeStart);
+
+            // Spread the first requests of each operation over its interval.
+            for (int i = kOperationKeepAlive; i < kNumOperations; i++)
+            {
+                if (mConfig.mRates[i] > 0)
+                {
+                    mNext[i] = aNow + static_cast<unsigned long>(1000000 / mConfig.mRates[i]) * (mId % 16) / 16;
+                }
+            }
+
+            Send(kOperationPetition, aNow);
+        }
+        else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+        {
+            otbrLog(OTBR_LOG_ERR, "client %u: handshake failed: -0x%04x", mId, -ret);
+
+            if (ret == MBEDTLS_ERR_SSL_TIMEOUT)
+            {
+                mStatistics[kOperationHandshake].mTimedOut++;
+                mState = kStateFailed;
+            }
+            else
+            {
+                Fail(kOperationHandshake);
+            }
+        }
+    }
+
+    void Receive(unsigned long aNow)
+    {
+        uint8_t buffer[kSizeMaxPacket];
+        int     ret;
+
+        while ((ret = mbedtls_ssl_read(&mSsl, buffer, sizeof(buffer))) > 0)
+        {
+            mNow = aNow;
+            mCoap->Input(buffer, static_cast<uint16_t>(ret), NULL, 0);
+        }
+
+        if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE && ret != MBEDTLS_ERR_SSL_TIMEOUT)
+        {
+            otbrLog(OTBR_LOG_ERR, "client %u: session lost: -0x%04x", mId, -ret);
+            Fail(kOperationHandshake);
+        }
+    }
+
+    void Send(Operation aOperation, unsigned long aNow)
+    {
+        uint16_t       token = htons(++mToken);
+        uint16_t       size = 0;
+        Coap::Message *message;
+        Request        request = {aOperation, aNow};
+
+        message = mCoap->NewMessage(aOperation == kOperationRelay ? Coap::kTypeNonConfirmable :
+                                    Coap::kTypeConfirmable, Coap::kCodePost,
+                                    reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+        {
+            TlvWriter writer(message->GetPayloadBuffer(size), size);
+
+            switch (aOperation)
+            {
+            case kOperationPetition:
+                message->SetPath(OT_URI_PATH_COMMISSIONER_PETITION);
+                writer.AppendCommissionerId(kCommissionerId);
+                break;
+
+            case kOperationKeepAlive:
+                message->SetPath(OT_URI_PATH_COMMISSIONER_KEEP_ALIVE);
+                writer.AppendState(static_cast<int8_t>(1));
+                writer.AppendCommissionerSessionId(mSessionId);
+                break;
+
+            case kOperationDatasetGet:
+                // No TLVs to get all of the active dataset.
+                message->SetPath(OT_URI_PATH_ACTIVE_GET);
+                break;
+
+            case kOperationRelay:
+            {
+                // A fake joiner of each client, relaying a fake DTLS record.
+                uint8_t  iid[8] = {0x12, 0x34, 0, 0, 0, 0, static_cast<uint8_t>(mId >> 8),
+                                   static_cast<uint8_t>(mId)};
+                uint8_t *record = writer.ReserveJoinerDtlsEncapsulation(kSizeOfRelayRecord);
+
+                message->SetPath(OT_URI_PATH_RELAY_TX);
+
+                if (record != NULL)
+                {
+                    memset(record, 0x5a, kSizeOfRelayRecord);
+                }
+
+                writer.AppendJoinerUdpPort(static_cast<uint16_t>(1000));
+                writer.AppendJoinerIid(iid);
+                writer.AppendJoinerRouterLocator(static_cast<uint16_t>(0));
+                break;
+            }
+
+            default:
+                assert(false);
+                break;
+            }
+
+            if (writer.GetError() != OTBR_ERROR_NONE ||
+                message->SetPayloadLength(writer.GetLength()) != OTBR_ERROR_NONE)
+            {
+                otbrLog(OTBR_LOG_ERR, "client %u: payload does not fit", mId);
+                mStatistics[aOperation].mFailed++;
+                mCoap->FreeMessage(message);
+                return;
+            }
+        }
+
+        mStatistics[aOperation].mSent++;
+        mWriteFailed = false;
+
+        if (aOperation == kOperationRelay)
+        {
+            mCoap->Send(*message, NULL, 0, NULL, this);
+        }
+        else
+        {
+            mPending[mToken] = request;
+            mCoap->Send(*message, NULL, 0, HandleResponse, this);
+        }
+
+        mCoap->FreeMessage(message);
+
+        if (mWriteFailed)
+        {
+            mStatistics[aOperation].mFailed++;
+            mPending.erase(mToken);
+        }
+        else if (aOperation == kOperationRelay)
+        {
+            mStatistics[aOperation].mSucceeded++;
+        }
+    }
+
+    void Expire(unsigned long aNow)
+    {
+        for (RequestMap::iterator it = mPending.begin(); it != mPending.end(); )
+        {
+            if (aNow - it->second.mSentTime >= mConfig.mTimeout)
+            {
+                mStatistics[it->second.mOperation].mTimedOut++;
+                mPending.erase(it++);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    void Fail(Operation aOperation)
+    {
+        mStatistics[aOperation].mFailed++;
+        mState = kStateFailed;
+
+        // Requests of a failed session never complete.
+        for (RequestMap::iterator it = mPending.begin(); it != mPending.end(); ++it)
+        {
+            mStatistics[it->second.mOperation].mFailed++;
+        }
+
+        mPending.clear();
+    }
+
+    static void HandleResponse(const Coap::Message &aMessage, void *aContext)
+    {
+        static_cast<LoadClient *>(aContext)->HandleResponse(aMessage);
+    }
+
+    void HandleResponse(const Coap::Message &aMessage)
+    {
+        uint8_t              tokenLength;
+        const uint8_t       *token = aMessage.GetToken(tokenLength);
+        uint16_t             length;
+        const uint8_t       *payload = aMessage.GetPayload(length);
+        RequestMap::iterator it;
+        TlvView              tlvs;
+        int8_t               state = 0;
+        bool                 succeeded;
+
+        // Late responses of requests timed out are ignored.
+        VerifyOrExit(tokenLength == sizeof(uint16_t));
+        it = mPending.find(static_cast<uint16_t>((token[0] << 8) | token[1]));
+        VerifyOrExit(it != mPending.end());
+
+        succeeded = aMessage.GetCode() >= Coap::kCodeCodeMin && aMessage.GetCode() < Coap::kCodeRequestIncomplete;
+
+        if (it->second.mOperation == kOperationPetition || it->second.mOperation == kOperationKeepAlive)
+        {
+            succeeded = succeeded && tlvs.Init(payload, length) == OTBR_ERROR_NONE && tlvs.GetState(state) &&
+                        state == 1;
+
+            if (succeeded && it->second.mOperation == kOperationPetition)
+            {
+                tlvs.GetCommissionerSessionId(mSessionId);
+            }
+        }
+
+        if (succeeded)
+        {
+            mStatistics[it->second.mOperation].mSucceeded++;
+        }
+        else
+        {
+            mStatistics[it->second.mOperation].mRejected++;
+        }
+
+        mStatistics[it->second.mOperation].mLatency.Add(mNow - it->second.mSentTime);
+        mPending.erase(it);
+
+exit:
+        return;
+    }
+
+    static ssize_t SendCoap(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
+                            void *aContext)
+    {
+        LoadClient *client = static_cast<LoadClient *>(aContext);
+        int         ret = -1;
+
+        VerifyOrExit(client->mState == kStateReady);
+        ret = mbedtls_ssl_write(&client->mSsl, aBuffer, aLength);
+
+exit:
+        if (ret < 0)
+        {
+            otbrLog(OTBR_LOG_ERR, "client %u: write failed: -0x%04x", client->mId, -ret);
+            client->mWriteFailed = true;
+        }
+
+        (void)aIp6;
+        (void)aPort;
+
+        return ret;
+    }
+
+    const Config                &mConfig;
+    mbedtls_ssl_config          &mSslConfig;
+    Statistics                  *mStatistics;
+    unsigned                     mId;
+    State                        mState;
+    Coap::Agent                 *mCoap;
+    uint16_t                     mToken;
+    uint16_t                     mSessionId;
+    unsigned long                mHandshakeStart;
+    unsigned long                mNow; ///< Time the responses being handled were received.
+    unsigned long                mNext[kNumOperations];
+    bool                         mWriteFailed;
+    RequestMap                   mPending;
+    mbedtls_net_context          mNet;
+    mbedtls_ssl_context          mSsl;
+    mbedtls_timing_delay_context mTimer;
+};
+
+/**
+ * This class implements the swarm of commissioners.
+ *
+ */
+class LoadGenerator
+{
+public:
+    LoadGenerator(const Config &aConfig) :
+        mConfig(aConfig),
+        mNumStarted(0)
+    {
+        mbedtls_ssl_config_init(&mSslConfig);
+        mbedtls_entropy_init(&mEntropy);
+        mbedtls_ctr_drbg_init(&mDrbg);
+    }
+
+    ~LoadGenerator(void)
+    {
+        for (std::vector<LoadClient *>::iterator it = mClients.begin(); it != mClients.end(); ++it)
+        {
+            delete *it;
+        }
+
+        mbedtls_ctr_drbg_free(&mDrbg);
+        mbedtls_entropy_free(&mEntropy);
+        mbedtls_ssl_config_free(&mSslConfig);
+    }
+
+    /**
+     * This method runs the load for the configured duration, and reports the results.
+     *
+     */
+    int Run(void)
+    {
+        int           ret;
+        unsigned long start;
+        unsigned long end;
+        unsigned long now;
+
+        SuccessOrExit(ret = mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, kSeed, sizeof(kSeed)));
+        SuccessOrExit(ret = mbedtls_ssl_config_defaults(&mSslConfig, MBEDTLS_SSL_IS_CLIENT,
+                                                        MBEDTLS_SSL_TRANSPORT_DATAGRAM, MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&mSslConfig, mbedtls_ctr_drbg_random, &mDrbg);
+        mbedtls_ssl_conf_min_version(&mSslConfig, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_max_version(&mSslConfig, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_authmode(&mSslConfig, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_ciphersuites(&mSslConfig, kCipherSuites);
+        mbedtls_ssl_conf_handshake_timeout(&mSslConfig, 1000, static_cast<uint32_t>(mConfig.mTimeout / 1000 * 4));
+
+        for (unsigned i = 0; i < mConfig.mClients; i++)
+        {
+            mClients.push_back(new LoadClient(mConfig, mSslConfig, mStatistics, i));
+        }
+
+        start = GetMicroseconds();
+        end = start + mConfig.mDuration;
+
+        // Outstanding requests are waited for after the load ends, until they time out.
+        for (now = start; now < end || (GetNumPending() > 0 && now < end + mConfig.mTimeout); now = GetMicroseconds())
+        {
+            fd_set         readFdSet;
+            int            maxFd = -1;
+            unsigned long  timeout = kMaxPollInterval;
+            struct timeval tv;
+
+            while (mNumStarted < mClients.size() && now < end && now >= GetStartTime(start, mNumStarted))
+            {
+                mClients[mNumStarted++]->Start(now);
+            }
+
+            FD_ZERO(&readFdSet);
+
+            for (std::vector<LoadClient *>::const_iterator it = mClients.begin(); it != mClients.end(); ++it)
+            {
+                (*it)->UpdateFdSet(readFdSet, maxFd, timeout, now);
+            }
+
+            tv.tv_sec = static_cast<time_t>(timeout / 1000000);
+            tv.tv_usec = static_cast<suseconds_t>(timeout % 1000000);
+
+            if (select(maxFd + 1, &readFdSet, NULL, NULL, &tv) < 0)
+            {
+                VerifyOrExit(errno == EINTR, ret = -1, perror("select"));
+                continue;
+            }
+
+            now = GetMicroseconds();
+
+            for (std::vector<LoadClient *>::const_iterator it = mClients.begin(); it != mClients.end(); ++it)
+            {
+                (*it)->Process(readFdSet, now, now < end);
+            }
+        }
+
+        Report(now - start);
+
+exit:
+        return ret;
+    }
+
+private:
+    unsigned long GetStartTime(unsigned long aStart, size_t aIndex) const
+    {
+        return mConfig.mConnectRate > 0 ? aStart + static_cast<unsigned long>(aIndex * 1000000 / mConfig.mConnectRate)
+               : aStart;
+    }
+
+    size_t GetNumPending(void) const
+    {
+        size_t count = 0;
+
+        for (std::vector<LoadClient *>::const_iterator it = mClients.begin(); it != mClients.end(); ++it)
+        {
+            count += (*it)->GetNumPending();
+        }
+
+        return count;
+    }
+
+    void Report(unsigned long aElapsed) const
+    {
+        double seconds = aElapsed / 1000000.0;
+
+        printf("clients=%u started=%u seconds=%.3f\n", mConfig.mClients, static_cast<unsigned>(mNumStarted),
+               seconds);
+        printf("%-12s %8s %8s %8s %8s %8s %10s %10s %10s %10s %10s %10s\n", "operation", "sent", "ok", "rejected",
+               "timeout", "failed", "ok/s", "min(us)", "p50(us)", "p90(us)", "p99(us)", "max(us)");
+
+        for (int i = 0; i < kNumOperations; i++)
+        {
+            const Statistics &statistics = mStatistics[i];
+
+            printf("%-12s %8lu %8lu %8lu %8lu %8lu %10.1f %10lu %10lu %10lu %10lu %10lu\n", kOperationNames[i],
+                   statistics.mSent, statistics.mSucceeded, statistics.mRejected, statistics.mTimedOut,
+                   statistics.mFailed, statistics.mSucceeded / seconds, statistics.mLatency.GetMin(),
+                   statistics.mLatency.GetPercentile(50), statistics.mLatency.GetPercentile(90),
+                   statistics.mLatency.GetPercentile(99), statistics.mLatency.GetMax());
+        }
+
+        for (int i = 0; i < kNumOperations; i++)
+        {
+            mStatistics[i].mLatency.Print(stdout, kOperationNames[i]);
+        }
+
+        fflush(stdout);
+    }
+
+    const Config              &mConfig;
+    std::vector<LoadClient *>  mClients;
+    size_t                     mNumStarted;
+    Statistics                 mStatistics[kNumOperations];
+    mbedtls_ssl_config         mSslConfig;
+    mbedtls_entropy_context    mEntropy;
+    mbedtls_ctr_drbg_context   mDrbg;
+};
+
+static void PrintUsage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s -k PSKc [-a address] [-p port] [-n clients] [-c connectRate] [-t seconds] [-w timeoutMs]\n"
+            "       [-K keepAliveRate] [-G datasetGetRate] [-R relayRate] [-d debugLevel]\n"
+            "\n"
+            "Runs a swarm of commissioners against a border agent. Each client handshakes, petitions, and then\n"
+            "sends keep-alive, active dataset get and relay requests at the given rates per second, 0 to disable.\n"
+            "Clients are started at connectRate per second, or all at once if 0. The latency, errors and throughput\n"
+            "of each operation are reported at the end. The PSKc in hex can be computed by\n"
+            "otbr-commissioner --compute-pskc.\n"
+            "\n"
+            "Defaults: -a %s -p %s -n %d -c 0 -t %d -w %d -K 1 -G 1 -R 1\n",
+            aProgram, kDefaultAddress, kDefaultPort, kDefaultClients, kDefaultDuration, kDefaultTimeout);
+}
+
+int main(int argc, char *argv[])
+{
+    Config config;
+    int    logLevel = OTBR_LOG_ERR;
+    bool   hasPSKc = false;
+    int    opt;
+    int    ret = EXIT_FAILURE;
+
+    config.mAddress = kDefaultAddress;
+    config.mPort = kDefaultPort;
+    config.mClients = kDefaultClients;
+    config.mConnectRate = 0;
+    config.mDuration = kDefaultDuration * 1000000UL;
+    config.mTimeout = kDefaultTimeout * 1000UL;
+    config.mRates[kOperationHandshake] = 0;
+    config.mRates[kOperationPetition] = 0;
+    config.mRates[kOperationKeepAlive] = 1;
+    config.mRates[kOperationDatasetGet] = 1;
+    config.mRates[kOperationRelay] = 1;
+
+    while ((opt = getopt(argc, argv, "a:c:d:G:k:K:n:p:R:t:w:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+            config.mAddress = optarg;
+            break;
+
+        case 'c':
+            config.mConnectRate = strtod(optarg, NULL);
+            break;
+
+        case 'd':
+            logLevel = atoi(optarg);
+            break;
+
+        case 'G':
+            config.mRates[kOperationDatasetGet] = strtod(optarg, NULL);
+            break;
+
+        case 'k':
+            VerifyOrExit(strlen(optarg) == kSizeOfPSKc * 2 &&
+                         Utils::Hex2Bytes(optarg, config.mPSKc, sizeof(config.mPSKc)) == kSizeOfPSKc,
+                         fprintf(stderr, "Invalid PSKc: %s\n", optarg));
+            hasPSKc = true;
+            break;
+
+        case 'K':
+            config.mRates[kOperationKeepAlive] = strtod(optarg, NULL);
+            break;
+
+        case 'n':
+            config.mClients = static_cast<unsigned>(strtoul(optarg, NULL, 0));
+            break;
+
+        case 'p':
+            config.mPort = optarg;
+            break;
+
+        case 'R':
+            config.mRates[kOperationRelay] = strtod(optarg, NULL);
+            break;
+
+        case 't':
+            config.mDuration = strtoul(optarg, NULL, 0) * 1000000UL;
+            break;
+
+        case 'w':
+            config.mTimeout = strtoul(optarg, NULL, 0) * 1000UL;
+            break;
+
+        default:
+            PrintUsage(argv[0]);
+            ExitNow();
+            break;
+        }
+    }
+
+    VerifyOrExit(hasPSKc && optind == argc, PrintUsage(argv[0]));
+    VerifyOrExit(config.mClients > 0 && config.mClients <= kMaxClients,
+                 fprintf(stderr, "Clients must be 1..%d\n", kMaxClients));
+    VerifyOrExit(config.mDuration > 0 && config.mTimeout > 0, PrintUsage(argv[0]));
+
+    otbrLogInit("otbr-commissioner-load", logLevel);
+
+    {
+        LoadGenerator generator(config);
+
+        VerifyOrExit(generator.Run() == 0);
+    }
+
+    ret = EXIT_SUCCESS;
+
+exit:
+    return ret;
+}
@@ -44,7 +44,7 @@ const char *CommissionerUtilsHexString(const uint8_t *pBytes, int n)
     }
 
 
-    Bytes2Hex(pBytes, n, buf);
+    Bytes2Hex(pBytes, static_cast<uint16_t>(n), buf, sizeof(buf));
     return buf;
 }
 
@@ -64,6 +64,21 @@ void TestRequestHandler(const Coap::Resource &aResource, const Coap::Message &aR
     (void)aContext;
 }
 
+void TestDeferredRequestHandler(const Coap::Resource &aResource, const Coap::Message &aRequest,
+                                Coap::Message &aResponse, const uint8_t *aIp6, uint16_t aPort, void *aContext)
+{
+    TestContext &context = *static_cast<TestContext *>(aContext);
+
+    // Leave the response empty to respond later.
+    context.mRequestHandled = true;
+
+    (void)aResource;
+    (void)aRequest;
+    (void)aResponse;
+    (void)aIp6;
+    (void)aPort;
+}
+
 void TestResponseHandler(const Coap::Message &aMessage, void *aContext)
 {
     TestContext &context = *static_cast<TestContext *>(aContext);
@@ -168,3 +183,200 @@ TEST(Coap, TestRequest)
 
     Coap::Agent::Destroy(agent);
 }
+
+static void InitTestContext(TestContext &aContext, Coap::Agent *aAgent)
+{
+    socklen_t sin6len = sizeof(aContext.mSockName);
+
+    aContext.mSocket = socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+    CHECK(aContext.mSocket != -1);
+    memset(&aContext.mSockName, 0, sizeof(aContext.mSockName));
+    aContext.mSockName.sin6_family = AF_INET6;
+    aContext.mSockName.sin6_addr = in6addr_any;
+    aContext.mSockName.sin6_port = 0;
+    CHECK_EQUAL(0, bind(aContext.mSocket,
+                        reinterpret_cast<struct sockaddr *>(&aContext.mSockName), sizeof(aContext.mSockName)));
+    getsockname(aContext.mSocket, reinterpret_cast<struct sockaddr *>(&aContext.mSockName), &sin6len);
+
+    aContext.mAgent = aAgent;
+    aContext.mRequestHandled = false;
+    aContext.mResponseHandled = false;
+}
+
+TEST(Coap, TestPiggybackedResponse)
+{
+    TestContext    context;
+    Coap::Resource resource("cool", TestDeferredRequestHandler, &context);
+    uint16_t       token = htons(2);
+    uint8_t        request[128];
+    uint8_t        buffer[128];
+    ssize_t        count;
+
+    agent = Coap::Agent::Create(TestNetworkSender, &context);
+    agent->SetAckDelay(1000);
+    InitTestContext(context, agent);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->AddResource(resource));
+
+    {
+        Coap::Message *message = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                                   reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+        message->SetPath("cool");
+        agent->Send(*message, NULL, 0, TestResponseHandler, &context);
+        agent->FreeMessage(message);
+    }
+
+    // Process request, the acknowledgment is held.
+    count = recvfrom(context.mSocket, request, sizeof(request), 0, NULL, NULL);
+    CHECK(count > 0);
+    agent->Input(request, static_cast<uint16_t>(count), NULL, 0);
+    CHECK_EQUAL(true, context.mRequestHandled);
+    CHECK_EQUAL(-1, recvfrom(context.mSocket, buffer, sizeof(buffer), MSG_DONTWAIT, NULL, NULL));
+
+    // Respond within the delay.
+    {
+        Coap::Message *message = agent->NewMessage(Coap::kTypeNonConfirmable, Coap::kCodeChanged,
+                                                   reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+        agent->Send(*message, NULL, 0, NULL, NULL);
+        agent->FreeMessage(message);
+    }
+
+    count = recvfrom(context.mSocket, buffer, sizeof(buffer), 0, NULL, NULL);
+    CHECK(count > 0);
+    CHECK_EQUAL(Coap::kTypeAcknowledgment, (buffer[0] >> 4) & 0x3);
+    CHECK_EQUAL(Coap::kCodeChanged, buffer[1]);
+    MEMCMP_EQUAL(request + 2, buffer + 2, 2);
+
+    agent->Input(buffer, static_cast<uint16_t>(count), NULL, 0);
+    CHECK_EQUAL(true, context.mResponseHandled);
+
+    CHECK_EQUAL(0, close(context.mSocket));
+
+    Coap::Agent::Destroy(agent);
+}
+
+TEST(Coap, TestHeldAckExpires)
+{
+    TestContext    context;
+    Coap::Resource resource("cool", TestDeferredRequestHandler, &context);
+    uint16_t       token = htons(3);
+    uint8_t        request[128];
+    uint8_t        buffer[128];
+    ssize_t        count;
+    fd_set         readFdSet;
+    fd_set         writeFdSet;
+    fd_set         errorFdSet;
+    int            maxFd = -1;
+    timeval        timeout = {10, 0};
+
+    agent = Coap::Agent::Create(TestNetworkSender, &context);
+    agent->SetAckDelay(10);
+    InitTestContext(context, agent);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, agent->AddResource(resource));
+
+    {
+        Coap::Message *message = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                                   reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+        message->SetPath("cool");
+        agent->Send(*message, NULL, 0, TestResponseHandler, &context);
+        agent->FreeMessage(message);
+    }
+
+    count = recvfrom(context.mSocket, request, sizeof(request), 0, NULL, NULL);
+    CHECK(count > 0);
+    agent->Input(request, static_cast<uint16_t>(count), NULL, 0);
+
+    FD_ZERO(&readFdSet);
+    FD_ZERO(&writeFdSet);
+    FD_ZERO(&errorFdSet);
+    agent->UpdateFdSet(readFdSet, writeFdSet, errorFdSet, maxFd, timeout);
+    CHECK(timeout.tv_sec == 0 && timeout.tv_usec <= 10000);
+
+    usleep(20000);
+    agent->Process(readFdSet, writeFdSet, errorFdSet);
+
+    // An empty acknowledgment is sent once the delay expires.
+    count = recvfrom(context.mSocket, buffer, sizeof(buffer), MSG_DONTWAIT, NULL, NULL);
+    CHECK_EQUAL(4, count);
+    CHECK_EQUAL(Coap::kTypeAcknowledgment, (buffer[0] >> 4) & 0x3);
+    CHECK_EQUAL(Coap::kCodeEmpty, buffer[1]);
+    MEMCMP_EQUAL(request + 2, buffer + 2, 2);
+
+    CHECK_EQUAL(0, close(context.mSocket));
+
+    Coap::Agent::Destroy(agent);
+}
+
+TEST(Coap, TestBlockOptions)
+{
+    uint16_t token = htons(4);
+    uint32_t number = 0;
+    bool     more = false;
+    uint16_t size = 0;
+    uint16_t length = 0;
+
+    agent = Coap::Agent::Create(NULL, NULL);
+
+    Coap::Message *message = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                               reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+    message->SetPath("c/as");
+    message->SetBlock(Coap::kBlock2, 0, false, Coap::kBlockSizeMin);
+    message->SetBlock(Coap::kBlock1, 0x1234, true, 2048);
+    message->SetPayload(reinterpret_cast<const uint8_t *>("block"), 5);
+
+    CHECK_TRUE(message->GetBlock(Coap::kBlock2, number, more, size));
+    CHECK_EQUAL(0, number);
+    CHECK_FALSE(more);
+    CHECK_EQUAL(Coap::kBlockSizeMin, size);
+
+    // Block sizes are capped to the largest one of RFC 7959.
+    CHECK_TRUE(message->GetBlock(Coap::kBlock1, number, more, size));
+    CHECK_EQUAL(0x1234, number);
+    CHECK_TRUE(more);
+    CHECK_EQUAL(Coap::kBlockSizeMax, size);
+
+    MEMCMP_EQUAL("block", message->GetPayload(length), 5);
+    CHECK_EQUAL(5, length);
+
+    agent->FreeMessage(message);
+
+    message = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost, NULL, 0);
+    CHECK_FALSE(message->GetBlock(Coap::kBlock1, number, more, size));
+    agent->FreeMessage(message);
+
+    Coap::Agent::Destroy(agent);
+}
+
+TEST(Coap, TestPayloadInPlace)
+{
+    uint16_t token = htons(5);
+    uint16_t size = 0;
+    uint16_t length = 0;
+    uint8_t *buffer;
+
+    agent = Coap::Agent::Create(NULL, NULL);
+
+    Coap::Message *message = agent->NewMessage(Coap::kTypeConfirmable, Coap::kCodePost,
+                                               reinterpret_cast<const uint8_t *>(&token), sizeof(token));
+
+    message->SetPath("c/tx");
+    buffer = message->GetPayloadBuffer(size);
+    CHECK_TRUE(size > 0);
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, message->SetPayloadLength(static_cast<uint16_t>(size + 1)));
+    memcpy(buffer, "in place", 8);
+    CHECK_EQUAL(OTBR_ERROR_NONE, message->SetPayloadLength(8));
+
+    MEMCMP_EQUAL("in place", message->GetPayload(length), 8);
+    CHECK_EQUAL(8, length);
+    POINTERS_EQUAL(buffer, message->GetPayload(length));
+
+    // The payload is set only once.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, message->SetPayloadLength(4));
+    message->GetPayload(length);
+    CHECK_EQUAL(8, length);
+
+    agent->FreeMessage(message);
+    Coap::Agent::Destroy(agent);
+}
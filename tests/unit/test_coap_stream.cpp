@@ -0,0 +1,141 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "agent/coap.hpp"
+#include "agent/coap_stream.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(StreamFramer)
+{
+};
+
+TEST(StreamFramer, TestRequest)
+{
+    Coap::StreamFramer framer;
+    // Len 5, TKL 2, POST, token, Uri-Path "c/cg" as two options.
+    const uint8_t      frame[] = {0x52, 0x02, 0xca, 0xfe, 0xb1, 'c', 0x02, 'c', 'g'};
+    uint8_t            message[64];
+
+    CHECK_EQUAL(0, framer.Next(message, sizeof(message)));
+
+    // Frames may be split in any way by the stream.
+    framer.Feed(frame, 3);
+    CHECK_EQUAL(0, framer.Next(message, sizeof(message)));
+    framer.Feed(frame + 3, sizeof(frame) - 3);
+
+    CHECK_EQUAL(11, framer.Next(message, sizeof(message)));
+    CHECK_EQUAL(0x42, message[0]);
+    CHECK_EQUAL(Coap::kCodePost, message[1]);
+    MEMCMP_EQUAL(frame + 2, message + 4, sizeof(frame) - 2);
+    CHECK_EQUAL(0, framer.Next(message, sizeof(message)));
+}
+
+TEST(StreamFramer, TestResponse)
+{
+    // Piggybacked 2.04 with a 300 bytes payload.
+    uint8_t message[4 + 1 + 1 + 300];
+    uint8_t frame[sizeof(message) + Coap::StreamFramer::kMaxSizeOfHeader];
+    uint8_t converted[sizeof(message)];
+    int     length;
+
+    memset(message, 0xab, sizeof(message));
+    message[0] = 0x61;
+    message[1] = Coap::kCodeChanged;
+    message[4] = 0x01;
+    message[5] = 0xff;
+
+    length = Coap::StreamFramer::Frame(message, sizeof(message), frame, sizeof(frame));
+    CHECK_EQUAL(1 + 2 + 1 + 1 + 301, length);
+    CHECK_EQUAL(0xe1, frame[0]);
+    CHECK_EQUAL(0, frame[1]);
+    CHECK_EQUAL(301 - 269, frame[2]);
+    CHECK_EQUAL(Coap::kCodeChanged, frame[3]);
+
+    {
+        Coap::StreamFramer framer;
+
+        framer.Feed(frame, static_cast<uint16_t>(length));
+        CHECK_EQUAL(sizeof(message), framer.Next(converted, sizeof(converted)));
+        CHECK_EQUAL(0x51, converted[0]);
+        MEMCMP_EQUAL(message + 4, converted + 4, sizeof(message) - 4);
+    }
+
+    CHECK_EQUAL(-1, Coap::StreamFramer::Frame(message, sizeof(message), frame, 100));
+}
+
+TEST(StreamFramer, TestEmptyAcknowledgment)
+{
+    const uint8_t ack[] = {0x60, 0x00, 0x12, 0x34};
+    uint8_t       frame[16];
+
+    CHECK_EQUAL(0, Coap::StreamFramer::Frame(ack, sizeof(ack), frame, sizeof(frame)));
+    CHECK_EQUAL(-1, Coap::StreamFramer::Frame(ack, 2, frame, sizeof(frame)));
+}
+
+TEST(StreamFramer, TestSignal)
+{
+    Coap::StreamFramer framer;
+    const uint8_t      token[] = {0x01, 0x02};
+    uint8_t            frame[8];
+    uint8_t            message[16];
+
+    CHECK_EQUAL(2, Coap::StreamFramer::Signal(Coap::StreamFramer::kCodeCsm, NULL, 0, frame));
+    CHECK_EQUAL(4, Coap::StreamFramer::Signal(Coap::StreamFramer::kCodePing, token, sizeof(token), frame));
+
+    framer.Feed(frame, 4);
+    CHECK_EQUAL(6, framer.Next(message, sizeof(message)));
+    CHECK_EQUAL(0x52, message[0]);
+    CHECK_EQUAL(Coap::StreamFramer::kCodePing, message[1]);
+    MEMCMP_EQUAL(token, message + 4, sizeof(token));
+}
+
+TEST(StreamFramer, TestMalformed)
+{
+    Coap::StreamFramer framer;
+    const uint8_t      badToken[] = {0x09, 0x02};
+    const uint8_t      tooLarge[] = {0xe0, 0xff, 0xff, 0x02};
+    uint8_t            message[16];
+
+    framer.Feed(badToken, sizeof(badToken));
+    CHECK_EQUAL(-1, framer.Next(message, sizeof(message)));
+    CHECK_EQUAL(EBADMSG, errno);
+
+    {
+        Coap::StreamFramer other;
+
+        other.Feed(tooLarge, sizeof(tooLarge));
+        CHECK_EQUAL(-1, other.Next(message, sizeof(message)));
+        CHECK_EQUAL(EMSGSIZE, errno);
+    }
+}
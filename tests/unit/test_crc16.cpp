@@ -0,0 +1,184 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "utils/crc16.hpp"
+#include "utils/steeringdata.hpp"
+
+using ot::Crc16;
+
+/**
+ * This function computes a CRC16 one bit at a time, as Crc16 did before its tables.
+ *
+ */
+static uint16_t ComputeBitwise(uint16_t aPolynomial, const uint8_t *aBuffer, size_t aLength)
+{
+    uint16_t crc = 0;
+
+    for (size_t i = 0; i < aLength; i++)
+    {
+        crc = crc ^ static_cast<uint16_t>(aBuffer[i] << 8);
+
+        for (int j = 0; j < 8; j++)
+        {
+            crc = (crc & 0x8000) ? (static_cast<uint16_t>(crc << 1) ^ aPolynomial) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+static void FillRandom(std::vector<uint8_t> &aBuffer)
+{
+    for (size_t i = 0; i < aBuffer.size(); i++)
+    {
+        aBuffer[i] = static_cast<uint8_t>(rand());
+    }
+}
+
+TEST_GROUP(Crc16)
+{
+};
+
+TEST(Crc16, TestCheckValues)
+{
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    Crc16         ccitt(Crc16::kCcitt);
+    Crc16         ansi(Crc16::kAnsi);
+
+    // CRC-16/XMODEM and CRC-16/UMTS.
+    ccitt.Update(check, sizeof(check));
+    ansi.Update(check, sizeof(check));
+    CHECK_EQUAL(0x31c3, ccitt.Get());
+    CHECK_EQUAL(0xfee8, ansi.Get());
+}
+
+TEST(Crc16, TestUpdateMatchesBitwise)
+{
+    std::vector<uint8_t> buffer(67);
+
+    srand(1);
+
+    for (int round = 0; round < 100; round++)
+    {
+        FillRandom(buffer);
+
+        for (size_t length = 0; length <= buffer.size(); length++)
+        {
+            Crc16 bytes(Crc16::kCcitt);
+            Crc16 slices(Crc16::kAnsi);
+            Crc16 split(Crc16::kCcitt);
+
+            for (size_t i = 0; i < length; i++)
+            {
+                bytes.Update(buffer[i]);
+            }
+
+            slices.Update(&buffer[0], length);
+            split.Update(&buffer[0], length / 3);
+            split.Update(&buffer[length / 3], length - length / 3);
+
+            CHECK_EQUAL(ComputeBitwise(Crc16::kCcitt, &buffer[0], length), bytes.Get());
+            CHECK_EQUAL(ComputeBitwise(Crc16::kAnsi, &buffer[0], length), slices.Get());
+            CHECK_EQUAL(ComputeBitwise(Crc16::kCcitt, &buffer[0], length), split.Get());
+        }
+    }
+}
+
+TEST(Crc16, TestComputeBlocksOnAllBackends)
+{
+    const Crc16::Backend backends[] = {Crc16::kBackendTable, Crc16::kBackendClmul, Crc16::kBackendPmull};
+    enum
+    {
+        kNumBlocks = 1000,
+    };
+    std::vector<uint8_t>  blocks(kNumBlocks * Crc16::kSizeOfBlock);
+    std::vector<uint16_t> ccitt(kNumBlocks);
+    std::vector<uint16_t> ansi(kNumBlocks);
+
+    srand(2);
+    FillRandom(blocks);
+
+    // The extremes of the carry-less reduction.
+    memset(&blocks[0], 0, Crc16::kSizeOfBlock);
+    memset(&blocks[Crc16::kSizeOfBlock], 0xff, Crc16::kSizeOfBlock);
+
+    for (size_t i = 0; i < sizeof(backends) / sizeof(backends[0]); i++)
+    {
+        if (!Crc16::IsSupported(backends[i]))
+        {
+            continue;
+        }
+
+        ccitt.assign(kNumBlocks, 0);
+        ansi.assign(kNumBlocks, 0);
+        Crc16::ComputeBlocks(&blocks[0], kNumBlocks, &ccitt[0], &ansi[0], backends[i]);
+
+        for (size_t j = 0; j < kNumBlocks; j++)
+        {
+            const uint8_t *block = &blocks[j * Crc16::kSizeOfBlock];
+
+            CHECK_EQUAL(ComputeBitwise(Crc16::kCcitt, block, Crc16::kSizeOfBlock), ccitt[j]);
+            CHECK_EQUAL(ComputeBitwise(Crc16::kAnsi, block, Crc16::kSizeOfBlock), ansi[j]);
+        }
+    }
+
+    CHECK(Crc16::IsSupported(Crc16::kBackendTable));
+    STRCMP_EQUAL("clmul", Crc16::BackendToString(Crc16::kBackendClmul));
+}
+
+TEST(Crc16, TestSteeringDataBatch)
+{
+    enum
+    {
+        kNumJoiners = 200,
+    };
+    std::vector<uint8_t> joinerIds(kNumJoiners * Crc16::kSizeOfBlock);
+    ot::SteeringData     expected;
+    ot::SteeringData     batch;
+
+    srand(3);
+    FillRandom(joinerIds);
+
+    expected.Init();
+    batch.Init();
+
+    for (size_t i = 0; i < kNumJoiners; i++)
+    {
+        expected.ComputeBloomFilter(&joinerIds[i * Crc16::kSizeOfBlock]);
+    }
+
+    batch.ComputeBloomFilter(&joinerIds[0], kNumJoiners);
+    MEMCMP_EQUAL(expected.GetDataPointer(), batch.GetDataPointer(), expected.GetLength());
+}
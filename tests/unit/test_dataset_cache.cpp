@@ -0,0 +1,190 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "agent/dataset_cache.hpp"
+#include "agent/uris.hpp"
+
+using namespace ot::BorderRouter;
+
+static const uint8_t kForwardToken[ForwardTable::kSizeOfToken] = {0x00, 0x01, 0x00, 0x00};
+
+static DatasetCache::Waiter MakeWaiter(uint8_t aToken)
+{
+    DatasetCache::Waiter waiter;
+
+    waiter.mSession = NULL;
+    waiter.mTokenLength = 1;
+    waiter.mToken[0] = aToken;
+
+    return waiter;
+}
+
+static DatasetCache::Response MakeResponse(uint8_t aCode, uint8_t aTimestamp)
+{
+    DatasetCache::Response response;
+    const uint8_t          payload[] = {14, 8, 0, 0, 0, 0, 0, 0, 0, aTimestamp};
+
+    response.mCode = aCode;
+    response.mPayload.assign(payload, payload + sizeof(payload));
+
+    return response;
+}
+
+TEST_GROUP(DatasetCache)
+{
+};
+
+TEST(DatasetCache, TestGetKey)
+{
+    const uint8_t get1[] = {13, 3, 14, 1, 1};
+    const uint8_t get2[] = {13, 2, 1, 14};
+    const uint8_t other[] = {11, 2, 0, 1};
+    const uint8_t truncated[] = {13, 4, 14, 1};
+    std::string   key1;
+    std::string   key2;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, get1, sizeof(get1), key1));
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, get2, sizeof(get2), key2));
+    CHECK(key1 == key2);
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_PENDING_GET, get2, sizeof(get2), key2));
+    CHECK(key1 != key2);
+
+    CHECK_FALSE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_SET, get1, sizeof(get1), key1));
+    CHECK_FALSE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, other, sizeof(other), key1));
+    CHECK_FALSE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, truncated, sizeof(truncated), key1));
+}
+
+TEST(DatasetCache, TestSingleFlight)
+{
+    DatasetCache                  cache;
+    std::string                   key;
+    const DatasetCache::Response *response = NULL;
+    DatasetCache::Waiters         waiters;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, NULL, 0, key));
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+    cache.Begin(key, kForwardToken);
+
+    CHECK_EQUAL(DatasetCache::kResultJoined, cache.Lookup(key, MakeWaiter(2), response));
+    CHECK_EQUAL(DatasetCache::kResultJoined, cache.Lookup(key, MakeWaiter(3), response));
+
+    cache.Complete(kForwardToken, sizeof(kForwardToken), MakeResponse(0x44, 1), waiters);
+    CHECK_EQUAL(2, waiters.size());
+    CHECK_EQUAL(2, waiters[0].mToken[0]);
+    CHECK_EQUAL(3, waiters[1].mToken[0]);
+
+    CHECK_EQUAL(DatasetCache::kResultHit, cache.Lookup(key, MakeWaiter(4), response));
+    CHECK(response != NULL);
+    CHECK_EQUAL(0x44, response->mCode);
+    CHECK_EQUAL(10, response->mPayload.size());
+}
+
+TEST(DatasetCache, TestErrorNotCached)
+{
+    DatasetCache                  cache;
+    std::string                   key;
+    const DatasetCache::Response *response = NULL;
+    DatasetCache::Waiters         waiters;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, NULL, 0, key));
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+    cache.Begin(key, kForwardToken);
+    cache.Complete(kForwardToken, sizeof(kForwardToken), MakeResponse(0xa3, 1), waiters);
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+}
+
+TEST(DatasetCache, TestBlockNotCached)
+{
+    DatasetCache                  cache;
+    std::string                   key;
+    const DatasetCache::Response *response = NULL;
+    DatasetCache::Response        block = MakeResponse(0x45, 1);
+    DatasetCache::Waiters         waiters;
+
+    block.mPartial = true;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, NULL, 0, key));
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+    cache.Begin(key, kForwardToken);
+    CHECK_EQUAL(DatasetCache::kResultJoined, cache.Lookup(key, MakeWaiter(2), response));
+    cache.Complete(kForwardToken, sizeof(kForwardToken), block, waiters);
+    CHECK_EQUAL(1, waiters.size());
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+}
+
+TEST(DatasetCache, TestInvalidate)
+{
+    DatasetCache                  cache;
+    std::string                   key;
+    const DatasetCache::Response *response = NULL;
+    DatasetCache::Waiters         waiters;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, NULL, 0, key));
+    cache.Begin(key, kForwardToken);
+    cache.Complete(kForwardToken, sizeof(kForwardToken), MakeResponse(0x44, 1), waiters);
+
+    cache.Invalidate(OT_URI_PATH_PENDING_GET);
+    CHECK_EQUAL(DatasetCache::kResultHit, cache.Lookup(key, MakeWaiter(1), response));
+    cache.Invalidate(OT_URI_PATH_ACTIVE_GET);
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+
+    // The response to a request in flight across a change is not cached.
+    cache.Begin(key, kForwardToken);
+    cache.Invalidate(NULL);
+    cache.Complete(kForwardToken, sizeof(kForwardToken), MakeResponse(0x44, 1), waiters);
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(key, MakeWaiter(1), response));
+}
+
+TEST(DatasetCache, TestTimestampChanged)
+{
+    DatasetCache                  cache;
+    const uint8_t                 get[] = {13, 1, 14};
+    const uint8_t                 token[ForwardTable::kSizeOfToken] = {0x00, 0x02, 0x00, 0x00};
+    std::string                   all;
+    std::string                   timestamp;
+    const DatasetCache::Response *response = NULL;
+    DatasetCache::Waiters         waiters;
+
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, NULL, 0, all));
+    CHECK_TRUE(DatasetCache::GetKey(OT_URI_PATH_ACTIVE_GET, get, sizeof(get), timestamp));
+
+    cache.Begin(all, kForwardToken);
+    cache.Complete(kForwardToken, sizeof(kForwardToken), MakeResponse(0x44, 1), waiters);
+    CHECK_EQUAL(DatasetCache::kResultHit, cache.Lookup(all, MakeWaiter(1), response));
+
+    // A newer active timestamp drops the response cached before.
+    cache.Begin(timestamp, token);
+    cache.Complete(token, sizeof(token), MakeResponse(0x44, 2), waiters);
+    CHECK_EQUAL(DatasetCache::kResultMiss, cache.Lookup(all, MakeWaiter(1), response));
+    CHECK_EQUAL(DatasetCache::kResultHit, cache.Lookup(timestamp, MakeWaiter(1), response));
+}
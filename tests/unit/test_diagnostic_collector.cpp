@@ -0,0 +1,212 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "agent/diagnostic_collector.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(DiagnosticCollector)
+{
+};
+
+TEST(DiagnosticCollector, TestHandleAnswer)
+{
+    DiagnosticCollector collector(NULL);
+    const uint8_t       answer[] = {
+        0, 8, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88,           // Extended MAC Address
+        1, 2, 0x04, 0x00,                                               // Address16
+        2, 1, 0x0f,                                                     // Mode
+        5, 11, 0x01, 0xc0, 0, 0, 0, 0, 0, 0, 0, 0x11, 0x11,             // Route64 of routers 0 and 1
+        16, 6, 0xf8, 0x01, 0x04, 0xf8, 0x02, 0x04,                      // Child Table of children 1 and 2
+        8, 16, 0xfd, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01,    // IPv6 Address List
+    };
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, collector.HandleAnswer(answer, sizeof(answer)));
+    CHECK_EQUAL(1, collector.GetNodes().size());
+
+    const DiagnosticCollector::Node &node = collector.GetNodes().begin()->second;
+
+    CHECK_EQUAL(0x0400, node.mRloc16);
+    MEMCMP_EQUAL(answer + 2, node.mExtAddress, sizeof(node.mExtAddress));
+    CHECK_EQUAL(0x0f, node.mMode);
+    CHECK_EQUAL(2, node.mRouterIds.size());
+    CHECK_EQUAL(0, node.mRouterIds[0]);
+    CHECK_EQUAL(1, node.mRouterIds[1]);
+    CHECK_EQUAL(2, node.mChildren.size());
+    CHECK_EQUAL(0x0401, node.mChildren[0]);
+    CHECK_EQUAL(0x0402, node.mChildren[1]);
+    CHECK_EQUAL(1, node.mAddresses.size());
+    CHECK_EQUAL(0xfd, node.mAddresses[0].m8[0]);
+
+    CHECK(collector.GetSnapshot().find("\"rloc16\":1024,\"extAddress\":\"1122334455667788\"") != std::string::npos);
+    CHECK(collector.GetSnapshot().find("\"addresses\":[\"fd00::1\"]") != std::string::npos);
+}
+
+TEST(DiagnosticCollector, TestIncrementalUpdate)
+{
+    DiagnosticCollector collector(NULL);
+    const uint8_t       first[] = {
+        1, 2, 0x08, 0x00, // Address16
+        2, 1, 0x0f,       // Mode
+    };
+    const uint8_t       second[] = {
+        1, 2, 0x08, 0x00,             // Address16
+        16, 3, 0xf8, 0x05, 0x04,      // Child Table
+    };
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, collector.HandleAnswer(first, sizeof(first)));
+    CHECK_EQUAL(OTBR_ERROR_NONE, collector.HandleAnswer(second, sizeof(second)));
+    CHECK_EQUAL(1, collector.GetNodes().size());
+
+    const DiagnosticCollector::Node &node = collector.GetNodes().begin()->second;
+
+    // Fields absent from an answer are kept.
+    CHECK_EQUAL(0x0f, node.mMode);
+    CHECK_EQUAL(1, node.mChildren.size());
+    CHECK_EQUAL(0x0805, node.mChildren[0]);
+}
+
+TEST(DiagnosticCollector, TestMalformedAnswer)
+{
+    DiagnosticCollector collector(NULL);
+    const uint8_t       noAddress16[] = {2, 1, 0x0f};
+    const uint8_t       truncated[] = {1, 2, 0x08, 0x00, 2, 4, 0x0f};
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, collector.HandleAnswer(noAddress16, sizeof(noAddress16)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, collector.HandleAnswer(truncated, sizeof(truncated)));
+    CHECK_EQUAL(0, collector.GetNodes().size());
+    STRCMP_EQUAL("{\"nodes\":[]}\n", collector.GetSnapshot().c_str());
+}
+
+static ssize_t DiscardSender(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
+                             void *aContext)
+{
+    (void)aBuffer;
+    (void)aIp6;
+    (void)aPort;
+    (void)aContext;
+
+    return aLength;
+}
+
+static int ConnectTo(const char *aPath)
+{
+    int                fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct sockaddr_un addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, aPath);
+    CHECK_EQUAL(0, connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+
+    return fd;
+}
+
+TEST(DiagnosticCollector, TestStalledClient)
+{
+    Coap::Agent *        coap = Coap::Agent::Create(DiscardSender);
+    DiagnosticCollector *collector = new DiagnosticCollector(coap);
+    char                 dir[] = "/tmp/otbr-diagnostic-XXXXXX";
+    char                 path[64];
+    uint8_t              answer[4 + 4 + 50 * 16];
+    std::string          received;
+    int                  stalled;
+    int                  reader;
+
+    CHECK(mkdtemp(dir) != NULL);
+    snprintf(path, sizeof(path), "%s/diag.sock", dir);
+
+    // Make the snapshot larger than what the socket buffers hold.
+    answer[4] = 8;
+    answer[5] = 0xff;
+    answer[6] = (50 * 16) >> 8;
+    answer[7] = (50 * 16) & 0xff;
+    memset(answer + 8, 0xfd, 50 * 16);
+
+    for (uint16_t rloc16 = 1; rloc16 <= 1000; ++rloc16)
+    {
+        answer[0] = 1;
+        answer[1] = 2;
+        answer[2] = static_cast<uint8_t>(rloc16 >> 8);
+        answer[3] = static_cast<uint8_t>(rloc16 & 0xff);
+        CHECK_EQUAL(OTBR_ERROR_NONE, collector->HandleAnswer(answer, sizeof(answer)));
+    }
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, collector->Start(path));
+    stalled = ConnectTo(path);
+    reader = ConnectTo(path);
+
+    while (true)
+    {
+        char    buffer[4096];
+        ssize_t count;
+        fd_set  readFdSet;
+        fd_set  writeFdSet;
+        int     maxFd = -1;
+        timeval timeout = {1, 0};
+
+        FD_ZERO(&readFdSet);
+        FD_ZERO(&writeFdSet);
+        collector->UpdateFdSet(readFdSet, writeFdSet, maxFd, timeout);
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 1000;
+        CHECK(select(maxFd + 1, &readFdSet, &writeFdSet, NULL, &timeout) >= 0);
+        collector->Process(readFdSet, writeFdSet);
+
+        while ((count = recv(reader, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0)
+        {
+            received.append(buffer, static_cast<size_t>(count));
+        }
+
+        if (count == 0)
+        {
+            break;
+        }
+    }
+
+    // The stalled client is still connected while the reader got the whole snapshot.
+    CHECK(received.size() > 1000000);
+    CHECK_EQUAL(0, received.find("{\"nodes\":[{\"rloc16\":1,"));
+    CHECK_EQUAL(received.size() - 3, received.rfind("]}\n"));
+
+    close(reader);
+    close(stalled);
+    delete collector;
+    Coap::Agent::Destroy(coap);
+    rmdir(dir);
+}
@@ -0,0 +1,375 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+
+#include "agent/dtls_mbedtls.hpp"
+#include "common/code_utils.hpp"
+
+using namespace ot::BorderRouter::Dtls;
+
+enum
+{
+    kPort             = 49191,
+    kMaxHandshakeTurn = 100,
+    kWriteLimit       = kMinIp6Mtu - kSizeOfUdp6Header, ///< A socket pair has no path MTU.
+};
+
+static const uint8_t kPSKc[] = {
+    0xc3, 0xf5, 0x93, 0x68, 0x44, 0x5a, 0x1b, 0x61, 0x06, 0xbe, 0x42, 0x0a, 0x70, 0x6d, 0x4c, 0xc9,
+};
+static const uint8_t kSeed[]         = "Coalescing";
+static const int     kCipherSuites[] = {MBEDTLS_TLS_ECJPAKE_WITH_AES_128_CCM_8, 0};
+
+/**
+ * This class implements the commissioner end of a DTLS connection.
+ *
+ */
+class Client
+{
+public:
+    Client(int aFd)
+    {
+        mbedtls_net_init(&mNet);
+        mbedtls_ssl_init(&mSsl);
+        mbedtls_ssl_config_init(&mConf);
+        mbedtls_entropy_init(&mEntropy);
+        mbedtls_ctr_drbg_init(&mDrbg);
+        mNet.fd = aFd;
+    }
+
+    ~Client(void)
+    {
+        mbedtls_net_free(&mNet);
+        mbedtls_ssl_free(&mSsl);
+        mbedtls_ssl_config_free(&mConf);
+        mbedtls_ctr_drbg_free(&mDrbg);
+        mbedtls_entropy_free(&mEntropy);
+    }
+
+    int Init(void)
+    {
+        int ret;
+
+        SuccessOrExit(ret = mbedtls_net_set_nonblock(&mNet));
+        SuccessOrExit(ret = mbedtls_ctr_drbg_seed(&mDrbg, mbedtls_entropy_func, &mEntropy, kSeed, sizeof(kSeed)));
+        SuccessOrExit(ret = mbedtls_ssl_config_defaults(&mConf, MBEDTLS_SSL_IS_CLIENT, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                                        MBEDTLS_SSL_PRESET_DEFAULT));
+        mbedtls_ssl_conf_rng(&mConf, mbedtls_ctr_drbg_random, &mDrbg);
+        mbedtls_ssl_conf_min_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_max_version(&mConf, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+        mbedtls_ssl_conf_authmode(&mConf, MBEDTLS_SSL_VERIFY_NONE);
+        mbedtls_ssl_conf_ciphersuites(&mConf, kCipherSuites);
+        SuccessOrExit(ret = mbedtls_ssl_setup(&mSsl, &mConf));
+        mbedtls_ssl_set_bio(&mSsl, &mNet, mbedtls_net_send, mbedtls_net_recv, NULL);
+        mbedtls_ssl_set_timer_cb(&mSsl, &mTimer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        ret = mbedtls_ssl_set_hs_ecjpake_password(&mSsl, kPSKc, sizeof(kPSKc));
+
+    exit:
+        return ret;
+    }
+
+    int Handshake(void) { return mbedtls_ssl_handshake(&mSsl); }
+
+    int Read(uint8_t *aBuffer, size_t aLength) { return mbedtls_ssl_read(&mSsl, aBuffer, aLength); }
+
+    /**
+     * This method returns the size of a record of @p aLength bytes of data.
+     *
+     */
+    int GetRecordSize(size_t aLength) { return static_cast<int>(aLength) + mbedtls_ssl_get_record_expansion(&mSsl); }
+
+private:
+    mbedtls_net_context          mNet;
+    mbedtls_ssl_context          mSsl;
+    mbedtls_ssl_config           mConf;
+    mbedtls_entropy_context      mEntropy;
+    mbedtls_ctr_drbg_context     mDrbg;
+    mbedtls_timing_delay_context mTimer;
+};
+
+/**
+ * This function returns the size of the next datagram on @p aFd without receiving it, -1 if there is none.
+ *
+ */
+static int PeekDatagram(int aFd)
+{
+    uint8_t datagram[kMaxSizeOfPacket];
+
+    return static_cast<int>(recv(aFd, datagram, sizeof(datagram), MSG_PEEK | MSG_DONTWAIT));
+}
+
+static void HandleData(Session &aSession, const uint8_t *aBuffer, uint16_t aLength, void *aContext)
+{
+    (void)aSession;
+    (void)aBuffer;
+    (void)aLength;
+    (void)aContext;
+}
+
+/**
+ * The client and the sessions are connected by two socket pairs, between which datagrams are forwarded by the
+ * test, so that the datagrams sent by a session are checked before the client receives them. Each session owns
+ * its socket pair, as a session shuts its socket down when destroyed.
+ *
+ */
+TEST_GROUP(DtlsCoalescing)
+{
+    MbedtlsServer  *mServer;
+    MbedtlsSession *mSession;
+    Client         *mClient;
+    int             mWireFd; ///< The end of the socket pair of the client.
+    int             mLinkFd; ///< The end of the socket pair of the session.
+
+    void setup()
+    {
+        int fds[2];
+
+        CHECK_EQUAL(0, socketpair(AF_UNIX, SOCK_DGRAM, 0, fds));
+
+        mWireFd = fds[1];
+        mClient = new Client(fds[0]);
+        CHECK_EQUAL(0, mClient->Init());
+
+        mServer = new MbedtlsServer(kPort, NULL, NULL, Server::kTransportDatagram);
+        mServer->SetCoalescing(true);
+        mServer->SetSocket(socket(AF_UNIX, SOCK_DGRAM, 0));
+        CHECK_EQUAL(OTBR_ERROR_NONE, mServer->SetSeed(kSeed, sizeof(kSeed)));
+        CHECK_EQUAL(OTBR_ERROR_NONE, mServer->SetPSK(kPSKc, sizeof(kPSKc)));
+        CHECK_EQUAL(OTBR_ERROR_NONE, mServer->Start());
+
+        mLinkFd = -1;
+        mSession = NULL;
+        NewSession();
+    }
+
+    void teardown()
+    {
+        delete mSession;
+        delete mServer;
+        delete mClient;
+        close(mWireFd);
+        close(mLinkFd);
+    }
+
+    /**
+     * This method creates a session of the server on a new socket pair.
+     *
+     */
+    void NewSession(void)
+    {
+        int                 fds[2];
+        mbedtls_net_context net;
+        sockaddr_in6        address;
+
+        delete mSession;
+        close(mLinkFd);
+
+        CHECK_EQUAL(0, socketpair(AF_UNIX, SOCK_DGRAM, 0, fds));
+        memset(&address, 0, sizeof(address));
+        address.sin6_family = AF_INET6;
+        net.fd = fds[0];
+        mLinkFd = fds[1];
+
+        mSession = new MbedtlsSession(*mServer, net, address, address);
+        CHECK_EQUAL(OTBR_ERROR_NONE, mSession->Init());
+        mSession->SetDataHandler(HandleData, NULL);
+    }
+
+    /**
+     * This method moves a datagram from @p aFrom to @p aTo.
+     *
+     * @returns The size of the datagram, -1 if there is none.
+     *
+     */
+    static int Move(int aFrom, int aTo)
+    {
+        uint8_t datagram[kMaxSizeOfPacket];
+        int     length = static_cast<int>(recv(aFrom, datagram, sizeof(datagram), MSG_DONTWAIT));
+
+        if (length > 0)
+        {
+            LONGS_EQUAL(length, send(aTo, datagram, static_cast<size_t>(length), 0));
+        }
+
+        return length;
+    }
+
+    /**
+     * This method forwards the next datagram sent by the session to the client.
+     *
+     */
+    void Forward(void) { CHECK(Move(mLinkFd, mWireFd) > 0); }
+
+    /**
+     * This method returns the size of the next datagram sent by the session, -1 if there is none.
+     *
+     */
+    int PeekSent(void) { return PeekDatagram(mLinkFd); }
+
+    /**
+     * This method performs the handshake without ever flushing the session.
+     *
+     */
+    void Connect(void)
+    {
+        int client = MBEDTLS_ERR_SSL_WANT_READ;
+
+        for (int turn = 0; turn < kMaxHandshakeTurn && (client != 0 || mSession->GetState() != Session::kStateReady);
+             turn++)
+        {
+            if (client == MBEDTLS_ERR_SSL_WANT_READ || client == MBEDTLS_ERR_SSL_WANT_WRITE)
+            {
+                client = mClient->Handshake();
+            }
+
+            while (Move(mWireFd, mLinkFd) > 0)
+            {
+                mSession->Process();
+
+                while (Move(mLinkFd, mWireFd) > 0)
+                {
+                }
+
+                // The session sending the hello verify request ends, the server creates another for the next hello.
+                if (mSession->GetState() == Session::kStateError)
+                {
+                    NewSession();
+                }
+            }
+        }
+
+        CHECK_EQUAL(0, client);
+        CHECK_EQUAL(Session::kStateReady, mSession->GetState());
+    }
+
+    void Write(size_t aLength)
+    {
+        uint8_t data[kMaxSizeOfPacket];
+
+        memset(data, static_cast<int>(aLength), aLength);
+        LONGS_EQUAL(aLength, mSession->Write(data, static_cast<uint16_t>(aLength)));
+    }
+
+    void CheckRead(size_t aLength)
+    {
+        uint8_t data[kMaxSizeOfPacket];
+
+        LONGS_EQUAL(aLength, mClient->Read(data, sizeof(data)));
+        BYTES_EQUAL(aLength, data[0]);
+    }
+};
+
+TEST(DtlsCoalescing, TestHandshakeBypassesCoalescing)
+{
+    // Handshake flights reach the client although the session is never flushed.
+    Connect();
+    CHECK(PeekSent() < 0);
+}
+
+TEST(DtlsCoalescing, TestRecordsHeldUntilFlush)
+{
+    Connect();
+
+    Write(100);
+    Write(120);
+    Write(140);
+    CHECK(PeekSent() < 0);
+
+    // The server flushes sessions before the mainloop blocks.
+    mSession->Flush();
+    LONGS_EQUAL(mClient->GetRecordSize(100) + mClient->GetRecordSize(120) + mClient->GetRecordSize(140), PeekSent());
+    Forward();
+    CheckRead(100);
+    CheckRead(120);
+    CheckRead(140);
+    CHECK(PeekSent() < 0);
+}
+
+TEST(DtlsCoalescing, TestDatagramSizeLimit)
+{
+    Connect();
+
+    CHECK(3 * mClient->GetRecordSize(500) > kWriteLimit);
+    CHECK(2 * mClient->GetRecordSize(500) <= kWriteLimit);
+
+    Write(500);
+    Write(500);
+    CHECK(PeekSent() < 0);
+
+    // The third record does not fit, the first two are sent in a datagram.
+    Write(500);
+    LONGS_EQUAL(2 * mClient->GetRecordSize(500), PeekSent());
+    Forward();
+    CheckRead(500);
+    CheckRead(500);
+    CHECK(PeekSent() < 0);
+
+    mSession->Flush();
+    LONGS_EQUAL(mClient->GetRecordSize(500), PeekSent());
+    Forward();
+    CheckRead(500);
+}
+
+TEST(DtlsCoalescing, TestOversizedRecordSentAlone)
+{
+    Connect();
+
+    CHECK(mClient->GetRecordSize(1300) > kWriteLimit);
+
+    // Records held are sent first, so that they are not reordered.
+    Write(100);
+    Write(1300);
+    LONGS_EQUAL(mClient->GetRecordSize(100), PeekSent());
+    Forward();
+    CheckRead(100);
+    LONGS_EQUAL(mClient->GetRecordSize(1300), PeekSent());
+    Forward();
+    CheckRead(1300);
+    CHECK(PeekSent() < 0);
+}
+
+TEST(DtlsCoalescing, TestCloseFlushes)
+{
+    uint8_t data[kMaxSizeOfPacket];
+
+    Connect();
+
+    // The close notify alert is sent with the records held.
+    Write(100);
+    mSession->Close();
+    LONGS_EQUAL(mClient->GetRecordSize(100) + mClient->GetRecordSize(2), PeekSent());
+    Forward();
+    CheckRead(100);
+    LONGS_EQUAL(MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY, mClient->Read(data, sizeof(data)));
+}
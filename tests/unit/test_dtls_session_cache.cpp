@@ -0,0 +1,167 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+
+#include "agent/dtls_session_cache.hpp"
+
+using namespace ot::BorderRouter::Dtls;
+
+static SessionCache::Entry MakeEntry(uint8_t aId)
+{
+    SessionCache::Entry entry;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.mIdLength = SessionCache::kMaxSizeOfId;
+    memset(entry.mId, aId, sizeof(entry.mId));
+    memset(entry.mMaster, aId ^ 0xff, sizeof(entry.mMaster));
+    entry.mCiphersuite = 0xc0ff;
+
+    return entry;
+}
+
+TEST_GROUP(SessionCache)
+{
+};
+
+TEST(SessionCache, TestStoreAndFind)
+{
+    SessionCache               cache;
+    SessionCache::Entry        entry = MakeEntry(1);
+    const SessionCache::Entry *found = NULL;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(NULL));
+    CHECK(cache.Find(entry.mId, entry.mIdLength) == NULL);
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(entry));
+
+    found = cache.Find(entry.mId, entry.mIdLength);
+    CHECK(found != NULL);
+    MEMCMP_EQUAL(entry.mMaster, found->mMaster, sizeof(entry.mMaster));
+    CHECK_EQUAL(entry.mCiphersuite, found->mCiphersuite);
+
+    cache.Clear();
+    CHECK(cache.Find(entry.mId, entry.mIdLength) == NULL);
+}
+
+TEST(SessionCache, TestExpiration)
+{
+    SessionCache        cache(4, 0);
+    SessionCache::Entry entry = MakeEntry(1);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(NULL));
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(entry));
+    CHECK(cache.Find(entry.mId, entry.mIdLength) == NULL);
+}
+
+TEST(SessionCache, TestEviction)
+{
+    SessionCache        cache(2);
+    SessionCache::Entry first = MakeEntry(1);
+    SessionCache::Entry second = MakeEntry(2);
+    SessionCache::Entry third = MakeEntry(3);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(NULL));
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(first));
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(second));
+    // Storing the same session again must not take another entry.
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(second));
+    CHECK(cache.Find(first.mId, first.mIdLength) != NULL);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(third));
+    CHECK(cache.Find(third.mId, third.mIdLength) != NULL);
+    CHECK_EQUAL(1, (cache.Find(first.mId, first.mIdLength) != NULL) +
+                (cache.Find(second.mId, second.mIdLength) != NULL));
+}
+
+TEST(SessionCache, TestPersistence)
+{
+    char                path[] = "/tmp/otbr-session-cache-XXXXXX";
+    int                 fd = mkstemp(path);
+    const uint8_t       psk[] = {0x00, 0x01, 0x02, 0x03};
+    const uint8_t       otherPsk[] = {0x03, 0x02, 0x01, 0x00};
+    SessionCache::Entry entry = MakeEntry(1);
+
+    CHECK(fd != -1);
+    close(fd);
+
+    {
+        SessionCache cache;
+
+        cache.SetPSK(psk, sizeof(psk));
+        CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(path));
+        CHECK_EQUAL(OTBR_ERROR_NONE, cache.Store(entry));
+    }
+
+    {
+        SessionCache cache;
+
+        CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(path));
+        cache.SetPSK(psk, sizeof(psk));
+        CHECK(cache.Find(entry.mId, entry.mIdLength) != NULL);
+
+        cache.SetPSK(otherPsk, sizeof(otherPsk));
+        CHECK(cache.Find(entry.mId, entry.mIdLength) == NULL);
+    }
+
+    unlink(path);
+}
+
+TEST(SessionCache, TestRefusesUnsafeFile)
+{
+    char         path[] = "/tmp/otbr-session-cache-XXXXXX";
+    char         link[sizeof(path) + 5];
+    int          fd = mkstemp(path);
+    SessionCache cache;
+
+    CHECK(fd != -1);
+    close(fd);
+
+    // Other users could read the master secrets.
+    CHECK_EQUAL(0, chmod(path, 0644));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Init(path));
+    CHECK_EQUAL(EPERM, errno);
+
+    // A link could point the cache at any file of this user.
+    CHECK_EQUAL(0, chmod(path, 0600));
+    snprintf(link, sizeof(link), "%s.link", path);
+    CHECK_EQUAL(0, symlink(path, link));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Init(link));
+    CHECK_EQUAL(ELOOP, errno);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Init(path));
+
+    unlink(link);
+    unlink(path);
+}
@@ -0,0 +1,110 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "agent/energy_summary.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(EnergySummary)
+{
+};
+
+TEST(EnergySummary, TestMerge)
+{
+    EnergySummary        summary;
+    std::vector<uint8_t> payload;
+    // Channels 11 and 12, two scans each.
+    const uint8_t        first[] = {53, 6, 0, 4, 0x00, 0x18, 0x00, 0x00, 57, 4, 0xb0, 0xc0, 0xb8, 0xa0};
+    // Channel 12 and 26, one scan.
+    const uint8_t        second[] = {53, 6, 0, 4, 0x00, 0x08, 0x00, 0x20, 57, 2, 0xd0, 0xa8};
+    const uint8_t        expected[] = {53, 6, 0, 4, 0x00, 0x18, 0x00, 0x20, 57, 3, 0xb8, 0xd0, 0xa8};
+
+    CHECK_FALSE(summary.IsUpdated());
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(first, sizeof(first)));
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(second, sizeof(second)));
+    CHECK_TRUE(summary.IsUpdated());
+
+    CHECK_EQUAL(-72, summary.GetEnergy(11));
+    CHECK_EQUAL(-48, summary.GetEnergy(12));
+    CHECK_EQUAL(-88, summary.GetEnergy(26));
+    CHECK_EQUAL(-128, summary.GetEnergy(13));
+
+    summary.Flush(payload);
+    CHECK_EQUAL(sizeof(expected), payload.size());
+    MEMCMP_EQUAL(expected, &payload[0], sizeof(expected));
+    CHECK_FALSE(summary.IsUpdated());
+}
+
+TEST(EnergySummary, TestFlushUpdatedOnly)
+{
+    EnergySummary        summary;
+    std::vector<uint8_t> payload;
+    const uint8_t        report[] = {53, 6, 0, 4, 0x00, 0x10, 0x00, 0x00, 57, 1, 0xc0};
+    const uint8_t        lower[] = {53, 6, 0, 4, 0x00, 0x10, 0x00, 0x00, 57, 1, 0xa0};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(report, sizeof(report)));
+    summary.Flush(payload);
+    CHECK_EQUAL(sizeof(report), payload.size());
+
+    // A lower energy does not change the summary.
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(lower, sizeof(lower)));
+    CHECK_FALSE(summary.IsUpdated());
+    summary.Flush(payload);
+    CHECK_TRUE(payload.empty());
+
+    summary.Reset();
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(lower, sizeof(lower)));
+    CHECK_TRUE(summary.IsUpdated());
+    CHECK_EQUAL(-96, summary.GetEnergy(11));
+}
+
+TEST(EnergySummary, TestMalformed)
+{
+    EnergySummary summary;
+    const uint8_t noMask[] = {57, 1, 0xc0};
+    const uint8_t truncated[] = {53, 6, 0, 4, 0x00, 0x10, 0x00, 0x00, 57, 2, 0xc0};
+    const uint8_t badEntry[] = {53, 3, 0, 4, 0x00, 57, 1, 0xc0};
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, summary.Merge(noMask, sizeof(noMask)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, summary.Merge(truncated, sizeof(truncated)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, summary.Merge(badEntry, sizeof(badEntry)));
+    CHECK_FALSE(summary.IsUpdated());
+}
+
+TEST(EnergySummary, TestRepeatedMaskEntries)
+{
+    EnergySummary summary;
+    // Two page 0 entries of all channels.
+    const uint8_t report[] = {53, 12, 0, 4, 0xff, 0xff, 0xff, 0xff, 0, 4, 0xff, 0xff, 0xff, 0xff, 57, 1, 0xc0};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, summary.Merge(report, sizeof(report)));
+    CHECK_EQUAL(-64, summary.GetEnergy(0));
+    CHECK_EQUAL(-128, summary.GetEnergy(1));
+}
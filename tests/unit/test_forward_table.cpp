@@ -0,0 +1,120 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+#include <unistd.h>
+
+#include "agent/forward_table.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(ForwardTable)
+{
+};
+
+TEST(ForwardTable, TestAddAndRemove)
+{
+    ForwardTable        table;
+    Dtls::Session      *session = reinterpret_cast<Dtls::Session *>(&table);
+    const uint8_t       token[] = {0xde, 0xad, 0xbe, 0xef, 0x01};
+    uint8_t             first[ForwardTable::kSizeOfToken];
+    uint8_t             second[ForwardTable::kSizeOfToken];
+    ForwardTable::Entry entry;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), first));
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), second));
+    CHECK(memcmp(first, second, sizeof(first)));
+    CHECK_EQUAL(2, table.GetSize());
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Remove(second, sizeof(second), entry));
+    POINTERS_EQUAL(session, entry.mSession);
+    CHECK_EQUAL(sizeof(token), entry.mTokenLength);
+    MEMCMP_EQUAL(token, entry.mToken, sizeof(token));
+
+    // A response is routed only once.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, table.Remove(second, sizeof(second), entry));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, table.Remove(token, sizeof(token), entry));
+    CHECK_EQUAL(1, table.GetSize());
+}
+
+TEST(ForwardTable, TestStaleToken)
+{
+    ForwardTable        table(1);
+    Dtls::Session      *session = reinterpret_cast<Dtls::Session *>(&table);
+    const uint8_t       token[] = {0x01};
+    uint8_t             stale[ForwardTable::kSizeOfToken];
+    uint8_t             fresh[ForwardTable::kSizeOfToken];
+    ForwardTable::Entry entry;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), stale));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, table.Add(session, "c/ag", token, sizeof(token), fresh));
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Remove(stale, sizeof(stale), entry));
+
+    // The entry is reused with a new token.
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), fresh));
+    CHECK(memcmp(stale, fresh, sizeof(stale)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, table.Remove(stale, sizeof(stale), entry));
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Remove(fresh, sizeof(fresh), entry));
+}
+
+TEST(ForwardTable, TestRemoveSession)
+{
+    ForwardTable        table;
+    int                 dummy[2];
+    Dtls::Session      *first = reinterpret_cast<Dtls::Session *>(&dummy[0]);
+    Dtls::Session      *second = reinterpret_cast<Dtls::Session *>(&dummy[1]);
+    const uint8_t       token[] = {0x01, 0x02};
+    uint8_t             forwardToken[ForwardTable::kSizeOfToken];
+    ForwardTable::Entry entry;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(first, "c/ag", token, sizeof(token), forwardToken));
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(first, "c/ag", token, sizeof(token), forwardToken));
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(second, "c/ag", token, sizeof(token), forwardToken));
+
+    table.Remove(first);
+    CHECK_EQUAL(1, table.GetSize());
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Remove(forwardToken, sizeof(forwardToken), entry));
+    POINTERS_EQUAL(second, entry.mSession);
+}
+
+TEST(ForwardTable, TestExpiration)
+{
+    ForwardTable   table(1, 0);
+    Dtls::Session *session = reinterpret_cast<Dtls::Session *>(&table);
+    const uint8_t  token[] = {0x01};
+    uint8_t        forwardToken[ForwardTable::kSizeOfToken];
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), forwardToken));
+    usleep(1000);
+
+    // Expired requests are reclaimed when the table is full.
+    CHECK_EQUAL(OTBR_ERROR_NONE, table.Add(session, "c/ag", token, sizeof(token), forwardToken));
+    CHECK_EQUAL(1, table.GetSize());
+}
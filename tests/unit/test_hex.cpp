@@ -0,0 +1,128 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <vector>
+
+#include "utils/hex.hpp"
+
+using namespace ot::Utils;
+
+TEST_GROUP(Hex)
+{
+};
+
+TEST(Hex, TestRoundTrip)
+{
+    std::vector<uint8_t> bytes(100);
+    std::vector<uint8_t> decoded(100);
+    std::vector<char>    hex(2 * 100 + 1);
+    char                 expected[2 * 100 + 1];
+
+    srand(1);
+
+    for (size_t length = 0; length <= bytes.size(); length++)
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            bytes[i] = static_cast<uint8_t>(rand());
+            snprintf(&expected[2 * i], 3, "%02X", bytes[i]);
+        }
+
+        expected[2 * length] = '\0';
+
+        CHECK_EQUAL(static_cast<int>(2 * length),
+                    Bytes2Hex(&bytes[0], static_cast<uint16_t>(length), &hex[0], 2 * length + 1));
+        STRCMP_EQUAL(expected, &hex[0]);
+        CHECK_EQUAL(static_cast<int>(length), Hex2Bytes(&hex[0], &decoded[0], static_cast<uint16_t>(length)));
+        MEMCMP_EQUAL(&bytes[0], &decoded[0], length);
+
+        // Lower case.
+        for (size_t i = 0; i < 2 * length; i++)
+        {
+            hex[i] = static_cast<char>(tolower(hex[i]));
+        }
+
+        CHECK_EQUAL(static_cast<int>(length),
+                    Hex2Bytes(&hex[0], 2 * length, &decoded[0], static_cast<uint16_t>(length)));
+        MEMCMP_EQUAL(&bytes[0], &decoded[0], length);
+    }
+}
+
+TEST(Hex, TestInvalidChars)
+{
+    const char invalid[] = {'/', ':', '@', 'G', '`', 'g', ' ', '\x80', '\xc1', '\xe6'};
+    char       hex[2 * 40 + 1];
+    uint8_t    bytes[40];
+
+    // Every position of the vector and scalar paths.
+    for (size_t position = 0; position < 2 * sizeof(bytes); position++)
+    {
+        for (size_t i = 0; i < sizeof(invalid); i++)
+        {
+            memset(hex, 'a', sizeof(hex) - 1);
+            hex[sizeof(hex) - 1] = '\0';
+            hex[position] = invalid[i];
+            CHECK_EQUAL(-1, Hex2Bytes(hex, bytes, sizeof(bytes)));
+        }
+    }
+}
+
+TEST(Hex, TestOddLengthAndBounds)
+{
+    uint8_t bytes[3];
+    char    hex[5];
+
+    CHECK_EQUAL(2, Hex2Bytes("abc", bytes, sizeof(bytes)));
+    CHECK_EQUAL(0x0a, bytes[0]);
+    CHECK_EQUAL(0xbc, bytes[1]);
+    CHECK_EQUAL(-1, Hex2Bytes("0102030", bytes, sizeof(bytes)));
+    CHECK_EQUAL(0, Hex2Bytes("", bytes, sizeof(bytes)));
+
+    bytes[0] = 0xde;
+    bytes[1] = 0xad;
+    CHECK_EQUAL(4, Bytes2Hex(bytes, 2, hex, sizeof(hex)));
+    STRCMP_EQUAL("DEAD", hex);
+    CHECK_EQUAL(-1, Bytes2Hex(bytes, 3, hex, sizeof(hex)));
+}
+
+TEST(Hex, TestLong2Hex)
+{
+    char hex[17];
+
+    // Least significant byte first.
+    CHECK_EQUAL(16, Long2Hex(0x0011223344556677ULL, hex));
+    STRCMP_EQUAL("7766554433221100", hex);
+    CHECK_EQUAL(-1, Long2Hex(0, hex, sizeof(hex) - 1));
+}
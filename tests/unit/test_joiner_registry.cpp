@@ -0,0 +1,233 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "agent/joiner_registry.hpp"
+
+using namespace ot::BorderRouter;
+
+static void MakeJoinerId(uint32_t aIndex, uint8_t *aJoinerId)
+{
+    JoinerRegistry::ComputeJoinerId(aIndex, 32, aJoinerId);
+}
+
+static void CheckSteeringData(const JoinerRegistry &aRegistry, uint32_t aFirst, uint32_t aLast)
+{
+    ot::SteeringData expected;
+    uint8_t          joinerId[JoinerRegistry::kSizeOfJoinerId];
+
+    expected.SetLength(aRegistry.GetSteeringData().GetLength());
+    expected.Clear();
+
+    for (uint32_t i = aFirst; i < aLast; i++)
+    {
+        MakeJoinerId(i, joinerId);
+        expected.ComputeBloomFilter(joinerId);
+    }
+
+    CHECK_EQUAL(expected.GetLength(), aRegistry.GetSteeringData().GetLength());
+    MEMCMP_EQUAL(expected.GetDataPointer(), aRegistry.GetSteeringData().GetDataPointer(), expected.GetLength());
+}
+
+TEST_GROUP(JoinerRegistry)
+{
+};
+
+TEST(JoinerRegistry, TestComputeJoinerId)
+{
+    const uint8_t eui64[] = {0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x01};
+    const uint8_t expectedEui64[] = {0xcf, 0xe0, 0xd8, 0xdd, 0x4e, 0xfc, 0x29, 0x73};
+    const uint8_t expectedDiscerner[] = {0x7e, 0x28, 0x1a, 0x1f, 0xed, 0x34, 0x5b, 0x6c};
+    uint8_t       joinerId[JoinerRegistry::kSizeOfJoinerId];
+
+    JoinerRegistry::ComputeJoinerId(eui64, joinerId);
+    MEMCMP_EQUAL(expectedEui64, joinerId, sizeof(joinerId));
+
+    // Bits beyond the length of the discerner are ignored.
+    JoinerRegistry::ComputeJoinerId(0xfabc, 12, joinerId);
+    MEMCMP_EQUAL(expectedDiscerner, joinerId, sizeof(joinerId));
+}
+
+TEST(JoinerRegistry, TestAddAndRemove)
+{
+    JoinerRegistry registry;
+    uint8_t        first[JoinerRegistry::kSizeOfJoinerId];
+    uint8_t        second[JoinerRegistry::kSizeOfJoinerId];
+
+    MakeJoinerId(1, first);
+    MakeJoinerId(2, second);
+
+    CHECK(registry.GetSteeringData().IsCleared());
+    CHECK(!registry.IsSteeringDataChanged());
+    POINTERS_EQUAL(NULL, registry.FindPskd(first));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(first, "J01NME", 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(second, "J01NU5", 0));
+    CHECK_EQUAL(2, registry.GetSize());
+    CHECK(registry.IsSteeringDataChanged());
+    CheckSteeringData(registry, 1, 3);
+    STRCMP_EQUAL("J01NME", registry.FindPskd(first));
+
+    // Updating the PSKd leaves the steering data.
+    registry.HandleSteeringDataSent();
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(first, "J01NME2", 0));
+    STRCMP_EQUAL("J01NME2", registry.FindPskd(first));
+    CHECK(!registry.IsSteeringDataChanged());
+    CHECK_EQUAL(2, registry.GetSize());
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Remove(first));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, registry.Remove(first));
+    POINTERS_EQUAL(NULL, registry.FindPskd(first));
+    CheckSteeringData(registry, 2, 3);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Remove(second));
+    CHECK_EQUAL(0, registry.GetSize());
+    CHECK(registry.IsSteeringDataChanged());
+    CHECK(registry.GetSteeringData().IsCleared());
+
+    // PSKd is 6 to 32 characters.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, registry.Add(first, "J01NM", 0));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, registry.Add(first, "J01NME0123456789ABCDEFGHJKLMNPRST", 0));
+}
+
+TEST(JoinerRegistry, TestChangedOnlyWhenBitsFlip)
+{
+    JoinerRegistry registry(1);
+    uint8_t        joinerId[JoinerRegistry::kSizeOfJoinerId];
+    uint32_t       i;
+
+    // With 8 bits, all bits are set well before 64 joiners.
+    for (i = 0; i < 64; i++)
+    {
+        MakeJoinerId(i, joinerId);
+        CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(joinerId, "J01NME", 0));
+    }
+
+    CHECK(registry.IsSteeringDataChanged());
+    registry.HandleSteeringDataSent();
+
+    for (i = 0; i < 32; i++)
+    {
+        MakeJoinerId(i, joinerId);
+        CHECK_EQUAL(OTBR_ERROR_NONE, registry.Remove(joinerId));
+        CheckSteeringData(registry, i + 1, 64);
+    }
+
+    CHECK(!registry.IsSteeringDataChanged());
+
+    registry.SetSteeringLength(JoinerRegistry::kMaxSteeringLength);
+    CHECK(registry.IsSteeringDataChanged());
+    CheckSteeringData(registry, 32, 64);
+}
+
+TEST(JoinerRegistry, TestExpire)
+{
+    JoinerRegistry registry;
+    uint8_t        first[JoinerRegistry::kSizeOfJoinerId];
+    uint8_t        second[JoinerRegistry::kSizeOfJoinerId];
+    uint8_t        third[JoinerRegistry::kSizeOfJoinerId];
+    unsigned long  expiration = 0;
+
+    MakeJoinerId(1, first);
+    MakeJoinerId(2, second);
+    MakeJoinerId(3, third);
+
+    CHECK(!registry.GetNextExpiration(expiration));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(first, "J01NME", 2000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(second, "J01NME", 1000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(third, "J01NME", 0));
+    CHECK(registry.GetNextExpiration(expiration));
+    CHECK_EQUAL(1000, expiration);
+
+    // Adding again renews the expiration.
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(second, "J01NME", 3000));
+    CHECK(registry.GetNextExpiration(expiration));
+    CHECK_EQUAL(2000, expiration);
+
+    CHECK_EQUAL(0, registry.Expire(1999));
+    CHECK_EQUAL(1, registry.Expire(2000));
+    POINTERS_EQUAL(NULL, registry.FindPskd(first));
+    CHECK_EQUAL(1, registry.Expire(5000));
+    CHECK(!registry.GetNextExpiration(expiration));
+    CHECK_EQUAL(1, registry.GetSize());
+    CheckSteeringData(registry, 3, 4);
+
+    registry.Clear();
+    CHECK_EQUAL(0, registry.GetSize());
+    CHECK_EQUAL(0, registry.Expire(5000));
+}
+
+TEST(JoinerRegistry, TestExpireAcrossWrap)
+{
+    JoinerRegistry registry;
+    uint8_t        first[JoinerRegistry::kSizeOfJoinerId];
+    uint8_t        second[JoinerRegistry::kSizeOfJoinerId];
+    unsigned long  now = static_cast<unsigned long>(-500);
+    unsigned long  expiration = 0;
+
+    MakeJoinerId(1, first);
+    MakeJoinerId(2, second);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(first, "J01NME", now + 1000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(second, "J01NME", now + 200));
+    CHECK(registry.GetNextExpiration(expiration));
+    CHECK_EQUAL(now + 200, expiration);
+
+    CHECK_EQUAL(0, registry.Expire(now));
+    CHECK_EQUAL(1, registry.Expire(now + 200));
+    POINTERS_EQUAL(NULL, registry.FindPskd(second));
+    CHECK_EQUAL(0, registry.Expire(now + 999));
+    CHECK_EQUAL(1, registry.Expire(now + 1000));
+    CHECK_EQUAL(0, registry.GetSize());
+}
+
+TEST(JoinerRegistry, TestManyJoiners)
+{
+    enum
+    {
+        kNumJoiners = 20000,
+    };
+
+    JoinerRegistry registry;
+    uint8_t        joinerId[JoinerRegistry::kSizeOfJoinerId];
+
+    for (uint32_t i = 0; i < kNumJoiners; i++)
+    {
+        MakeJoinerId(i, joinerId);
+        CHECK_EQUAL(OTBR_ERROR_NONE, registry.Add(joinerId, "J01NME", i + 1));
+    }
+
+    CHECK_EQUAL(kNumJoiners, registry.GetSize());
+    CheckSteeringData(registry, 0, kNumJoiners);
+
+    CHECK_EQUAL(kNumJoiners - 10, registry.Expire(kNumJoiners - 10));
+    CheckSteeringData(registry, kNumJoiners - 10, kNumJoiners);
+}
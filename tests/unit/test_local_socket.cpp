@@ -0,0 +1,98 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "agent/local_socket.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(LocalSocket)
+{
+};
+
+TEST(LocalSocket, TestPrivateSocket)
+{
+    char               dir[] = "/tmp/otbr-local-socket-XXXXXX";
+    char               path[64];
+    int                listener;
+    int                client;
+    int                peer;
+    struct stat        st;
+    struct sockaddr_un addr;
+
+    CHECK(mkdtemp(dir) != NULL);
+    snprintf(path, sizeof(path), "%s/test.sock", dir);
+
+    listener = ListenLocal(path, 1);
+    CHECK(listener != -1);
+    CHECK_EQUAL(0, stat(path, &st));
+    CHECK(S_ISSOCK(st.st_mode));
+    LONGS_EQUAL(S_IRUSR | S_IWUSR, st.st_mode & (S_IRWXU | S_IRWXG | S_IRWXO));
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    client = socket(AF_UNIX, SOCK_STREAM, 0);
+    CHECK_EQUAL(0, connect(client, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)));
+    peer = accept(listener, NULL, NULL);
+    CHECK(peer != -1);
+    CHECK(IsTrustedPeer(peer));
+    CHECK(IsTrustedPeer(client));
+
+    close(peer);
+    close(client);
+    close(listener);
+    unlink(path);
+    rmdir(dir);
+}
+
+TEST(LocalSocket, TestRefusesUnsafeDirectory)
+{
+    char dir[] = "/tmp/otbr-local-socket-XXXXXX";
+    char path[64];
+
+    CHECK(mkdtemp(dir) != NULL);
+    snprintf(path, sizeof(path), "%s/test.sock", dir);
+
+    CHECK_EQUAL(0, chmod(dir, 0777));
+    CHECK_EQUAL(-1, ListenLocal(path, 1));
+    CHECK_EQUAL(EPERM, errno);
+    CHECK_EQUAL(-1, access(path, F_OK));
+
+    rmdir(dir);
+}
@@ -0,0 +1,103 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <string.h>
+
+#include "agent/observer_registry.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(ObserverRegistry)
+{
+};
+
+TEST(ObserverRegistry, TestRegister)
+{
+    ObserverRegistry            registry;
+    Dtls::Session              *session = reinterpret_cast<Dtls::Session *>(&registry);
+    const uint8_t               token[] = {0x01, 0x02};
+    const uint8_t               payload[] = {0x0d, 0x01, 0x00};
+    ObserverRegistry::Observers observers;
+    uint32_t                    sequence = 0;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(session, "c/ag", token, sizeof(token), payload, sizeof(payload)));
+    // Registering again with the same token updates the observer.
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(session, "c/ag", token, sizeof(token), NULL, 0));
+    CHECK_EQUAL(1, registry.GetSize());
+
+    registry.GetObservers("c/ag", observers);
+    CHECK_EQUAL(1, observers.size());
+    POINTERS_EQUAL(session, observers[0].mSession);
+    CHECK(observers[0].mPayload.empty());
+    MEMCMP_EQUAL(token, observers[0].mToken, sizeof(token));
+
+    registry.GetObservers("c/pg", observers);
+    CHECK(observers.empty());
+
+    CHECK(registry.Notify(session, token, sizeof(token), sequence));
+    CHECK_EQUAL(1, sequence);
+    CHECK(registry.Notify(session, token, sizeof(token), sequence));
+    CHECK_EQUAL(2, sequence);
+    CHECK(!registry.Notify(session, token, 1, sequence));
+
+    registry.Deregister(session, token, sizeof(token));
+    CHECK_EQUAL(0, registry.GetSize());
+    CHECK(!registry.Notify(session, token, sizeof(token), sequence));
+}
+
+TEST(ObserverRegistry, TestCapacity)
+{
+    ObserverRegistry registry(1);
+    Dtls::Session   *session = reinterpret_cast<Dtls::Session *>(&registry);
+    const uint8_t    first[] = {0x01};
+    const uint8_t    second[] = {0x02};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(session, "c/ag", first, sizeof(first), NULL, 0));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, registry.Register(session, "c/pg", second, sizeof(second), NULL, 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(session, "c/pg", first, sizeof(first), NULL, 0));
+    CHECK_EQUAL(1, registry.GetSize());
+}
+
+TEST(ObserverRegistry, TestRemoveSession)
+{
+    ObserverRegistry registry;
+    int              dummy[2];
+    Dtls::Session   *first = reinterpret_cast<Dtls::Session *>(&dummy[0]);
+    Dtls::Session   *second = reinterpret_cast<Dtls::Session *>(&dummy[1]);
+    const uint8_t    token[] = {0x01};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(first, "c/ag", token, sizeof(token), NULL, 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(second, "c/ag", token, sizeof(token), NULL, 0));
+    CHECK_EQUAL(OTBR_ERROR_NONE, registry.Register(first, "c/cg", token + 1, 0, NULL, 0));
+    CHECK_EQUAL(3, registry.GetSize());
+
+    registry.Remove(first);
+    CHECK_EQUAL(1, registry.GetSize());
+}
@@ -28,8 +28,13 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include <string.h>
+
+#include "pskc-generator/cmac_prf.hpp"
 #include "pskc-generator/pskc.hpp"
 
+using ot::Psk::CmacPrf;
+
 TEST_GROUP(Pskc)
 {
     ot::Psk::Pskc mPSKc;
@@ -49,3 +54,175 @@ TEST(Pskc, Test123456_0001020304050607_OpenThread)
     pskc = mPSKc.ComputePskc(extpanid, "OpenThread", "123456");
     MEMCMP_EQUAL(expected, pskc, sizeof(expected));
 }
+
+TEST(Pskc, TestThreadSpecificationOnAllBackends)
+{
+    const uint8_t extpanid[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+    };
+    const uint8_t expected[] = {
+        0xc3, 0xf5, 0x93, 0x68, 0x44, 0x5a, 0x1b, 0x61,
+        0x06, 0xbe, 0x42, 0x0a, 0x70, 0x6d, 0x4c, 0xc9,
+    };
+    const uint8_t expected16[] = {
+        0x0e, 0x3d, 0xc8, 0xd4, 0x6a, 0xb1, 0xbc, 0xa4,
+        0xf1, 0xfb, 0xbb, 0xf9, 0xb0, 0x57, 0x89, 0x96,
+    };
+    const uint8_t extpanid16[] = {
+        0xde, 0xad, 0x00, 0xbe, 0xef, 0x00, 0xca, 0xfe
+    };
+
+    CHECK_TRUE(CmacPrf::IsSupported(CmacPrf::kBackendSoftware));
+
+    for (int backend = CmacPrf::kBackendSoftware; backend <= CmacPrf::kBackendArmCe; backend++)
+    {
+        if (!mPSKc.GetPrf().SetBackend(static_cast<CmacPrf::Backend>(backend)))
+        {
+            continue;
+        }
+
+        MEMCMP_EQUAL(expected, mPSKc.ComputePskc(extpanid, "Test Network", "12SECRETPASSWORD34"), sizeof(expected));
+
+        // A passphrase of 16 bytes is taken as the PRF key as is.
+        MEMCMP_EQUAL(expected16, mPSKc.ComputePskc(extpanid16, "OpenThread-1234", "0123456789abcdef"),
+                     sizeof(expected16));
+    }
+}
+
+TEST(Pskc, TestCmacPrfRfc4615)
+{
+    const uint8_t key[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0xed, 0xcb,
+    };
+    const uint8_t message[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13,
+    };
+    const uint8_t expected18[] = {
+        0x84, 0xa3, 0x48, 0xa4, 0xa4, 0x5d, 0x23, 0x5b,
+        0xab, 0xff, 0xfc, 0x0d, 0x2b, 0x4d, 0xa0, 0x9a,
+    };
+    const uint8_t expected16[] = {
+        0x98, 0x0a, 0xe8, 0x7b, 0x5f, 0x4c, 0x9c, 0x52,
+        0x14, 0xf5, 0xb6, 0xa8, 0x45, 0x5e, 0x4c, 0x2d,
+    };
+    const uint8_t expected10[] = {
+        0x29, 0x0d, 0x9e, 0x11, 0x2e, 0xdb, 0x09, 0xee,
+        0x14, 0x1f, 0xcf, 0x64, 0xc0, 0xb7, 0x2f, 0x3d,
+    };
+
+    for (int backend = CmacPrf::kBackendSoftware; backend <= CmacPrf::kBackendArmCe; backend++)
+    {
+        CmacPrf prf;
+        uint8_t output[16];
+
+        if (!prf.SetBackend(static_cast<CmacPrf::Backend>(backend)))
+        {
+            continue;
+        }
+
+        prf.SetKey(key, 18);
+        prf.Compute(message, sizeof(message), output);
+        MEMCMP_EQUAL(expected18, output, sizeof(output));
+
+        prf.SetKey(key, 16);
+        prf.Compute(message, sizeof(message), output);
+        MEMCMP_EQUAL(expected16, output, sizeof(output));
+
+        prf.SetKey(key, 10);
+        prf.Compute(message, sizeof(message), output);
+        MEMCMP_EQUAL(expected10, output, sizeof(output));
+    }
+}
+
+TEST(Pskc, TestCmacPrfIterate)
+{
+    CmacPrf reference;
+    CmacPrf prf;
+    uint8_t block[16];
+    uint8_t sum[16];
+    uint8_t expectedBlock[16];
+    uint8_t expectedSum[16];
+
+    reference.SetBackend(CmacPrf::kBackendSoftware);
+    reference.SetKey(reinterpret_cast<const uint8_t *>("123456"), 6);
+    memset(expectedBlock, 0x11, sizeof(expectedBlock));
+    memset(expectedSum, 0, sizeof(expectedSum));
+
+    // Iterating is computing the PRF of each block and xoring it into the sum.
+    for (int i = 0; i < 100; i++)
+    {
+        reference.Compute(expectedBlock, sizeof(expectedBlock), expectedBlock);
+
+        for (int j = 0; j < 16; j++)
+        {
+            expectedSum[j] ^= expectedBlock[j];
+        }
+    }
+
+    for (int backend = CmacPrf::kBackendSoftware; backend <= CmacPrf::kBackendArmCe; backend++)
+    {
+        if (!prf.SetBackend(static_cast<CmacPrf::Backend>(backend)))
+        {
+            continue;
+        }
+
+        prf.SetKey(reinterpret_cast<const uint8_t *>("123456"), 6);
+        memset(block, 0x11, sizeof(block));
+        memset(sum, 0, sizeof(sum));
+        prf.Iterate(block, sum, 100);
+        MEMCMP_EQUAL(expectedBlock, block, sizeof(block));
+        MEMCMP_EQUAL(expectedSum, sum, sizeof(sum));
+    }
+}
+
+TEST(Pskc, TestBatch)
+{
+    const uint8_t  extpanid[] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+    };
+    const char    *names[] = {
+        "OpenThread", "Test Network", "OpenThread-1234", "net3", "net4", "net5", "net6", "net7", "net8", "net9", "n10",
+    };
+    const char    *passphrases[] = {
+        "123456", "12SECRETPASSWORD34", "0123456789abcdef", "p3", "p4", "p5", "p6", "p7", "p8", "p9", "p10",
+    };
+    const uint8_t *extpanids[sizeof(names) / sizeof(names[0])];
+    const uint8_t  expected[] = {
+        0xb7, 0x83, 0x81, 0x27, 0x89, 0x91, 0x1e, 0xb4,
+        0xea, 0x76, 0x59, 0x6c, 0x9c, 0xed, 0x2a, 0x69,
+    };
+    const uint8_t  count = sizeof(names) / sizeof(names[0]);
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+        extpanids[i] = extpanid;
+    }
+
+    // More networks than a batch, on every backend.
+    for (int backend = CmacPrf::kBackendSoftware; backend <= CmacPrf::kBackendArmCe; backend++)
+    {
+        ot::Psk::Pskc batch[sizeof(names) / sizeof(names[0])];
+
+        if (!CmacPrf::IsSupported(static_cast<CmacPrf::Backend>(backend)))
+        {
+            continue;
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            batch[i].GetPrf().SetBackend(static_cast<CmacPrf::Backend>(backend));
+        }
+
+        ot::Psk::Pskc::ComputePskcs(batch, extpanids, names, passphrases, count);
+        MEMCMP_EQUAL(expected, batch[0].GetPskc(), sizeof(expected));
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            MEMCMP_EQUAL(mPSKc.ComputePskc(extpanid, names[i], passphrases[i]), batch[i].GetPskc(), OT_PSKC_LENGTH);
+        }
+    }
+}
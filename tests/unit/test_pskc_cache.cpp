@@ -0,0 +1,228 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pskc-generator/pskc_cache.hpp"
+
+using ot::Psk::PskcCache;
+
+static const uint8_t kExtPanId[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07
+};
+
+static const uint8_t kExpected[] = {
+    0xb7, 0x83, 0x81, 0x27, 0x89, 0x91, 0x1e, 0xb4,
+    0xea, 0x76, 0x59, 0x6c, 0x9c, 0xed, 0x2a, 0x69,
+};
+
+TEST_GROUP(PskcCache)
+{
+    char mPath[32];
+
+    void setup()
+    {
+        int fd;
+
+        strcpy(mPath, "/tmp/pskc-cache-XXXXXX");
+        fd = mkstemp(mPath);
+        CHECK(fd >= 0);
+        close(fd);
+        unlink(mPath);
+    }
+
+    void teardown()
+    {
+        unlink(mPath);
+    }
+};
+
+TEST(PskcCache, TestHitsAndMisses)
+{
+    PskcCache cache;
+    uint8_t   pskc[OT_PSKC_LENGTH];
+
+    CHECK(!cache.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+
+    MEMCMP_EQUAL(kExpected, cache.ComputePskc(kExtPanId, "OpenThread", "123456"), sizeof(kExpected));
+    CHECK_EQUAL(0, cache.GetNumHits());
+    CHECK_EQUAL(1, cache.GetNumMisses());
+
+    MEMCMP_EQUAL(kExpected, cache.ComputePskc(kExtPanId, "OpenThread", "123456"), sizeof(kExpected));
+    CHECK_EQUAL(1, cache.GetNumHits());
+    CHECK_EQUAL(1, cache.GetNumMisses());
+
+    CHECK(cache.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+    MEMCMP_EQUAL(kExpected, pskc, sizeof(kExpected));
+
+    // The inputs are not concatenated ambiguously.
+    CHECK(!cache.Lookup(kExtPanId, "OpenThrea", "d123456", pskc));
+
+    cache.Clear();
+    CHECK(!cache.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+}
+
+TEST(PskcCache, TestEviction)
+{
+    PskcCache cache;
+    uint8_t   pskc[OT_PSKC_LENGTH];
+    char      passphrase[16];
+
+    for (int i = 0; i <= PskcCache::kNumEntries; i++)
+    {
+        snprintf(passphrase, sizeof(passphrase), "passphrase%d", i);
+        cache.ComputePskc(kExtPanId, "OpenThread", passphrase);
+
+        // Keeps the first one the most recently used.
+        CHECK(cache.Lookup(kExtPanId, "OpenThread", "passphrase0", pskc));
+    }
+
+    CHECK(cache.Lookup(kExtPanId, "OpenThread", "passphrase0", pskc));
+    CHECK(!cache.Lookup(kExtPanId, "OpenThread", "passphrase1", pskc));
+    snprintf(passphrase, sizeof(passphrase), "passphrase%d", PskcCache::kNumEntries);
+    CHECK(cache.Lookup(kExtPanId, "OpenThread", passphrase, pskc));
+}
+
+TEST(PskcCache, TestVerify)
+{
+    PskcCache cache;
+    uint8_t   wrong[OT_PSKC_LENGTH];
+
+    memcpy(wrong, kExpected, sizeof(wrong));
+    wrong[OT_PSKC_LENGTH - 1] ^= 1;
+
+    CHECK(cache.Verify(kExtPanId, "OpenThread", "123456", kExpected));
+    CHECK(!cache.Verify(kExtPanId, "OpenThread", "123456", wrong));
+    CHECK(PskcCache::Equals(kExpected, kExpected, sizeof(kExpected)));
+    CHECK(!PskcCache::Equals(kExpected, wrong, sizeof(kExpected)));
+}
+
+TEST(PskcCache, TestPersistence)
+{
+    struct stat st;
+    uint8_t     pskc[OT_PSKC_LENGTH];
+
+    {
+        PskcCache cache;
+
+        CHECK_EQUAL(OTBR_ERROR_NONE, cache.Open(mPath));
+        cache.ComputePskc(kExtPanId, "OpenThread", "123456");
+    }
+
+    CHECK_EQUAL(0, stat(mPath, &st));
+    CHECK_EQUAL(0600, st.st_mode & 0777);
+
+    {
+        PskcCache cache;
+
+        CHECK_EQUAL(OTBR_ERROR_NONE, cache.Open(mPath));
+        CHECK(cache.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+        MEMCMP_EQUAL(kExpected, pskc, sizeof(kExpected));
+
+        cache.Close();
+        CHECK(!cache.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+    }
+}
+
+TEST(PskcCache, TestRefusesSharedFile)
+{
+    PskcCache cache;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, cache.Open(mPath));
+    cache.Close();
+    CHECK_EQUAL(0, chmod(mPath, 0644));
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Open(mPath));
+    CHECK_EQUAL(EPERM, errno);
+
+    // Still works in memory.
+    MEMCMP_EQUAL(kExpected, cache.ComputePskc(kExtPanId, "OpenThread", "123456"), sizeof(kExpected));
+}
+
+TEST(PskcCache, TestRefusesOtherFiles)
+{
+    PskcCache   cache;
+    char        target[sizeof(mPath) + 8];
+    struct stat st;
+    int         fd;
+
+    snprintf(target, sizeof(target), "%s.other", mPath);
+    fd = open(target, O_WRONLY | O_CREAT | O_EXCL, 0600);
+    CHECK(fd >= 0);
+    CHECK_EQUAL(4, write(fd, "key\n", 4));
+    close(fd);
+
+    // A symbolic link is not followed.
+    CHECK_EQUAL(0, symlink(target, mPath));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Open(mPath));
+    CHECK_EQUAL(ELOOP, errno);
+    CHECK_EQUAL(0, unlink(mPath));
+
+    // Nor is a hard link used.
+    CHECK_EQUAL(0, link(target, mPath));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Open(mPath));
+    CHECK_EQUAL(EPERM, errno);
+    CHECK_EQUAL(0, unlink(mPath));
+
+    // A file of another size is not truncated.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, cache.Open(target));
+    CHECK_EQUAL(EINVAL, errno);
+    CHECK_EQUAL(0, stat(target, &st));
+    CHECK_EQUAL(4, st.st_size);
+
+    unlink(target);
+}
+
+TEST(PskcCache, TestSaltedKeys)
+{
+    PskcCache first;
+    PskcCache second;
+    uint8_t   pskc[OT_PSKC_LENGTH];
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, first.Open(mPath));
+    first.ComputePskc(kExtPanId, "OpenThread", "123456");
+
+    // Caches sharing the file share its salt.
+    CHECK_EQUAL(OTBR_ERROR_NONE, second.Open(mPath));
+    CHECK(second.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+    second.Close();
+
+    // Keys of a new cache are hashed with another salt.
+    unlink(mPath);
+    CHECK_EQUAL(OTBR_ERROR_NONE, second.Open(mPath));
+    CHECK(!second.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+    CHECK(first.Lookup(kExtPanId, "OpenThread", "123456", pskc));
+}
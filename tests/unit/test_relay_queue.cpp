@@ -0,0 +1,173 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+
+#include "agent/relay_queue.hpp"
+
+using namespace ot::BorderRouter;
+
+TEST_GROUP(RelayQueue)
+{
+    uint8_t mPayload[RelayQueue::kMaxRelaySize + 1];
+};
+
+TEST(RelayQueue, TestRoundRobin)
+{
+    RelayQueue        queue(0, 0, 100);
+    RelayQueue::Relay relay;
+    const uint8_t     token[] = {0xaa, 0xbb};
+    // Joiner router 0x0400 sends first but does not starve 0x0800.
+    const uint16_t    expected[] = {0x0400, 0x0800, 0x0400, 0x0800, 0x0400, 0x0400};
+
+    for (int i = 0; i < 4; i++)
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, token, sizeof(token), mPayload, 100));
+    }
+
+    for (int i = 0; i < 2; i++)
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, token, sizeof(token), mPayload, 100));
+    }
+
+    CHECK_EQUAL(6, queue.GetSize());
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        CHECK_TRUE(queue.Pop(0, relay));
+        CHECK_EQUAL(expected[i], relay.mLocator);
+        CHECK_EQUAL(sizeof(token), relay.mTokenLength);
+        MEMCMP_EQUAL(token, relay.mToken, sizeof(token));
+        CHECK_EQUAL(100, relay.mPayload.size());
+    }
+
+    CHECK_TRUE(queue.IsEmpty());
+    CHECK_FALSE(queue.Pop(0, relay));
+}
+
+TEST(RelayQueue, TestDeficit)
+{
+    RelayQueue        queue(0, 0, 100);
+    RelayQueue::Relay relay;
+    // Joiner routers share bytes rather than messages.
+    const uint16_t    expected[] = {0x0800, 0x0800, 0x0800, 0x0800, 0x0400, 0x0800, 0x0800};
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 250));
+
+    for (int i = 0; i < 8; i++)
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, NULL, 0, mPayload, 50));
+    }
+
+    for (size_t i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        CHECK_TRUE(queue.Pop(0, relay));
+        CHECK_EQUAL(expected[i], relay.mLocator);
+    }
+}
+
+TEST(RelayQueue, TestRouterRate)
+{
+    RelayQueue        queue(1000, 0);
+    RelayQueue::Relay relay;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 1000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 1000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, NULL, 0, mPayload, 1000));
+
+    // The burst allows one message per joiner router.
+    CHECK_TRUE(queue.Pop(0, relay));
+    CHECK_EQUAL(0x0400, relay.mLocator);
+    CHECK_TRUE(queue.Pop(0, relay));
+    CHECK_EQUAL(0x0800, relay.mLocator);
+    CHECK_FALSE(queue.Pop(0, relay));
+
+    CHECK_EQUAL(720, queue.GetNextTime(0));
+    CHECK_FALSE(queue.Pop(719, relay));
+    CHECK_TRUE(queue.Pop(720, relay));
+    CHECK_EQUAL(0x0400, relay.mLocator);
+    CHECK_TRUE(queue.IsEmpty());
+}
+
+TEST(RelayQueue, TestTotalRate)
+{
+    RelayQueue        queue(0, 1000);
+    RelayQueue::Relay relay;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 1000));
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, NULL, 0, mPayload, 1000));
+
+    CHECK_TRUE(queue.Pop(0, relay));
+    CHECK_EQUAL(0x0400, relay.mLocator);
+    CHECK_FALSE(queue.Pop(0, relay));
+    CHECK_EQUAL(720, queue.GetNextTime(0));
+    CHECK_TRUE(queue.Pop(720, relay));
+    CHECK_EQUAL(0x0800, relay.mLocator);
+}
+
+TEST(RelayQueue, TestLimits)
+{
+    RelayQueue queue;
+
+    for (int i = 0; i < RelayQueue::kMaxQueueLength; i++)
+    {
+        CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 10));
+    }
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, queue.Push(0x0400, NULL, 0, mPayload, 10));
+    CHECK_EQUAL(ENOBUFS, errno);
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, NULL, 0, mPayload, 10));
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, queue.Push(0x0800, NULL, 0, mPayload, sizeof(mPayload)));
+    CHECK_EQUAL(EMSGSIZE, errno);
+    CHECK_EQUAL(RelayQueue::kMaxQueueLength + 1, queue.GetSize());
+}
+
+TEST(RelayQueue, TestPurgeRouters)
+{
+    RelayQueue        queue(1000, 0);
+    RelayQueue::Relay relay;
+
+    // A rejected message does not track its joiner router.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, queue.Push(0x0400, NULL, 0, mPayload, sizeof(mPayload)));
+    CHECK_EQUAL(0, queue.GetNumRouters());
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0400, NULL, 0, mPayload, 1000));
+    CHECK_TRUE(queue.Pop(0, relay));
+    CHECK_EQUAL(OTBR_ERROR_NONE, queue.Push(0x0800, NULL, 0, mPayload, 1000));
+    CHECK_TRUE(queue.Pop(999, relay));
+    CHECK_EQUAL(2, queue.GetNumRouters());
+
+    // Drained joiner routers are forgotten once their buckets refill.
+    CHECK_FALSE(queue.Pop(1000, relay));
+    CHECK_EQUAL(1, queue.GetNumRouters());
+    CHECK_FALSE(queue.Pop(1999, relay));
+    CHECK_EQUAL(0, queue.GetNumRouters());
+}
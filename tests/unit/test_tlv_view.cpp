@@ -0,0 +1,127 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/tlv_view.hpp"
+
+using namespace ot;
+
+TEST_GROUP(TlvView)
+{
+};
+
+TEST(TlvView, TestRelayTransmit)
+{
+    TlvView        view;
+    uint16_t       value = 0;
+    uint16_t       length = 0;
+    const uint8_t *data;
+    const uint8_t  payload[] = {
+        Meshcop::kJoinerUdpPort,           2, 0x03, 0xe8,
+        Meshcop::kJoinerIid,               8, 1, 2, 3, 4, 5, 6, 7, 8,
+        Meshcop::kJoinerRouterLocator,     2, 0x04, 0x00,
+        Meshcop::kJoinerDtlsEncapsulation, 3, 0x16, 0xfe, 0xfd,
+        // A later TLV of the same type is ignored.
+        Meshcop::kJoinerRouterLocator,     2, 0x08, 0x00,
+    };
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(payload, sizeof(payload)));
+
+    CHECK_TRUE(view.GetJoinerUdpPort(value));
+    CHECK_EQUAL(1000, value);
+    CHECK_TRUE(view.GetJoinerRouterLocator(value));
+    CHECK_EQUAL(0x0400, value);
+    POINTERS_EQUAL(payload + 6, view.GetJoinerIid());
+
+    data = view.GetJoinerDtlsEncapsulation(length);
+    POINTERS_EQUAL(payload + 20, data);
+    CHECK_EQUAL(3, length);
+
+    CHECK_FALSE(view.Contains(Meshcop::kJoinerRouterKek));
+    POINTERS_EQUAL(NULL, view.GetJoinerRouterKek());
+    CHECK_FALSE(view.GetCommissionerSessionId(value));
+}
+
+TEST(TlvView, TestExtendedLength)
+{
+    TlvView  view;
+    uint8_t  payload[4 + 300 + 4];
+    uint16_t length = 0;
+    uint16_t value = 0;
+
+    payload[0] = Meshcop::kJoinerDtlsEncapsulation;
+    payload[1] = 0xff;
+    payload[2] = 0x01;
+    payload[3] = 0x2c;
+    memset(payload + 4, 0x16, 300);
+    payload[304] = Meshcop::kCommissionerSessionId;
+    payload[305] = 2;
+    payload[306] = 0x12;
+    payload[307] = 0x34;
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(payload, sizeof(payload)));
+    POINTERS_EQUAL(payload + 4, view.GetJoinerDtlsEncapsulation(length));
+    CHECK_EQUAL(300, length);
+    CHECK_TRUE(view.GetCommissionerSessionId(value));
+    CHECK_EQUAL(0x1234, value);
+}
+
+TEST(TlvView, TestMalformed)
+{
+    TlvView        view;
+    uint16_t       value = 0;
+    // Length past the end.
+    const uint8_t  overflow[] = {Meshcop::kJoinerRouterLocator, 2, 0x04, 0x00, Meshcop::kJoinerIid, 8, 1, 2};
+    // Truncated header.
+    const uint8_t  header[] = {Meshcop::kJoinerRouterLocator, 2, 0x04, 0x00, Meshcop::kJoinerIid};
+    // Truncated extended length.
+    const uint8_t  extended[] = {Meshcop::kJoinerDtlsEncapsulation, 0xff, 0x00};
+    // Wrong length of a fixed size TLV.
+    const uint8_t  fixed[] = {Meshcop::kJoinerRouterLocator, 1, 0x04, Meshcop::kState, 2, 0x01, 0x00};
+    int8_t         state;
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, view.Init(overflow, sizeof(overflow)));
+    CHECK_EQUAL(EBADMSG, errno);
+    // A malformed buffer leaves the view empty.
+    CHECK_FALSE(view.GetJoinerRouterLocator(value));
+
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, view.Init(header, sizeof(header)));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, view.Init(extended, sizeof(extended)));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(fixed, sizeof(fixed)));
+    CHECK_TRUE(view.Contains(Meshcop::kJoinerRouterLocator));
+    CHECK_FALSE(view.GetJoinerRouterLocator(value));
+    CHECK_FALSE(view.GetState(state));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(NULL, 0));
+    CHECK_FALSE(view.Contains(Meshcop::kState));
+}
@@ -0,0 +1,150 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <errno.h>
+#include <string.h>
+
+#include "common/tlv_view.hpp"
+#include "common/tlv_writer.hpp"
+
+using namespace ot;
+
+TEST_GROUP(TlvWriter)
+{
+};
+
+TEST(TlvWriter, TestRelayTransmit)
+{
+    uint8_t        buffer[64];
+    TlvWriter      writer(buffer, sizeof(buffer));
+    TlvView        view;
+    uint16_t       value = 0;
+    uint16_t       length = 0;
+    uint8_t       *record;
+    const uint8_t  iid[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    const uint8_t  kek[16] = {0xaa};
+    const uint8_t  expected[] = {
+        Meshcop::kJoinerDtlsEncapsulation, 3, 0x16, 0xfe, 0xfd,
+        Meshcop::kJoinerUdpPort,           2, 0x03, 0xe8,
+        Meshcop::kJoinerIid,               8, 1, 2, 3, 4, 5, 6, 7, 8,
+        Meshcop::kJoinerRouterLocator,     2, 0x04, 0x00,
+    };
+
+    record = writer.ReserveJoinerDtlsEncapsulation(3);
+    POINTERS_EQUAL(buffer + 2, record);
+    memcpy(record, "\x16\xfe\xfd", 3);
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.AppendJoinerUdpPort(static_cast<uint16_t>(1000)));
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.AppendJoinerIid(iid));
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.AppendJoinerRouterLocator(static_cast<uint16_t>(0x0400)));
+    CHECK_EQUAL(sizeof(expected), writer.GetLength());
+    MEMCMP_EQUAL(expected, buffer, sizeof(expected));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.AppendJoinerRouterKek(kek));
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.GetError());
+
+    // What is written reads back through a view.
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(buffer, writer.GetLength()));
+    CHECK_TRUE(view.GetJoinerUdpPort(value));
+    CHECK_EQUAL(1000, value);
+    CHECK_TRUE(view.GetJoinerRouterLocator(value));
+    CHECK_EQUAL(0x0400, value);
+    MEMCMP_EQUAL(iid, view.GetJoinerIid(), sizeof(iid));
+    MEMCMP_EQUAL(kek, view.GetJoinerRouterKek(), sizeof(kek));
+    POINTERS_EQUAL(record, view.GetJoinerDtlsEncapsulation(length));
+    CHECK_EQUAL(3, length);
+}
+
+TEST(TlvWriter, TestCommissionerSet)
+{
+    uint8_t        buffer[32];
+    TlvWriter      writer(buffer, sizeof(buffer));
+    TlvView        view;
+    uint16_t       sessionId = 0;
+    int8_t         state = 0;
+    uint16_t       length = 0;
+    const uint8_t  steering[] = {0xff};
+    const uint8_t *data;
+
+    writer.AppendState(static_cast<int8_t>(-1));
+    writer.AppendCommissionerSessionId(static_cast<uint16_t>(0x1234));
+    writer.AppendSteeringData(steering, sizeof(steering));
+    writer.AppendCommissionerId("OpenThread");
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.GetError());
+    CHECK_EQUAL(3 + 4 + 3 + 12, writer.GetLength());
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, view.Init(buffer, writer.GetLength()));
+    CHECK_TRUE(view.GetState(state));
+    CHECK_EQUAL(-1, state);
+    CHECK_TRUE(view.GetCommissionerSessionId(sessionId));
+    CHECK_EQUAL(0x1234, sessionId);
+    data = view.GetSteeringData(length);
+    CHECK_EQUAL(1, length);
+    CHECK_EQUAL(0xff, data[0]);
+    data = view.GetCommissionerId(length);
+    CHECK_EQUAL(10, length);
+    MEMCMP_EQUAL("OpenThread", data, length);
+}
+
+TEST(TlvWriter, TestExtendedLength)
+{
+    uint8_t   buffer[4 + 300];
+    uint8_t   value[300];
+    TlvWriter writer(buffer, sizeof(buffer));
+
+    memset(value, 0x5a, sizeof(value));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.Append(Meshcop::kJoinerDtlsEncapsulation, value, sizeof(value)));
+    CHECK_EQUAL(sizeof(buffer), writer.GetLength());
+    CHECK_EQUAL(Meshcop::kJoinerDtlsEncapsulation, buffer[0]);
+    CHECK_EQUAL(0xff, buffer[1]);
+    CHECK_EQUAL(0x01, buffer[2]);
+    CHECK_EQUAL(0x2c, buffer[3]);
+    MEMCMP_EQUAL(value, buffer + 4, sizeof(value));
+}
+
+TEST(TlvWriter, TestOverflow)
+{
+    uint8_t   buffer[6];
+    TlvWriter writer(buffer, sizeof(buffer));
+
+    CHECK_EQUAL(OTBR_ERROR_NONE, writer.AppendJoinerUdpPort(static_cast<uint16_t>(1000)));
+
+    errno = 0;
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, writer.AppendCommissionerSessionId(static_cast<uint16_t>(1)));
+    CHECK_EQUAL(ENOBUFS, errno);
+    CHECK_EQUAL(4, writer.GetLength());
+
+    // Failures are sticky, even if a later TLV would fit.
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, writer.AppendUInt8(Meshcop::kState, 1));
+    POINTERS_EQUAL(NULL, writer.Reserve(Meshcop::kState, 0));
+    CHECK_EQUAL(OTBR_ERROR_ERRNO, writer.GetError());
+    CHECK_EQUAL(4, writer.GetLength());
+}
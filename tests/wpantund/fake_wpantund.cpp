@@ -0,0 +1,1340 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *    AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *    ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *    LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *    SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *    INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *    CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *    ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *    POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a fake wpantund, which serves the wpantund D-Bus APIs used by the border agent and the web
+ *   service from an in-memory NCP, with scriptable latency and a loopback mesh answering TMF requests as the leader.
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <getopt.h>
+#include <net/if.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <dbus/dbus.h>
+
+extern "C" {
+#include "wpan-dbus-v0.h"
+#include "wpan-dbus-v1.h"
+#include "wpan-error.h"
+}
+
+#include "agent/coap.hpp"
+#include "agent/uris.hpp"
+#include "common/code_utils.hpp"
+#include "common/logging.hpp"
+#include "common/tlv.hpp"
+#include "common/tlv_view.hpp"
+#include "common/tlv_writer.hpp"
+#include "common/types.hpp"
+#include "utils/hex.hpp"
+
+namespace ot {
+
+namespace BorderRouter {
+
+namespace Fake {
+
+/**
+ * Constants.
+ */
+enum
+{
+    kPollTimeout      = 1000, ///< Milliseconds to wait for D-Bus messages when nothing is scheduled.
+    kMaxLine          = 256,
+    kMaxPayload       = 1024,
+    kSizeLocatorPort  = 4,    ///< Bytes of locator and port trailing a TMF proxy stream.
+    kLeaderLocator    = 0xfc00,
+    kDefaultBeacons   = 4,
+    kStateAccept      = 1,
+};
+
+/**
+ * MeshCoP dataset TLV types served by the leader.
+ */
+enum
+{
+    kChannel         = 0,
+    kPanId           = 1,
+    kExtendedPanId   = 2,
+    kNetworkName     = 3,
+    kPSKc            = 4,
+    kNetworkKey      = 5,
+    kMeshLocalPrefix = 7,
+    kBorderAgentRloc = 9,
+    kSecurityPolicy  = 12,
+    kActiveTimestamp = 14,
+};
+
+static const char    kSyslogIdent[] = "otbr-fake-wpantund";
+static const uint8_t kDefaultEui64[] = { 0x18, 0xb4, 0x30, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t kDefaultPSKc[] = {
+    0xc2, 0x3a, 0x76, 0xe9, 0x8f, 0x1a, 0x64, 0x83, 0x63, 0x9b, 0x1a, 0xc1, 0x27, 0x1e, 0x2e, 0x27
+};
+static const uint8_t kDefaultNetworkKey[] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const uint8_t kDefaultMeshLocalPrefix[] = { 0xfd, 0xde, 0xad, 0x00, 0xbe, 0xef, 0x00, 0x00 };
+
+static volatile sig_atomic_t sTerminated = 0;
+
+static void HandleSignal(int aSignal)
+{
+    (void)aSignal;
+    sTerminated = 1;
+}
+
+static uint64_t GetNowUs(void)
+{
+    timeval now;
+
+    gettimeofday(&now, NULL);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_usec);
+}
+
+/**
+ * This structure represents the latency of a reply, a fixed delay plus a uniformly distributed jitter.
+ */
+struct Latency
+{
+    uint64_t mDelay;  ///< Microseconds.
+    uint64_t mJitter; ///< Microseconds.
+
+    Latency(void) :
+        mDelay(0),
+        mJitter(0) {}
+
+    uint64_t Sample(void) const
+    {
+        return mDelay + (mJitter > 0 ? static_cast<uint64_t>(rand()) % (mJitter + 1) : 0);
+    }
+};
+
+/**
+ * This structure represents a property value, stored with the D-Bus type it is replied with.
+ */
+struct Property
+{
+    int                  mType;
+    std::string          mString;
+    std::vector<uint8_t> mData;
+    uint64_t             mInteger;
+
+    Property(void) :
+        mType(DBUS_TYPE_INVALID),
+        mInteger(0) {}
+
+    static Property String(const char *aValue)
+    {
+        Property property;
+
+        property.mType = DBUS_TYPE_STRING;
+        property.mString = aValue;
+        return property;
+    }
+
+    static Property Data(const uint8_t *aValue, size_t aLength)
+    {
+        Property property;
+
+        property.mType = DBUS_TYPE_ARRAY;
+        property.mData.assign(aValue, aValue + aLength);
+        return property;
+    }
+
+    static Property Integer(int aType, uint64_t aValue)
+    {
+        Property property;
+
+        property.mType = aType;
+        property.mInteger = aValue;
+        return property;
+    }
+
+    bool Append(DBusMessageIter &aIter) const;
+    bool Parse(DBusMessageIter &aIter);
+};
+
+bool Property::Append(DBusMessageIter &aIter) const
+{
+    bool ret = false;
+
+    switch (mType)
+    {
+    case DBUS_TYPE_STRING:
+    {
+        const char *value = mString.c_str();
+
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_STRING, &value);
+        break;
+    }
+
+    case DBUS_TYPE_ARRAY:
+    {
+        DBusMessageIter subIter;
+        const uint8_t  *value = mData.empty() ? NULL : &mData[0];
+
+        VerifyOrExit(dbus_message_iter_open_container(&aIter, DBUS_TYPE_ARRAY, DBUS_TYPE_BYTE_AS_STRING, &subIter));
+        VerifyOrExit(dbus_message_iter_append_fixed_array(&subIter, DBUS_TYPE_BYTE, &value,
+                                                          static_cast<int>(mData.size())));
+        ret = dbus_message_iter_close_container(&aIter, &subIter);
+        break;
+    }
+
+    case DBUS_TYPE_BOOLEAN:
+    {
+        dbus_bool_t value = mInteger ? TRUE : FALSE;
+
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_BOOLEAN, &value);
+        break;
+    }
+
+    case DBUS_TYPE_UINT16:
+    {
+        uint16_t value = static_cast<uint16_t>(mInteger);
+
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_UINT16, &value);
+        break;
+    }
+
+    case DBUS_TYPE_INT32:
+    {
+        int32_t value = static_cast<int32_t>(mInteger);
+
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_INT32, &value);
+        break;
+    }
+
+    case DBUS_TYPE_UINT32:
+    {
+        uint32_t value = static_cast<uint32_t>(mInteger);
+
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_UINT32, &value);
+        break;
+    }
+
+    case DBUS_TYPE_UINT64:
+        ret = dbus_message_iter_append_basic(&aIter, DBUS_TYPE_UINT64, &mInteger);
+        break;
+
+    default:
+        break;
+    }
+
+exit:
+    return ret;
+}
+
+bool Property::Parse(DBusMessageIter &aIter)
+{
+    bool ret = true;
+
+    mType = dbus_message_iter_get_arg_type(&aIter);
+
+    switch (mType)
+    {
+    case DBUS_TYPE_STRING:
+    {
+        const char *value = NULL;
+
+        dbus_message_iter_get_basic(&aIter, &value);
+        mString = value;
+        break;
+    }
+
+    case DBUS_TYPE_ARRAY:
+    {
+        DBusMessageIter subIter;
+        const uint8_t  *value = NULL;
+        int             count = 0;
+
+        VerifyOrExit(dbus_message_iter_get_element_type(&aIter) == DBUS_TYPE_BYTE, ret = false);
+        dbus_message_iter_recurse(&aIter, &subIter);
+        dbus_message_iter_get_fixed_array(&subIter, &value, &count);
+        mData.assign(value, value + count);
+        break;
+    }
+
+    case DBUS_TYPE_BOOLEAN:
+    {
+        dbus_bool_t value = FALSE;
+
+        dbus_message_iter_get_basic(&aIter, &value);
+        mInteger = value ? 1 : 0;
+        break;
+    }
+
+    case DBUS_TYPE_BYTE:
+    case DBUS_TYPE_INT16:
+    case DBUS_TYPE_UINT16:
+    case DBUS_TYPE_INT32:
+    case DBUS_TYPE_UINT32:
+    case DBUS_TYPE_INT64:
+    case DBUS_TYPE_UINT64:
+    {
+        DBusBasicValue value;
+
+        memset(&value, 0, sizeof(value));
+        dbus_message_iter_get_basic(&aIter, &value);
+        mInteger = mType == DBUS_TYPE_BYTE ? value.byt :
+                   mType == DBUS_TYPE_INT16 ? static_cast<uint64_t>(value.i16) :
+                   mType == DBUS_TYPE_UINT16 ? value.u16 :
+                   mType == DBUS_TYPE_INT32 ? static_cast<uint64_t>(value.i32) :
+                   mType == DBUS_TYPE_UINT32 ? value.u32 : value.u64;
+        // Integers are replied with the widest type the clients here parse.
+        mType = mType == DBUS_TYPE_UINT64 || mType == DBUS_TYPE_INT64 ? DBUS_TYPE_UINT64 : DBUS_TYPE_UINT32;
+        break;
+    }
+
+    default:
+        ret = false;
+        break;
+    }
+
+exit:
+    return ret;
+}
+
+/**
+ * This class implements a fake wpantund serving one interface.
+ */
+class Wpantund
+{
+public:
+    Wpantund(const char *aInterfaceName, unsigned aNumBeacons);
+    ~Wpantund(void);
+
+    /**
+     * This method sets the latency of the replies to a method, or of the loopback mesh for "Mesh".
+     *
+     * @param[in]   aSpec   A string of METHOD=DELAY[:JITTER], in milliseconds. METHOD * applies to all methods.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully set the latency.
+     * @retval  OTBR_ERROR_ERRNO    Failed to parse @p aSpec.
+     *
+     */
+    otbrError SetLatency(const char *aSpec);
+
+    /**
+     * This method reads latencies from a script, one METHOD=DELAY[:JITTER] per line.
+     *
+     * @param[in]   aFile   The path of the script.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully read the script.
+     * @retval  OTBR_ERROR_ERRNO    Failed to open or parse the script.
+     *
+     */
+    otbrError LoadScript(const char *aFile);
+
+    /**
+     * This method sets the PSKc of the fake network.
+     *
+     */
+    void SetPSKc(const uint8_t *aPSKc) { mProperties[kWPANTUNDProperty_NetworkPSKc] = Property::Data(aPSKc, 16); }
+
+    /**
+     * This method connects to the bus and claims the wpantund name.
+     *
+     * @retval  OTBR_ERROR_NONE     Successfully connected.
+     * @retval  OTBR_ERROR_DBUS     Failed due to a D-Bus error.
+     *
+     */
+    otbrError Init(void);
+
+    /**
+     * This method serves requests until a termination signal.
+     *
+     */
+    void Run(void);
+
+    /**
+     * This method prints the counts of requests served.
+     *
+     */
+    void Report(void) const;
+
+private:
+    typedef std::map<std::string, Property>        Properties;
+    typedef std::map<std::string, Latency>         Latencies;
+    typedef std::map<std::string, unsigned long>   Counters;
+    typedef std::multimap<uint64_t, DBusMessage *> Outbox;
+
+    static DBusHandlerResult HandleMessage(DBusConnection *aConnection, DBusMessage *aMessage, void *aContext)
+    {
+        (void)aConnection;
+        return static_cast<Wpantund *>(aContext)->HandleMessage(*aMessage);
+    }
+    DBusHandlerResult HandleMessage(DBusMessage &aMessage);
+
+    void HandleGetInterfaces(DBusMessage &aMessage, uint64_t aDue);
+    void HandlePropGet(DBusMessage &aMessage, uint64_t aDue);
+    void HandlePropSet(DBusMessage &aMessage, uint64_t aDue);
+    void HandleNetScanStart(DBusMessage &aMessage, uint64_t aDue);
+    void HandleForm(DBusMessage &aMessage, uint64_t aDue);
+    void HandleJoin(DBusMessage &aMessage, uint64_t aDue);
+    void HandleLeave(DBusMessage &aMessage, uint64_t aDue);
+
+    void ReplyStatus(DBusMessage &aMessage, int32_t aStatus, uint64_t aDue);
+    void SetProperty(const char *aKey, const Property &aValue, uint64_t aDue);
+    void SendBeacon(unsigned aIndex, uint64_t aDue);
+    void Schedule(DBusMessage *aMessage, uint64_t aDue);
+    void FlushDue(void);
+    uint64_t GetDue(const char *aMethod) const;
+
+    void FeedTmf(const std::vector<uint8_t> &aStream);
+
+    static ssize_t SendTmf(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort,
+                           void *aContext)
+    {
+        return static_cast<Wpantund *>(aContext)->SendTmf(aBuffer, aLength, aIp6, aPort);
+    }
+    ssize_t SendTmf(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort);
+
+    static void HandleLeaderRequest(const Coap::Resource &aResource, const Coap::Message &aRequest,
+                                    Coap::Message &aResponse, const uint8_t *aIp6, uint16_t aPort, void *aContext)
+    {
+        (void)aIp6;
+        (void)aPort;
+        static_cast<Wpantund *>(aContext)->HandleLeaderRequest(aResource, aRequest, aResponse);
+    }
+    void HandleLeaderRequest(const Coap::Resource &aResource, const Coap::Message &aRequest,
+                             Coap::Message &aResponse);
+    uint16_t WriteActiveDataset(uint8_t *aBuffer, uint16_t aSize) const;
+    void ApplyDataset(const TlvView &aView);
+    const Property *FindProperty(const char *aKey) const;
+
+    char            mInterfaceName[IFNAMSIZ];
+    char            mInterfacePath[DBUS_MAXIMUM_NAME_LENGTH + 1];
+    DBusConnection *mDBus;
+    Coap::Agent    *mLeader;
+    Properties      mProperties;
+    Latencies       mLatencies;
+    Counters        mMethodCounters;
+    Counters        mTmfCounters;
+    Outbox          mOutbox;
+    unsigned        mNumBeacons;
+    uint16_t        mSessionId;
+    std::string     mSteeringData;
+
+    Coap::Resource mLeaderPetition;
+    Coap::Resource mLeaderKeepAlive;
+    Coap::Resource mActiveGet;
+    Coap::Resource mActiveSet;
+    Coap::Resource mPendingGet;
+    Coap::Resource mPendingSet;
+    Coap::Resource mCommissionerGet;
+    Coap::Resource mCommissionerSet;
+    Coap::Resource mRelayTransmit;
+    Coap::Resource mEnergyScan;
+    Coap::Resource mPanIdQuery;
+};
+
+Wpantund::Wpantund(const char *aInterfaceName, unsigned aNumBeacons) :
+    mDBus(NULL),
+    mLeader(Coap::Agent::Create(SendTmf, this)),
+    mNumBeacons(aNumBeacons),
+    mSessionId(0),
+    mLeaderPetition(OT_URI_PATH_LEADER_PETITION, HandleLeaderRequest, this),
+    mLeaderKeepAlive(OT_URI_PATH_LEADER_KEEP_ALIVE, HandleLeaderRequest, this),
+    mActiveGet(OT_URI_PATH_ACTIVE_GET, HandleLeaderRequest, this),
+    mActiveSet(OT_URI_PATH_ACTIVE_SET, HandleLeaderRequest, this),
+    mPendingGet(OT_URI_PATH_PENDING_GET, HandleLeaderRequest, this),
+    mPendingSet(OT_URI_PATH_PENDING_SET, HandleLeaderRequest, this),
+    mCommissionerGet(OT_URI_PATH_COMMISSIONER_GET, HandleLeaderRequest, this),
+    mCommissionerSet(OT_URI_PATH_COMMISSIONER_SET, HandleLeaderRequest, this),
+    mRelayTransmit(OT_URI_PATH_RELAY_TX, HandleLeaderRequest, this),
+    mEnergyScan(OT_URI_PATH_ENERGY_SCAN, HandleLeaderRequest, this),
+    mPanIdQuery(OT_URI_PATH_PANID_QUERY, HandleLeaderRequest, this)
+{
+    strncpy(mInterfaceName, aInterfaceName, sizeof(mInterfaceName) - 1);
+    mInterfaceName[sizeof(mInterfaceName) - 1] = '\0';
+    snprintf(mInterfacePath, sizeof(mInterfacePath), "%s/%s", WPANTUND_DBUS_PATH, mInterfaceName);
+
+    mProperties[kWPANTUNDProperty_NCPState] = Property::String(kWPANTUNDStateAssociated);
+    mProperties[kWPANTUNDProperty_NCPHardwareAddress] = Property::Data(kDefaultEui64, sizeof(kDefaultEui64));
+    mProperties[kWPANTUNDProperty_NCPChannel] = Property::Integer(DBUS_TYPE_UINT16, 15);
+    mProperties[kWPANTUNDProperty_NetworkName] = Property::String("OpenThread");
+    mProperties[kWPANTUNDProperty_NetworkPANID] = Property::Integer(DBUS_TYPE_UINT16, 0xface);
+    mProperties[kWPANTUNDProperty_NetworkXPANID] = Property::Integer(DBUS_TYPE_UINT64, 0xdead00beef00cafeULL);
+    mProperties[kWPANTUNDProperty_NetworkKey] = Property::Data(kDefaultNetworkKey, sizeof(kDefaultNetworkKey));
+    mProperties[kWPANTUNDProperty_NetworkNodeType] = Property::String("leader");
+    mProperties[kWPANTUNDProperty_IPv6MeshLocalPrefix] = Property::String("fdde:ad00:beef:0::/64");
+    mProperties[kWPANTUNDProperty_TmfProxyEnabled] = Property::Integer(DBUS_TYPE_BOOLEAN, 0);
+    SetPSKc(kDefaultPSKc);
+
+    mLeader->AddResource(mLeaderPetition);
+    mLeader->AddResource(mLeaderKeepAlive);
+    mLeader->AddResource(mActiveGet);
+    mLeader->AddResource(mActiveSet);
+    mLeader->AddResource(mPendingGet);
+    mLeader->AddResource(mPendingSet);
+    mLeader->AddResource(mCommissionerGet);
+    mLeader->AddResource(mCommissionerSet);
+    mLeader->AddResource(mRelayTransmit);
+    mLeader->AddResource(mEnergyScan);
+    mLeader->AddResource(mPanIdQuery);
+}
+
+Wpantund::~Wpantund(void)
+{
+    for (Outbox::iterator it = mOutbox.begin(); it != mOutbox.end(); ++it)
+    {
+        dbus_message_unref(it->second);
+    }
+
+    Coap::Agent::Destroy(mLeader);
+
+    if (mDBus)
+    {
+        dbus_connection_unref(mDBus);
+    }
+}
+
+otbrError Wpantund::SetLatency(const char *aSpec)
+{
+    otbrError   ret = OTBR_ERROR_ERRNO;
+    const char *equal = strchr(aSpec, '=');
+    char       *end = NULL;
+    Latency     latency;
+    double      value;
+
+    VerifyOrExit(equal != NULL && equal != aSpec, errno = EINVAL);
+
+    value = strtod(equal + 1, &end);
+    VerifyOrExit(end != equal + 1 && value >= 0, errno = EINVAL);
+    latency.mDelay = static_cast<uint64_t>(value * 1000);
+
+    if (*end == ':')
+    {
+        const char *jitter = end + 1;
+
+        value = strtod(jitter, &end);
+        VerifyOrExit(end != jitter && value >= 0, errno = EINVAL);
+        latency.mJitter = static_cast<uint64_t>(value * 1000);
+    }
+
+    VerifyOrExit(*end == '\0', errno = EINVAL);
+
+    mLatencies[std::string(aSpec, equal)] = latency;
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    return ret;
+}
+
+otbrError Wpantund::LoadScript(const char *aFile)
+{
+    otbrError ret = OTBR_ERROR_NONE;
+    FILE     *file = fopen(aFile, "r");
+    char      line[kMaxLine];
+    unsigned  lineNumber = 0;
+
+    VerifyOrExit(file != NULL, perror(aFile), ret = OTBR_ERROR_ERRNO);
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        size_t length = strcspn(line, "\r\n");
+
+        lineNumber++;
+        line[length] = '\0';
+
+        if (length == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        if (SetLatency(line) != OTBR_ERROR_NONE)
+        {
+            fprintf(stderr, "%s:%u: expecting METHOD=DELAY[:JITTER].\n", aFile, lineNumber);
+            ret = OTBR_ERROR_ERRNO;
+        }
+    }
+
+exit:
+    if (file != NULL)
+    {
+        fclose(file);
+    }
+
+    return ret;
+}
+
+otbrError Wpantund::Init(void)
+{
+    otbrError ret = OTBR_ERROR_DBUS;
+    DBusError error;
+
+    dbus_error_init(&error);
+    mDBus = dbus_bus_get(DBUS_BUS_STARTER, &error);
+    if (!mDBus)
+    {
+        dbus_error_free(&error);
+        mDBus = dbus_bus_get(DBUS_BUS_SESSION, &error);
+    }
+    VerifyOrExit(mDBus != NULL);
+
+    // Each name is what one of the clients looks up the interface by.
+    VerifyOrExit(dbus_bus_request_name(mDBus, WPAN_TUNNEL_DBUS_NAME, DBUS_NAME_FLAG_DO_NOT_QUEUE, &error) ==
+                 DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER);
+    VerifyOrExit(dbus_bus_request_name(mDBus, WPANTUND_DBUS_NAME, DBUS_NAME_FLAG_DO_NOT_QUEUE, &error) ==
+                 DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER);
+
+    VerifyOrExit(dbus_connection_add_filter(mDBus, HandleMessage, this, NULL));
+
+    otbrLog(OTBR_LOG_INFO, "Serving %s as %s", mInterfaceName, dbus_bus_get_unique_name(mDBus));
+    ret = OTBR_ERROR_NONE;
+
+exit:
+    if (dbus_error_is_set(&error))
+    {
+        otbrLog(OTBR_LOG_ERR, "DBus error %s: %s!", error.name, error.message);
+        dbus_error_free(&error);
+    }
+
+    return ret;
+}
+
+void Wpantund::Run(void)
+{
+    while (!sTerminated)
+    {
+        int timeout = kPollTimeout;
+
+        if (!mOutbox.empty())
+        {
+            uint64_t now = GetNowUs();
+            uint64_t due = mOutbox.begin()->first;
+
+            timeout = due > now ? static_cast<int>((due - now + 999) / 1000) : 0;
+        }
+
+        if (!dbus_connection_read_write_dispatch(mDBus, timeout))
+        {
+            otbrLog(OTBR_LOG_ERR, "DBus disconnected!");
+            break;
+        }
+
+        while (dbus_connection_get_dispatch_status(mDBus) == DBUS_DISPATCH_DATA_REMAINS)
+        {
+            dbus_connection_dispatch(mDBus);
+        }
+
+        FlushDue();
+    }
+}
+
+void Wpantund::Report(void) const
+{
+    printf("%-24s %10s\n", "method", "calls");
+
+    for (Counters::const_iterator it = mMethodCounters.begin(); it != mMethodCounters.end(); ++it)
+    {
+        printf("%-24s %10lu\n", it->first.c_str(), it->second);
+    }
+
+    printf("%-24s %10s\n", "tmf", "requests");
+
+    for (Counters::const_iterator it = mTmfCounters.begin(); it != mTmfCounters.end(); ++it)
+    {
+        printf("%-24s %10lu\n", it->first.c_str(), it->second);
+    }
+
+    fflush(stdout);
+}
+
+uint64_t Wpantund::GetDue(const char *aMethod) const
+{
+    Latencies::const_iterator it = mLatencies.find(aMethod);
+
+    if (it == mLatencies.end())
+    {
+        it = mLatencies.find("*");
+    }
+
+    return GetNowUs() + (it != mLatencies.end() ? it->second.Sample() : 0);
+}
+
+void Wpantund::Schedule(DBusMessage *aMessage, uint64_t aDue)
+{
+    VerifyOrExit(aMessage != NULL, otbrLog(OTBR_LOG_ERR, "Failed to allocate DBus message!"));
+
+    // Messages due at the same time keep the order they are scheduled in, e.g. beacons before the scan reply.
+    mOutbox.insert(mOutbox.upper_bound(aDue), Outbox::value_type(aDue, aMessage));
+
+exit:
+    return;
+}
+
+void Wpantund::FlushDue(void)
+{
+    uint64_t now = GetNowUs();
+
+    while (!mOutbox.empty() && mOutbox.begin()->first <= now)
+    {
+        DBusMessage *message = mOutbox.begin()->second;
+
+        mOutbox.erase(mOutbox.begin());
+        dbus_connection_send(mDBus, message, NULL);
+        dbus_message_unref(message);
+    }
+
+    dbus_connection_flush(mDBus);
+}
+
+DBusHandlerResult Wpantund::HandleMessage(DBusMessage &aMessage)
+{
+    DBusHandlerResult result = DBUS_HANDLER_RESULT_HANDLED;
+    const char       *member = dbus_message_get_member(&aMessage);
+    uint64_t          due;
+
+    VerifyOrExit(dbus_message_get_type(&aMessage) == DBUS_MESSAGE_TYPE_METHOD_CALL && member != NULL,
+                 result = DBUS_HANDLER_RESULT_NOT_YET_HANDLED);
+
+    mMethodCounters[member]++;
+    due = GetDue(member);
+
+    if (!strcmp(member, WPAN_TUNNEL_CMD_GET_INTERFACES))
+    {
+        HandleGetInterfaces(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_PROP_GET))
+    {
+        HandlePropGet(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_PROP_SET))
+    {
+        HandlePropSet(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_NET_SCAN_START))
+    {
+        HandleNetScanStart(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_FORM))
+    {
+        HandleForm(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_JOIN))
+    {
+        HandleJoin(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_LEAVE))
+    {
+        HandleLeave(aMessage, due);
+    }
+    else if (!strcmp(member, WPANTUND_IF_CMD_CONFIG_GATEWAY) || !strcmp(member, WPANTUND_IF_CMD_NET_SCAN_STOP))
+    {
+        ReplyStatus(aMessage, kWPANTUNDStatus_Ok, due);
+    }
+    else
+    {
+        Schedule(dbus_message_new_error(&aMessage, DBUS_ERROR_UNKNOWN_METHOD, member), due);
+    }
+
+exit:
+    return result;
+}
+
+void Wpantund::HandleGetInterfaces(DBusMessage &aMessage, uint64_t aDue)
+{
+    DBusMessage    *reply = dbus_message_new_method_return(&aMessage);
+    DBusMessageIter iter;
+    DBusMessageIter listIter;
+    DBusMessageIter itemIter;
+    const char     *interfaceName = mInterfaceName;
+    const char     *busName = dbus_bus_get_unique_name(mDBus);
+
+    VerifyOrExit(reply != NULL);
+
+    // Signals are sent from the unique name, which the agent compares the looked up name with.
+    dbus_message_iter_init_append(reply, &iter);
+    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY, DBUS_TYPE_ARRAY_AS_STRING DBUS_TYPE_STRING_AS_STRING,
+                                     &listIter);
+    dbus_message_iter_open_container(&listIter, DBUS_TYPE_ARRAY, DBUS_TYPE_STRING_AS_STRING, &itemIter);
+    dbus_message_iter_append_basic(&itemIter, DBUS_TYPE_STRING, &interfaceName);
+    dbus_message_iter_append_basic(&itemIter, DBUS_TYPE_STRING, &busName);
+    dbus_message_iter_close_container(&listIter, &itemIter);
+    dbus_message_iter_close_container(&iter, &listIter);
+
+exit:
+    Schedule(reply, aDue);
+}
+
+const Property *Wpantund::FindProperty(const char *aKey) const
+{
+    Properties::const_iterator it = mProperties.find(aKey);
+
+    return it != mProperties.end() ? &it->second : NULL;
+}
+
+void Wpantund::HandlePropGet(DBusMessage &aMessage, uint64_t aDue)
+{
+    DBusMessage    *reply = dbus_message_new_method_return(&aMessage);
+    DBusMessageIter iter;
+    const char     *key = "";
+    const Property *property = NULL;
+    int32_t         status = kWPANTUNDStatus_Ok;
+
+    VerifyOrExit(reply != NULL);
+
+    dbus_message_get_args(&aMessage, NULL, DBUS_TYPE_STRING, &key, DBUS_TYPE_INVALID);
+    property = FindProperty(key);
+
+    // Like wpantund, the status is followed by the value, or by a string if there is none.
+    dbus_message_iter_init_append(reply, &iter);
+
+    if (property == NULL)
+    {
+        const char *empty = "<empty>";
+
+        status = kWPANTUNDStatus_PropertyNotFound;
+        dbus_message_iter_append_basic(&iter, DBUS_TYPE_INT32, &status);
+        dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &empty);
+    }
+    else
+    {
+        dbus_message_iter_append_basic(&iter, DBUS_TYPE_INT32, &status);
+        property->Append(iter);
+    }
+
+exit:
+    Schedule(reply, aDue);
+}
+
+void Wpantund::HandlePropSet(DBusMessage &aMessage, uint64_t aDue)
+{
+    DBusMessageIter iter;
+    const char     *key = NULL;
+    Property        value;
+    int32_t         status = kWPANTUNDStatus_InvalidArgument;
+
+    VerifyOrExit(dbus_message_iter_init(&aMessage, &iter) &&
+                 dbus_message_iter_get_arg_type(&iter) == DBUS_TYPE_STRING);
+    dbus_message_iter_get_basic(&iter, &key);
+    dbus_message_iter_next(&iter);
+    VerifyOrExit(value.Parse(iter));
+
+    status = kWPANTUNDStatus_Ok;
+
+    if (!strcmp(key, kWPANTUNDProperty_TmfProxyStream))
+    {
+        VerifyOrExit(value.mType == DBUS_TYPE_ARRAY && value.mData.size() > kSizeLocatorPort,
+                     status = kWPANTUNDStatus_InvalidArgument);
+        FeedTmf(value.mData);
+    }
+    else
+    {
+        SetProperty(key, value, aDue);
+    }
+
+exit:
+    // The agent sends the TMF proxy stream without expecting a reply.
+    if (!dbus_message_get_no_reply(&aMessage))
+    {
+        ReplyStatus(aMessage, status, aDue);
+    }
+}
+
+void Wpantund::SetProperty(const char *aKey, const Property &aValue, uint64_t aDue)
+{
+    DBusMessage    *signal = dbus_message_new_signal(mInterfacePath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                                     WPANTUND_IF_SIGNAL_PROP_CHANGED);
+    DBusMessageIter iter;
+
+    mProperties[aKey] = aValue;
+
+    VerifyOrExit(signal != NULL);
+    dbus_message_iter_init_append(signal, &iter);
+    dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &aKey);
+    aValue.Append(iter);
+
+exit:
+    Schedule(signal, aDue);
+}
+
+void Wpantund::ReplyStatus(DBusMessage &aMessage, int32_t aStatus, uint64_t aDue)
+{
+    DBusMessage *reply = dbus_message_new_method_return(&aMessage);
+
+    if (reply != NULL)
+    {
+        dbus_message_append_args(reply, DBUS_TYPE_INT32, &aStatus, DBUS_TYPE_INVALID);
+    }
+
+    Schedule(reply, aDue);
+}
+
+void Wpantund::HandleNetScanStart(DBusMessage &aMessage, uint64_t aDue)
+{
+    for (unsigned i = 0; i < mNumBeacons; i++)
+    {
+        SendBeacon(i, aDue);
+    }
+
+    ReplyStatus(aMessage, kWPANTUNDStatus_Ok, aDue);
+}
+
+static void AppendDictEntry(DBusMessageIter &aDict, const char *aKey, int aType, const void *aValue)
+{
+    DBusMessageIter entry;
+    DBusMessageIter variant;
+    const char      signature[] = { static_cast<char>(aType), '\0' };
+
+    dbus_message_iter_open_container(&aDict, DBUS_TYPE_DICT_ENTRY, NULL, &entry);
+    dbus_message_iter_append_basic(&entry, DBUS_TYPE_STRING, &aKey);
+    dbus_message_iter_open_container(&entry, DBUS_TYPE_VARIANT, signature, &variant);
+    dbus_message_iter_append_basic(&variant, aType, aValue);
+    dbus_message_iter_close_container(&entry, &variant);
+    dbus_message_iter_close_container(&aDict, &entry);
+}
+
+void Wpantund::SendBeacon(unsigned aIndex, uint64_t aDue)
+{
+    DBusMessage    *signal = dbus_message_new_signal(mInterfacePath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                                     WPANTUND_IF_SIGNAL_NET_SCAN_BEACON);
+    DBusMessageIter iter;
+    DBusMessageIter dict;
+    char            name[17];
+    const char     *networkName = name;
+    uint64_t        extPanId = 0xdead00beef000000ULL + aIndex;
+    uint16_t        panId = static_cast<uint16_t>(0x1000 + aIndex);
+    int16_t         channel = static_cast<int16_t>(11 + aIndex % 16);
+    int8_t          rssi = static_cast<int8_t>(-40 - static_cast<int>(aIndex % 60));
+    dbus_bool_t     joinable = (aIndex % 2 == 0) ? TRUE : FALSE;
+
+    VerifyOrExit(signal != NULL);
+
+    snprintf(name, sizeof(name), "fake-%u", aIndex);
+
+    // The entries of a beacon are those of wpantund's network dictionary.
+    dbus_message_iter_init_append(signal, &iter);
+    dbus_message_iter_open_container(&iter, DBUS_TYPE_ARRAY,
+                                     DBUS_DICT_ENTRY_BEGIN_CHAR_AS_STRING DBUS_TYPE_STRING_AS_STRING
+                                     DBUS_TYPE_VARIANT_AS_STRING DBUS_DICT_ENTRY_END_CHAR_AS_STRING, &dict);
+    AppendDictEntry(dict, kWPANTUNDProperty_NetworkName, DBUS_TYPE_STRING, &networkName);
+    AppendDictEntry(dict, kWPANTUNDProperty_NetworkXPANID, DBUS_TYPE_UINT64, &extPanId);
+    AppendDictEntry(dict, kWPANTUNDProperty_NetworkPANID, DBUS_TYPE_UINT16, &panId);
+    AppendDictEntry(dict, kWPANTUNDProperty_NCPChannel, DBUS_TYPE_INT16, &channel);
+    AppendDictEntry(dict, "RSSI", DBUS_TYPE_BYTE, &rssi);
+    AppendDictEntry(dict, kWPANTUNDProperty_NestLabs_NetworkAllowingJoin, DBUS_TYPE_BOOLEAN, &joinable);
+    dbus_message_iter_close_container(&iter, &dict);
+
+exit:
+    Schedule(signal, aDue);
+}
+
+void Wpantund::HandleForm(DBusMessage &aMessage, uint64_t aDue)
+{
+    const char *networkName = NULL;
+    int16_t     nodeType = 0;
+    uint32_t    channel = 0;
+    int32_t     status = kWPANTUNDStatus_InvalidArgument;
+
+    VerifyOrExit(dbus_message_get_args(&aMessage, NULL, DBUS_TYPE_STRING, &networkName, DBUS_TYPE_INT16, &nodeType,
+                                       DBUS_TYPE_UINT32, &channel, DBUS_TYPE_INVALID));
+
+    // The web service passes the channel itself, wpantund takes a mask of channels.
+    if (channel > 26)
+    {
+        uint32_t mask = channel;
+
+        for (channel = 11; channel <= 26 && !(mask & (1U << channel)); channel++)
+        {
+        }
+    }
+
+    VerifyOrExit(channel >= 11 && channel <= 26);
+
+    SetProperty(kWPANTUNDProperty_NetworkName, Property::String(networkName), aDue);
+    SetProperty(kWPANTUNDProperty_NCPChannel, Property::Integer(DBUS_TYPE_UINT16, channel), aDue);
+    SetProperty(kWPANTUNDProperty_NetworkNodeType, Property::String("leader"), aDue);
+    SetProperty(kWPANTUNDProperty_NCPState, Property::String(kWPANTUNDStateAssociated), aDue);
+    status = kWPANTUNDStatus_Ok;
+
+exit:
+    ReplyStatus(aMessage, status, aDue);
+}
+
+void Wpantund::HandleJoin(DBusMessage &aMessage, uint64_t aDue)
+{
+    const char *networkName = NULL;
+    int16_t     nodeType = 0;
+    uint64_t    extPanId = 0;
+    uint16_t    panId = 0;
+    uint8_t     channel = 0;
+    int32_t     status = kWPANTUNDStatus_InvalidArgument;
+
+    VerifyOrExit(dbus_message_get_args(&aMessage, NULL, DBUS_TYPE_STRING, &networkName, DBUS_TYPE_INT16, &nodeType,
+                                       DBUS_TYPE_UINT64, &extPanId, DBUS_TYPE_UINT16, &panId,
+                                       DBUS_TYPE_BYTE, &channel, DBUS_TYPE_INVALID));
+
+    SetProperty(kWPANTUNDProperty_NetworkName, Property::String(networkName), aDue);
+    SetProperty(kWPANTUNDProperty_NetworkXPANID, Property::Integer(DBUS_TYPE_UINT64, extPanId), aDue);
+    SetProperty(kWPANTUNDProperty_NetworkPANID, Property::Integer(DBUS_TYPE_UINT16, panId), aDue);
+    SetProperty(kWPANTUNDProperty_NCPChannel, Property::Integer(DBUS_TYPE_UINT16, channel), aDue);
+    SetProperty(kWPANTUNDProperty_NetworkNodeType, Property::String("router"), aDue);
+    SetProperty(kWPANTUNDProperty_NCPState, Property::String(kWPANTUNDStateAssociated), aDue);
+    status = kWPANTUNDStatus_Ok;
+
+exit:
+    ReplyStatus(aMessage, status, aDue);
+}
+
+void Wpantund::HandleLeave(DBusMessage &aMessage, uint64_t aDue)
+{
+    SetProperty(kWPANTUNDProperty_NCPState, Property::String(kWPANTUNDStateOffline), aDue);
+    ReplyStatus(aMessage, kWPANTUNDStatus_Ok, aDue);
+}
+
+void Wpantund::FeedTmf(const std::vector<uint8_t> &aStream)
+{
+    uint16_t   length = static_cast<uint16_t>(aStream.size() - kSizeLocatorPort);
+    uint16_t   locator = static_cast<uint16_t>((aStream[length] << 8) | aStream[length + 1]);
+    uint16_t   port = static_cast<uint16_t>((aStream[length + 2] << 8) | aStream[length + 3]);
+    Ip6Address address(locator);
+
+    // Every locator is answered by the leader, so that relayed messages to any joiner router are accounted.
+    mLeader->Input(&aStream[0], length, address.m8, port);
+}
+
+ssize_t Wpantund::SendTmf(const uint8_t *aBuffer, uint16_t aLength, const uint8_t *aIp6, uint16_t aPort)
+{
+    const Ip6Address *address = reinterpret_cast<const Ip6Address *>(aIp6);
+    uint16_t          locator = address->ToLocator();
+    Property          stream;
+    const Property   *enabled = FindProperty(kWPANTUNDProperty_TmfProxyEnabled);
+
+    VerifyOrExit(enabled != NULL && enabled->mInteger, otbrLog(OTBR_LOG_WARNING, "TMF proxy disabled, dropped."));
+
+    // Like the NCP, the stream is the message followed by the locator and port of the leader, network endian.
+    stream.mType = DBUS_TYPE_ARRAY;
+    stream.mData.assign(aBuffer, aBuffer + aLength);
+    stream.mData.push_back(static_cast<uint8_t>(locator >> 8));
+    stream.mData.push_back(static_cast<uint8_t>(locator & 0xff));
+    stream.mData.push_back(static_cast<uint8_t>(aPort >> 8));
+    stream.mData.push_back(static_cast<uint8_t>(aPort & 0xff));
+
+    {
+        DBusMessage    *signal = dbus_message_new_signal(mInterfacePath, WPANTUND_DBUS_APIv1_INTERFACE,
+                                                         WPANTUND_IF_SIGNAL_PROP_CHANGED);
+        DBusMessageIter iter;
+        const char     *key = kWPANTUNDProperty_TmfProxyStream;
+
+        if (signal != NULL)
+        {
+            dbus_message_iter_init_append(signal, &iter);
+            dbus_message_iter_append_basic(&iter, DBUS_TYPE_STRING, &key);
+            stream.Append(iter);
+        }
+
+        Schedule(signal, GetDue("Mesh"));
+    }
+
+exit:
+    return aLength;
+}
+
+void Wpantund::HandleLeaderRequest(const Coap::Resource &aResource, const Coap::Message &aRequest,
+                                   Coap::Message &aResponse)
+{
+    uint8_t        payload[kMaxPayload];
+    TlvWriter      writer(payload, sizeof(payload));
+    TlvView        view;
+    const uint8_t *request;
+    uint16_t       length = 0;
+    const char    *path = aResource.mPath;
+
+    mTmfCounters[path]++;
+
+    request = aRequest.GetPayload(length);
+    view.Init(request, length);
+
+    // Relayed messages are non-confirmable, there is no joiner on the loopback mesh to answer them.
+    VerifyOrExit(strcmp(path, OT_URI_PATH_RELAY_TX));
+
+    if (!strcmp(path, OT_URI_PATH_LEADER_PETITION))
+    {
+        const uint8_t *id = view.GetCommissionerId(length);
+
+        // Every petition is accepted, so that concurrent commissioners can be benchmarked.
+        writer.AppendState(kStateAccept);
+        if (id != NULL)
+        {
+            writer.Append(Meshcop::kCommissionerId, id, length);
+        }
+        writer.AppendCommissionerSessionId(++mSessionId);
+    }
+    else if (!strcmp(path, OT_URI_PATH_ACTIVE_GET))
+    {
+        length = WriteActiveDataset(payload, sizeof(payload));
+        aResponse.SetCode(Coap::kCodeChanged);
+        aResponse.SetPayload(payload, length);
+        ExitNow();
+    }
+    else if (!strcmp(path, OT_URI_PATH_COMMISSIONER_GET))
+    {
+        writer.AppendCommissionerSessionId(mSessionId);
+        writer.AppendUInt16(kBorderAgentRloc, kLeaderLocator);
+        if (!mSteeringData.empty())
+        {
+            writer.AppendSteeringData(reinterpret_cast<const uint8_t *>(mSteeringData.data()),
+                                      static_cast<uint8_t>(mSteeringData.size()));
+        }
+    }
+    else if (!strcmp(path, OT_URI_PATH_COMMISSIONER_SET))
+    {
+        const uint8_t *steeringData = view.GetSteeringData(length);
+
+        if (steeringData != NULL)
+        {
+            mSteeringData.assign(reinterpret_cast<const char *>(steeringData), length);
+        }
+        writer.AppendState(kStateAccept);
+    }
+    else if (!strcmp(path, OT_URI_PATH_ACTIVE_SET))
+    {
+        ApplyDataset(view);
+        writer.AppendState(kStateAccept);
+    }
+    else if (!strcmp(path, OT_URI_PATH_LEADER_KEEP_ALIVE) || !strcmp(path, OT_URI_PATH_PENDING_SET))
+    {
+        writer.AppendState(kStateAccept);
+    }
+
+    // There is no pending dataset, and scans and queries are only acknowledged.
+    aResponse.SetCode(Coap::kCodeChanged);
+    aResponse.SetPayload(payload, writer.GetLength());
+
+exit:
+    return;
+}
+
+uint16_t Wpantund::WriteActiveDataset(uint8_t *aBuffer, uint16_t aSize) const
+{
+    TlvWriter       writer(aBuffer, aSize);
+    const Property *property;
+    uint8_t         channel[3] = { 0, 0, 0 };
+    uint8_t         extPanId[8];
+    uint8_t         timestamp[8] = { 0, 0, 0, 0, 0, 1, 0, 0 };
+    const uint8_t   securityPolicy[3] = { 0x02, 0xa0, 0xff };
+
+    if ((property = FindProperty(kWPANTUNDProperty_NCPChannel)) != NULL)
+    {
+        channel[1] = static_cast<uint8_t>(property->mInteger >> 8);
+        channel[2] = static_cast<uint8_t>(property->mInteger & 0xff);
+        writer.Append(kChannel, channel, sizeof(channel));
+    }
+
+    if ((property = FindProperty(kWPANTUNDProperty_NetworkPANID)) != NULL)
+    {
+        writer.AppendUInt16(kPanId, static_cast<uint16_t>(property->mInteger));
+    }
+
+    if ((property = FindProperty(kWPANTUNDProperty_NetworkXPANID)) != NULL)
+    {
+        for (size_t i = 0; i < sizeof(extPanId); i++)
+        {
+            extPanId[i] = static_cast<uint8_t>(property->mInteger >> (8 * (sizeof(extPanId) - 1 - i)));
+        }
+        writer.Append(kExtendedPanId, extPanId, sizeof(extPanId));
+    }
+
+    if ((property = FindProperty(kWPANTUNDProperty_NetworkName)) != NULL)
+    {
+        writer.Append(kNetworkName, property->mString.data(), static_cast<uint16_t>(property->mString.size()));
+    }
+
+    if ((property = FindProperty(kWPANTUNDProperty_NetworkPSKc)) != NULL && !property->mData.empty())
+    {
+        writer.Append(kPSKc, &property->mData[0], static_cast<uint16_t>(property->mData.size()));
+    }
+
+    if ((property = FindProperty(kWPANTUNDProperty_NetworkKey)) != NULL && !property->mData.empty())
+    {
+        writer.Append(kNetworkKey, &property->mData[0], static_cast<uint16_t>(property->mData.size()));
+    }
+
+    writer.Append(kMeshLocalPrefix, kDefaultMeshLocalPrefix, sizeof(kDefaultMeshLocalPrefix));
+    writer.Append(kSecurityPolicy, securityPolicy, sizeof(securityPolicy));
+    writer.Append(kActiveTimestamp, timestamp, sizeof(timestamp));
+
+    return writer.GetLength();
+}
+
+void Wpantund::ApplyDataset(const TlvView &aView)
+{
+    const uint8_t *value;
+    uint16_t       length;
+    uint16_t       panId;
+    uint64_t       now = GetNowUs();
+
+    if ((value = aView.GetFixed(kChannel, 3)) != NULL)
+    {
+        SetProperty(kWPANTUNDProperty_NCPChannel,
+                    Property::Integer(DBUS_TYPE_UINT16, static_cast<uint16_t>((value[1] << 8) | value[2])), now);
+    }
+
+    if (aView.GetUInt16(kPanId, panId))
+    {
+        SetProperty(kWPANTUNDProperty_NetworkPANID, Property::Integer(DBUS_TYPE_UINT16, panId), now);
+    }
+
+    if ((value = aView.GetFixed(kExtendedPanId, 8)) != NULL)
+    {
+        uint64_t extPanId = 0;
+
+        for (int i = 0; i < 8; i++)
+        {
+            extPanId = (extPanId << 8) | value[i];
+        }
+        SetProperty(kWPANTUNDProperty_NetworkXPANID, Property::Integer(DBUS_TYPE_UINT64, extPanId), now);
+    }
+
+    if ((value = aView.GetValue(kNetworkName, length)) != NULL)
+    {
+        SetProperty(kWPANTUNDProperty_NetworkName,
+                    Property::String(std::string(reinterpret_cast<const char *>(value), length).c_str()), now);
+    }
+
+    // The agent follows the PSKc by its property changed signal.
+    if ((value = aView.GetFixed(kPSKc, 16)) != NULL)
+    {
+        SetProperty(kWPANTUNDProperty_NetworkPSKc, Property::Data(value, 16), now);
+    }
+}
+
+} // namespace Fake
+
+} // namespace BorderRouter
+
+} // namespace ot
+
+static void PrintUsage(const char *aProgram)
+{
+    fprintf(stderr,
+            "Usage: %s [-I interfaceName] [-d DEBUG_LEVEL] [-b beacons] [-k PSKc] [-l METHOD=DELAY[:JITTER]]... "
+            "[-f latencyScript]\n"
+            "    Serves the wpantund D-Bus APIs of interfaceName (default wpan0) on the starter or session bus.\n"
+            "    METHOD is a D-Bus method, e.g. PropGet, * for all methods, or Mesh for the TMF round trip through\n"
+            "    the loopback mesh, DELAY and JITTER are in milliseconds. The latency script has one\n"
+            "    METHOD=DELAY[:JITTER] per line. Counts of requests are printed on SIGINT or SIGTERM.\n",
+            aProgram);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *interfaceName = "wpan0";
+    const char *pskc = NULL;
+    const char *script = NULL;
+    unsigned    numBeacons = ot::BorderRouter::Fake::kDefaultBeacons;
+    int         logLevel = OTBR_LOG_INFO;
+    int         opt;
+    int         ret = 0;
+
+    std::vector<const char *> latencies;
+
+    while ((opt = getopt(argc, argv, "b:d:f:I:k:l:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b':
+            numBeacons = static_cast<unsigned>(strtoul(optarg, NULL, 0));
+            break;
+
+        case 'd':
+            logLevel = atoi(optarg);
+            break;
+
+        case 'f':
+            script = optarg;
+            break;
+
+        case 'I':
+            interfaceName = optarg;
+            break;
+
+        case 'k':
+            pskc = optarg;
+            break;
+
+        case 'l':
+            latencies.push_back(optarg);
+            break;
+
+        default:
+            PrintUsage(argv[0]);
+            ExitNow(ret = -1);
+            break;
+        }
+    }
+
+    otbrLogInit(ot::BorderRouter::Fake::kSyslogIdent, logLevel);
+
+    {
+        ot::BorderRouter::Fake::Wpantund wpantund(interfaceName, numBeacons);
+        uint8_t                          pskcBin[16];
+
+        if (pskc != NULL)
+        {
+            VerifyOrExit(strlen(pskc) == 2 * sizeof(pskcBin) &&
+                         ot::Utils::Hex2Bytes(pskc, pskcBin, sizeof(pskcBin)) == sizeof(pskcBin),
+                         fprintf(stderr, "PSKc must be %u bytes in hex.\n", static_cast<unsigned>(sizeof(pskcBin))),
+                         ret = -1);
+            wpantund.SetPSKc(pskcBin);
+        }
+
+        VerifyOrExit(script == NULL || wpantund.LoadScript(script) == OTBR_ERROR_NONE, ret = -1);
+
+        for (size_t i = 0; i < latencies.size(); i++)
+        {
+            VerifyOrExit(wpantund.SetLatency(latencies[i]) == OTBR_ERROR_NONE,
+                         fprintf(stderr, "Invalid latency %s.\n", latencies[i]), ret = -1);
+        }
+
+        VerifyOrExit(wpantund.Init() == OTBR_ERROR_NONE, ret = -1);
+
+        signal(SIGINT, ot::BorderRouter::Fake::HandleSignal);
+        signal(SIGTERM, ot::BorderRouter::Fake::HandleSignal);
+
+        wpantund.Run();
+        wpantund.Report();
+    }
+
+exit:
+    otbrLogDeinit();
+    return ret;
+}
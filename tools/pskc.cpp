@@ -1,4 +1,15 @@
 #include <cstdio>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
 
 #include "common/code_utils.hpp"
 #include "utils/hex.hpp"
@@ -9,9 +20,33 @@
  */
 enum
 {
-    kMaxNetworkName = 16,
-    kMaxPassphrase  = 255,
-    kSizeExtPanId   = 8,
+    kMaxNetworkName   = 16,
+    kMaxPassphrase    = 255,
+    kSizeExtPanId     = 8,
+    kMaxThreads       = 64,
+    kBatchesPerThread = 16,   ///< Number of batches per thread read before the results are written.
+    kMaxLine          = 512,
+};
+
+/**
+ * This structure represents a network of the batch mode.
+ */
+struct Network
+{
+    std::string mPassphrase;
+    std::string mExtPanId;
+    std::string mNetworkName;
+    uint8_t     mExtPanIdBin[kSizeExtPanId];
+    uint8_t     mPskc[OT_PSKC_LENGTH];
+};
+
+/**
+ * This structure represents the networks shared by the threads of the batch mode.
+ */
+struct Work
+{
+    std::vector<Network> mNetworks;
+    unsigned             mNext;
 };
 
 void help(void)
@@ -19,38 +54,62 @@ void help(void)
     printf("pskc - generate PSKc\n"
            "SYNTAX:\n"
            "    pskc <PASSPHRASE> <EXTPANID> <NETWORK_NAME>\n"
+           "    pskc -b [-j THREADS] [FILE]\n"
+           "BATCH:\n"
+           "    Reads lines of PASSPHRASE,EXTPANID,NETWORK_NAME from FILE, or the standard input if FILE is - or\n"
+           "    absent, and writes lines of EXTPANID,NETWORK_NAME,PSKC in the same order. Empty lines and lines\n"
+           "    starting with # are skipped. THREADS defaults to the number of CPUs. The throughput is reported\n"
+           "    to the standard error.\n"
            "EXAMPLE:\n"
-           "    pskc 654321 1122334455667788 OpenThread\n");
+           "    pskc 654321 1122334455667788 OpenThread\n"
+           "    echo 654321,1122334455667788,OpenThread | pskc -b\n");
 }
 
-int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+static bool checkArguments(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName,
+                           uint8_t *aExtPanIdBin, FILE *aOutput, const char *aPrefix)
 {
-    uint8_t extpanid[kSizeExtPanId];
-    size_t  length;
-    int     ret = -1;
-
-    ot::Psk::Pskc  pskcComputer;
-    const uint8_t *pskc;
+    size_t length;
+    bool   ret = false;
 
     length = strlen(aPassphrase);
-    VerifyOrExit(length > 0, printf("PASSPHRASE must not be empty.\n"));
+    VerifyOrExit(length > 0, fprintf(aOutput, "%sPASSPHRASE must not be empty.\n", aPrefix));
     VerifyOrExit(length <= kMaxPassphrase,
-                 printf("PASSPHRASE Passphrase must be no more than %d bytes.\n", kMaxPassphrase));
+                 fprintf(aOutput, "%sPASSPHRASE Passphrase must be no more than %d bytes.\n", aPrefix,
+                         kMaxPassphrase));
 
     length = strlen(aExtPanId);
-    VerifyOrExit(length == kSizeExtPanId * 2, printf("EXTPANID length must be %d bytes.\n", kSizeExtPanId));
+    VerifyOrExit(length == kSizeExtPanId * 2,
+                 fprintf(aOutput, "%sEXTPANID length must be %d bytes.\n", aPrefix, kSizeExtPanId));
     for (size_t i = 0; i < length; i++)
     {
         VerifyOrExit((aExtPanId[i] <= '9' && aExtPanId[i] >= '0') ||
                      (aExtPanId[i] <= 'f' && aExtPanId[i] >= 'a') ||
-                     (aExtPanId[i] <= 'F' && aExtPanId[i] >= 'A'), printf("EXTPANID must be encoded in hex.\n"));
+                     (aExtPanId[i] <= 'F' && aExtPanId[i] >= 'A'),
+                     fprintf(aOutput, "%sEXTPANID must be encoded in hex.\n", aPrefix));
     }
-    ot::Utils::Hex2Bytes(aExtPanId, extpanid, sizeof(extpanid));
+    ot::Utils::Hex2Bytes(aExtPanId, aExtPanIdBin, kSizeExtPanId);
 
     length = strlen(aNetworkName);
-    VerifyOrExit(length > 0, printf("NETWORK_NAME must not be empty.\n"));
+    VerifyOrExit(length > 0, fprintf(aOutput, "%sNETWORK_NAME must not be empty.\n", aPrefix));
     VerifyOrExit(length <= kMaxNetworkName,
-                 printf("NETWOR_KNAME length must be no more than %d bytes.\n", kMaxNetworkName));
+                 fprintf(aOutput, "%sNETWOR_KNAME length must be no more than %d bytes.\n", aPrefix,
+                         kMaxNetworkName));
+
+    ret = true;
+
+exit:
+    return ret;
+}
+
+int printPSKc(const char *aPassphrase, const char *aExtPanId, const char *aNetworkName)
+{
+    uint8_t extpanid[kSizeExtPanId];
+    int     ret = -1;
+
+    ot::Psk::Pskc  pskcComputer;
+    const uint8_t *pskc;
+
+    VerifyOrExit(checkArguments(aPassphrase, aExtPanId, aNetworkName, extpanid, stdout, ""));
 
     pskc = pskcComputer.ComputePskc(extpanid, aNetworkName, aPassphrase);
     for (int i = 0; i < 16; i++)
@@ -64,9 +123,239 @@ exit:
     return ret;
 }
 
+/**
+ * This function computes the PSKcs of the networks, a batch of interleaved PBKDF2 chains at a time.
+ */
+static void *computeBatches(void *aContext)
+{
+    Work          &work = *static_cast<Work *>(aContext);
+    ot::Psk::Pskc  pskcs[ot::Psk::Pskc::kMaxBatchSize];
+    const uint8_t *extpanids[ot::Psk::Pskc::kMaxBatchSize];
+    const char    *networkNames[ot::Psk::Pskc::kMaxBatchSize];
+    const char    *passphrases[ot::Psk::Pskc::kMaxBatchSize];
+    unsigned       start;
+
+    while ((start = __sync_fetch_and_add(&work.mNext, ot::Psk::Pskc::kMaxBatchSize)) < work.mNetworks.size())
+    {
+        uint8_t count = 0;
+
+        for (unsigned i = start; i < work.mNetworks.size() && count < ot::Psk::Pskc::kMaxBatchSize; i++, count++)
+        {
+            extpanids[count] = work.mNetworks[i].mExtPanIdBin;
+            networkNames[count] = work.mNetworks[i].mNetworkName.c_str();
+            passphrases[count] = work.mNetworks[i].mPassphrase.c_str();
+        }
+
+        ot::Psk::Pskc::ComputePskcs(pskcs, extpanids, networkNames, passphrases, count);
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            memcpy(work.mNetworks[start + i].mPskc, pskcs[i].GetPskc(), OT_PSKC_LENGTH);
+        }
+    }
+
+    return NULL;
+}
+
+static void computeAndPrint(Work &aWork, unsigned aNumThreads)
+{
+    pthread_t threads[kMaxThreads];
+    unsigned  numThreads = 0;
+
+    aWork.mNext = 0;
+
+    // The calling thread computes too.
+    for (; numThreads + 1 < aNumThreads; numThreads++)
+    {
+        if (pthread_create(&threads[numThreads], NULL, computeBatches, &aWork) != 0)
+        {
+            break;
+        }
+    }
+
+    computeBatches(&aWork);
+
+    for (unsigned i = 0; i < numThreads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (std::vector<Network>::const_iterator it = aWork.mNetworks.begin(); it != aWork.mNetworks.end(); ++it)
+    {
+        printf("%s,%s,", it->mExtPanId.c_str(), it->mNetworkName.c_str());
+        for (int i = 0; i < OT_PSKC_LENGTH; i++)
+        {
+            printf("%02x", it->mPskc[i]);
+        }
+        printf("\n");
+    }
+
+    fflush(stdout);
+}
+
+/**
+ * This function parses a line of the batch mode, and appends its network to the work.
+ */
+static bool parseLine(char *aLine, unsigned aLineNumber, Work &aWork)
+{
+    char    prefix[32];
+    char   *extpanid;
+    char   *networkName;
+    Network network;
+    bool    ret = false;
+
+    snprintf(prefix, sizeof(prefix), "line %u: ", aLineNumber);
+
+    extpanid = strchr(aLine, ',');
+    VerifyOrExit(extpanid != NULL, fprintf(stderr, "%sexpecting PASSPHRASE,EXTPANID,NETWORK_NAME.\n", prefix));
+    *extpanid++ = '\0';
+
+    networkName = strchr(extpanid, ',');
+    VerifyOrExit(networkName != NULL, fprintf(stderr, "%sexpecting PASSPHRASE,EXTPANID,NETWORK_NAME.\n", prefix));
+    *networkName++ = '\0';
+
+    VerifyOrExit(checkArguments(aLine, extpanid, networkName, network.mExtPanIdBin, stderr, prefix));
+
+    network.mPassphrase = aLine;
+    network.mExtPanId = extpanid;
+    network.mNetworkName = networkName;
+    aWork.mNetworks.push_back(network);
+    ret = true;
+
+exit:
+    return ret;
+}
+
+static uint64_t getMicroseconds(void)
+{
+    struct timeval now;
+
+    gettimeofday(&now, NULL);
+
+    return static_cast<uint64_t>(now.tv_sec) * 1000000 + static_cast<uint64_t>(now.tv_usec);
+}
+
+int printPSKcs(const char *aFile, unsigned aNumThreads)
+{
+    FILE         *input = stdin;
+    Work          work;
+    char          line[kMaxLine];
+    unsigned      lineNumber = 0;
+    unsigned long count = 0;
+    uint64_t      elapsed = getMicroseconds();
+    size_t        chunkSize = aNumThreads * ot::Psk::Pskc::kMaxBatchSize * kBatchesPerThread;
+    int           ret = 0;
+
+    if (aFile != NULL && strcmp(aFile, "-") != 0)
+    {
+        input = fopen(aFile, "r");
+        VerifyOrExit(input != NULL, perror(aFile), ret = -1);
+    }
+
+    work.mNetworks.reserve(chunkSize);
+
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        size_t length = strlen(line);
+
+        lineNumber++;
+
+        if (length > 0 && line[length - 1] == '\n')
+        {
+            line[--length] = '\0';
+        }
+        else if (!feof(input))
+        {
+            int c;
+
+            fprintf(stderr, "line %u: longer than %d bytes.\n", lineNumber, kMaxLine - 2);
+            ret = -1;
+
+            while ((c = fgetc(input)) != EOF && c != '\n')
+            {
+            }
+
+            continue;
+        }
+
+        if (length > 0 && line[length - 1] == '\r')
+        {
+            line[--length] = '\0';
+        }
+
+        if (length == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        if (!parseLine(line, lineNumber, work))
+        {
+            ret = -1;
+        }
+
+        // Results are written as a stream, a chunk at a time.
+        if (work.mNetworks.size() >= chunkSize)
+        {
+            computeAndPrint(work, aNumThreads);
+            count += work.mNetworks.size();
+            work.mNetworks.clear();
+        }
+    }
+
+    computeAndPrint(work, aNumThreads);
+    count += work.mNetworks.size();
+
+    elapsed = getMicroseconds() - elapsed;
+    fprintf(stderr, "%lu PSKc in %.3fs with %u threads, %.1f PSKc/s\n", count, elapsed / 1000000.0, aNumThreads,
+            elapsed > 0 ? count * 1000000.0 / elapsed : 0.0);
+
+exit:
+    if (input != NULL && input != stdin)
+    {
+        fclose(input);
+    }
+
+    return ret;
+}
+
 int main(int argc, char *argv[])
 {
-    int ret = 0;
+    int  ret = 0;
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    int  arg = 2;
+
+    VerifyOrExit(argc > 1, help(), ret = -1);
+
+    if (strcmp(argv[1], "-b") == 0)
+    {
+        if (numThreads > kMaxThreads)
+        {
+            numThreads = kMaxThreads;
+        }
+        else if (numThreads < 1)
+        {
+            numThreads = 1;
+        }
+
+        if (arg + 1 < argc && strcmp(argv[arg], "-j") == 0)
+        {
+            char *end;
+
+            errno = 0;
+            numThreads = strtol(argv[arg + 1], &end, 0);
+
+            if (errno != 0 || end == argv[arg + 1] || *end != '\0')
+            {
+                numThreads = 0;
+            }
+
+            arg += 2;
+        }
+
+        VerifyOrExit(argc <= arg + 1 && numThreads > 0 && numThreads <= kMaxThreads, help(), ret = -1);
+        ret = printPSKcs(arg < argc ? argv[arg] : NULL, static_cast<unsigned>(numThreads));
+        ExitNow();
+    }
 
     VerifyOrExit(argc == 4, help(), ret = -1);
     ret = printPSKc(argv[1], argv[2], argv[3]);